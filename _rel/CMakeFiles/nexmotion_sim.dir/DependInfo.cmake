@@ -0,0 +1,40 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/sim/SimApi.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimApi.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimApi.cpp.o.d"
+  "/root/repo/src/sim/SimAxis.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimAxis.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimAxis.cpp.o.d"
+  "/root/repo/src/sim/SimConfig.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimConfig.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimConfig.cpp.o.d"
+  "/root/repo/src/sim/SimConfigCache.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimConfigCache.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimConfigCache.cpp.o.d"
+  "/root/repo/src/sim/SimDevice.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimDevice.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimDevice.cpp.o.d"
+  "/root/repo/src/sim/SimEvent.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimEvent.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimEvent.cpp.o.d"
+  "/root/repo/src/sim/SimFrame.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimFrame.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimFrame.cpp.o.d"
+  "/root/repo/src/sim/SimGroup.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimGroup.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimGroup.cpp.o.d"
+  "/root/repo/src/sim/SimInputEdge.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimInputEdge.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimInputEdge.cpp.o.d"
+  "/root/repo/src/sim/SimIoCapture.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoCapture.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoCapture.cpp.o.d"
+  "/root/repo/src/sim/SimIoGather.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoGather.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoGather.cpp.o.d"
+  "/root/repo/src/sim/SimIoImage.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoImage.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoImage.cpp.o.d"
+  "/root/repo/src/sim/SimIoMap.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoMap.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoMap.cpp.o.d"
+  "/root/repo/src/sim/SimOutputMask.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimOutputMask.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimOutputMask.cpp.o.d"
+  "/root/repo/src/sim/SimParam.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimParam.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimParam.cpp.o.d"
+  "/root/repo/src/sim/SimParamBlob.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimParamBlob.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimParamBlob.cpp.o.d"
+  "/root/repo/src/sim/SimProfile.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimProfile.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimProfile.cpp.o.d"
+  "/root/repo/src/sim/SimRealtime.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimRealtime.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimRealtime.cpp.o.d"
+  "/root/repo/src/sim/SimRuntime.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimRuntime.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimRuntime.cpp.o.d"
+  "/root/repo/src/sim/SimSCurve.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimSCurve.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimSCurve.cpp.o.d"
+  "/root/repo/src/sim/SimSnapshot.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimSnapshot.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimSnapshot.cpp.o.d"
+  "/root/repo/src/sim/SimSpline.cpp" "CMakeFiles/nexmotion_sim.dir/src/sim/SimSpline.cpp.o" "gcc" "CMakeFiles/nexmotion_sim.dir/src/sim/SimSpline.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
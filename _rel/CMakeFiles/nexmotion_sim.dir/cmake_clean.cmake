@@ -0,0 +1,53 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimApi.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimApi.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimAxis.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimAxis.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimConfig.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimConfig.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimConfigCache.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimConfigCache.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimDevice.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimDevice.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimEvent.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimEvent.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimFrame.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimFrame.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimGroup.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimGroup.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimInputEdge.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimInputEdge.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoCapture.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoCapture.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoGather.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoGather.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoImage.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoImage.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoMap.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimIoMap.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimOutputMask.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimOutputMask.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimParam.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimParam.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimParamBlob.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimParamBlob.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimProfile.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimProfile.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimRealtime.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimRealtime.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimRuntime.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimRuntime.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimSCurve.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimSCurve.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimSnapshot.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimSnapshot.cpp.o.d"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimSpline.cpp.o"
+  "CMakeFiles/nexmotion_sim.dir/src/sim/SimSpline.cpp.o.d"
+  "libnexmotion_sim.a"
+  "libnexmotion_sim.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nexmotion_sim.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nmc_config_cache.dir/src/tools/NmcConfigCache.cpp.o"
+  "CMakeFiles/nmc_config_cache.dir/src/tools/NmcConfigCache.cpp.o.d"
+  "nmc_config_cache"
+  "nmc_config_cache.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nmc_config_cache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nmc_io_capture.dir/src/tools/NmcIoCapture.cpp.o"
+  "CMakeFiles/nmc_io_capture.dir/src/tools/NmcIoCapture.cpp.o.d"
+  "nmc_io_capture"
+  "nmc_io_capture.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nmc_io_capture.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nmc_scurve.dir/src/tools/NmcSCurve.cpp.o"
+  "CMakeFiles/nmc_scurve.dir/src/tools/NmcSCurve.cpp.o.d"
+  "nmc_scurve"
+  "nmc_scurve.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nmc_scurve.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -11,9 +11,13 @@
 #define __NEXMOTION_H
 
 /*!
- * @brief define marco FNTYPE as __stdcall
+ * @brief define marco FNTYPE as __stdcall (Windows only, empty for the other platforms)
  */
+#if defined(_WIN32)
 #define FNTYPE  __stdcall
+#else
+#define FNTYPE
+#endif
 
 #ifdef __cplusplus
   extern "C" {
@@ -148,6 +152,25 @@ RTN_ERR FNTYPE NMC_DeviceShutdown( I32_T DevID );
  * NMC_DeviceWaitOpenUpRequest()
  */
 RTN_ERR FNTYPE NMC_DeviceOpenUpRequest( I32_T DevType, I32_T DevIndex );
+/*!
+ * @brief Request the device open up with options (Non-blocking call).
+ *
+ * @param DevType   The specified device type
+ * @param DevIndex  The specified index of device which is set to 0
+ * @param Options   A combination of NMC_OPENUP_OPT_*, 0 is the same as NMC_DeviceOpenUpRequest().
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. With NMC_OPENUP_OPT_ENABLE_ALL, every axis and group is enabled as the last phase of the open up, as by NMC_DeviceEnableAll().
+ *    NMC_DeviceWaitOpenUpRequest() then returns once the device is ready to move.
+ * 2. The progress of the open up can be read by NMC_DeviceGetOpenUpProgress() meanwhile.
+ *
+ * \b Reference: <br>
+ * NMC_DeviceOpenUpRequest(), NMC_DeviceGetOpenUpProgress()
+ */
+RTN_ERR FNTYPE NMC_DeviceOpenUpRequestEx( I32_T DevType, I32_T DevIndex, I32_T Options );
 /*!
  * @brief Wait for device open up (Blocking call).
  *
@@ -164,6 +187,36 @@ RTN_ERR FNTYPE NMC_DeviceOpenUpRequest( I32_T DevType, I32_T DevIndex );
  * NMC_DeviceOpenUpRequest()
  */
 RTN_ERR FNTYPE NMC_DeviceWaitOpenUpRequest( U32_T WaitMs, I32_T *PRetDevID  );
+/*!
+ * @brief Get the phase and the phase timings of the last device open up.
+ *
+ * @param[out] PRetProgress Return the progress. The "sizeOfStruct" member variable must be initialized before calling the function.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ * If no open up was started yet, the return value is ERR_NEXMOTION_WAIT_FAILED.
+ *
+ * \b Usage: <br>
+ * 1. The last open up is the last call of NMC_DeviceOpenUp(), NMC_DeviceOpenUpRequest() or NMC_DeviceOpenUpRequestEx().
+ * 2. The open up runs the phases NMC_OPENUP_PHASE_CREATE to NMC_OPENUP_PHASE_ENABLE in order, then the phase is NMC_OPENUP_PHASE_DONE
+ *    and "result" is the return value of the open up. The axes and groups are configured and started by several threads in parallel.
+ * 3. "phaseTimeUs" holds the time spent in each phase, 0 for a phase not run. While the open up runs, the entry of the current phase
+ *    and "totalTimeUs" are the time spent so far.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcOpenUpProgress_T progress;
+ * progress.sizeOfStruct = sizeof( progress );
+ * NMC_DeviceOpenUpRequestEx( NMC_DEVICE_TYPE_SIMULATOR, 0, NMC_OPENUP_OPT_ENABLE_ALL );
+ * while( NMC_DeviceGetOpenUpProgress( &progress ) == 0 && progress.phase != NMC_OPENUP_PHASE_DONE )
+ *   Sleep( 10 );
+ * printf( "open up %d in %u us\n", progress.result, progress.totalTimeUs );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceOpenUpRequestEx()
+ */
+RTN_ERR FNTYPE NMC_DeviceGetOpenUpProgress( NmcOpenUpProgress_T *PRetProgress );
 /*!
  * @brief Request the device shut down (Non-blocking call).
  *
@@ -389,6 +442,106 @@ RTN_ERR FNTYPE NMC_DeviceStopRequest( I32_T DevID );
  * \b Reference: <br>
  */
 RTN_ERR FNTYPE NMC_DeviceGetState( I32_T DevID, I32_T *PRetDeviceState );
+/*!
+ * @brief Read the status of every axis and group of the device in a single call.
+ *
+ * @param DevID        Device ID (DevID)
+ * @param[out] PRetSnapshot Return the status of the axes and groups after called successfully. The "sizeOfStruct" member
+ * variable must be initialized before calling the function.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ * If "sizeOfStruct" is not sizeof(NmcSnapshot_T), the function returns ERR_NEXMOTION_STRUCT_SIZE_INCOMPTIBLE.
+ *
+ * \b Usage: <br>
+ * All the data is taken from the same motion cycle, identified by cycleCount and timestampNs. The function does not wait
+ * for the motion cycle and replaces the NMC_AxisGetState(), NMC_AxisGetStatus(), NMC_AxisGetCommandPos(),
+ * NMC_AxisGetActualPos(), NMC_AxisGetCommandVel(), NMC_AxisGetActualVel() and group equivalent calls of a polling loop.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcSnapshot_T snap;
+ * snap.sizeOfStruct = sizeof(snap);
+ * if( NMC_DeviceGetSnapshot( devId, &snap ) == ERR_NEXMOTION_SUCCESS )
+ * {
+ *   for( I32_T i = 0; i < snap.axisCount; ++i )
+ *     printf( "Axis%d: state=%d pos=%f\n", i, snap.axisState[i], snap.axisActPos[i] );
+ * }
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_AxisGetStatus(), NMC_GroupGetStatus()
+ */
+RTN_ERR FNTYPE NMC_DeviceGetSnapshot( I32_T DevID, NmcSnapshot_T *PRetSnapshot );
+/*!
+ * @brief Subscribe to the events of the device and get a file descriptor which is readable while event records are pending.
+ *
+ * @param DevID         Device ID (DevID)
+ * @param EventMask     The events to record, a combination of NMC_EVENT_MASK_*. Set to 0 to stop recording.
+ * @param BuffLowWater  The low-water mark of NMC_EVENT_AXIS_BUFF_LOW and NMC_EVENT_GROUP_BUFF_LOW: number of buffered motions
+ *                      waiting behind the running motion.
+ * @param[out] PRetFd   Return the file descriptor (an eventfd), the same for every call on the device.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. Add the file descriptor to an epoll (or poll, select) set for reading. It is level triggered: it stays readable until
+ *    NMC_DevicePopEvents() has returned every pending record. Do not read or close it; it is closed when the device is shut down.
+ * 2. The events are detected by comparing the status of each motion cycle, and of each function call changing it, with the previous one:
+ *    | Event                     | Recorded when                                                    | prevValue, value              |
+ *    | :----                     | :----                                                            | :----                         |
+ *    | NMC_EVENT_AXIS_STATE      | The [axis state](@ref NMC_AxisGetState) changed                  | The states                    |
+ *    | NMC_EVENT_GROUP_STATE     | The [group state](@ref NMC_GroupGetState) changed                | The states                    |
+ *    | NMC_EVENT_AXIS_BUFF_LOW   | The buffered motions of an axis dropped to BuffLowWater or less  | The numbers of motions        |
+ *    | NMC_EVENT_GROUP_BUFF_LOW  | The buffered motions of a group dropped to BuffLowWater or less  | The numbers of motions        |
+ *    | NMC_EVENT_AXIS_DRIVE_ALM  | The [drive alarm code](@ref NMC_AxisGetDriveAlmCode) changed     | The alarm codes               |
+ *    | NMC_EVENT_MESSAGE         | System messages were posted, see NMC_MessagePopFirst()           | The next message index        |
+ * 3. Up to 1024 records are kept. A record which finds 1024 pending is dropped and counted by the read only system parameter 0x24.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * I32_T fd;
+ * NMC_DeviceSubscribeEvents( devId, NMC_EVENT_MASK_GROUP_STATE | NMC_EVENT_MASK_MESSAGE, 0, &fd );
+ * struct epoll_event ev = { EPOLLIN, { 0 } };
+ * epoll_ctl( epfd, EPOLL_CTL_ADD, fd, &ev );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DevicePopEvents()
+ */
+RTN_ERR FNTYPE NMC_DeviceSubscribeEvents( I32_T DevID, U32_T EventMask, I32_T BuffLowWater, I32_T *PRetFd );
+/*!
+ * @brief Move the pending event records of the device to an array, oldest first.
+ *
+ * @param DevID           Device ID (DevID)
+ * @param MaxCount        The size of the PRetEvents array
+ * @param[out] PRetEvents Return the event records
+ * @param[out] PRetCount  Return the number of records returned, 0 if none is pending
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * The function does not wait for the motion cycle. Call it when the file descriptor of NMC_DeviceSubscribeEvents() is readable,
+ * until *PRetCount is less than MaxCount.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcEvent_T events[64];
+ * I32_T      count = 0;
+ * do
+ * {
+ *   NMC_DevicePopEvents( devId, 64, events, &count );
+ *   for( I32_T i = 0; i < count; ++i )
+ *     printf( "event %d index %d: %d -> %d\n", events[i].type, events[i].index, events[i].prevValue, events[i].value );
+ * } while( count == 64 );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceSubscribeEvents()
+ */
+RTN_ERR FNTYPE NMC_DevicePopEvents( I32_T DevID, I32_T MaxCount, NmcEvent_T *PRetEvents, I32_T *PRetCount );
 /*!
  *  @}
  */
@@ -434,6 +587,203 @@ RTN_ERR FNTYPE NMC_DeviceSetParam( I32_T DevID, I32_T ParamNum, I32_T SubIndex,
  * Please refer to the section, System Parameters.
  */
 RTN_ERR FNTYPE NMC_DeviceGetParam( I32_T DevID, I32_T ParamNum, I32_T SubIndex, I32_T *PRetParaValue );
+/*!
+ * @brief Open a parameter transaction.
+ *
+ * @param DevID         Device ID (DevID)
+ * @param[out] PRetTxID Return the ID of the transaction
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. A transaction collects writes of system, axis, group and group axis parameters which are applied together
+ *    by NMC_DeviceParamTxCommit(), so the motion never runs with a part of them.
+ * 2. Up to NMC_MAX_PARAM_TX transactions can be open on a device, the transaction is closed by
+ *    NMC_DeviceParamTxCommit() or NMC_DeviceParamTxAbort().
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * I32_T   txId, failed;
+ * RTN_ERR entryErr[12];
+ * NMC_DeviceParamTxBegin( devId, &txId );
+ * for( I32_T i = 0; i < 6; ++i )
+ * {
+ *   NMC_DeviceParamTxStageF64( devId, txId, NMC_PARAM_SCOPE_GROUP_AXIS, 0, i, 0x32, 0, vm[i] );
+ *   NMC_DeviceParamTxStageF64( devId, txId, NMC_PARAM_SCOPE_GROUP_AXIS, 0, i, 0x33, 0, acc[i] );
+ * }
+ * ret = NMC_DeviceParamTxCommit( devId, txId, 12, entryErr, &failed );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceParamTxStageI32(), NMC_DeviceParamTxStageF64(), NMC_DeviceParamTxCommit(), NMC_DeviceParamTxAbort()
+ */
+RTN_ERR FNTYPE NMC_DeviceParamTxBegin( I32_T DevID, I32_T *PRetTxID );
+/*!
+ * @brief Stage the write of an I32 parameter in a parameter transaction.
+ *
+ * @param DevID          Device ID (DevID)
+ * @param TxID           Transaction ID returned by NMC_DeviceParamTxBegin()
+ * @param Scope          [Parameter scope](@ref Param_Scope), NMC_PARAM_SCOPE_*
+ * @param Index          Axis index or group index, ignored for NMC_PARAM_SCOPE_DEVICE
+ * @param GroupAxisIndex Axis index in the group for NMC_PARAM_SCOPE_GROUP_AXIS, ignored otherwise
+ * @param ParamNum       Parameter Number
+ * @param SubIndex       Parameter Sub-index
+ * @param ParaValueI32   Value to be set
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. The write is only recorded, it is checked and applied by NMC_DeviceParamTxCommit(). Entries are numbered from 0 in the staging order.
+ * 2. Up to NMC_MAX_PARAM_TX_ENTRIES writes can be staged, a later write of the same parameter overrides an earlier one.
+ * 3. The system parameters 0x01 and 0x02 (axis and group counts) cannot be written by a transaction.
+ *
+ * \b Reference: <br>
+ * NMC_DeviceParamTxBegin()
+ */
+RTN_ERR FNTYPE NMC_DeviceParamTxStageI32( I32_T DevID, I32_T TxID, I32_T Scope, I32_T Index, I32_T GroupAxisIndex, I32_T ParamNum, I32_T SubIndex, I32_T ParaValueI32 );
+/*!
+ * @brief Stage the write of an F64 parameter in a parameter transaction.
+ *
+ * @param DevID          Device ID (DevID)
+ * @param TxID           Transaction ID returned by NMC_DeviceParamTxBegin()
+ * @param Scope          [Parameter scope](@ref Param_Scope), NMC_PARAM_SCOPE_*
+ * @param Index          Axis index or group index
+ * @param GroupAxisIndex Axis index in the group for NMC_PARAM_SCOPE_GROUP_AXIS, ignored otherwise
+ * @param ParamNum       Parameter Number
+ * @param SubIndex       Parameter Sub-index
+ * @param ParaValueF64   Value to be set
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * See NMC_DeviceParamTxStageI32().
+ *
+ * \b Reference: <br>
+ * NMC_DeviceParamTxBegin()
+ */
+RTN_ERR FNTYPE NMC_DeviceParamTxStageF64( I32_T DevID, I32_T TxID, I32_T Scope, I32_T Index, I32_T GroupAxisIndex, I32_T ParamNum, I32_T SubIndex, F64_T ParaValueF64 );
+/*!
+ * @brief Check and apply every write of a parameter transaction, then close it.
+ *
+ * @param DevID                        Device ID (DevID)
+ * @param TxID                         Transaction ID returned by NMC_DeviceParamTxBegin()
+ * @param MaxCount                     The size of the PRetEntryErrors array
+ * @param[out] PRetEntryErrors         _opt_null_ Return the error code of each staged write, in the staging order
+ * @param[out] PRetFailedCount         _opt_null_ Return the number of rejected writes
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. Every write is checked as by the corresponding NMC_*SetParam*() function. If one is rejected, none is applied and the
+ *    error of the first rejected write is returned; PRetEntryErrors tells which writes were rejected.
+ * 2. Otherwise all writes are applied between two motion cycles: the next cycle runs with all of them.
+ * 3. The transaction is closed in both cases.
+ *
+ * \b Reference: <br>
+ * NMC_DeviceParamTxBegin()
+ */
+RTN_ERR FNTYPE NMC_DeviceParamTxCommit( I32_T DevID, I32_T TxID, I32_T MaxCount, _opt_null_ RTN_ERR *PRetEntryErrors, _opt_null_ I32_T *PRetFailedCount );
+/*!
+ * @brief Close a parameter transaction without applying it.
+ *
+ * @param DevID  Device ID (DevID)
+ * @param TxID   Transaction ID returned by NMC_DeviceParamTxBegin()
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Reference: <br>
+ * NMC_DeviceParamTxBegin()
+ */
+RTN_ERR FNTYPE NMC_DeviceParamTxAbort( I32_T DevID, I32_T TxID );
+/*!
+ * @brief Export every parameter of a device to a binary image.
+ *
+ * @param DevID                Device ID (DevID)
+ * @param BufferSize           The size of the buffer PRetBuffer, in byte
+ * @param[out] PRetBuffer      _opt_null_ Return the image. If it is NULL, only the size of the image is returned.
+ * @param[out] PRetSizeByte    Return the size of the image, in byte
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. The image holds every system, axis, group and group axis parameter which is not read only, read in one pass between two
+ *    motion cycles. Its size depends on the axis count of the device and of its groups only.
+ * 2. If BufferSize is smaller than the image, ERR_NEXMOTION_ACCESS_AREA_INVALID is returned and PRetSizeByte tells the size needed.
+ * 3. The image can be stored as is, restored by NMC_DeviceImportParams() and compared by NMC_DiffParams(). It is checked by a hash
+ *    and bound to the parameter tables of the library, an image of another version is rejected with ERR_NEXMOTION_FILE_VERSION_INCOMPTIBLE.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * U32_T size;
+ * NMC_DeviceExportParams( devId, 0, NULL, &size );
+ * U8_T *image = (U8_T *)malloc( size );
+ * ret = NMC_DeviceExportParams( devId, size, image, &size );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceImportParams(), NMC_DiffParams()
+ */
+RTN_ERR FNTYPE NMC_DeviceExportParams( I32_T DevID, U32_T BufferSize, _opt_null_ void *PRetBuffer, U32_T *PRetSizeByte );
+/*!
+ * @brief Restore the parameters of a device from an image of NMC_DeviceExportParams().
+ *
+ * @param DevID                    Device ID (DevID)
+ * @param SizeByte                 The size of the image, in byte
+ * @param PBuffer                  The image
+ * @param[out] PRetChangedCount    _opt_null_ Return the number of parameters which were changed
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. The image must come from a device with the same axis count and the same axis count in each group, otherwise
+ *    ERR_NEXMOTION_AXIS_COUNT_INVALID or ERR_NEXMOTION_GROUP_COUNT_INVALID is returned.
+ * 2. Every value which differs from the current one is checked as by the corresponding NMC_*SetParam*() function; in the operation
+ *    state, the parameters effective after start must be unchanged. If one is rejected, none is applied and its error is returned.
+ * 3. Otherwise all values are applied between two motion cycles, as by NMC_DeviceParamTxCommit().
+ *
+ * \b Reference: <br>
+ * NMC_DeviceExportParams()
+ */
+RTN_ERR FNTYPE NMC_DeviceImportParams( I32_T DevID, U32_T SizeByte, const void *PBuffer, _opt_null_ I32_T *PRetChangedCount );
+/*!
+ * @brief Compare two images of NMC_DeviceExportParams() and return the parameters which differ.
+ *
+ * @param SizeByteA            The size of the first image, in byte
+ * @param PBufferA             The first image, the old values
+ * @param SizeByteB            The size of the second image, in byte
+ * @param PBufferB             The second image, the new values
+ * @param MaxCount             The size of the PRetDiffs array
+ * @param[out] PRetDiffs       _opt_null_ Return the first MaxCount differences, see NmcParamDiff_T
+ * @param[out] PRetDiffCount   Return the number of differences, which may be larger than MaxCount
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. No device is needed. The images must have the same axis and group axis counts.
+ * 2. The differences are ordered as the images: system parameters, then each axis, then each group followed by its group axes.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcParamDiff_T diff[64];
+ * I32_T          count;
+ * NMC_DiffParams( sizeBefore, before, sizeAfter, after, 64, diff, &count );
+ * for( I32_T i = 0; i < count && i < 64; ++i )
+ *   printf( "%d.%d.%d 0x%X:%d %g -> %g\n", diff[i].scope, diff[i].index, diff[i].groupAxisIndex,
+ *           diff[i].paramNum, diff[i].subIndex, diff[i].oldValue, diff[i].newValue );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceExportParams()
+ */
+RTN_ERR FNTYPE NMC_DiffParams( U32_T SizeByteA, const void *PBufferA, U32_T SizeByteB, const void *PBufferB, I32_T MaxCount, _opt_null_ NmcParamDiff_T *PRetDiffs, I32_T *PRetDiffCount );
 /*!
  * @brief Set the path of the ini file.
  *
@@ -443,167 +793,535 @@ RTN_ERR FNTYPE NMC_DeviceGetParam( I32_T DevID, I32_T ParamNum, I32_T SubIndex,
  * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
  *
  * \b Usage: <br>
- * During the starting, the system will load the configurations in accordance with the file, NexMotionLibConfig.ini. Also, the function can be called to specify the ini file path. The default path is `C:\NEXCOM\`.
+ * During the starting, the system will load the configurations in accordance with the file, NexMotionLibConfig.ini. Also, the function can be called to specify the ini file path. The default path is `C:\NEXCOM\`.
+ *
+ * \b Reference: <br>
+ * NMC_DeviceOpenUp() and NMC_DeviceOpenUpRequest()
+ */
+RTN_ERR FNTYPE NMC_SetIniPath( _opt_null_ const char *PIniPath );
+/*!
+ *  @}
+ */
+
+// I/O access APIs
+/*! \addtogroup IO_Control_Functions
+ *  I/O Control Functions
+ *  @{
+ */
+/*!
+ * @brief Get the size of mapped input(Input) memory.
+ *
+ * @param DevID         Device ID (DevID)
+ * @param PRetSizeByte  The size of I/O output memory will be returned after the function is called successfully. Unit: byte.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * NMC_GetInputMemorySize() is used to read the accessible range of the I/O memory in the controller (0 to the return size, in bytes). Different controllers (different models) may have different I/O memory sizes that can be controlled,
+ * so this API can be used to confirm the actual reachable range.
+ *
+ * The function can be called after the device is started.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * @endcode
+ *
+ * \b Reference: <br>
+ *
+ */
+RTN_ERR FNTYPE NMC_GetInputMemorySize ( I32_T DevID, U32_T *PRetSizeByte );
+/*!
+ * @brief Get the size of mapped output (Output) memory.
+ *
+ * @param DevID         Device ID (DevID)
+ * @param PRetSizeByte  The size of I/O output memory will be returned after the function is called successfully. Unit: byte.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * NMC_GetOutputMemorySize () is used to read the accessible range of the I/O memory in the controller (0 to the return size, in bytes). Different controllers (different models) may have different I/O memory sizes that can be controlled,
+ * so this API can be used to confirm the actual reachable range.
+ *
+ * The function can be called after the device is started.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * @endcode
+ *
+ * \b Reference: <br>
+ *
+ */
+RTN_ERR FNTYPE NMC_GetOutputMemorySize( I32_T DevID, U32_T *PRetSizeByte );
+/*!
+ * @brief Read the mapped input (Input) memory.
+ *
+ * @param DevID       Device ID (DEVID)
+ * @param OffsetByte  Memory offset (byte) from 0.
+ * @param SizeByte    Size of the memory to be read.
+ * @param PRetValue   The contents within the specified memory segment will be saved into the variable after the function is called successfully.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * Please refer to the [I/O Control](@ref IO_Control) chapter for information on how to map I/O to the controller's internal I/O memory.
+ * This function can be called after the controller is started.
+ * Suppose an I/O device sets its DI-0 to DI-15 to the first Byte and the second Byte of the I/O Input memory.
+ * I want to read the value of the fourth DI input (DI-3). Please refer to the following example
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * RTN_ERR ret;
+ * U32_T offsetByte = 0;
+ * U32_T sizeByte = 2;
+ * U16_T diValue = 0;
+ * U16_T di_03;
+ *
+ * ret = NMC_ReadInputMemory( devId, offsetByte, sizeByte, &diValue );
+ * di_03 = ( diValue >> 3 ) & 1;
+ * @endcode
+ *
+ * \b Reference: <br>
+ */
+RTN_ERR FNTYPE NMC_ReadInputMemory( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, void *PRetValue );
+/*!
+ * @brief Read the mapped output (Output) memory
+ *
+ * @param DevID       Device ID (DevID)
+ * @param OffsetByte  Memory offset (byte) from 0.
+ * @param SizeByte    Size of the memory to be read.
+ * @param PRetValue   The contents within the specified memory segment will be saved into the variable after the function is called successfully.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * Please refer to the [I/O Control](@ref IO_Control) chapter for information on how to map I/O to the controller's internal I/O memory.
+ * This function can be called after the controller is started.
+ * Suppose an I/O device sets its DO-0 to DO-15 to the first Byte and the second Byte of the I/O output memory.
+ * I want to read the value of the fourth DO output (DO-3). Please refer to the following example:
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * RTN_ERR ret;
+ * U32_T offsetByte = 0;
+ * U32_T sizeByte = 2;
+ * U16_T doValue = 0;
+ * U16_T do_03;
+ * ret = NMC_ReadOutputMemory( devId, offsetByte, sizeByte, &doValue );
+ * do_03 = ( doValue >> 3 ) & 1;
+ * @endcode
+ *
+ * \b Reference: <br>
+ */
+RTN_ERR FNTYPE NMC_ReadOutputMemory( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, void *PRetValue );
+/*!
+ * @brief Write the mapped output (Output) memory.
+ *
+ * @param DevID       Device ID (DevID)
+ * @param OffsetByte  Memory offset (byte) from 0.
+ * @param SizeByte    Size of the memory to be read.
+ * @param PValue      set the value into output memory
+ *
+ * @todo Update the description of PValue
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * Please refer to the [I/O Control](@ref IO_Control) chapter for information on how to map I/O to the controller's internal I/O memory.
+ * This function can be called after the controller is started.
+ * Suppose an I/O device has its DO-0 to DO-15 set to the first Byte and the second Byte of the I/O output memory.
+ * I want to set the value of the fourth output point (DO 3). Refer to the following example:
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * RTN_ERR ret;
+ * U32_T offsetByte = 0;
+ * U32_T sizeByte = 2;
+ * U16_T doValue = 0;
+ * U16_T do_03;
+ * NMC_ReadOutputMemory( devId, offsetByte, sizeByte, &doValue );
+ * doValue = doValue | ( ( 1 << 3 ) ); // Set bit 3 ON
+ * //doValue = doValue & (~( 1 << 3 ) ); // Set bit 3 OFF
+ * NMC_WriteOutputMemory( devId, offsetByte, sizeByte, &doValue );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_WriteOutputMasked()
+ */
+RTN_ERR FNTYPE NMC_WriteOutputMemory( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, const void *PValue );
+/*!
+ * @brief Write selected bits of the mapped output (Output) memory, leaving the others unchanged.
+ *
+ * @param DevID       Device ID (DevID)
+ * @param OffsetByte  Memory offset (byte) from 0.
+ * @param SizeByte    Size of the memory to be written, and of the PValue and PMask arrays.
+ * @param PValue      The values of the bits to write
+ * @param PMask       The bits to write: the bits set in PMask are set to their value in PValue, the other ones are not modified.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. The function replaces a read-modify-write with NMC_ReadOutputMemory() and NMC_WriteOutputMemory(), which would overwrite the bits
+ *    written by another thread in between.
+ * 2. The output write functions do not take any lock. The writes are merged into set and clear masks, and the motion cycle applies all
+ *    the writes since the last exchange at the start of the next one: the bits of one call always go out in the same exchange, and the
+ *    last write of a bit wins. The read functions of the output memory return the written values at once.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * // DO-3 ON and DO-12 OFF in one write, DO-0 ~ DO-2, DO-4 ~ DO-11 and DO-13 ~ DO-15 unchanged
+ * U16_T value = ( 1 << 3 );
+ * U16_T mask  = ( 1 << 3 ) | ( 1 << 12 );
+ * NMC_WriteOutputMasked( devId, 0, 2, &value, &mask );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_WriteOutputMemory(), NMC_WriteOutputBit()
+ */
+RTN_ERR FNTYPE NMC_WriteOutputMasked( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, const void *PValue, const void *PMask );
+/*!
+ * @brief Get pointers to the input and output memory, for direct access without any function call.
+ *
+ * @param DevID           Device ID (DevID)
+ * @param[out] PRetImage  Return the pointers and sizes, see NmcIoImage_T. sizeOfStruct must be set before the call.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. pInput and pOutput address the same memory as NMC_ReadInputMemory() and NMC_WriteOutputMemory(), with plain loads and stores.
+ *    The function can be called once the configuration is loaded; the pointers stay valid until NMC_DeviceResetConfig(),
+ *    NMC_DeviceShutdown(), or NMC_DeviceLoadIniConfig() with other I/O memory sizes.
+ * 2. The motion cycle copies the inputs in and the outputs out at each exchange. To read several bytes of the same exchange, read
+ *    *pSequence with acquire ordering before, and again after the loads; retry if it was odd or changed.
+ * 3. A store to pOutput is sent by the next exchange. A multi-byte value stored while an exchange runs (odd *pSequence) may be sent
+ *    in two parts; the complete value goes with the following exchange.
+ * 4. The output writes of the functions (NMC_WriteOutputMemory(), NMC_WriteOutputMasked(), ...) are applied to pOutput at the start
+ *    of the next exchange, over the stores made to the same bits in between. They are applied byte by byte (read, modify, write), so a
+ *    store made to another bit of a byte the functions write may be lost if it lands while the exchange applies that byte; bytes the
+ *    functions do not write are left untouched.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcIoImage_T io;
+ * U32_T        seq;
+ * U16_T        di;
+ * io.sizeOfStruct = sizeof( io );
+ * NMC_DeviceGetIoImage( devId, &io );
+ *
+ * do
+ * {
+ *   seq = __atomic_load_n( io.pSequence, __ATOMIC_ACQUIRE );
+ *   di  = *(const volatile U16_T *)( io.pInput + 0 );
+ *   __atomic_thread_fence( __ATOMIC_ACQUIRE );
+ * } while( ( seq & 1 ) || seq != *io.pSequence );
+ *
+ * if( ( di >> 3 ) & 1 )
+ *   io.pOutput[2] |= 0x01; // DO-16 ON
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_ReadInputMemory(), NMC_WriteOutputMemory()
+ */
+RTN_ERR FNTYPE NMC_DeviceGetIoImage( I32_T DevID, NmcIoImage_T *PRetImage );
+/*!
+ * @brief Subscribe to the changes of input bits, detected at each exchange of the input memory.
+ *
+ * @param DevID           Device ID (DevID)
+ * @param OffsetByte      Memory offset (byte) of the input byte from 0.
+ * @param BitMask         The bits of the byte to watch, not 0.
+ * @param Edge            The changes to record: NMC_INPUT_EDGE_RISING, NMC_INPUT_EDGE_FALLING or NMC_INPUT_EDGE_BOTH.
+ * @param[out] PRetSubID  Return the subscription ID, found in the records of NMC_DevicePopInputEdges().
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. The motion cycle compares the inputs of each exchange with those of the previous one, so every edge is recorded once,
+ *    even if the input kept its value for a single exchange. Set system parameter 0x14 to 1 to exchange every motion cycle.
+ * 2. A byte may have several subscriptions, each one produces its own record. Up to NMC_MAX_INPUT_EDGE_SUBS subscriptions
+ *    are kept per device; they are dropped by NMC_DeviceResetConfig() and when the input memory size changes.
+ * 3. Up to NMC_MAX_INPUT_EDGES records are kept until NMC_DevicePopInputEdges(). Beyond, the new records are dropped and counted
+ *    by the read only system parameter 0x23. The records and the count are cleared when the device is started.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * I32_T estopId, doorId;
+ * NMC_DeviceSubscribeInputEdge( devId, 0, 0x01, NMC_INPUT_EDGE_FALLING, &estopId ); // DI-0
+ * NMC_DeviceSubscribeInputEdge( devId, 1, 0x0C, NMC_INPUT_EDGE_BOTH, &doorId );     // DI-10, DI-11
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceUnsubscribeInputEdge(), NMC_DevicePopInputEdges()
+ */
+RTN_ERR FNTYPE NMC_DeviceSubscribeInputEdge( I32_T DevID, U32_T OffsetByte, U8_T BitMask, I32_T Edge, I32_T *PRetSubID );
+/*!
+ * @brief Remove a subscription of NMC_DeviceSubscribeInputEdge().
+ *
+ * @param DevID  Device ID (DevID)
+ * @param SubID  The subscription ID.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * The records of the subscription which are already queued remain until NMC_DevicePopInputEdges().
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NMC_DeviceUnsubscribeInputEdge( devId, doorId );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceSubscribeInputEdge()
+ */
+RTN_ERR FNTYPE NMC_DeviceUnsubscribeInputEdge( I32_T DevID, I32_T SubID );
+/*!
+ * @brief Move the pending input edge records of the device to an array, oldest first.
+ *
+ * @param DevID           Device ID (DevID)
+ * @param MaxCount        The size of the PRetEdges array
+ * @param[out] PRetEdges  Return the input edge records
+ * @param[out] PRetCount  Return the number of records returned, 0 if none is pending
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * The records are passed from the motion cycle through a lock free queue, the function does not wait for the motion cycle.
+ * Call it until *PRetCount is less than MaxCount.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcInputEdge_T edges[64];
+ * I32_T          count = 0;
+ * do
+ * {
+ *   NMC_DevicePopInputEdges( devId, 64, edges, &count );
+ *   for( I32_T i = 0; i < count; ++i )
+ *   {
+ *     if( edges[i].subscriptionId == estopId )
+ *       printf( "E-stop in cycle %llu\n", (unsigned long long)edges[i].cycleCount );
+ *   }
+ * } while( count == 64 );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceSubscribeInputEdge()
+ */
+RTN_ERR FNTYPE NMC_DevicePopInputEdges( I32_T DevID, I32_T MaxCount, NmcInputEdge_T *PRetEdges, I32_T *PRetCount );
+/*!
+ * @brief Start recording ranges of the I/O memory at each exchange to a file.
+ *
+ * @param DevID           Device ID (DevID)
+ * @param Count           The number of ranges, 1 ~ NMC_MAX_IO_CAPTURE_RANGES.
+ * @param PRanges         The ranges to capture, NMC_MAX_IO_CAPTURE_BYTES bytes at most in total.
+ * @param PFilePath       The capture file, created or truncated.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. At each exchange, the motion cycle copies the ranges of the inputs it received and of the outputs it sent to a preallocated
+ *    ring; a thread of the library appends them to the file as the bytes which changed since the previous record, with the
+ *    number of the motion cycle. An exchange which changed none of the bytes is not recorded, so a pulse of a single exchange
+ *    is recorded while a static input costs nothing. Set system parameter 0x14 to 1 to exchange every motion cycle.
+ * 2. The capture runs until NMC_DeviceStopIoCapture(), also while the device is stopped and started again. It is stopped by
+ *    NMC_DeviceResetConfig() and by loading a configuration. One capture runs per device, a second one returns ERR_NEXMOTION_OPERATION_BUSY.
+ * 3. If the file writes cannot keep up, the records which find the ring full are dropped and counted in the file and by
+ *    NMC_DeviceGetIoCaptureStatus(). The next record still holds the captured bytes, only the changes in between are missing.
+ * 4. The tool nmc_io_capture decodes the file; the format is described in the user manual.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcIoCaptureRange_T ranges[2] = { { NMC_MEM_ENTRY_AREA_INPUT,  0, 4 },   // DI-0 ~ DI-31
+ *                                   { NMC_MEM_ENTRY_AREA_OUTPUT, 0, 2 } }; // DO-0 ~ DO-15
+ * NMC_DeviceStartIoCapture( devId, 2, ranges, "/var/log/press_fit.nmccap" );
+ * ...
+ * NMC_DeviceStopIoCapture( devId );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceStopIoCapture(), NMC_DeviceGetIoCaptureStatus(), NMC_DeviceSubscribeInputEdge()
+ */
+RTN_ERR FNTYPE NMC_DeviceStartIoCapture( I32_T DevID, I32_T Count, const NmcIoCaptureRange_T *PRanges, const char *PFilePath );
+/*!
+ * @brief Stop the I/O capture of the device and close its file.
+ *
+ * @param DevID           Device ID (DevID)
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * The function returns once the records of the ring are written. It does nothing if no capture runs.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NMC_DeviceStopIoCapture( devId );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_DeviceStartIoCapture()
+ */
+RTN_ERR FNTYPE NMC_DeviceStopIoCapture( I32_T DevID );
+/*!
+ * @brief Get the state of the I/O capture of the device.
+ *
+ * @param DevID           Device ID (DevID)
+ * @param[out] PRetStatus Return the state of the running capture, or of the last one.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * The counters are read without waiting for the motion cycle.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcIoCaptureStatus_T status;
+ * NMC_DeviceGetIoCaptureStatus( devId, &status );
+ * if( status.lostCount > 0 || status.error != ERR_NEXMOTION_SUCCESS )
+ *   printf( "capture incomplete\n" );
+ * @endcode
  *
  * \b Reference: <br>
- * NMC_DeviceOpenUp() and NMC_DeviceOpenUpRequest()
- */
-RTN_ERR FNTYPE NMC_SetIniPath( _opt_null_ const char *PIniPath );
-/*!
- *  @}
- */
-
-// I/O access APIs
-/*! \addtogroup IO_Control_Functions
- *  I/O Control Functions
- *  @{
+ * NMC_DeviceStartIoCapture()
  */
+RTN_ERR FNTYPE NMC_DeviceGetIoCaptureStatus( I32_T DevID, NmcIoCaptureStatus_T *PRetStatus );
 /*!
- * @brief Get the size of mapped input(Input) memory.
+ * @brief Get the number of named entries of an I/O memory area.
  *
- * @param DevID         Device ID (DevID)
- * @param PRetSizeByte  The size of I/O output memory will be returned after the function is called successfully. Unit: byte.
+ * @param DevID           Device ID (DevID)
+ * @param Area            NMC_MEM_ENTRY_AREA_INPUT or NMC_MEM_ENTRY_AREA_OUTPUT
+ * @param[out] PRetCount  Return the number of entries
  *
  * @return Return an [error code](@ref Error_code). <br>
  * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
  *
  * \b Usage: <br>
- * NMC_GetInputMemorySize() is used to read the accessible range of the I/O memory in the controller (0 to the return size, in bytes). Different controllers (different models) may have different I/O memory sizes that can be controlled,
- * so this API can be used to confirm the actual reachable range.
- *
- * The function can be called after the device is started.
+ * The entries are defined by the sections [InputMap] and [OutputMap] of the configuration file, see the user manual.
  *
  * \b Examples: <br>
  * @code{.h}
+ * I32_T count = 0;
+ * NMC_MemEntryGetCount( devId, NMC_MEM_ENTRY_AREA_INPUT, &count );
  * @endcode
  *
  * \b Reference: <br>
- *
+ * NMC_MemEntryGetInfo(), NMC_MemEntryFind()
  */
-RTN_ERR FNTYPE NMC_GetInputMemorySize ( I32_T DevID, U32_T *PRetSizeByte );
+RTN_ERR FNTYPE NMC_MemEntryGetCount( I32_T DevID, I32_T Area, I32_T *PRetCount );
 /*!
- * @brief Get the size of mapped output (Output) memory.
+ * @brief Get a named entry of an I/O memory area by index.
  *
- * @param DevID         Device ID (DevID)
- * @param PRetSizeByte  The size of I/O output memory will be returned after the function is called successfully. Unit: byte.
+ * @param DevID          Device ID (DevID)
+ * @param Area           NMC_MEM_ENTRY_AREA_INPUT or NMC_MEM_ENTRY_AREA_OUTPUT
+ * @param Index          Index of the entry from 0, in the order of the configuration file.
+ * @param[out] PRetInfo  Return the entry
  *
  * @return Return an [error code](@ref Error_code). <br>
  * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
  *
  * \b Usage: <br>
- * NMC_GetOutputMemorySize () is used to read the accessible range of the I/O memory in the controller (0 to the return size, in bytes). Different controllers (different models) may have different I/O memory sizes that can be controlled,
- * so this API can be used to confirm the actual reachable range.
- *
- * The function can be called after the device is started.
+ * None.
  *
  * \b Examples: <br>
  * @code{.h}
+ * MemEntryInfo_T info;
+ * for( I32_T i = 0; i < count; ++i )
+ * {
+ *   NMC_MemEntryGetInfo( devId, NMC_MEM_ENTRY_AREA_INPUT, i, &info );
+ *   printf( "%s at bit %u\n", info.name, info.bitStartOffset );
+ * }
  * @endcode
  *
  * \b Reference: <br>
- *
+ * NMC_MemEntryGetCount()
  */
-RTN_ERR FNTYPE NMC_GetOutputMemorySize( I32_T DevID, U32_T *PRetSizeByte );
+RTN_ERR FNTYPE NMC_MemEntryGetInfo( I32_T DevID, I32_T Area, I32_T Index, MemEntryInfo_T *PRetInfo );
 /*!
- * @brief Read the mapped input (Input) memory.
+ * @brief Look a named entry of an I/O memory area up, and get the handle to access it.
  *
- * @param DevID       Device ID (DEVID)
- * @param OffsetByte  Memory offset (byte) from 0.
- * @param SizeByte    Size of the memory to be read.
- * @param PRetValue   The contents within the specified memory segment will be saved into the variable after the function is called successfully.
+ * @param DevID            Device ID (DevID)
+ * @param Area             NMC_MEM_ENTRY_AREA_INPUT or NMC_MEM_ENTRY_AREA_OUTPUT
+ * @param PName            Name of the entry, case sensitive.
+ * @param[out] PRetHandle  Return the handle of the entry, for NMC_MemEntryRead() and NMC_MemEntryWrite().
+ * @param[out] PRetInfo    Return the entry, may be NULL.
  *
  * @return Return an [error code](@ref Error_code). <br>
  * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
  *
  * \b Usage: <br>
- * Please refer to the [I/O Control](@ref IO_Control) chapter for information on how to map I/O to the controller's internal I/O memory.
- * This function can be called after the controller is started.
- * Suppose an I/O device sets its DI-0 to DI-15 to the first Byte and the second Byte of the I/O Input memory.
- * I want to read the value of the fourth DI input (DI-3). Please refer to the following example
+ * 1. The names are indexed by a hash table, the lookup does not depend on the number of entries.
+ * 2. Look the names up once, then access the entries by handle: the handle is resolved without any string operation.
+ * 3. A handle remains valid until the configuration is loaded again or reset. Then the functions return ERR_NEXMOTION_OBJECT_ID_INVALID
+ *    and the names must be looked up again.
  *
  * \b Examples: <br>
  * @code{.h}
- * RTN_ERR ret;
- * U32_T offsetByte = 0;
- * U32_T sizeByte = 2;
- * U16_T diValue = 0;
- * U16_T di_03;
- *
- * ret = NMC_ReadInputMemory( devId, offsetByte, sizeByte, &diValue );
- * di_03 = ( diValue >> 3 ) & 1;
+ * I32_T doorClosed, spindleSpeed;
+ * NMC_MemEntryFind( devId, NMC_MEM_ENTRY_AREA_INPUT, "DoorClosed", &doorClosed, NULL );
+ * NMC_MemEntryFind( devId, NMC_MEM_ENTRY_AREA_OUTPUT, "SpindleSpeed", &spindleSpeed, NULL );
  * @endcode
  *
  * \b Reference: <br>
+ * NMC_MemEntryRead(), NMC_MemEntryWrite()
  */
-RTN_ERR FNTYPE NMC_ReadInputMemory( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, void *PRetValue );
+RTN_ERR FNTYPE NMC_MemEntryFind( I32_T DevID, I32_T Area, const char *PName, I32_T *PRetHandle, _opt_null_ MemEntryInfo_T *PRetInfo );
 /*!
- * @brief Read the mapped output (Output) memory
+ * @brief Read a named entry of the input or the output memory.
  *
- * @param DevID       Device ID (DevID)
- * @param OffsetByte  Memory offset (byte) from 0.
- * @param SizeByte    Size of the memory to be read.
- * @param PRetValue   The contents within the specified memory segment will be saved into the variable after the function is called successfully.
+ * @param DevID           Device ID (DevID)
+ * @param Handle          Handle of the entry, from NMC_MemEntryFind().
+ * @param[out] PRetValue  Return the value, of the type of the entry: BOOL_T for NMC_MEM_ENTRY_TYPE_BIT, F64_T for NMC_MEM_ENTRY_TYPE_F64, ...
  *
  * @return Return an [error code](@ref Error_code). <br>
  * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
  *
  * \b Usage: <br>
- * Please refer to the [I/O Control](@ref IO_Control) chapter for information on how to map I/O to the controller's internal I/O memory.
- * This function can be called after the controller is started.
- * Suppose an I/O device sets its DO-0 to DO-15 to the first Byte and the second Byte of the I/O output memory.
- * I want to read the value of the fourth DO output (DO-3). Please refer to the following example:
+ * PRetValue need not be aligned.
  *
  * \b Examples: <br>
  * @code{.h}
- * RTN_ERR ret;
- * U32_T offsetByte = 0;
- * U32_T sizeByte = 2;
- * U16_T doValue = 0;
- * U16_T do_03;
- * ret = NMC_ReadOutputMemory( devId, offsetByte, sizeByte, &doValue );
- * do_03 = ( doValue >> 3 ) & 1;
+ * BOOL_T closed = 0;
+ * NMC_MemEntryRead( devId, doorClosed, &closed );
  * @endcode
  *
  * \b Reference: <br>
+ * NMC_MemEntryFind(), NMC_MemEntryWrite()
  */
-RTN_ERR FNTYPE NMC_ReadOutputMemory( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, void *PRetValue );
+RTN_ERR FNTYPE NMC_MemEntryRead( I32_T DevID, I32_T Handle, void *PRetValue );
 /*!
- * @brief Write the mapped output (Output) memory.
- *
- * @param DevID       Device ID (DevID)
- * @param OffsetByte  Memory offset (byte) from 0.
- * @param SizeByte    Size of the memory to be read.
- * @param PValue      set the value into output memory
+ * @brief Write a named entry of the output memory.
  *
- * @todo Update the description of PValue
+ * @param DevID   Device ID (DevID)
+ * @param Handle  Handle of an entry of the output memory, from NMC_MemEntryFind().
+ * @param PValue  The value, of the type of the entry: BOOL_T for NMC_MEM_ENTRY_TYPE_BIT, F64_T for NMC_MEM_ENTRY_TYPE_F64, ...
  *
  * @return Return an [error code](@ref Error_code). <br>
  * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
  *
  * \b Usage: <br>
- * Please refer to the [I/O Control](@ref IO_Control) chapter for information on how to map I/O to the controller's internal I/O memory.
- * This function can be called after the controller is started.
- * Suppose an I/O device has its DO-0 to DO-15 set to the first Byte and the second Byte of the I/O output memory.
- * I want to set the value of the fourth output point (DO 3). Refer to the following example:
+ * An entry of the input memory cannot be written, the function returns ERR_NEXMOTION_OPERATION_DENIED.
  *
  * \b Examples: <br>
  * @code{.h}
- * RTN_ERR ret;
- * U32_T offsetByte = 0;
- * U32_T sizeByte = 2;
- * U16_T doValue = 0;
- * U16_T do_03;
- * NMC_ReadOutputMemory( devId, offsetByte, sizeByte, &doValue );
- * doValue = doValue | ( ( 1 << 3 ) ); // Set bit 3 ON
- * //doValue = doValue & (~( 1 << 3 ) ); // Set bit 3 OFF
- * NMC_WriteOutputMemory( devId, offsetByte, sizeByte, &doValue );
+ * F32_T rpm = 1200.0f;
+ * NMC_MemEntryWrite( devId, spindleSpeed, &rpm );
  * @endcode
  *
  * \b Reference: <br>
+ * NMC_MemEntryFind(), NMC_MemEntryRead()
  */
-RTN_ERR FNTYPE NMC_WriteOutputMemory( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, const void *PValue );
+RTN_ERR FNTYPE NMC_MemEntryWrite( I32_T DevID, I32_T Handle, const void *PValue );
 /*!
- * @brief Read the mapped input memory by bit, word or dword.
+ * @brief Read the mapped input memory by bit, or as an integer or floating point value of 1, 2, 4 or 8 bytes.
  *
  * @param DevID         Device ID (DevID)
  * @param OffsetByte    Memory offset (byte) from 0
@@ -626,8 +1344,15 @@ RTN_ERR FNTYPE NMC_ReadInputBit( I32_T DevID, U32_T OffsetByte, U32_T BitIndex,
 RTN_ERR FNTYPE NMC_ReadInputI8( I32_T DevID, U32_T OffsetByte, I8_T *PRetI8Value );
 RTN_ERR FNTYPE NMC_ReadInputI16( I32_T DevID, U32_T OffsetByte, I16_T *PRetI16Value );
 RTN_ERR FNTYPE NMC_ReadInputI32( I32_T DevID, U32_T OffsetByte, I32_T *PRetI32Value );
+RTN_ERR FNTYPE NMC_ReadInputU8( I32_T DevID, U32_T OffsetByte, U8_T *PRetU8Value );
+RTN_ERR FNTYPE NMC_ReadInputU16( I32_T DevID, U32_T OffsetByte, U16_T *PRetU16Value );
+RTN_ERR FNTYPE NMC_ReadInputU32( I32_T DevID, U32_T OffsetByte, U32_T *PRetU32Value );
+RTN_ERR FNTYPE NMC_ReadInputI64( I32_T DevID, U32_T OffsetByte, I64_T *PRetI64Value );
+RTN_ERR FNTYPE NMC_ReadInputU64( I32_T DevID, U32_T OffsetByte, U64_T *PRetU64Value );
+RTN_ERR FNTYPE NMC_ReadInputF32( I32_T DevID, U32_T OffsetByte, F32_T *PRetF32Value );
+RTN_ERR FNTYPE NMC_ReadInputF64( I32_T DevID, U32_T OffsetByte, F64_T *PRetF64Value );
 /*!
- * @brief Read the mapped output memory by bit, word or dword.
+ * @brief Read the mapped output memory by bit, or as an integer or floating point value of 1, 2, 4 or 8 bytes.
  *
  * @param DevID         Device ID (DevID)
  * @param OffsetByte    Memory offset (byte) from 0
@@ -650,8 +1375,15 @@ RTN_ERR FNTYPE NMC_ReadOutputBit( I32_T DevID, U32_T OffsetByte, U32_T BitIndex,
 RTN_ERR FNTYPE NMC_ReadOutputI8( I32_T DevID, U32_T OffsetByte, I8_T *PRetI8Value );
 RTN_ERR FNTYPE NMC_ReadOutputI16( I32_T DevID, U32_T OffsetByte, I16_T *PRetI16Value );
 RTN_ERR FNTYPE NMC_ReadOutputI32( I32_T DevID, U32_T OffsetByte, I32_T *PRetI32Value );
+RTN_ERR FNTYPE NMC_ReadOutputU8( I32_T DevID, U32_T OffsetByte, U8_T *PRetU8Value );
+RTN_ERR FNTYPE NMC_ReadOutputU16( I32_T DevID, U32_T OffsetByte, U16_T *PRetU16Value );
+RTN_ERR FNTYPE NMC_ReadOutputU32( I32_T DevID, U32_T OffsetByte, U32_T *PRetU32Value );
+RTN_ERR FNTYPE NMC_ReadOutputI64( I32_T DevID, U32_T OffsetByte, I64_T *PRetI64Value );
+RTN_ERR FNTYPE NMC_ReadOutputU64( I32_T DevID, U32_T OffsetByte, U64_T *PRetU64Value );
+RTN_ERR FNTYPE NMC_ReadOutputF32( I32_T DevID, U32_T OffsetByte, F32_T *PRetF32Value );
+RTN_ERR FNTYPE NMC_ReadOutputF64( I32_T DevID, U32_T OffsetByte, F64_T *PRetF64Value );
 /*!
- * @brief Write the mapped output memory by bit, word or dword.
+ * @brief Write the mapped output memory by bit, or as an integer or floating point value of 1, 2, 4 or 8 bytes.
  *
  * @param DevID       Device ID (DevID)
  * @param OffsetByte  Memory offset (byte) from 0
@@ -674,6 +1406,100 @@ RTN_ERR FNTYPE NMC_WriteOutputBit( I32_T DevID, U32_T OffsetByte, U32_T BitIndex
 RTN_ERR FNTYPE NMC_WriteOutputI8( I32_T DevID, U32_T OffsetByte, I8_T I8Value );
 RTN_ERR FNTYPE NMC_WriteOutputI16( I32_T DevID, U32_T OffsetByte, I16_T I16Value );
 RTN_ERR FNTYPE NMC_WriteOutputI32( I32_T DevID, U32_T OffsetByte, I32_T I32Value );
+RTN_ERR FNTYPE NMC_WriteOutputU8( I32_T DevID, U32_T OffsetByte, U8_T U8Value );
+RTN_ERR FNTYPE NMC_WriteOutputU16( I32_T DevID, U32_T OffsetByte, U16_T U16Value );
+RTN_ERR FNTYPE NMC_WriteOutputU32( I32_T DevID, U32_T OffsetByte, U32_T U32Value );
+RTN_ERR FNTYPE NMC_WriteOutputI64( I32_T DevID, U32_T OffsetByte, I64_T I64Value );
+RTN_ERR FNTYPE NMC_WriteOutputU64( I32_T DevID, U32_T OffsetByte, U64_T U64Value );
+RTN_ERR FNTYPE NMC_WriteOutputF32( I32_T DevID, U32_T OffsetByte, F32_T F32Value );
+RTN_ERR FNTYPE NMC_WriteOutputF64( I32_T DevID, U32_T OffsetByte, F64_T F64Value );
+/*!
+ * @brief Read typed fields of the input memory in one call.
+ *
+ * @param DevID            Device ID (DevID)
+ * @param Count            Number of fields
+ * @param PItems           The offset and type of each field, an array of Count items.
+ * @param[out] PRetValues  Return the value of each field in the member of its type, an array of Count values.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. All the fields are read from the same exchange, under a single lock of the device. No field is read if any item is invalid.
+ * 2. Consecutive items of the same type at consecutive offsets, e.g. the channels of an analog module, are copied as one block:
+ *    list the fields in the order of the memory where possible.
+ * 3. Fields need not be aligned. Multi-byte fields are little endian.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcIoItem_T  items[5] = { { 0, NMC_MEM_ENTRY_TYPE_I16 }, { 2, NMC_MEM_ENTRY_TYPE_I16 }, { 4, NMC_MEM_ENTRY_TYPE_I16 }, // AI-0 ~ AI-2
+ *                           { 16, NMC_MEM_ENTRY_TYPE_I64 },                                                           // Encoder
+ *                           { 24, NMC_MEM_ENTRY_TYPE_BIT, 3 } };                                                      // DI-195
+ * NmcIoValue_T values[5];
+ * NMC_ReadInputGather( devId, 5, items, values );
+ * printf( "AI-0 %d encoder %lld DI %d\n", values[0].i16, values[3].i64, values[4].bitValue );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_ReadOutputGather(), NMC_WriteOutputScatter()
+ */
+RTN_ERR FNTYPE NMC_ReadInputGather( I32_T DevID, I32_T Count, const NmcIoItem_T *PItems, NmcIoValue_T *PRetValues );
+/*!
+ * @brief Read typed fields of the output memory in one call.
+ *
+ * @param DevID            Device ID (DevID)
+ * @param Count            Number of fields
+ * @param PItems           The offset and type of each field, an array of Count items.
+ * @param[out] PRetValues  Return the value of each field in the member of its type, an array of Count values.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * As NMC_ReadInputGather(). The values include the writes not sent yet.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcIoItem_T  items[2] = { { 8, NMC_MEM_ENTRY_TYPE_F32 }, { 12, NMC_MEM_ENTRY_TYPE_F32 } };
+ * NmcIoValue_T values[2];
+ * NMC_ReadOutputGather( devId, 2, items, values );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_ReadInputGather(), NMC_WriteOutputScatter()
+ */
+RTN_ERR FNTYPE NMC_ReadOutputGather( I32_T DevID, I32_T Count, const NmcIoItem_T *PItems, NmcIoValue_T *PRetValues );
+/*!
+ * @brief Write typed fields of the output memory in one call.
+ *
+ * @param DevID    Device ID (DevID)
+ * @param Count    Number of fields
+ * @param PItems   The offset and type of each field, an array of Count items.
+ * @param PValues  The value of each field in the member of its type, an array of Count values.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. As the other output write functions, the function takes no lock and all the fields go out in the same exchange.
+ *    No field is written if any item is invalid.
+ * 2. The other bits of the bytes of NMC_MEM_ENTRY_TYPE_BIT items are not modified.
+ * 3. Consecutive items of the same type at consecutive offsets are written as one block, see NMC_ReadInputGather().
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * NmcIoItem_T  items[3] = { { 8, NMC_MEM_ENTRY_TYPE_F32 }, { 12, NMC_MEM_ENTRY_TYPE_F32 }, { 0, NMC_MEM_ENTRY_TYPE_BIT, 5 } };
+ * NmcIoValue_T values[3];
+ * values[0].f32 = 1.5f;
+ * values[1].f32 = -0.25f;
+ * values[2].bitValue = 1;
+ * NMC_WriteOutputScatter( devId, 3, items, values );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_ReadOutputGather()
+ */
+RTN_ERR FNTYPE NMC_WriteOutputScatter( I32_T DevID, I32_T Count, const NmcIoItem_T *PItems, const NmcIoValue_T *PValues );
 /*!
  *  @}
  */
@@ -1050,6 +1876,37 @@ RTN_ERR FNTYPE NMC_AxisDisable( I32_T DevID, I32_T AxisIndex );
  * NMC_AxisGetState()
  */
 RTN_ERR FNTYPE NMC_AxisGetStatus( I32_T DevID, I32_T AxisIndex, I32_T *PRetAxisStatus );
+/*!
+ * @brief Wait until the status bits of the axis selected by StatusMask are equal to StatusValue.
+ *
+ * @param DevID           Device ID (DevID)
+ * @param AxisIndex       Axis Index
+ * @param StatusMask      The status bits to test (NMC_AXIS_STATUS_MASK_*)
+ * @param StatusValue     The value of the selected bits to wait for. Bits outside StatusMask are ignored.
+ * @param WaitMs          Waiting time (unit: ms). It can be set to the NMC_WAIT_TIME_INFINITE (0xFFFFFFFF) to wait without time limit,
+ *                        or to 0 to test the condition once.
+ * @param PRetAxisStatus  Return the last axis status tested. Can be set to 0.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the condition is met, the return value is ERR_NEXMOTION_SUCCESS (0). If the waiting time expires first, the return value is
+ * ERR_NEXMOTION_PROCESS_TIMEOUT. If the device leaves the operation state, the return value is ERR_NEXMOTION_SYSTEM_NOT_READY.
+ *
+ * \b Usage: <br>
+ * 1. The calling thread sleeps and is woken by the motion cycle which publishes a status meeting the condition, instead of polling NMC_AxisGetStatus().
+ * 2. Other threads can call any function of the device during the wait.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * RTN_ERR ret = 0;
+ * ret = NMC_AxisPtp( 0, 0, 100, 0 );
+ * // Wait for the target position to be reached
+ * ret = NMC_AxisWaitStatus( 0, 0, NMC_AXIS_STATUS_MASK_TAR, NMC_AXIS_STATUS_MASK_TAR, NMC_WAIT_TIME_INFINITE, 0 );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_AxisGetStatus()
+ */
+RTN_ERR FNTYPE NMC_AxisWaitStatus( I32_T DevID, I32_T AxisIndex, I32_T StatusMask, I32_T StatusValue, U32_T WaitMs, _opt_null_ I32_T *PRetAxisStatus );
 /*!
  * @brief Get the state of the axis
  *
@@ -1309,11 +2166,12 @@ RTN_ERR FNTYPE NMC_AxisGetMotionBuffSpace(  I32_T DevID, I32_T AxisIndex, I32_T
  * 5. The function can be called to enable the point-to-point motion. After the motion completely, the axis will move to the input target position. If the axis parameter 0x30 (Absolute or relative programming) is set to 1, the target position and the relative distance from the current position shall be input in the function. If the relative distance is set to 0, the target position will be set as an absolute position.
  * 6. If the axis is excuting the point-to-point motion, the [axis state](@ref NMC_AxisGetState) will transfer to AXIS_STATE_DISCRETE_MOTION. After the axis moves to the target position and there is no successive motion, the bit 9 of axis status will become to 1, and the axis will transfer to the normal excitation (AXIS_STATE_STAND_STILL).
  * 7. The drive will plan the velocity curve depended on the axis parameters, AXP_PROF_TYPE, AXP_ACC, AXP_DEC and AXP_JERK.
- * 8. The maximum velocity can be input with the pointer variable, PMaxVel. Then the corresponding axis parameter AXP_VM will be modified to the input value, and the velocity plan will be performed accordingly.
- * 9. If the pointer variable, PMaxVel, is set to 0, the drive will perform the velocity plan based on the axis parameter AXP_VM as the target velocity.
- * 10. If the [axis state](@ref NMC_AxisGetState) is AXIS_STATE_STAND_STILL, the function will enable the point-to-point motion immediately after called whether the content of axis parameter AXP_BUFF_PARAM.
- * 11. After the function is called and if the [axis state](@ref NMC_AxisGetState) is AXIS_STATE_WAIT_SYNC and the axis parameter AXP_BUFF_PARAM is aborting, the motions stored in the motion queue will be removed. Then the point-to-point motion will be stored into the motion queue and wait for trigger signal.
- * 12. If the axis has not reach the target position during the point-to-point motion, NMC_AxisHalt() can be called to stop the motion.
+ * 8. If AXP_PROF_TYPE is NMC_PROF_TYPE_SCURVE, the acceleration rises and falls at the rate AXP_JERK. The motion falls back to NMC_PROF_TYPE_TRAPEZOID when the axis is too fast to stop on the target within AXP_DEC and AXP_JERK.
+ * 9. The maximum velocity can be input with the pointer variable, PMaxVel. Then the corresponding axis parameter AXP_VM will be modified to the input value, and the velocity plan will be performed accordingly.
+ * 10. If the pointer variable, PMaxVel, is set to 0, the drive will perform the velocity plan based on the axis parameter AXP_VM as the target velocity.
+ * 11. If the [axis state](@ref NMC_AxisGetState) is AXIS_STATE_STAND_STILL, the function will enable the point-to-point motion immediately after called whether the content of axis parameter AXP_BUFF_PARAM.
+ * 12. After the function is called and if the [axis state](@ref NMC_AxisGetState) is AXIS_STATE_WAIT_SYNC and the axis parameter AXP_BUFF_PARAM is aborting, the motions stored in the motion queue will be removed. Then the point-to-point motion will be stored into the motion queue and wait for trigger signal.
+ * 13. If the axis has not reach the target position during the point-to-point motion, NMC_AxisHalt() can be called to stop the motion.
  *
  * \b Examples: <br>
  * @code{.h}
@@ -1328,6 +2186,38 @@ RTN_ERR FNTYPE NMC_AxisGetMotionBuffSpace(  I32_T DevID, I32_T AxisIndex, I32_T
  * 4. NMC_AxisHalt()
  */
 RTN_ERR FNTYPE NMC_AxisPtp( I32_T DevID, I32_T AxisIndex, F64_T TargetPos, _opt_null_ const F64_T *PMaxVel );
+/*!
+ * @brief Point-to-point motion of several axes, started in the same motion cycle.
+ *
+ * @param DevID       Device ID (DevID)
+ * @param Count       Number of entries, 1 to the number of axes of the device
+ * @param PAxisIndex  Axis index of each entry. An axis may appear once only.
+ * @param PTargetPos  Target position of each entry, as TargetPos of NMC_AxisPtp()
+ * @param PMaxVel     Maximum velocity of each entry, as PMaxVel of NMC_AxisPtp(). Set to 0 to use the axis parameter AXP_VM of every axis.
+ * @param PRetErrors  Return the error code of each entry. Can be set to 0.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ * If an entry is rejected, the return value is the error code of the first rejected entry.
+ *
+ * \b Usage: <br>
+ * 1. Every entry is checked as by NMC_AxisPtp() before any motion is submitted. If an entry is rejected, no motion is submitted;
+ *    PRetErrors holds the error code of each rejected entry and ERR_NEXMOTION_SUCCESS for the others.
+ * 2. The motions of all entries are submitted at once, so the axes which start immediately (see NMC_AxisPtp()) start in the same motion cycle.
+ *    A motion buffered behind a running motion (AXP_BUFF_PARAM) starts when the running motion completes.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * I32_T   axes[3]   = { 0, 1, 2 };
+ * F64_T   target[3] = { 100, 200, 300 };
+ * RTN_ERR errors[3];
+ * RTN_ERR ret = NMC_AxisPtpBatch( 0, 3, axes, target, 0, errors );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_AxisPtp()
+ */
+RTN_ERR FNTYPE NMC_AxisPtpBatch( I32_T DevID, I32_T Count, const I32_T *PAxisIndex, const F64_T *PTargetPos, _opt_null_ const F64_T *PMaxVel, _opt_null_ RTN_ERR *PRetErrors );
 /*!
  * @brief Execute Point-To-Point Motion according with target (or default) velocity.
  *
@@ -1966,6 +2856,63 @@ RTN_ERR FNTYPE NMC_GroupDisable( I32_T DevID, I32_T GroupIndex );
  *
  */
 RTN_ERR FNTYPE NMC_GroupGetStatus( I32_T DevID, I32_T GroupIndex, I32_T *PRetStatusInBit );
+/*!
+ * @brief Wait until the status bits of the group selected by StatusMask are equal to StatusValue.
+ *
+ * @param DevID            Device ID (DevID)
+ * @param GroupIndex       Group index
+ * @param StatusMask       The status bits to test (NMC_GROUP_STATUS_MASK_*)
+ * @param StatusValue      The value of the selected bits to wait for. Bits outside StatusMask are ignored.
+ * @param WaitMs           Waiting time (unit: ms). It can be set to the NMC_WAIT_TIME_INFINITE (0xFFFFFFFF) to wait without time limit,
+ *                         or to 0 to test the condition once.
+ * @param PRetStatusInBit  Return the last group status tested. Can be set to 0.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the condition is met, the return value is ERR_NEXMOTION_SUCCESS (0). If the waiting time expires first, the return value is
+ * ERR_NEXMOTION_PROCESS_TIMEOUT. If the device leaves the operation state, the return value is ERR_NEXMOTION_SYSTEM_NOT_READY.
+ *
+ * \b Usage: <br>
+ * The wait is performed as by NMC_AxisWaitStatus().
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * RTN_ERR ret = 0;
+ * // Wait until the group is no longer in motion, at most 5 seconds
+ * ret = NMC_GroupWaitStatus( 0, 0, NMC_GROUP_STATUS_MASK_OP, 0, 5000, 0 );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_GroupGetStatus(), NMC_GroupWaitMotionDone()
+ */
+RTN_ERR FNTYPE NMC_GroupWaitStatus( I32_T DevID, I32_T GroupIndex, I32_T StatusMask, I32_T StatusValue, U32_T WaitMs, _opt_null_ I32_T *PRetStatusInBit );
+/*!
+ * @brief Wait until every motion of the group, including the buffered motions, is done.
+ *
+ * @param DevID       Device ID (DevID)
+ * @param GroupIndex  Group index
+ * @param WaitMs      Waiting time (unit: ms). It can be set to the NMC_WAIT_TIME_INFINITE (0xFFFFFFFF) to wait without time limit.
+ * @param PRetState   Return the group state at the end of the wait. Can be set to 0.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the motion is done, the return value is ERR_NEXMOTION_SUCCESS (0). If the waiting time expires first, the return value is
+ * ERR_NEXMOTION_PROCESS_TIMEOUT. If the device leaves the operation state, the return value is ERR_NEXMOTION_SYSTEM_NOT_READY.
+ *
+ * \b Usage: <br>
+ * 1. The motion is done once the group state is neither GROUP_MOVING, GROUP_HOMING nor GROUP_STOPPING.
+ * 2. The motion also ends if it is stopped or aborted by an error: check *PRetState for GROUP_STAND_STILL.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * I32_T   state = 0;
+ * RTN_ERR ret = NMC_GroupLine( 0, 0, 7, &targetPos, NULL );
+ * ret = NMC_GroupWaitMotionDone( 0, 0, NMC_WAIT_TIME_INFINITE, &state );
+ * if( ret == 0 && state != NMC_GROUP_STATE_STAND_STILL ) return -1;
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_GroupWaitStatus()
+ */
+RTN_ERR FNTYPE NMC_GroupWaitMotionDone( I32_T DevID, I32_T GroupIndex, U32_T WaitMs, _opt_null_ I32_T *PRetState );
 /*!
  * @brief Get the state of group. Please refer to the below table for details.
  *
@@ -2219,6 +3166,9 @@ RTN_ERR FNTYPE NMC_GroupPtpAcs( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIn
  * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
  *
  * \b Usage: <br>
+ * 1. If the group parameter 0x39 (PTP synchronization) is 0, each axis moves with its own group axis parameters 0x32 ~ 0x34 and the axes with a short distance arrive first.
+ * 2. If the group parameter 0x39 is 1, the motion is planned when the function is called: all axes accelerate and decelerate for the same times, the longest ones of the axes, and the axis needing the longest motion within its limits sets the duration. The other axes are slowed down to it, so all axes start and arrive together and the motion is a straight line in ACS.
+ * 3. The synchronized plan assumes the axes at rest. A group speed ratio below 100% scales the velocities only, so the axes are no longer exactly synchronized.
  *
  * \b Examples: <br>
  * @code{.h}
@@ -2403,6 +3353,8 @@ RTN_ERR FNTYPE NMC_GroupPtpCart( I32_T DevID, I32_T GroupIndex, I32_T CartAxis,
  * The usage of the group axis index mask in the Cartesian coordinate system (CartAxesMask) is described as follows:
  * If the group axes to be moved are the X-, Z- and A-axis, the GroupAxesIdxMask is \f$2^0\f$ + \f$2^2\f$ + \f$2^3\f$ = 13.
  *
+ * The group axes move point-to-point in ACS to the inverse kinematics of the target, synchronized as NMC_GroupPtpAcsAll() if the group parameter 0x39 is 1.
+ *
  * \b Examples: <br>
  * @code{.h}
  * I32_T devID = 0;
@@ -3150,6 +4102,138 @@ RTN_ERR FNTYPE NMC_GroupCircC( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask
  */
 RTN_ERR FNTYPE NMC_GroupCircB( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask, const Pos_T *PCartPos, I32_T BorPosMask, const Xyz_T *PBorPoint, _opt_null_ const F64_T *PMaxVel );
 RTN_ERR FNTYPE NMC_GroupCircBEx( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask, const Pos_T *PCartPos, I32_T BorPosMask, const Xyz_T *PBorPoint, _opt_null_ const F64_T *PAngleDeg, _opt_null_ const F64_T *PMaxVel );
+/*!
+ * @brief Enqueue several line interpolation segments with one call, as consecutive calls of NMC_GroupLine().
+ *
+ * @param DevID              Device ID (DevID)
+ * @param GroupIndex         Group index
+ * @param Count              Number of segments
+ * @param[in] PCartAxisMask  CartAxisMask of each segment, as NMC_GroupLine()
+ * @param[in] PCartPos       Target position of each segment
+ * @param[in] PMaxVel        Maximum velocity of each segment. Input NULL (0) to ignore the parameter for every segment.
+ * @param[out] PRetAccepted  Return the number of segments accepted, from the first one on.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If every segment is accepted, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is the error code of the first rejected segment.
+ *
+ * \b Usage: <br>
+ * 1. The segments are enqueued in order and the function stops at the first rejected segment: the segments before it are kept,
+ *    the segments from it on are not enqueued.
+ * 2. If the motion buffer of the group (GRP_BUFF) is full, the return value is ERR_NEXMOTION_OPERATION_BUSY. Call the function again
+ *    from entry *PRetAccepted once the buffer has free space (NMC_GroupGetMotionBuffSpace()).
+ * 3. While the group is moving and new segments are appended to the buffer, the motion cycle is not blocked by the call.
+ * 4. For paths of many short blended segments, set the group parameter 0x36:4 (look-ahead segments) to e.g. 32 ~ 512: the velocity at each
+ *    corner is then planned over that many buffered segments instead of the next one only, within the group axis limits 0x32 ~ 0x34.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * Pos_T path[100];   // Target positions of the path
+ * I32_T mask[100];   // 7: X-, Y- and Z-axis for every segment
+ * I32_T done = 0;
+ * while( done < 100 )
+ * {
+ *     I32_T accepted = 0;
+ *     RTN_ERR ret = NMC_GroupLineBatch( 0, 0, 100 - done, &mask[done], &path[done], NULL, &accepted );
+ *     done += accepted;
+ *     if( ret == ERR_NEXMOTION_OPERATION_BUSY ) { Sleep( 10 ); continue; }
+ *     if( ret != 0 ) return ret;
+ * }
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_GroupLine(), NMC_GroupCircRBatch()
+ */
+RTN_ERR FNTYPE NMC_GroupLineBatch( I32_T DevID, I32_T GroupIndex, I32_T Count, const I32_T *PCartAxisMask, const Pos_T *PCartPos, _opt_null_ const F64_T *PMaxVel, I32_T *PRetAccepted );
+/*!
+ * @brief Enqueue several circular interpolation segments with one call, as consecutive calls of NMC_GroupCircR(), NMC_GroupCircC()
+ * or NMC_GroupCircBEx() respectively.
+ *
+ * @param DevID              Device ID (DevID)
+ * @param GroupIndex         Group index
+ * @param Count              Number of segments
+ * @param[in] PCartAxisMask  CartAxisMask of each segment
+ * @param[in] PCartPos       Target position of each segment
+ * @param[in] PNormalVector  NMC_GroupCircRBatch(): normal vector of each segment
+ * @param[in] PRadius        NMC_GroupCircRBatch(): radius of each segment
+ * @param[in] PCenOfsMask    NMC_GroupCircCBatch(): CenOfsMask of each segment
+ * @param[in] PCenOfs        NMC_GroupCircCBatch(): center offset of each segment
+ * @param[in] PCW_CCW        NMC_GroupCircRBatch(), NMC_GroupCircCBatch(): direction of each segment
+ * @param[in] PBorPosMask    NMC_GroupCircBBatch(): BorPosMask of each segment
+ * @param[in] PBorPoint      NMC_GroupCircBBatch(): pass-through point of each segment
+ * @param[in] PAngleDeg      NMC_GroupCircBBatch(): angle of each segment, as NMC_GroupCircBEx(). Input NULL (0) to ignore the parameter for every segment.
+ * @param[in] PMaxVel        Maximum velocity of each segment. Input NULL (0) to ignore the parameter for every segment.
+ * @param[out] PRetAccepted  Return the number of segments accepted, from the first one on.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If every segment is accepted, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is the error code of the first rejected segment.
+ *
+ * \b Usage: <br>
+ * The segments are enqueued as by NMC_GroupLineBatch().
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * I32_T mask[2]   = { 3, 3 };
+ * Pos_T target[2] = { { 10, 10 }, { 20, 0 } };
+ * I32_T cenMask[2] = { 3, 3 };
+ * Xyz_T cenOfs[2] = { { 10, 0, 0 }, { 0, -10, 0 } };
+ * I32_T dir[2]    = { 1, 1 };
+ * I32_T accepted  = 0;
+ * RTN_ERR ret = NMC_GroupCircCBatch( 0, 0, 2, mask, target, cenMask, cenOfs, dir, NULL, &accepted );
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_GroupLineBatch()
+ */
+RTN_ERR FNTYPE NMC_GroupCircRBatch( I32_T DevID, I32_T GroupIndex, I32_T Count, const I32_T *PCartAxisMask, const Pos_T *PCartPos, const Xyz_T *PNormalVector, const F64_T *PRadius, const I32_T *PCW_CCW, _opt_null_ const F64_T *PMaxVel, I32_T *PRetAccepted );
+RTN_ERR FNTYPE NMC_GroupCircCBatch( I32_T DevID, I32_T GroupIndex, I32_T Count, const I32_T *PCartAxisMask, const Pos_T *PCartPos, const I32_T *PCenOfsMask, const Xyz_T *PCenOfs, const I32_T *PCW_CCW, _opt_null_ const F64_T *PMaxVel, I32_T *PRetAccepted );
+RTN_ERR FNTYPE NMC_GroupCircBBatch( I32_T DevID, I32_T GroupIndex, I32_T Count, const I32_T *PCartAxisMask, const Pos_T *PCartPos, const I32_T *PBorPosMask, const Xyz_T *PBorPoint, _opt_null_ const F64_T *PAngleDeg, _opt_null_ const F64_T *PMaxVel, I32_T *PRetAccepted );
+/*!
+ * @brief Enable the group B-spline or NURBS interpolation motion from the current position through the control points in the Cartesian
+ * space. The [group state](@ref NMC_GroupGetState) will transfer from GROUP_STAND_STILL to GROUP_MOVING. If the group reaches the last
+ * control point (i.e. the velocity is decreased to 0), the [group state](@ref NMC_GroupGetState) will transfer to GROUP_STAND_STILL.
+ * The TCP moves along the curve at the velocity of the group, as on a line, so one command replaces the many line segments of a
+ * sampled freeform path.
+ *
+ * @param DevID         Device ID (DevID)
+ * @param GroupIndex    Group index
+ * @param CartAxisMask  The mask is specified to execute the motion in the Cartesian space, as NMC_GroupLine().
+ * @param Degree        Degree of the curve (1 ~ 5), e.g. 3 for a cubic curve
+ * @param Count         Number of control points (Degree + 1 ~ 16384)
+ * @param[in] PCtrlPos  Array of Count control points. The first one is the current position (the start of the motion).
+ * @param[in] PKnots    Array of Count + Degree + 1 knots. Input NULL (0) for uniform knots.
+ * @param[in] PWeights  Array of Count weights (> 0) of a NURBS curve. Input NULL (0) for a B-spline curve (all weights 1).
+ * @param[in] PMaxVel   A pointer variable to set the maximum velocity. Input NULL (0) to ignore the parameter.
+ *
+ * @return Return an [error code](@ref Error_code). <br>
+ * If the function is called successfully, the return value is ERR_NEXMOTION_SUCCESS (0). Otherwise, the return value is an error code. All error codes are defined in the header file, NexMotionError.h.
+ *
+ * \b Usage: <br>
+ * 1. The control points are absolute or relative (group parameter 0x30) PCS positions as the target of NMC_GroupLine(): the coordinates
+ *    outside CartAxisMask keep their start value. The first control point must be the start position (0 in relative mode), since the
+ *    curve starts on it and ends on the last control point.
+ * 2. The knots are non-decreasing, the first Degree + 1 knots are equal and so are the last Degree + 1 (clamped knot vector), an inner
+ *    knot is repeated at most Degree times.
+ * 3. The path length of the curve (XYZ, or the largest coordinate change without translation) is tabulated when the command is called,
+ *    so the motion cycle follows the curve at the planned velocity without iterating.
+ * 4. The command is buffered and blended with the neighbouring line, arc and spline commands as a line (group parameter 0x36).
+ *    With the group parameter 0x36:4 (look-ahead segments) set, the velocity is also limited by the curvature of the path
+ *    within the group axis limits 0x32 ~ 0x34.
+ * 5. Up to 8 spline commands are buffered or running at once: the return value is ERR_NEXMOTION_OPERATION_BUSY when the
+ *    motion buffer or the spline slots are full.
+ *
+ * \b Examples: <br>
+ * @code{.h}
+ * // Cubic curve from ( 0, 0, 0 ) to ( 30, 0, 0 ), through the other control points in the XY-plane
+ * Pos_T ctrl[5] = { { 0, 0, 0 }, { 5, 10, 0 }, { 15, -10, 0 }, { 25, 10, 0 }, { 30, 0, 0 } };
+ * F64_T knots[9] = { 0, 0, 0, 0, 0.5, 1, 1, 1, 1 };
+ * RTN_ERR ret = NMC_GroupSpline( 0, 0, 7, 3, 5, ctrl, knots, NULL, NULL );
+ * if( ret != 0 ) return ret;
+ * @endcode
+ *
+ * \b Reference: <br>
+ * NMC_GroupLine(), NMC_GroupLineBatch()
+ */
+RTN_ERR FNTYPE NMC_GroupSpline( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask, I32_T Degree, I32_T Count, const Pos_T *PCtrlPos, _opt_null_ const F64_T *PKnots, _opt_null_ const F64_T *PWeights, _opt_null_ const F64_T *PMaxVel );
 /*!
  *  @}
  */
@@ -164,6 +164,16 @@
  *  @}
  */
 
+/*! \addtogroup Profile_Type
+ *  Velocity profiles of the axis parameter AXP_PROF_TYPE (0x31)
+ *  @{
+ */
+#define NMC_PROF_TYPE_TRAPEZOID             (0)    //!< Acceleration limited, trapezoidal velocity (T-curve).
+#define NMC_PROF_TYPE_SCURVE                (1)    //!< Jerk limited by AXP_JERK (0x35), 7 phases (S-curve).
+/*!
+ *  @}
+ */
+
 /*! \addtogroup Group_State
  *  State definition of group
  *
@@ -315,6 +325,113 @@
 #define NMC_MEM_ENTRY_NAME_SIZE             (128)
 #define NMC_MEM_ENTRY_CLASS_DIO             (0)
 #define NMC_MEM_ENTRY_CLASS_DATA            (1)
+
+#define NMC_MEM_ENTRY_AREA_INPUT            (0)   //!< An entry of the input memory.
+#define NMC_MEM_ENTRY_AREA_OUTPUT           (1)   //!< An entry of the output memory.
+#define NMC_MAX_MEM_ENTRIES                 (65536) //!< Memory entries per area.
+
+#define NMC_MEM_ENTRY_TYPE_BIT              (0)   //!< One bit, accessed as BOOL_T.
+#define NMC_MEM_ENTRY_TYPE_I8               (1)   //!< I8_T
+#define NMC_MEM_ENTRY_TYPE_U8               (2)   //!< U8_T
+#define NMC_MEM_ENTRY_TYPE_I16              (3)   //!< I16_T
+#define NMC_MEM_ENTRY_TYPE_U16              (4)   //!< U16_T
+#define NMC_MEM_ENTRY_TYPE_I32              (5)   //!< I32_T
+#define NMC_MEM_ENTRY_TYPE_U32              (6)   //!< U32_T
+#define NMC_MEM_ENTRY_TYPE_I64              (7)   //!< I64_T
+#define NMC_MEM_ENTRY_TYPE_U64              (8)   //!< U64_T
+#define NMC_MEM_ENTRY_TYPE_F32              (9)   //!< F32_T
+#define NMC_MEM_ENTRY_TYPE_F64              (10)  //!< F64_T
+/*!
+ *  @}
+ */
+
+/*! \addtogroup Device_Snapshot
+ *  Array sizes of NmcSnapshot_T
+ *  @{
+ */
+#define NMC_MAX_SNAPSHOT_AXES               (64)  //!< Axis entries of NmcSnapshot_T, equal to the range of system parameter 0x01
+#define NMC_MAX_SNAPSHOT_GROUPS             (64)  //!< Group entries of NmcSnapshot_T, equal to the range of system parameter 0x02
+/*!
+ *  @}
+ */
+
+/*! \addtogroup Device_OpenUp
+ *  Options of NMC_DeviceOpenUpRequestEx() and phases of NmcOpenUpProgress_T
+ *  @{
+ */
+#define NMC_OPENUP_OPT_ENABLE_ALL           (0x1) //!< Enable every axis and group once the device is started.
+
+#define NMC_OPENUP_PHASE_CREATE             (0)   //!< Create the device.
+#define NMC_OPENUP_PHASE_READ_CONFIG        (1)   //!< Read the configuration file.
+#define NMC_OPENUP_PHASE_APPLY_CONFIG       (2)   //!< Download the parameters to the axes and groups.
+#define NMC_OPENUP_PHASE_START              (3)   //!< Set up the kinematics and motion buffers, start the motion cycle.
+#define NMC_OPENUP_PHASE_ENABLE             (4)   //!< Enable the axes and groups (NMC_OPENUP_OPT_ENABLE_ALL).
+#define NMC_OPENUP_PHASE_COUNT              (5)   //!< Number of phases, size of NmcOpenUpProgress_T::phaseTimeUs.
+#define NMC_OPENUP_PHASE_DONE               (5)   //!< The open up is finished.
+/*!
+ *  @}
+ */
+
+/*! \addtogroup Device_Event
+ *  Event types of NmcEvent_T and subscription masks of NMC_DeviceSubscribeEvents()
+ *  @{
+ */
+#define NMC_EVENT_AXIS_STATE                (0)   //!< The state of an axis changed.
+#define NMC_EVENT_GROUP_STATE               (1)   //!< The state of a group changed.
+#define NMC_EVENT_AXIS_BUFF_LOW             (2)   //!< The motion buffer of an axis dropped to the low-water mark.
+#define NMC_EVENT_GROUP_BUFF_LOW            (3)   //!< The motion buffer of a group dropped to the low-water mark.
+#define NMC_EVENT_AXIS_DRIVE_ALM            (4)   //!< The drive alarm code of an axis changed.
+#define NMC_EVENT_MESSAGE                   (5)   //!< New system messages are available to NMC_MessagePopFirst().
+
+#define NMC_EVENT_MASK_AXIS_STATE           (1 << NMC_EVENT_AXIS_STATE)
+#define NMC_EVENT_MASK_GROUP_STATE          (1 << NMC_EVENT_GROUP_STATE)
+#define NMC_EVENT_MASK_AXIS_BUFF_LOW        (1 << NMC_EVENT_AXIS_BUFF_LOW)
+#define NMC_EVENT_MASK_GROUP_BUFF_LOW       (1 << NMC_EVENT_GROUP_BUFF_LOW)
+#define NMC_EVENT_MASK_AXIS_DRIVE_ALM       (1 << NMC_EVENT_AXIS_DRIVE_ALM)
+#define NMC_EVENT_MASK_MESSAGE              (1 << NMC_EVENT_MESSAGE)
+#define NMC_EVENT_MASK_ALL                  (0x3F)
+/*!
+ *  @}
+ */
+
+/*! \addtogroup Param_Scope
+ *  Parameter scopes of NMC_DeviceParamTxStageI32(), NMC_DeviceParamTxStageF64() and NmcParamDiff_T
+ *  @{
+ */
+#define NMC_PARAM_SCOPE_DEVICE              (0)   //!< System parameter, as NMC_DeviceSetParam().
+#define NMC_PARAM_SCOPE_AXIS                (1)   //!< Axis parameter, as NMC_AxisSetParamI32().
+#define NMC_PARAM_SCOPE_GROUP               (2)   //!< Group parameter, as NMC_GroupSetParamI32().
+#define NMC_PARAM_SCOPE_GROUP_AXIS          (3)   //!< Group axis parameter, as NMC_GroupAxSetParamI32().
+
+#define NMC_MAX_PARAM_TX                    (16)   //!< Open parameter transactions per device.
+#define NMC_MAX_PARAM_TX_ENTRIES            (4096) //!< Writes staged in a parameter transaction.
+
+#define NMC_PARAM_TYPE_I32                  (0)    //!< I32_T parameter, type of NmcParamDiff_T.
+#define NMC_PARAM_TYPE_F64                  (1)    //!< F64_T parameter, type of NmcParamDiff_T.
+/*!
+ *  @}
+ */
+
+/*! \addtogroup Input_Edge
+ *  Edges of NMC_DeviceSubscribeInputEdge()
+ *  @{
+ */
+#define NMC_INPUT_EDGE_RISING               (1)    //!< A bit changed from 0 to 1.
+#define NMC_INPUT_EDGE_FALLING              (2)    //!< A bit changed from 1 to 0.
+#define NMC_INPUT_EDGE_BOTH                 (3)    //!< Either change.
+
+#define NMC_MAX_INPUT_EDGE_SUBS             (4096) //!< Input edge subscriptions per device.
+#define NMC_MAX_INPUT_EDGES                 (4096) //!< Input edge records kept until NMC_DevicePopInputEdges().
+/*!
+ *  @}
+ */
+
+/*! \addtogroup Io_Capture
+ *  Limits of NMC_DeviceStartIoCapture()
+ *  @{
+ */
+#define NMC_MAX_IO_CAPTURE_RANGES           (64)   //!< Ranges of an I/O capture.
+#define NMC_MAX_IO_CAPTURE_BYTES            (4096) //!< Bytes captured per exchange, the sum of the sizes of the ranges.
 /*!
  *  @}
  */
@@ -503,17 +620,174 @@ typedef struct
 
 /*! @struct MemEntryInfo_T
  * @brief A data structure is used to describe the information of memory entry
- * @todo update with more detial.
+ *
+ * The entries are named ranges of the I/O memory, configured in the [InputMap] and [OutputMap] sections of the
+ * configuration file and read by NMC_MemEntryGetInfo() and NMC_MemEntryFind().
  */
 typedef struct
 {
-    U32_T bitStartOffset;
-    U32_T bitLen;
-    U32_T dataType;
-    U32_T fclass;
-    char  name[NMC_MEM_ENTRY_NAME_SIZE];
+    U32_T bitStartOffset;   //!< Offset of the first bit in the memory area, a multiple of 8 except for NMC_MEM_ENTRY_TYPE_BIT.
+    U32_T bitLen;           //!< Number of bits: 1 for NMC_MEM_ENTRY_TYPE_BIT, else 8 times the size of the type.
+    U32_T dataType;         //!< NMC_MEM_ENTRY_TYPE_*
+    U32_T fclass;           //!< NMC_MEM_ENTRY_CLASS_DIO for a bit, NMC_MEM_ENTRY_CLASS_DATA otherwise.
+    char  name[NMC_MEM_ENTRY_NAME_SIZE];    //!< Null terminated name, unique in the memory area.
 }MemEntryInfo_T;
 
+/*! @struct NmcSnapshot_T
+ *  @brief  The status of every axis and group of a device, read by NMC_DeviceGetSnapshot().
+ *
+ *  All the data is from the same motion cycle. The data of axis i (group g) is in entry i (g) of each
+ *  array; entries from axisCount (groupCount) on are not used.
+ */
+typedef struct
+{
+    U32_T sizeOfStruct;     //!< The size of NmcSnapshot_T, and equivalent to the sizeof(NmcSnapshot_T).
+    I32_T axisCount;        //!< Number of axes of the device.
+    I32_T groupCount;       //!< Number of groups of the device.
+    I32_T reserved;
+    U64_T cycleCount;       //!< Motion cycles executed since the device was started.
+    U64_T timestampNs;      //!< Time of the motion cycle on the monotonic clock of the system (ns).
+
+    I32_T axisState[NMC_MAX_SNAPSHOT_AXES];     //!< As NMC_AxisGetState()
+    I32_T axisStatus[NMC_MAX_SNAPSHOT_AXES];    //!< As NMC_AxisGetStatus()
+    F64_T axisCmdPos[NMC_MAX_SNAPSHOT_AXES];    //!< As NMC_AxisGetCommandPos()
+    F64_T axisActPos[NMC_MAX_SNAPSHOT_AXES];    //!< As NMC_AxisGetActualPos()
+    F64_T axisCmdVel[NMC_MAX_SNAPSHOT_AXES];    //!< As NMC_AxisGetCommandVel()
+    F64_T axisActVel[NMC_MAX_SNAPSHOT_AXES];    //!< As NMC_AxisGetActualVel()
+
+    I32_T groupState[NMC_MAX_SNAPSHOT_GROUPS];      //!< As NMC_GroupGetState()
+    I32_T groupStatus[NMC_MAX_SNAPSHOT_GROUPS];     //!< As NMC_GroupGetStatus()
+    Pos_T groupCmdPosAcs[NMC_MAX_SNAPSHOT_GROUPS];  //!< As NMC_GroupGetCommandPosAcs()
+    Pos_T groupActPosAcs[NMC_MAX_SNAPSHOT_GROUPS];  //!< As NMC_GroupGetActualPosAcs()
+    Pos_T groupCmdVelAcs[NMC_MAX_SNAPSHOT_GROUPS];  //!< Command velocity of the group axes
+    Pos_T groupActVelAcs[NMC_MAX_SNAPSHOT_GROUPS];  //!< Actual velocity of the group axes
+} NmcSnapshot_T;
+
+/*! @struct NmcOpenUpProgress_T
+ *  @brief  The progress of a device open up, read by NMC_DeviceGetOpenUpProgress().
+ */
+typedef struct
+{
+    U32_T   sizeOfStruct;   //!< The size of NmcOpenUpProgress_T, and equivalent to the sizeof(NmcOpenUpProgress_T).
+    I32_T   devId;          //!< The device ID, -1 before the device is created or if the open up failed.
+    I32_T   phase;          //!< The current phase, NMC_OPENUP_PHASE_*.
+    RTN_ERR result;         //!< The return value of the open up once the phase is NMC_OPENUP_PHASE_DONE.
+    U32_T   phaseTimeUs[NMC_OPENUP_PHASE_COUNT];    //!< Time spent in each phase (us).
+    U32_T   totalTimeUs;    //!< Time since the open up started (us).
+} NmcOpenUpProgress_T;
+
+/*! @struct NmcEvent_T
+ *  @brief  An event record of a device, read by NMC_DevicePopEvents().
+ */
+typedef struct
+{
+    I32_T type;             //!< The type of event, NMC_EVENT_*.
+    I32_T index;            //!< The axis or group index, -1 for NMC_EVENT_MESSAGE.
+    I32_T prevValue;        //!< The value before the event: state, buffered motions, alarm code or message index.
+    I32_T value;            //!< The value after the event.
+    U64_T cycleCount;       //!< The motion cycle of the event, as NmcSnapshot_T.
+    U64_T timestampNs;      //!< Time of the event on the monotonic clock of the system (ns).
+} NmcEvent_T;
+
+/*! @struct NmcParamDiff_T
+ *  @brief  A parameter which differs between two parameter images, read by NMC_DiffParams().
+ */
+typedef struct
+{
+    I32_T scope;            //!< The parameter scope, NMC_PARAM_SCOPE_*.
+    I32_T index;            //!< The axis or group index, 0 for NMC_PARAM_SCOPE_DEVICE.
+    I32_T groupAxisIndex;   //!< The axis index in the group for NMC_PARAM_SCOPE_GROUP_AXIS, 0 otherwise.
+    I32_T paramNum;         //!< Parameter number.
+    I32_T subIndex;         //!< Parameter sub-index.
+    I32_T type;             //!< NMC_PARAM_TYPE_I32 or NMC_PARAM_TYPE_F64.
+    F64_T oldValue;         //!< The value in the first image.
+    F64_T newValue;         //!< The value in the second image.
+} NmcParamDiff_T;
+
+/*! @struct NmcIoImage_T
+ *  @brief  Direct access to the I/O memory of a device, read by NMC_DeviceGetIoImage().
+ *
+ *  The images are exchanged with the I/O devices by the motion cycle. While it exchanges them, *pSequence is odd;
+ *  it grows by 2 per exchange, so a reader which sees the same even value before and after reading saw a single exchange.
+ */
+typedef struct
+{
+    U32_T                 sizeOfStruct; //!< The size of NmcIoImage_T, and equivalent to the sizeof(NmcIoImage_T).
+    U32_T                 inputSize;    //!< Size of the input memory (byte), as NMC_GetInputMemorySize().
+    U32_T                 outputSize;   //!< Size of the output memory (byte), as NMC_GetOutputMemorySize().
+    U32_T                 reserved;
+    const volatile U8_T  *pInput;       //!< The input memory, read only.
+    volatile U8_T        *pOutput;      //!< The output memory, sent at the next exchange.
+    const volatile U32_T *pSequence;    //!< The exchange sequence counter.
+} NmcIoImage_T;
+
+/*! @struct NmcInputEdge_T
+ *  @brief  An edge of a subscribed input byte, read by NMC_DevicePopInputEdges().
+ */
+typedef struct
+{
+    I32_T subscriptionId;   //!< The subscription which matched, as returned by NMC_DeviceSubscribeInputEdge().
+    U32_T offsetByte;       //!< The offset of the input byte.
+    U8_T  risingBits;       //!< The subscribed bits which changed from 0 to 1.
+    U8_T  fallingBits;      //!< The subscribed bits which changed from 1 to 0.
+    U8_T  value;            //!< The input byte after the change.
+    U8_T  reserved[5];
+    U64_T cycleCount;       //!< The motion cycle of the exchange which received the change, as NmcSnapshot_T.
+    U64_T timestampNs;      //!< Time of the exchange on the monotonic clock of the system (ns).
+} NmcInputEdge_T;
+
+/*! @struct NmcIoItem_T
+ *  @brief  A typed field of the I/O memory, for NMC_ReadInputGather(), NMC_ReadOutputGather() and NMC_WriteOutputScatter().
+ */
+typedef struct
+{
+    U32_T offsetByte;       //!< Memory offset (byte) of the field from 0.
+    U32_T type;             //!< NMC_MEM_ENTRY_TYPE_*
+    U32_T bitIndex;         //!< Bit index in the byte (0~7) for NMC_MEM_ENTRY_TYPE_BIT, ignored otherwise.
+} NmcIoItem_T;
+
+/*! @union NmcIoValue_T
+ *  @brief  The value of a NmcIoItem_T, in the member of its type.
+ */
+typedef union
+{
+    BOOL_T bitValue;        //!< NMC_MEM_ENTRY_TYPE_BIT, 0 or 1.
+    I8_T   i8;
+    U8_T   u8;
+    I16_T  i16;
+    U16_T  u16;
+    I32_T  i32;
+    U32_T  u32;
+    I64_T  i64;
+    U64_T  u64;
+    F32_T  f32;
+    F64_T  f64;
+} NmcIoValue_T;
+
+/*! @struct NmcIoCaptureRange_T
+ *  @brief  A range of the I/O memory captured by NMC_DeviceStartIoCapture().
+ */
+typedef struct
+{
+    I32_T area;             //!< NMC_MEM_ENTRY_AREA_INPUT or NMC_MEM_ENTRY_AREA_OUTPUT
+    U32_T offsetByte;       //!< Memory offset (byte) of the range from 0.
+    U32_T sizeByte;         //!< Size of the range (byte), not 0.
+} NmcIoCaptureRange_T;
+
+/*! @struct NmcIoCaptureStatus_T
+ *  @brief  The I/O capture of a device, read by NMC_DeviceGetIoCaptureStatus(). Kept after the capture is stopped.
+ */
+typedef struct
+{
+    I32_T   active;         //!< 1 from NMC_DeviceStartIoCapture() to NMC_DeviceStopIoCapture(), 0 otherwise.
+    RTN_ERR error;          //!< ERR_NEXMOTION_SUCCESS, or the write error which stopped the writes to the file.
+    U32_T   frameBytes;     //!< Bytes captured per exchange.
+    U32_T   reserved;
+    U64_T   frameCount;     //!< Frames written: the exchanges which changed the captured bytes, and the first one.
+    U64_T   lostCount;      //!< Frames dropped because the file writes could not keep up.
+    U64_T   fileBytes;      //!< Size of the file (byte).
+} NmcIoCaptureStatus_T;
+
 /////////////////////////////////////////////////////////////////////
 //                      Obsolete definition
 /////////////////////////////////////////////////////////////////////
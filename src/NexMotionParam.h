@@ -0,0 +1,349 @@
+/*!
+ * @file        NexMotionParam.h
+ * @brief       Parameter descriptor tables and typed C++ parameter accessors of the NexMotion Library
+ * @author      NexCOBOT, Inc.
+ *
+ * The tables list every system, axis, group and group axis parameter of the
+ * [device parameters](@ref DeviceParameters) chapter. In C++, each parameter is also a type:
+ *
+ * @code{.cpp}
+ * #include "NexMotionParam.h"
+ *
+ * NexMotion::SetParam<NexMotion::AXP_VM>( devId, 0, 200.0 );         // NMC_AxisSetParamF64( devId, 0, 0x32, 0, 200.0 )
+ * NexMotion::SetParam<NexMotion::GRP_BUFF>( devId, 0, 2 );            // NMC_GroupSetParamI32( devId, 0, 0x36, 0, 2 )
+ * NexMotion::SetParam<NexMotion::GRP_TOOL_T<3, 2> >( devId, 0, 15.0 ); // Tool 3, z: NMC_GroupSetParamF64( devId, 0, 0x83, 2, 15.0 )
+ * NexMotion::SetParam<NexMotion::AXP_VM>( devId, 0, 2 );              // Does not compile, the parameter is an F64_T, 2 an int
+ * NexMotion::SetParam<NexMotion::GRP_BUFF>( devId, 0, 2.5 );          // Does not compile, the parameter is an I32_T
+ * NexMotion::SetParam<NexMotion::SYS_CYCLE_OVERRUN>( devId, 0 );      // Does not compile, the parameter is read only
+ * @endcode
+ */
+/******************************************************************************
+  Open Robots & Machines
+  (C) 2018 NEXCOBOT Co., Ltd. All Rights Reserved.
+*******************************************************************************/
+#ifndef __NEXMOTION_PARAM_H
+#define __NEXMOTION_PARAM_H
+
+#include "NexMotion.h"
+#include "NexMotionError.h"
+
+/*! \addtogroup Param_Table
+ *  Parameter descriptor tables
+ *  @{
+ */
+#define NMC_PARAM_FLAG_AFTER_START          (0x01)          //!< (*1) Effective after the system is started, cannot be modified in operation.
+#define NMC_PARAM_FLAG_READ_ONLY            (0x02)          //!< (*4) Read only.
+
+#define NMC_PARAM_I32_LIMIT                 (2147483647.0)  //!< Largest I32_T value
+#define NMC_PARAM_F64_LIMIT                 (1e12)          //!< Largest magnitude of an F64_T parameter
+#define NMC_PARAM_F64_MIN_POS               (1e-6)          //!< Smallest value of a strictly positive F64_T parameter
+#define NMC_PARAM_MAX_AXES                  (64)            //!< Range of system parameter 0x01
+#define NMC_PARAM_MAX_GROUPS                (64)            //!< Range of system parameter 0x02
+#define NMC_PARAM_MAX_TOOLS                 (16)            //!< Group parameters 0x80 ~ 0x8F
+#define NMC_PARAM_MAX_BASES                 (32)            //!< Group parameters 0xC0 ~ 0xDF
+#define NMC_PARAM_MAX_LOOK_AHEAD            (512)           //!< Range of group parameter 0x36:4
+
+/*!
+ * Each row describes a block of parameters, number range x sub-index range, sharing the same properties:
+ *
+ * X( Tag, ParamNum, ParamNumLast, SubIndex, SubIndexLast, Type (I32 or F64), Flags, Min, Max, Default, Name )
+ */
+#define NMC_PARAM_TABLE_DEVICE( X ) \
+    X( SYS_CYCLE_TIME_US,   0x00, 0x00, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 1000, 4000, 1000, "CycleTimeUs" ) \
+    X( SYS_AXIS_COUNT,      0x01, 0x01, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, NMC_PARAM_MAX_AXES, 0, "AxisCount" ) \
+    X( SYS_GROUP_COUNT,     0x02, 0x02, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, NMC_PARAM_MAX_GROUPS, 0, "GroupCount" ) \
+    X( SYS_RT_PRIORITY,     0x10, 0x10, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 99, 0, "RtPriority" ) \
+    X( SYS_RT_CPU,          0x11, 0x11, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, -1, 1023, -1, "RtCpu" ) \
+    X( SYS_RT_LOCK_MEMORY,  0x12, 0x12, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 1, 0, "RtLockMemory" ) \
+    X( SYS_RT_STACK_KB,     0x13, 0x13, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 1024, 64, "RtStackPrefaultKb" ) \
+    X( SYS_IO_CYCLES,       0x14, 0x14, 0, 0,  I32, 0, 0, 1000, 0, "IoExchangeCycles" ) \
+    X( SYS_CYCLE_LATENCY,   0x20, 0x20, 0, 3,  I32, NMC_PARAM_FLAG_READ_ONLY, 0, NMC_PARAM_I32_LIMIT, 0, "CycleLatencyUs" ) \
+    X( SYS_CYCLE_OVERRUN,   0x21, 0x21, 0, 0,  I32, NMC_PARAM_FLAG_READ_ONLY, 0, NMC_PARAM_I32_LIMIT, 0, "CycleOverrunCount" ) \
+    X( SYS_IO_LATENCY,      0x22, 0x22, 0, 3,  I32, NMC_PARAM_FLAG_READ_ONLY, 0, NMC_PARAM_I32_LIMIT, 0, "IoLatencyUs" ) \
+    X( SYS_INPUT_EDGE_LOST, 0x23, 0x23, 0, 0,  I32, NMC_PARAM_FLAG_READ_ONLY, 0, NMC_PARAM_I32_LIMIT, 0, "InputEdgeLostCount" ) \
+    X( SYS_EVENT_LOST,      0x24, 0x24, 0, 0,  I32, NMC_PARAM_FLAG_READ_ONLY, 0, NMC_PARAM_I32_LIMIT, 0, "EventLostCount" )
+
+#define NMC_PARAM_TABLE_AXIS( X ) \
+    X( AXP_PITCH,           0x00, 0x00, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 1, NMC_PARAM_I32_LIMIT, 360, "MechanicalPitch" ) \
+    X( AXP_MECH_REV,        0x01, 0x01, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 1, NMC_PARAM_I32_LIMIT, 1, "MechanicalRevolution" ) \
+    X( AXP_MOTOR_REV,       0x02, 0x02, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 1, NMC_PARAM_I32_LIMIT, 1, "MotorRevolution" ) \
+    X( AXP_ENC_RES,         0x03, 0x03, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 1, NMC_PARAM_I32_LIMIT, 131072, "EncoderResolution" ) \
+    X( AXP_ENC_DIR,         0x04, 0x04, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 1, 0, "EncoderDirection" ) \
+    X( AXP_ENC_TYPE,        0x05, 0x05, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 1, 0, "EncoderType" ) \
+    X( AXP_ENC_ENABLE,      0x06, 0x06, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 1, 1, "EncoderEnable" ) \
+    X( AXP_SW_LIMIT_POS,    0x10, 0x10, 0, 0,  F64, 0, -NMC_PARAM_F64_LIMIT, NMC_PARAM_F64_LIMIT, 0, "SoftLimitPositive" ) \
+    X( AXP_SW_LIMIT_NEG,    0x11, 0x11, 0, 0,  F64, 0, -NMC_PARAM_F64_LIMIT, NMC_PARAM_F64_LIMIT, 0, "SoftLimitNegative" ) \
+    X( AXP_SW_LIMIT_ENABLE, 0x12, 0x12, 0, 0,  I32, 0, 0, 1, 0, "SoftLimitEnable" ) \
+    X( AXP_ABS_REL,         0x30, 0x30, 0, 0,  I32, 0, 0, 1, 0, "AbsRel" ) \
+    X( AXP_PROF_TYPE,       0x31, 0x31, 0, 0,  I32, 0, 0, 1, 0, "ProfileType" ) \
+    X( AXP_VM,              0x32, 0x32, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 100, "MaxVelocity" ) \
+    X( AXP_ACC,             0x33, 0x33, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 1000, "Acceleration" ) \
+    X( AXP_DEC,             0x34, 0x34, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 1000, "Deceleration" ) \
+    X( AXP_JERK,            0x35, 0x35, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 10000, "Jerk" ) \
+    X( AXP_BUFF_PARAM,      0x36, 0x36, 0, 0,  I32, 0, 0, 1, 0, "BufferMode" ) \
+    X( AXP_V_BASE,          0x37, 0x37, 0, 0,  F64, 0, 0, NMC_PARAM_F64_LIMIT, 0, "BaseVelocity" ) \
+    X( AXP_STOP_PROF_DEC,   0x38, 0x38, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 10000, "StopDeceleration" )
+
+#define NMC_PARAM_TABLE_GROUP( X ) \
+    X( GRP_KIN,             0x00, 0x00, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 3, 0, "KinematicsType" ) \
+    X( GRP_KIN_PARAM,       0x00, 0x00, 1, 48, F64, NMC_PARAM_FLAG_AFTER_START, -NMC_PARAM_F64_LIMIT, NMC_PARAM_F64_LIMIT, 0, "KinematicsParam" ) \
+    X( GRP_ABS_REL,         0x30, 0x30, 0, 0,  I32, 0, 0, 1, 0, "AbsRel" ) \
+    X( GRP_PROF_TYPE,       0x31, 0x31, 0, 0,  I32, 0, 0, 0, 0, "ProfileType" ) \
+    X( GRP_VM,              0x32, 0x32, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 100, "MaxVelocity" ) \
+    X( GRP_ACC,             0x33, 0x33, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 1000, "Acceleration" ) \
+    X( GRP_DEC,             0x34, 0x34, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 1000, "Deceleration" ) \
+    X( GRP_JERK,            0x35, 0x35, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 10000, "Jerk" ) \
+    X( GRP_BUFF,            0x36, 0x36, 0, 0,  I32, 0, 0, 2, 1, "BufferMode" ) \
+    X( GRP_BLEND_MODE,      0x36, 0x36, 1, 1,  I32, 0, 0, 1, 0, "BlendingMode" ) \
+    X( GRP_BLEND_VALUE,     0x36, 0x36, 2, 3,  F64, 0, 0, NMC_PARAM_I32_LIMIT, 0, "BlendingValue" ) \
+    X( GRP_LOOK_AHEAD,      0x36, 0x36, 4, 4,  I32, 0, 0, NMC_PARAM_MAX_LOOK_AHEAD, 0, "LookAheadSegments" ) \
+    X( GRP_STOP_PROF_DEC,   0x38, 0x38, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 10000, "StopDeceleration" ) \
+    X( GRP_PTP_SYNC,        0x39, 0x39, 0, 0,  I32, 0, 0, 1, 0, "PtpSync" ) \
+    X( GRP_TOOL_SEL,        0x47, 0x47, 0, 0,  I32, 0, -1, NMC_PARAM_MAX_TOOLS - 1, -1, "ToolSelect" ) \
+    X( GRP_BASE_SEL,        0x48, 0x48, 0, 0,  I32, 0, -1, NMC_PARAM_MAX_BASES - 1, -1, "BaseSelectTarget" ) \
+    X( GRP_BASE_SEL_READ,   0x48, 0x48, 1, 1,  I32, 0, -2, NMC_PARAM_MAX_BASES - 1, -2, "BaseSelectRead" ) \
+    X( GRP_TOOL,            0x80, 0x8F, 0, 5,  F64, 0, -NMC_PARAM_F64_LIMIT, NMC_PARAM_F64_LIMIT, 0, "Tool" ) \
+    X( GRP_BASE,            0xC0, 0xDF, 0, 5,  F64, 0, -NMC_PARAM_F64_LIMIT, NMC_PARAM_F64_LIMIT, 0, "Base" ) \
+    X( GRP_BASE_REF,        0xC0, 0xDF, 6, 6,  I32, 0, -1, NMC_PARAM_MAX_BASES - 1, -1, "BaseReference" )
+
+#define NMC_PARAM_TABLE_GROUP_AXIS( X ) \
+    X( GAXP_PITCH,          0x00, 0x00, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 1, NMC_PARAM_I32_LIMIT, 360, "MechanicalPitch" ) \
+    X( GAXP_MECH_REV,       0x01, 0x01, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 1, NMC_PARAM_I32_LIMIT, 1, "MechanicalRevolution" ) \
+    X( GAXP_MOTOR_REV,      0x02, 0x02, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 1, NMC_PARAM_I32_LIMIT, 1, "MotorRevolution" ) \
+    X( GAXP_ENC_RES,        0x03, 0x03, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 1, NMC_PARAM_I32_LIMIT, 131072, "EncoderResolution" ) \
+    X( GAXP_ENC_DIR,        0x04, 0x04, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 1, 0, "EncoderDirection" ) \
+    X( GAXP_ENC_TYPE,       0x05, 0x05, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 1, 0, "EncoderType" ) \
+    X( GAXP_ENC_ENABLE,     0x06, 0x06, 0, 0,  I32, NMC_PARAM_FLAG_AFTER_START, 0, 1, 1, "EncoderEnable" ) \
+    X( GAXP_SW_LIMIT_POS,   0x10, 0x10, 0, 0,  F64, 0, -NMC_PARAM_F64_LIMIT, NMC_PARAM_F64_LIMIT, 0, "SoftLimitPositive" ) \
+    X( GAXP_SW_LIMIT_NEG,   0x11, 0x11, 0, 0,  F64, 0, -NMC_PARAM_F64_LIMIT, NMC_PARAM_F64_LIMIT, 0, "SoftLimitNegative" ) \
+    X( GAXP_SW_LIMIT_ENABLE,0x12, 0x12, 0, 0,  I32, 0, 0, 1, 0, "SoftLimitEnable" ) \
+    X( GAXP_VM,             0x32, 0x32, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 100, "MaxVelocity" ) \
+    X( GAXP_ACC,            0x33, 0x33, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 1000, "Acceleration" ) \
+    X( GAXP_DEC,            0x34, 0x34, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 1000, "Deceleration" ) \
+    X( GAXP_JERK,           0x35, 0x35, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 10000, "Jerk" ) \
+    X( GAXP_STOP_PROF_DEC,  0x38, 0x38, 0, 0,  F64, 0, NMC_PARAM_F64_MIN_POS, NMC_PARAM_F64_LIMIT, 10000, "StopDeceleration" )
+/*!
+ *  @}
+ */
+
+#ifdef __cplusplus
+
+#include <type_traits>
+
+namespace NexMotion
+{
+
+/*! @struct ParamDesc
+ *  @brief  Row of a parameter descriptor table.
+ */
+struct ParamDesc
+{
+    I32_T       paramNum;       //!< First parameter number of the block.
+    I32_T       paramNumLast;   //!< Last parameter number of the block (inclusive).
+    I32_T       subIndex;       //!< First sub-index of the block.
+    I32_T       subIndexLast;   //!< Last sub-index of the block (inclusive).
+    bool        isF64;          //!< F64_T or I32_T parameter.
+    U32_T       flags;          //!< NMC_PARAM_FLAG_*
+    F64_T       minValue;       //!< Minimum value (inclusive).
+    F64_T       maxValue;       //!< Maximum value (inclusive).
+    F64_T       defValue;       //!< Default value.
+    const char *name;           //!< Name used in messages and configuration files.
+};
+
+#define NMC_PARAM_DESC_ROW( Tag, Num, NumLast, Sub, SubLast, Type, Flags, Min, Max, Def, Name ) \
+    { Num, NumLast, Sub, SubLast, sizeof( Type##_T ) == sizeof( F64_T ), Flags, Min, Max, Def, Name },
+
+constexpr ParamDesc kDeviceParamTable[]    = { NMC_PARAM_TABLE_DEVICE( NMC_PARAM_DESC_ROW ) };
+constexpr ParamDesc kAxisParamTable[]      = { NMC_PARAM_TABLE_AXIS( NMC_PARAM_DESC_ROW ) };
+constexpr ParamDesc kGroupParamTable[]     = { NMC_PARAM_TABLE_GROUP( NMC_PARAM_DESC_ROW ) };
+constexpr ParamDesc kGroupAxisParamTable[] = { NMC_PARAM_TABLE_GROUP_AXIS( NMC_PARAM_DESC_ROW ) };
+
+#undef NMC_PARAM_DESC_ROW
+
+/*!
+ * @brief Compile time description of one parameter, the base of the parameter types below.
+ *
+ * A table row covering several parameter numbers or sub-indexes is the template Tag_T<N, S>: parameter
+ * number ParamNum + N, sub-index SubIndex + S. Tag is Tag_T<0, 0>.
+ */
+template <I32_T Scope, I32_T Num, I32_T Sub, typename T, U32_T Flags>
+struct Param
+{
+    typedef T value_type;
+    static constexpr I32_T scope()    { return Scope; }
+    static constexpr I32_T paramNum() { return Num; }
+    static constexpr I32_T subIndex() { return Sub; }
+    static constexpr U32_T flags()    { return Flags; }
+};
+
+#define NMC_PARAM_TYPE( Scope, Tag, Num, NumLast, Sub, SubLast, Type, Flags, Min, Max, Def, Name ) \
+    template <I32_T N = 0, I32_T S = 0> \
+    struct Tag##_T : Param<Scope, ( Num ) + N, ( Sub ) + S, Type##_T, Flags> \
+    { \
+        static_assert( N >= 0 && N <= ( NumLast ) - ( Num ) && S >= 0 && S <= ( SubLast ) - ( Sub ), Name ": index out of the parameter block" ); \
+        static constexpr F64_T minValue() { return Min; } \
+        static constexpr F64_T maxValue() { return Max; } \
+        static constexpr F64_T defValue() { return Def; } \
+    }; \
+    typedef Tag##_T<> Tag;
+#define NMC_PARAM_TYPE_DEVICE( ... )     NMC_PARAM_TYPE( NMC_PARAM_SCOPE_DEVICE, __VA_ARGS__ )
+#define NMC_PARAM_TYPE_AXIS( ... )       NMC_PARAM_TYPE( NMC_PARAM_SCOPE_AXIS, __VA_ARGS__ )
+#define NMC_PARAM_TYPE_GROUP( ... )      NMC_PARAM_TYPE( NMC_PARAM_SCOPE_GROUP, __VA_ARGS__ )
+#define NMC_PARAM_TYPE_GROUP_AXIS( ... ) NMC_PARAM_TYPE( NMC_PARAM_SCOPE_GROUP_AXIS, __VA_ARGS__ )
+
+NMC_PARAM_TABLE_DEVICE( NMC_PARAM_TYPE_DEVICE )
+NMC_PARAM_TABLE_AXIS( NMC_PARAM_TYPE_AXIS )
+NMC_PARAM_TABLE_GROUP( NMC_PARAM_TYPE_GROUP )
+NMC_PARAM_TABLE_GROUP_AXIS( NMC_PARAM_TYPE_GROUP_AXIS )
+
+#undef NMC_PARAM_TYPE_DEVICE
+#undef NMC_PARAM_TYPE_AXIS
+#undef NMC_PARAM_TYPE_GROUP
+#undef NMC_PARAM_TYPE_GROUP_AXIS
+#undef NMC_PARAM_TYPE
+
+//! True if Value is in the range of the parameter P, usable in a static_assert.
+template <typename P>
+constexpr bool InRange( typename P::value_type Value )
+{
+    return Value >= P::minValue() && Value <= P::maxValue();
+}
+
+namespace detail
+{
+
+//! The API functions of a scope and type.
+template <I32_T Scope, typename T> struct ParamApi;
+
+template <> struct ParamApi<NMC_PARAM_SCOPE_DEVICE, I32_T>
+{
+    static RTN_ERR Set( I32_T DevID, I32_T, I32_T, I32_T Num, I32_T Sub, I32_T V )   { return NMC_DeviceSetParam( DevID, Num, Sub, V ); }
+    static RTN_ERR Get( I32_T DevID, I32_T, I32_T, I32_T Num, I32_T Sub, I32_T *PV ) { return NMC_DeviceGetParam( DevID, Num, Sub, PV ); }
+};
+template <> struct ParamApi<NMC_PARAM_SCOPE_AXIS, I32_T>
+{
+    static RTN_ERR Set( I32_T DevID, I32_T Idx, I32_T, I32_T Num, I32_T Sub, I32_T V )   { return NMC_AxisSetParamI32( DevID, Idx, Num, Sub, V ); }
+    static RTN_ERR Get( I32_T DevID, I32_T Idx, I32_T, I32_T Num, I32_T Sub, I32_T *PV ) { return NMC_AxisGetParamI32( DevID, Idx, Num, Sub, PV ); }
+};
+template <> struct ParamApi<NMC_PARAM_SCOPE_AXIS, F64_T>
+{
+    static RTN_ERR Set( I32_T DevID, I32_T Idx, I32_T, I32_T Num, I32_T Sub, F64_T V )   { return NMC_AxisSetParamF64( DevID, Idx, Num, Sub, V ); }
+    static RTN_ERR Get( I32_T DevID, I32_T Idx, I32_T, I32_T Num, I32_T Sub, F64_T *PV ) { return NMC_AxisGetParamF64( DevID, Idx, Num, Sub, PV ); }
+};
+template <> struct ParamApi<NMC_PARAM_SCOPE_GROUP, I32_T>
+{
+    static RTN_ERR Set( I32_T DevID, I32_T Idx, I32_T, I32_T Num, I32_T Sub, I32_T V )   { return NMC_GroupSetParamI32( DevID, Idx, Num, Sub, V ); }
+    static RTN_ERR Get( I32_T DevID, I32_T Idx, I32_T, I32_T Num, I32_T Sub, I32_T *PV ) { return NMC_GroupGetParamI32( DevID, Idx, Num, Sub, PV ); }
+};
+template <> struct ParamApi<NMC_PARAM_SCOPE_GROUP, F64_T>
+{
+    static RTN_ERR Set( I32_T DevID, I32_T Idx, I32_T, I32_T Num, I32_T Sub, F64_T V )   { return NMC_GroupSetParamF64( DevID, Idx, Num, Sub, V ); }
+    static RTN_ERR Get( I32_T DevID, I32_T Idx, I32_T, I32_T Num, I32_T Sub, F64_T *PV ) { return NMC_GroupGetParamF64( DevID, Idx, Num, Sub, PV ); }
+};
+template <> struct ParamApi<NMC_PARAM_SCOPE_GROUP_AXIS, I32_T>
+{
+    static RTN_ERR Set( I32_T DevID, I32_T Idx, I32_T Ax, I32_T Num, I32_T Sub, I32_T V )   { return NMC_GroupAxSetParamI32( DevID, Idx, Ax, Num, Sub, V ); }
+    static RTN_ERR Get( I32_T DevID, I32_T Idx, I32_T Ax, I32_T Num, I32_T Sub, I32_T *PV ) { return NMC_GroupAxGetParamI32( DevID, Idx, Ax, Num, Sub, PV ); }
+};
+template <> struct ParamApi<NMC_PARAM_SCOPE_GROUP_AXIS, F64_T>
+{
+    static RTN_ERR Set( I32_T DevID, I32_T Idx, I32_T Ax, I32_T Num, I32_T Sub, F64_T V )   { return NMC_GroupAxSetParamF64( DevID, Idx, Ax, Num, Sub, V ); }
+    static RTN_ERR Get( I32_T DevID, I32_T Idx, I32_T Ax, I32_T Num, I32_T Sub, F64_T *PV ) { return NMC_GroupAxGetParamF64( DevID, Idx, Ax, Num, Sub, PV ); }
+};
+
+//! The value is not converted: an int for an F64_T parameter or a double for an I32_T parameter is an error.
+template <typename P, typename T>
+inline RTN_ERR Set( I32_T DevID, I32_T Index, I32_T GroupAxisIndex, T Value )
+{
+    static_assert( std::is_same<T, typename P::value_type>::value, "the value must have the type of the parameter" );
+    static_assert( ( P::flags() & NMC_PARAM_FLAG_READ_ONLY ) == 0, "the parameter is read only" );
+    if( !InRange<P>( Value ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    return ParamApi<P::scope(), typename P::value_type>::Set( DevID, Index, GroupAxisIndex, P::paramNum(), P::subIndex(), Value );
+}
+
+template <typename P>
+inline RTN_ERR Get( I32_T DevID, I32_T Index, I32_T GroupAxisIndex, typename P::value_type *PRetValue )
+{
+    return ParamApi<P::scope(), typename P::value_type>::Get( DevID, Index, GroupAxisIndex, P::paramNum(), P::subIndex(), PRetValue );
+}
+
+} // namespace detail
+
+/*!
+ * @brief Set a system parameter, as NMC_DeviceSetParam().
+ *
+ * The value must have the type of the parameter, it is not converted, and is checked against its range
+ * before the call.
+ */
+template <typename P, typename T>
+inline RTN_ERR SetParam( I32_T DevID, T Value )
+{
+    static_assert( P::scope() == NMC_PARAM_SCOPE_DEVICE, "SetParam( DevID, Value ) sets a system parameter" );
+    return detail::Set<P>( DevID, 0, 0, Value );
+}
+
+//! Set an axis or group parameter, as NMC_AxisSetParamI32() or NMC_GroupSetParamF64(), etc.
+template <typename P, typename T>
+inline RTN_ERR SetParam( I32_T DevID, I32_T Index, T Value )
+{
+    static_assert( P::scope() == NMC_PARAM_SCOPE_AXIS || P::scope() == NMC_PARAM_SCOPE_GROUP,
+                   "SetParam( DevID, Index, Value ) sets an axis or group parameter" );
+    return detail::Set<P>( DevID, Index, 0, Value );
+}
+
+//! Set a group axis parameter, as NMC_GroupAxSetParamI32() or NMC_GroupAxSetParamF64().
+template <typename P, typename T>
+inline RTN_ERR SetParam( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex, T Value )
+{
+    static_assert( P::scope() == NMC_PARAM_SCOPE_GROUP_AXIS, "SetParam( DevID, GroupIndex, GroupAxisIndex, Value ) sets a group axis parameter" );
+    return detail::Set<P>( DevID, GroupIndex, GroupAxisIndex, Value );
+}
+
+//! Get a system parameter, as NMC_DeviceGetParam().
+template <typename P>
+inline RTN_ERR GetParam( I32_T DevID, typename P::value_type *PRetValue )
+{
+    static_assert( P::scope() == NMC_PARAM_SCOPE_DEVICE, "GetParam( DevID, PRetValue ) gets a system parameter" );
+    return detail::Get<P>( DevID, 0, 0, PRetValue );
+}
+
+//! Get an axis or group parameter.
+template <typename P>
+inline RTN_ERR GetParam( I32_T DevID, I32_T Index, typename P::value_type *PRetValue )
+{
+    static_assert( P::scope() == NMC_PARAM_SCOPE_AXIS || P::scope() == NMC_PARAM_SCOPE_GROUP,
+                   "GetParam( DevID, Index, PRetValue ) gets an axis or group parameter" );
+    return detail::Get<P>( DevID, Index, 0, PRetValue );
+}
+
+//! Get a group axis parameter.
+template <typename P>
+inline RTN_ERR GetParam( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex, typename P::value_type *PRetValue )
+{
+    static_assert( P::scope() == NMC_PARAM_SCOPE_GROUP_AXIS, "GetParam( DevID, GroupIndex, GroupAxisIndex, PRetValue ) gets a group axis parameter" );
+    return detail::Get<P>( DevID, GroupIndex, GroupAxisIndex, PRetValue );
+}
+
+/*!
+ * @brief Stage the write of a parameter in a transaction, as NMC_DeviceParamTxStageI32() or NMC_DeviceParamTxStageF64().
+ *
+ * Index and GroupAxisIndex are used as by the stage functions, according to the scope of P.
+ */
+template <typename P, typename T>
+inline RTN_ERR StageParam( I32_T DevID, I32_T TxID, I32_T Index, I32_T GroupAxisIndex, T Value )
+{
+    static_assert( std::is_same<T, typename P::value_type>::value, "the value must have the type of the parameter" );
+    static_assert( ( P::flags() & NMC_PARAM_FLAG_READ_ONLY ) == 0, "the parameter is read only" );
+    if( !InRange<P>( Value ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    return ( sizeof( typename P::value_type ) == sizeof( F64_T ) )
+        ? NMC_DeviceParamTxStageF64( DevID, TxID, P::scope(), Index, GroupAxisIndex, P::paramNum(), P::subIndex(), Value )
+        : NMC_DeviceParamTxStageI32( DevID, TxID, P::scope(), Index, GroupAxisIndex, P::paramNum(), P::subIndex(), static_cast<I32_T>( Value ) );
+}
+
+} // namespace NexMotion
+
+#endif // #ifdef __cplusplus
+
+#endif // #ifndef __NEXMOTION_PARAM_H
@@ -0,0 +1,2828 @@
+/*!
+ * @file        SimApi.cpp
+ * @brief       NexMotion API (NexMotion.h) implemented on the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimDevice.h"
+#include "SimParamBlob.h"
+#include "SimRuntime.h"
+#include <cstdio>
+#include <cstring>
+
+#ifndef NMC_LIB_VERSION_MAJOR
+#define NMC_LIB_VERSION_MAJOR   1
+#endif
+#ifndef NMC_LIB_VERSION_MINOR
+#define NMC_LIB_VERSION_MINOR   4
+#endif
+#ifndef NMC_LIB_VERSION_BUILD
+#define NMC_LIB_VERSION_BUILD   0
+#endif
+#define NMC_LIB_VERSION_STAGE   5       // Official release
+
+//! Return from an API through the trace function. The device lock must have been released.
+#define NMC_API_RETURN( Func, Ret ) \
+    return nmc::TraceApi( reinterpret_cast<const void *>( &Func ), #Func, ( Ret ) )
+
+using namespace nmc;
+
+namespace
+{
+
+//! Locks taken by DeviceRef, AxisRef and GroupRef.
+enum RefLock_E
+{
+    REF_LOCK_DEVICE = 0,    //!< Command lock and device lock, plus the append lock of an axis or group
+    REF_LOCK_COMMAND,       //!< Command lock only, the object is accessed through atomics
+    REF_LOCK_APPEND,        //!< Append lock of the axis or group only, all of REF_LOCK_DEVICE unless the command can be appended
+    REF_LOCK_NONE,          //!< No lock. An axis or group is only checked against the status snapshot, not accessed
+};
+
+/*!
+ * @brief Locked access to a device for the duration of an API call.
+ *
+ * Error() is set if the device does not exist, or if NeedOperation is set and the device is not in
+ * the operation state. A call which needs the operation state and holds the device lock may change
+ * the status of axes and groups, it is published to the status snapshot when the call returns.
+ */
+class DeviceRef
+{
+public:
+    DeviceRef( I32_T DevID, bool NeedOperation, I32_T Lock = REF_LOCK_DEVICE )
+        : dev_( DeviceFind( DevID ) )
+        , error_( ERR_NEXMOTION_SUCCESS )
+        , publish_( NeedOperation )
+    {
+        if( !dev_ )
+        {
+            error_ = ERR_NEXMOTION_OBJECT_ID_INVALID;
+            return;
+        }
+        if( Lock == REF_LOCK_DEVICE || Lock == REF_LOCK_COMMAND )
+            cmdLock_ = std::unique_lock<std::mutex>( dev_->CommandMutex() );
+        if( Lock == REF_LOCK_DEVICE )
+            lock_ = std::unique_lock<PiMutex>( dev_->Mutex() );
+        if( NeedOperation && !dev_->Operating() )
+            error_ = ERR_NEXMOTION_SYSTEM_NOT_READY;
+    }
+
+    ~DeviceRef()
+    {
+        if( publish_ && lock_.owns_lock() && dev_->Operating() ) dev_->PublishStatus();
+    }
+
+    bool    Ok() const    { return error_ == ERR_NEXMOTION_SUCCESS; }
+    RTN_ERR Error() const { return error_; }
+    Device *Dev() const   { return dev_.get(); }
+    Device *operator->() const { return dev_.get(); }
+
+protected:
+    //! REF_LOCK_APPEND: take the locks of REF_LOCK_DEVICE if the command cannot be appended.
+    void LockDevice( bool NeedOperation )
+    {
+        cmdLock_ = std::unique_lock<std::mutex>( dev_->CommandMutex() );
+        lock_    = std::unique_lock<PiMutex>( dev_->Mutex() );
+        error_   = ( NeedOperation && !dev_->Operating() ) ? ERR_NEXMOTION_SYSTEM_NOT_READY : ERR_NEXMOTION_SUCCESS;
+    }
+
+    std::shared_ptr<Device>      dev_;
+    std::unique_lock<std::mutex> cmdLock_;
+    std::unique_lock<PiMutex>    lock_;
+    RTN_ERR                      error_;
+    bool                         publish_;
+};
+
+//! Locked access to an axis of a device.
+class AxisRef : public DeviceRef
+{
+public:
+    AxisRef( I32_T DevID, I32_T AxisIndex, bool NeedOperation, I32_T Lock = REF_LOCK_DEVICE )
+        : DeviceRef( DevID, NeedOperation, Lock )
+        , index_( AxisIndex )
+        , axis_( 0 )
+        , appendOnly_( false )
+    {
+        if( !dev_ ) return;
+        if( Lock == REF_LOCK_NONE )
+        {
+            // The snapshot holds kMaxAxes axes, reading one beyond a concurrent resize is harmless.
+            if( AxisIndex < 0 || AxisIndex >= dev_->Snapshot().AxisCount() )
+                error_ = ERR_NEXMOTION_OBJECT_ID_INVALID;
+            return;
+        }
+        if( Lock == REF_LOCK_APPEND )
+        {
+            // FindAxis() keeps the axis alive without the command lock, a concurrent resize needs the READY state.
+            hold_ = dev_->FindAxis( AxisIndex );
+            if( hold_ )
+            {
+                appendLock_ = std::unique_lock<PiMutex>( hold_->AppendMutex() );
+                if( Ok() && hold_->Appendable() )
+                {
+                    axis_       = hold_.get();
+                    appendOnly_ = true;
+                    axis_->SetAppendOnly( true );
+                    return;
+                }
+                appendLock_.unlock();
+            }
+            hold_.reset();
+            LockDevice( NeedOperation );
+        }
+        if( AxisIndex < 0 || AxisIndex >= dev_->AxisCount() )
+        {
+            error_ = ERR_NEXMOTION_OBJECT_ID_INVALID;
+            return;
+        }
+        axis_ = &dev_->AxisAt( AxisIndex );
+        if( lock_.owns_lock() )
+            appendLock_ = std::unique_lock<PiMutex>( axis_->AppendMutex() );
+    }
+
+    ~AxisRef()
+    {
+        if( appendOnly_ ) axis_->SetAppendOnly( false );
+    }
+
+    Axis *operator->() const { return axis_; }
+
+    //! Status of the axis published by the last cycle.
+    AxisSnap_T Snap() const
+    {
+        AxisSnap_T snap;
+        dev_->Snapshot().GetAxis( index_, &snap );
+        return snap;
+    }
+
+private:
+    I32_T                        index_;
+    Axis                        *axis_;
+    bool                         appendOnly_;
+    std::shared_ptr<Axis>        hold_;
+    std::unique_lock<PiMutex>    appendLock_;   //!< Released before the locks of DeviceRef
+};
+
+//! Locked access to a group of a device.
+class GroupRef : public DeviceRef
+{
+public:
+    GroupRef( I32_T DevID, I32_T GroupIndex, bool NeedOperation, I32_T Lock = REF_LOCK_DEVICE )
+        : DeviceRef( DevID, NeedOperation, Lock )
+        , index_( GroupIndex )
+        , group_( 0 )
+        , appendOnly_( false )
+    {
+        if( !dev_ ) return;
+        if( Lock == REF_LOCK_NONE )
+        {
+            if( GroupIndex < 0 || GroupIndex >= dev_->Snapshot().GroupCount() )
+                error_ = ERR_NEXMOTION_OBJECT_ID_INVALID;
+            return;
+        }
+        if( Lock == REF_LOCK_APPEND )
+        {
+            hold_ = dev_->FindGroup( GroupIndex );
+            if( hold_ )
+            {
+                appendLock_ = std::unique_lock<PiMutex>( hold_->AppendMutex() );
+                if( Ok() && hold_->Appendable() )
+                {
+                    group_      = hold_.get();
+                    appendOnly_ = true;
+                    group_->SetAppendOnly( true );
+                    return;
+                }
+                appendLock_.unlock();
+            }
+            hold_.reset();
+            LockDevice( NeedOperation );
+        }
+        if( GroupIndex < 0 || GroupIndex >= dev_->GroupCount() )
+        {
+            error_ = ERR_NEXMOTION_OBJECT_ID_INVALID;
+            return;
+        }
+        group_ = &dev_->GroupAt( GroupIndex );
+        if( lock_.owns_lock() )
+            appendLock_ = std::unique_lock<PiMutex>( group_->AppendMutex() );
+    }
+
+    ~GroupRef()
+    {
+        if( appendOnly_ ) group_->SetAppendOnly( false );
+    }
+
+    //! Check a group axis index, return false and set Error() if it is not valid.
+    bool CheckAxis( I32_T GroupAxisIndex )
+    {
+        if( Ok() && ( GroupAxisIndex < 0 || GroupAxisIndex >= group_->AxisCount() ) )
+            error_ = ERR_NEXMOTION_OBJECT_ID_INVALID;
+        return Ok();
+    }
+
+    Group *operator->() const { return group_; }
+
+    //! Status of the group published by the last cycle.
+    GroupSnap_T Snap() const
+    {
+        GroupSnap_T snap;
+        dev_->Snapshot().GetGroup( index_, &snap );
+        return snap;
+    }
+
+private:
+    I32_T                        index_;
+    Group                       *group_;
+    bool                         appendOnly_;
+    std::shared_ptr<Group>       hold_;
+    std::unique_lock<PiMutex>    appendLock_;   //!< Released before the locks of DeviceRef
+};
+
+struct ErrorDesc_T
+{
+    RTN_ERR     code;
+    const char *text;
+};
+
+const ErrorDesc_T kErrorDescs[] =
+{
+    { ERR_NEXMOTION_SUCCESS,                               "The operation completed successfully." },
+    { ERR_NEXMOTION_EXTERNAL_LIBRARY_NOT_FOUND,            "The system cannot find the externel library." },
+    { ERR_NEXMOTION_API_NOT_FOUND,                         "The system cannot find an API address when specified library is loading." },
+    { ERR_NEXMOTION_LOAD_EXTERNAL_LIBRARY_FAILED,          "The system cannot load the externel library." },
+    { ERR_NEXMOTION_LOAD_RUNTIME_FAILED,                   "The system cannot load the runtime library." },
+    { ERR_NEXMOTION_FILE_NOT_FOUND,                        "The system cannot find the specified file." },
+    { ERR_NEXMOTION_FILE_OPEN_FAILED,                      "The system cannot open the specified file." },
+    { ERR_NEXMOTION_FILE_LOAD_FAILED,                      "The system cannot load the specified file." },
+    { ERR_NEXMOTION_FILE_BAD_FORMAT,                       "The format of the file is bad." },
+    { ERR_NEXMOTION_FILE_READ_PROHIBIT,                    "The file cannot be read." },
+    { ERR_NEXMOTION_FILE_WRITE_PROHIBIT,                   "The file cannot be write." },
+    { ERR_NEXMOTION_FILE_VERSION_INCOMPTIBLE,              "The version of the file is incompatible." },
+    { ERR_NEXMOTION_OPENUP_RUNTIME_FAILED,                 "The system cannot openup the runtime, system state error, check devices or network." },
+    { ERR_NEXMOTION_RUNTIME_VERSION_INCOMPTIBLE,           "The version of the runtime is incompatible." },
+    { ERR_NEXMOTION_EXTERNAL_RUNTIME_VERSION_INCOMPTIBLE,  "The version of the runtime (external runtime system) is incompatible." },
+    { ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES,               "The system resources is inefficient." },
+    { ERR_NEXMOTION_EXTERNAL_CALL_FAILED,                  "An external call or system call has made an error." },
+    { ERR_NEXMOTION_SYSTEM_NOT_INITIALIZATION,             "The system cannot be accessed before initialization process." },
+    { ERR_NEXMOTION_SYSTEM_CLOSED_DENIED,                  "The system cannot be closed before clean up process." },
+    { ERR_NEXMOTION_OPERATION_DENIED,                      "In current state, the system cannot accept the operation." },
+    { ERR_NEXMOTION_PERMISSION_DENIED,                     "The user does not have permission." },
+    { ERR_NEXMOTION_UNEXPECTED_EXCEPTION,                  "The operation occurred unexpected exception." },
+    { ERR_NEXMOTION_SYSTEM_NOT_READY,                      "The system is not ready." },
+    { ERR_NEXMOTION_OPERATION_BUSY,                        "The system is busy and cannot accept the operation." },
+    { ERR_NEXMOTION_WAIT_FAILED,                           "The wait function has failed. No wait condition." },
+    { ERR_NEXMOTION_PROCESS_TIMEOUT,                       "System perform current process is timeout." },
+    { ERR_NEXMOTION_RUNTIME_RESPONSE_TIMEOUT,              "Runtime module does not respond in a certain time." },
+    { ERR_NEXMOTION_OBJECT_ID_INVALID,                     "The system cannot find the object through specified [ID], [Index], or [Handle] etc." },
+    { ERR_NEXMOTION_PARAMETER_NUMBER_INVALID,              "The parameter number is invalid." },
+    { ERR_NEXMOTION_PARAMETER_VALUE_INVALID,               "The parameter value is invalid." },
+    { ERR_NEXMOTION_PARAMETER_READ_ONLY,                   "The parameter is read only." },
+    { ERR_NEXMOTION_ACCESS_AREA_INVALID,                   "The operation attempted to access invalid area." },
+    { ERR_NEXMOTION_POINTER_NULL,                          "The input pointer variable is null." },
+    { ERR_NEXMOTION_QUEUE_EMPTY,                           "The queue is empty." },
+    { ERR_NEXMOTION_STRUCT_SIZE_INCOMPTIBLE,               "The size of structure is incomptible." },
+    { ERR_NEXMOTION_INITIAL_AXIS_POSITION_INVALID,         "The initial position of an axis is out of limit." },
+    { ERR_NEXMOTION_INVERSE_KINEMATICS_FAILED,             "Inverse kinematics process is failed." },
+    { ERR_NEXMOTION_INVERSE_KINEMATICS_OVER_AXIS_LIMIT,    "The solution of inverse kinematics is out of limit." },
+    { ERR_NEXMOTION_INVERSE_KINEMATICS_SINGULAR,           "The solution of inverse kinematics is singular." },
+    { ERR_NEXMOTION_KINEMATICS_TYPE_INVALID,               "The type of kinematics is invalid." },
+    { ERR_NEXMOTION_AXIS_COUNT_INVALID,                    "The count of axis is invalid." },
+    { ERR_NEXMOTION_GROUP_COUNT_INVALID,                   "The count of group is invalid." },
+    { ERR_NEXMOTION_AXIS_MAPPING_INVALID,                  "The map setting of the axis is invalid." },
+    { ERR_NEXMOTION_KINEMATICS_PARAMETER_INVALID,          "The kinematics parameter of a group is invalid." },
+    { ERR_NEXMOTION_EMERGENCY_STOP_ACTIVE,                 "Emergency stop signal is detected." },
+    { ERR_NEXMOTION_ENABLE_SWITCH_FULL_PRESSED,            "Enabling switch full pressed signal is detected." },
+    { ERR_NEXMOTION_SAFE_GUARD_ACTIVE,                     "Safe-guard signal is detected." },
+    { ERR_NEXMOTION_SAFETY_ERROR,                          "Safety error is detected." },
+};
+
+RTN_ERR CopyDescription( const std::string &Text, U32_T DescStrSize, char *PRetDesc )
+{
+    if( !PRetDesc )
+        return ERR_NEXMOTION_POINTER_NULL;
+    if( DescStrSize == 0 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    size_t n = std::min( Text.size(), static_cast<size_t>( DescStrSize - 1 ) );
+    std::memcpy( PRetDesc, Text.c_str(), n );
+    PRetDesc[n] = '\0';
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+template <typename T>
+RTN_ERR ReadInputValue( I32_T DevID, U32_T OffsetByte, T *PRetValue )
+{
+    DeviceRef dev( DevID, false );
+    return dev.Ok() ? dev->ReadInput( OffsetByte, sizeof( T ), PRetValue ) : dev.Error();
+}
+
+template <typename T>
+RTN_ERR ReadOutputValue( I32_T DevID, U32_T OffsetByte, T *PRetValue )
+{
+    DeviceRef dev( DevID, false );
+    return dev.Ok() ? dev->ReadOutput( OffsetByte, sizeof( T ), PRetValue ) : dev.Error();
+}
+
+template <typename T>
+RTN_ERR WriteOutputValue( I32_T DevID, U32_T OffsetByte, T Value )
+{
+    DeviceRef dev( DevID, false, REF_LOCK_NONE );
+    return dev.Ok() ? dev->WriteOutput( OffsetByte, sizeof( T ), &Value ) : dev.Error();
+}
+
+RTN_ERR ReadBit( I32_T DevID, bool Output, U32_T OffsetByte, U32_T BitIndex, BOOL_T *PRetBitValue )
+{
+    if( !PRetBitValue )
+        return ERR_NEXMOTION_POINTER_NULL;
+    if( BitIndex > 7 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    U8_T    value;
+    RTN_ERR ret = Output ? ReadOutputValue( DevID, OffsetByte, &value ) : ReadInputValue( DevID, OffsetByte, &value );
+    if( ret == ERR_NEXMOTION_SUCCESS )
+        *PRetBitValue = ( value >> BitIndex ) & 1;
+    return ret;
+}
+
+//! Position of a group snapshot in CoordSys, one of PAcs, PMcs and PPcs.
+RTN_ERR SnapPos( const GroupSnap_T &Snap, I32_T CoordSys, const F64_T *PAcs, const F64_T *PMcs, const F64_T *PPcs, Pos_T *PRetPos )
+{
+    const F64_T *src;
+    switch( CoordSys )
+    {
+    case NMC_COORD_ACS: src = PAcs; break;
+    case NMC_COORD_MCS: src = PMcs; break;
+    case NMC_COORD_PCS:
+        NMC_RETURN_IF_ERR( Snap.pcsError );
+        src = PPcs;
+        break;
+    default:
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    }
+    std::memcpy( PRetPos->pos, src, sizeof( PRetPos->pos ) );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+//! Run Func on every axis and then on every group, stop at the first failure.
+RTN_ERR ForAll( I32_T DevID, bool Axes, bool Groups, RTN_ERR ( Axis::*AxisFunc )(), RTN_ERR ( Group::*GroupFunc )() )
+{
+    DeviceRef dev( DevID, true );
+    if( !dev.Ok() )
+        return dev.Error();
+    AppendLocks appends( *dev.Dev() );
+    for( I32_T i = 0; Axes && i < dev->AxisCount(); ++i )
+        NMC_RETURN_IF_ERR( ( dev->AxisAt( i ).*AxisFunc )() );
+    for( I32_T g = 0; Groups && g < dev->GroupCount(); ++g )
+        NMC_RETURN_IF_ERR( ( dev->GroupAt( g ).*GroupFunc )() );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+//! Build the coordinate mask and position of the 2D (XY) group functions.
+I32_T XyTarget( const F64_T *PX, const F64_T *PY, F64_T PRetPos[kGroupCoords] )
+{
+    std::memset( PRetPos, 0, sizeof( F64_T ) * kGroupCoords );
+    I32_T mask = 0;
+    if( PX ) { PRetPos[0] = *PX; mask |= NMC_GROUP_AXIS_MASK_X; }
+    if( PY ) { PRetPos[1] = *PY; mask |= NMC_GROUP_AXIS_MASK_Y; }
+    return mask;
+}
+
+// Arrays of the group batch functions, Submit( grp, k ) enqueues segment k.
+
+struct LineBatch_T
+{
+    const I32_T *pMask;
+    const Pos_T *pPos;
+    const F64_T *pMaxVel;
+
+    bool    Valid() const { return pMask && pPos; }
+    RTN_ERR Submit( const GroupRef &Grp, I32_T K ) const
+    {
+        return Grp->Line( pMask[K], pPos[K].pos, pMaxVel ? &pMaxVel[K] : 0 );
+    }
+};
+
+struct CircRBatch_T
+{
+    const I32_T *pMask;
+    const Pos_T *pPos;
+    const Xyz_T *pNormal;
+    const F64_T *pRadius;
+    const I32_T *pCwCcw;
+    const F64_T *pMaxVel;
+
+    bool    Valid() const { return pMask && pPos && pNormal && pRadius && pCwCcw; }
+    RTN_ERR Submit( const GroupRef &Grp, I32_T K ) const
+    {
+        return Grp->CircR( pMask[K], pPos[K].pos, pNormal[K].pos, pRadius[K], pCwCcw[K], pMaxVel ? &pMaxVel[K] : 0 );
+    }
+};
+
+struct CircCBatch_T
+{
+    const I32_T *pMask;
+    const Pos_T *pPos;
+    const I32_T *pCenMask;
+    const Xyz_T *pCenOfs;
+    const I32_T *pCwCcw;
+    const F64_T *pMaxVel;
+
+    bool    Valid() const { return pMask && pPos && pCenMask && pCenOfs && pCwCcw; }
+    RTN_ERR Submit( const GroupRef &Grp, I32_T K ) const
+    {
+        return Grp->CircC( pMask[K], pPos[K].pos, pCenMask[K], pCenOfs[K].pos, pCwCcw[K], pMaxVel ? &pMaxVel[K] : 0 );
+    }
+};
+
+struct CircBBatch_T
+{
+    const I32_T *pMask;
+    const Pos_T *pPos;
+    const I32_T *pBorMask;
+    const Xyz_T *pBorPoint;
+    const F64_T *pAngleDeg;
+    const F64_T *pMaxVel;
+
+    bool    Valid() const { return pMask && pPos && pBorMask && pBorPoint; }
+    RTN_ERR Submit( const GroupRef &Grp, I32_T K ) const
+    {
+        return Grp->CircB( pMask[K], pPos[K].pos, pBorMask[K], pBorPoint[K].pos, pAngleDeg ? &pAngleDeg[K] : 0, pMaxVel ? &pMaxVel[K] : 0 );
+    }
+};
+
+/*!
+ * Enqueue Count path segments in order under one group reference, stop at the first rejected segment.
+ * A full motion buffer stops the batch with ERR_NEXMOTION_OPERATION_BUSY, *PRetAccepted tells where
+ * the caller resumes.
+ */
+template <typename Batch>
+RTN_ERR GroupBatch( I32_T DevID, I32_T GroupIndex, I32_T Count, const Batch &Segs, I32_T *PRetAccepted )
+{
+    if( !PRetAccepted )
+        return ERR_NEXMOTION_POINTER_NULL;
+    *PRetAccepted = 0;
+    if( !Segs.Valid() )
+        return ERR_NEXMOTION_POINTER_NULL;
+    if( Count < 0 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    // In append mode every segment is pushed without the device lock, the cycle keeps running.
+    GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+    if( !grp.Ok() )
+        return grp.Error();
+    for( I32_T k = 0; k < Count; ++k )
+    {
+        NMC_RETURN_IF_ERR( Segs.Submit( grp, k ) );
+        ++*PRetAccepted;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+//! Status of an axis or group equal to Value in the bits of Mask.
+class StatusBitsCond : public StatusCondition
+{
+public:
+    StatusBitsCond( bool Group, I32_T Index, I32_T Mask, I32_T Value, I32_T *PRetStatus )
+        : group_( Group ), index_( Index ), mask_( Mask ), value_( Value ), pRetStatus_( PRetStatus ) {}
+
+    bool Test( const StatusSnapshot &Snap, RTN_ERR *PRetErr )
+    {
+        if( index_ < 0 || index_ >= ( group_ ? Snap.GroupCount() : Snap.AxisCount() ) )
+        {
+            *PRetErr = ERR_NEXMOTION_OBJECT_ID_INVALID;
+            return true;
+        }
+        I32_T status;
+        if( group_ )
+        {
+            GroupSnap_T snap;
+            Snap.GetGroup( index_, &snap );
+            status = snap.status;
+        }
+        else
+        {
+            AxisSnap_T snap;
+            Snap.GetAxis( index_, &snap );
+            status = snap.status;
+        }
+        if( pRetStatus_ ) *pRetStatus_ = status;
+        *PRetErr = ERR_NEXMOTION_SUCCESS;
+        return ( status & mask_ ) == ( value_ & mask_ );
+    }
+
+private:
+    bool   group_;
+    I32_T  index_;
+    I32_T  mask_;
+    I32_T  value_;
+    I32_T *pRetStatus_;
+};
+
+//! Group no longer moving, homing or stopping: every buffered motion is done or was aborted.
+class GroupMotionDoneCond : public StatusCondition
+{
+public:
+    GroupMotionDoneCond( I32_T Index, I32_T *PRetState ) : index_( Index ), pRetState_( PRetState ) {}
+
+    bool Test( const StatusSnapshot &Snap, RTN_ERR *PRetErr )
+    {
+        if( index_ < 0 || index_ >= Snap.GroupCount() )
+        {
+            *PRetErr = ERR_NEXMOTION_OBJECT_ID_INVALID;
+            return true;
+        }
+        GroupSnap_T snap;
+        Snap.GetGroup( index_, &snap );
+        if( pRetState_ ) *pRetState_ = snap.state;
+        *PRetErr = ERR_NEXMOTION_SUCCESS;
+        return snap.state != NMC_GROUP_STATE_MOVING && snap.state != NMC_GROUP_STATE_HOMING && snap.state != NMC_GROUP_STATE_STOPPING;
+    }
+
+private:
+    I32_T  index_;
+    I32_T *pRetState_;
+};
+
+//! Wait for a status condition. No lock is held, the other API calls proceed during the wait.
+RTN_ERR WaitStatus( I32_T DevID, StatusCondition &Cond, U32_T WaitMs )
+{
+    std::shared_ptr<Device> dev = DeviceFind( DevID );
+    return dev ? dev->WaitStatus( Cond, WaitMs ) : ERR_NEXMOTION_OBJECT_ID_INVALID;
+}
+
+RTN_ERR ParamTxStage( I32_T DevID, I32_T TxID, I32_T Scope, I32_T Index, I32_T GroupAxisIndex, I32_T ParamNum, I32_T SubIndex, I32_T Type, F64_T Value )
+{
+    ParamTxEntry_T entry;
+    entry.scope          = Scope;
+    entry.index          = Index;
+    entry.groupAxisIndex = GroupAxisIndex;
+    entry.paramNum       = ParamNum;
+    entry.subIndex       = SubIndex;
+    entry.type           = Type;
+    entry.value          = Value;
+    DeviceRef dev( DevID, false, REF_LOCK_COMMAND );
+    return dev.Ok() ? dev->ParamTxStage( TxID, entry ) : dev.Error();
+}
+
+void PoseToCoordTrans( const F64_T PPose[6], CoordTrans_T *PRet )
+{
+    for( I32_T i = 0; i < NMC_MAX_POSE_DATA_SIZE; ++i )
+        PRet->pose[i] = PPose[i];
+}
+
+RTN_ERR ToolTranslation( const Pos_T *P1, const Pos_T *P2, const Pos_T *P3, const Pos_T *P4, F64_T PRetPose[6], F64_T *PRetTolerance )
+{
+    if( !P1 || !P2 || !P3 || !P4 )
+        return ERR_NEXMOTION_POINTER_NULL;
+    F64_T flange[4][6];
+    const Pos_T *points[4] = { P1, P2, P3, P4 };
+    for( I32_T n = 0; n < 4; ++n )
+        std::memcpy( flange[n], points[n]->pos, sizeof( flange[n] ) );
+    std::memset( PRetPose, 0, sizeof( F64_T ) * 6 );
+    return CalibToolTranslation( flange, 4, PRetPose, PRetTolerance );
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////
+//                      Version and error
+/////////////////////////////////////////////////////////////////////
+
+I32_T FNTYPE NMC_GetLibVersion( I32_T *PRetMajor, I32_T *PRetMinor, I32_T *PRetStage, I32_T *PRetBuild )
+{
+    if( PRetMajor ) *PRetMajor = NMC_LIB_VERSION_MAJOR;
+    if( PRetMinor ) *PRetMinor = NMC_LIB_VERSION_MINOR;
+    if( PRetStage ) *PRetStage = NMC_LIB_VERSION_STAGE;
+    if( PRetBuild ) *PRetBuild = NMC_LIB_VERSION_BUILD;
+    TraceApi( reinterpret_cast<const void *>( &NMC_GetLibVersion ), "NMC_GetLibVersion", ERR_NEXMOTION_SUCCESS );
+    return NMC_LIB_VERSION_MAJOR * 10000000 + NMC_LIB_VERSION_MINOR * 100000 + NMC_LIB_VERSION_STAGE * 10000 + NMC_LIB_VERSION_BUILD;
+}
+
+void FNTYPE NMC_GetLibVersionString( char *PRetVersionString, U32_T StringSize )
+{
+    if( PRetVersionString && StringSize > 0 )
+        std::snprintf( PRetVersionString, StringSize, "%d.%d.%d.%d", NMC_LIB_VERSION_MAJOR, NMC_LIB_VERSION_MINOR, NMC_LIB_VERSION_STAGE, NMC_LIB_VERSION_BUILD );
+    TraceApi( reinterpret_cast<const void *>( &NMC_GetLibVersionString ), "NMC_GetLibVersionString", ERR_NEXMOTION_SUCCESS );
+}
+
+const char* FNTYPE NMC_GetErrorDescription( RTN_ERR ErrorCode, char *PRetErrorDesc, U32_T StringSize )
+{
+    const char *text = 0;
+    for( size_t i = 0; i < sizeof( kErrorDescs ) / sizeof( kErrorDescs[0] ); ++i )
+    {
+        if( kErrorDescs[i].code == ErrorCode )
+        {
+            text = kErrorDescs[i].text;
+            break;
+        }
+    }
+    if( PRetErrorDesc && StringSize > 0 )
+    {
+        std::strncpy( PRetErrorDesc, text ? text : "", StringSize - 1 );
+        PRetErrorDesc[StringSize - 1] = '\0';
+    }
+    TraceApi( reinterpret_cast<const void *>( &NMC_GetErrorDescription ), "NMC_GetErrorDescription",
+              text ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_PARAMETER_VALUE_INVALID );
+    return text;
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      Device
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_DeviceOpenUp( I32_T DevType, I32_T DevIndex, I32_T *PRetDevID )
+{
+    NMC_API_RETURN( NMC_DeviceOpenUp, DeviceOpenUp( DevType, DevIndex, 0, PRetDevID ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceShutdown( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_DeviceShutdown, DeviceShutdown( DevID ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceOpenUpRequest( I32_T DevType, I32_T DevIndex )
+{
+    NMC_API_RETURN( NMC_DeviceOpenUpRequest, DeviceOpenUpRequest( DevType, DevIndex, 0 ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceOpenUpRequestEx( I32_T DevType, I32_T DevIndex, I32_T Options )
+{
+    NMC_API_RETURN( NMC_DeviceOpenUpRequestEx, DeviceOpenUpRequest( DevType, DevIndex, Options ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceWaitOpenUpRequest( U32_T WaitMs, I32_T *PRetDevID )
+{
+    NMC_API_RETURN( NMC_DeviceWaitOpenUpRequest, DeviceWaitOpenUpRequest( WaitMs, PRetDevID ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceGetOpenUpProgress( NmcOpenUpProgress_T *PRetProgress )
+{
+    NMC_API_RETURN( NMC_DeviceGetOpenUpProgress, GetOpenUpProgress( PRetProgress ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceShutdownRequest( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_DeviceShutdownRequest, DeviceShutdownRequest( DevID ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceWaitShutdownRequest( I32_T DevID, U32_T WaitMs )
+{
+    NMC_API_RETURN( NMC_DeviceWaitShutdownRequest, DeviceWaitShutdownRequest( DevID, WaitMs ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceWatchdogTimerEnable( I32_T DevID, U32_T TimeoutMs, I32_T Mode )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Ok() ? dev->WatchdogEnable( TimeoutMs, Mode ) : dev.Error();
+    }
+    NMC_API_RETURN( NMC_DeviceWatchdogTimerEnable, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceWatchdogTimerDisable( I32_T DevID )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Ok() ? dev->WatchdogDisable() : dev.Error();
+    }
+    NMC_API_RETURN( NMC_DeviceWatchdogTimerDisable, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceWatchdogTimerReset( I32_T DevID )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Ok() ? dev->WatchdogReset() : dev.Error();
+    }
+    NMC_API_RETURN( NMC_DeviceWatchdogTimerReset, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceCreate( I32_T DevType, I32_T DevIndex, I32_T *PRetDevID )
+{
+    NMC_API_RETURN( NMC_DeviceCreate, DeviceCreate( DevType, DevIndex, PRetDevID ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceDelete( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_DeviceDelete, DeviceDelete( DevID ) );
+}
+
+// The lifecycle functions lock the device themselves.
+
+RTN_ERR FNTYPE NMC_DeviceLoadIniConfig( I32_T DevID )
+{
+    std::shared_ptr<Device> dev = DeviceFind( DevID );
+    NMC_API_RETURN( NMC_DeviceLoadIniConfig, dev ? dev->LoadIniConfig() : ERR_NEXMOTION_OBJECT_ID_INVALID );
+}
+
+RTN_ERR FNTYPE NMC_DeviceResetConfig( I32_T DevID )
+{
+    std::shared_ptr<Device> dev = DeviceFind( DevID );
+    NMC_API_RETURN( NMC_DeviceResetConfig, dev ? dev->ResetConfig() : ERR_NEXMOTION_OBJECT_ID_INVALID );
+}
+
+RTN_ERR FNTYPE NMC_DeviceStart( I32_T DevID )
+{
+    std::shared_ptr<Device> dev = DeviceFind( DevID );
+    NMC_API_RETURN( NMC_DeviceStart, dev ? dev->Start() : ERR_NEXMOTION_OBJECT_ID_INVALID );
+}
+
+RTN_ERR FNTYPE NMC_DeviceStop( I32_T DevID )
+{
+    std::shared_ptr<Device> dev = DeviceFind( DevID );
+    NMC_API_RETURN( NMC_DeviceStop, dev ? dev->Stop() : ERR_NEXMOTION_OBJECT_ID_INVALID );
+}
+
+RTN_ERR FNTYPE NMC_DeviceStartRequest( I32_T DevID )
+{
+    std::shared_ptr<Device> dev = DeviceFind( DevID );
+    NMC_API_RETURN( NMC_DeviceStartRequest, dev ? dev->StartRequest() : ERR_NEXMOTION_OBJECT_ID_INVALID );
+}
+
+RTN_ERR FNTYPE NMC_DeviceStopRequest( I32_T DevID )
+{
+    std::shared_ptr<Device> dev = DeviceFind( DevID );
+    NMC_API_RETURN( NMC_DeviceStopRequest, dev ? dev->StopRequest() : ERR_NEXMOTION_OBJECT_ID_INVALID );
+}
+
+RTN_ERR FNTYPE NMC_DeviceGetState( I32_T DevID, I32_T *PRetDeviceState )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetDeviceState ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetDeviceState = dev->State();
+    }
+    NMC_API_RETURN( NMC_DeviceGetState, ret );
+}
+
+static_assert( kMaxAxes == NMC_MAX_SNAPSHOT_AXES && kMaxGroups == NMC_MAX_SNAPSHOT_GROUPS, "NmcSnapshot_T must hold every axis and group" );
+
+RTN_ERR FNTYPE NMC_DeviceGetSnapshot( I32_T DevID, NmcSnapshot_T *PRetSnapshot )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_NONE );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetSnapshot ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS && PRetSnapshot->sizeOfStruct != sizeof( NmcSnapshot_T ) ) ret = ERR_NEXMOTION_STRUCT_SIZE_INCOMPTIBLE;
+        if( ret == ERR_NEXMOTION_SUCCESS )
+        {
+            const StatusSnapshot &snapshot = dev->Snapshot();
+            AxisSnap_T  axes[kMaxAxes];
+            GroupSnap_T groups[kMaxGroups];
+            U64_T       cycleCount;
+            I64_T       timeNs;
+            I32_T       axisCount, groupCount;
+            snapshot.GetAll( &cycleCount, &timeNs, &axisCount, &groupCount, axes, groups );
+
+            // Transpose the records of the snapshot to the array per field layout of NmcSnapshot_T.
+            NmcSnapshot_T &snap = *PRetSnapshot;
+            std::memset( &snap, 0, sizeof( snap ) );
+            snap.sizeOfStruct = sizeof( snap );
+            snap.axisCount    = axisCount;
+            snap.groupCount   = groupCount;
+            snap.cycleCount   = cycleCount;
+            snap.timestampNs  = static_cast<U64_T>( timeNs );
+            for( I32_T i = 0; i < snap.axisCount; ++i )
+            {
+                snap.axisState[i]  = axes[i].state;
+                snap.axisStatus[i] = axes[i].status;
+                snap.axisCmdPos[i] = axes[i].cmdPos;
+                snap.axisActPos[i] = axes[i].actPos;
+                snap.axisCmdVel[i] = axes[i].cmdVel;
+                snap.axisActVel[i] = axes[i].actVel;
+            }
+            for( I32_T g = 0; g < snap.groupCount; ++g )
+            {
+                snap.groupState[g]  = groups[g].state;
+                snap.groupStatus[g] = groups[g].status;
+                std::memcpy( snap.groupCmdPosAcs[g].pos, groups[g].cmdAcs, sizeof( Pos_T ) );
+                std::memcpy( snap.groupActPosAcs[g].pos, groups[g].actAcs, sizeof( Pos_T ) );
+                std::memcpy( snap.groupCmdVelAcs[g].pos, groups[g].cmdVel, sizeof( Pos_T ) );
+                std::memcpy( snap.groupActVelAcs[g].pos, groups[g].actVel, sizeof( Pos_T ) );
+            }
+        }
+    }
+    NMC_API_RETURN( NMC_DeviceGetSnapshot, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceSubscribeEvents( I32_T DevID, U32_T EventMask, I32_T BuffLowWater, I32_T *PRetFd )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetFd ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->Events().Subscribe( EventMask, BuffLowWater, PRetFd );
+    }
+    NMC_API_RETURN( NMC_DeviceSubscribeEvents, ret );
+}
+
+RTN_ERR FNTYPE NMC_DevicePopEvents( I32_T DevID, I32_T MaxCount, NmcEvent_T *PRetEvents, I32_T *PRetCount )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_COMMAND );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PRetEvents || !PRetCount ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS && MaxCount <= 0 ) ret = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetCount = dev->Events().Pop( PRetEvents, MaxCount );
+    }
+    NMC_API_RETURN( NMC_DevicePopEvents, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceSetParam( I32_T DevID, I32_T ParamNum, I32_T SubIndex, I32_T ParaValue )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Ok() ? dev->SetParam( ParamNum, SubIndex, ParaValue ) : dev.Error();
+    }
+    NMC_API_RETURN( NMC_DeviceSetParam, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceGetParam( I32_T DevID, I32_T ParamNum, I32_T SubIndex, I32_T *PRetParaValue )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetParaValue ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->GetParam( ParamNum, SubIndex, PRetParaValue );
+    }
+    NMC_API_RETURN( NMC_DeviceGetParam, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceParamTxBegin( I32_T DevID, I32_T *PRetTxID )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_COMMAND );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetTxID ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->ParamTxBegin( PRetTxID );
+    }
+    NMC_API_RETURN( NMC_DeviceParamTxBegin, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceParamTxStageI32( I32_T DevID, I32_T TxID, I32_T Scope, I32_T Index, I32_T GroupAxisIndex, I32_T ParamNum, I32_T SubIndex, I32_T ParaValueI32 )
+{
+    RTN_ERR ret = ParamTxStage( DevID, TxID, Scope, Index, GroupAxisIndex, ParamNum, SubIndex, PARAM_TYPE_I32, ParaValueI32 );
+    NMC_API_RETURN( NMC_DeviceParamTxStageI32, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceParamTxStageF64( I32_T DevID, I32_T TxID, I32_T Scope, I32_T Index, I32_T GroupAxisIndex, I32_T ParamNum, I32_T SubIndex, F64_T ParaValueF64 )
+{
+    RTN_ERR ret = ParamTxStage( DevID, TxID, Scope, Index, GroupAxisIndex, ParamNum, SubIndex, PARAM_TYPE_F64, ParaValueF64 );
+    NMC_API_RETURN( NMC_DeviceParamTxStageF64, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceParamTxCommit( I32_T DevID, I32_T TxID, I32_T MaxCount, RTN_ERR *PRetEntryErrors, I32_T *PRetFailedCount )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && PRetEntryErrors && MaxCount < 0 ) ret = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->ParamTxCommit( TxID, MaxCount, PRetEntryErrors, PRetFailedCount );
+    }
+    NMC_API_RETURN( NMC_DeviceParamTxCommit, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceParamTxAbort( I32_T DevID, I32_T TxID )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_COMMAND );
+        ret = dev.Ok() ? dev->ParamTxAbort( TxID ) : dev.Error();
+    }
+    NMC_API_RETURN( NMC_DeviceParamTxAbort, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceExportParams( I32_T DevID, U32_T BufferSize, void *PRetBuffer, U32_T *PRetSizeByte )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetSizeByte ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->ExportParams( BufferSize, PRetBuffer, PRetSizeByte );
+    }
+    NMC_API_RETURN( NMC_DeviceExportParams, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceImportParams( I32_T DevID, U32_T SizeByte, const void *PBuffer, I32_T *PRetChangedCount )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PBuffer ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->ImportParams( PBuffer, SizeByte, PRetChangedCount );
+    }
+    NMC_API_RETURN( NMC_DeviceImportParams, ret );
+}
+
+RTN_ERR FNTYPE NMC_DiffParams( U32_T SizeByteA, const void *PBufferA, U32_T SizeByteB, const void *PBufferB, I32_T MaxCount, NmcParamDiff_T *PRetDiffs, I32_T *PRetDiffCount )
+{
+    RTN_ERR ret = ERR_NEXMOTION_SUCCESS;
+    if( !PBufferA || !PBufferB || !PRetDiffCount ) ret = ERR_NEXMOTION_POINTER_NULL;
+    else if( PRetDiffs && MaxCount < 0 ) ret = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    else ret = ParamBlobDiff( PBufferA, SizeByteA, PBufferB, SizeByteB, MaxCount, PRetDiffs, PRetDiffCount );
+    NMC_API_RETURN( NMC_DiffParams, ret );
+}
+
+RTN_ERR FNTYPE NMC_SetIniPath( const char *PIniPath )
+{
+    ConfigSetIniPath( PIniPath );
+    NMC_API_RETURN( NMC_SetIniPath, ERR_NEXMOTION_SUCCESS );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      I/O memory
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_GetInputMemorySize( I32_T DevID, U32_T *PRetSizeByte )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetSizeByte ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetSizeByte = dev->InputSize();
+    }
+    NMC_API_RETURN( NMC_GetInputMemorySize, ret );
+}
+
+RTN_ERR FNTYPE NMC_GetOutputMemorySize( I32_T DevID, U32_T *PRetSizeByte )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetSizeByte ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetSizeByte = dev->OutputSize();
+    }
+    NMC_API_RETURN( NMC_GetOutputMemorySize, ret );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputMemory( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, void *PRetValue )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Ok() ? dev->ReadInput( OffsetByte, SizeByte, PRetValue ) : dev.Error();
+    }
+    NMC_API_RETURN( NMC_ReadInputMemory, ret );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputMemory( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, void *PRetValue )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Ok() ? dev->ReadOutput( OffsetByte, SizeByte, PRetValue ) : dev.Error();
+    }
+    NMC_API_RETURN( NMC_ReadOutputMemory, ret );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputMemory( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, const void *PValue )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_NONE );
+        ret = dev.Ok() ? dev->WriteOutput( OffsetByte, SizeByte, PValue ) : dev.Error();
+    }
+    NMC_API_RETURN( NMC_WriteOutputMemory, ret );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputMasked( I32_T DevID, U32_T OffsetByte, U32_T SizeByte, const void *PValue, const void *PMask )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_NONE );
+        ret = dev.Ok() ? dev->WriteOutputMasked( OffsetByte, SizeByte, PValue, PMask ) : dev.Error();
+    }
+    NMC_API_RETURN( NMC_WriteOutputMasked, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceGetIoImage( I32_T DevID, NmcIoImage_T *PRetImage )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetImage ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS && PRetImage->sizeOfStruct != sizeof( NmcIoImage_T ) ) ret = ERR_NEXMOTION_STRUCT_SIZE_INCOMPTIBLE;
+        if( ret == ERR_NEXMOTION_SUCCESS && dev->State() == NMC_DEVICE_STATE_INIT ) ret = ERR_NEXMOTION_SYSTEM_NOT_READY;
+        if( ret == ERR_NEXMOTION_SUCCESS )
+        {
+            IoImage &io = dev->Io();
+            PRetImage->inputSize  = io.InputSize();
+            PRetImage->outputSize = io.OutputSize();
+            PRetImage->reserved   = 0;
+            PRetImage->pInput     = io.Input();
+            PRetImage->pOutput    = io.Output();
+            PRetImage->pSequence  = reinterpret_cast<const volatile U32_T *>( &io.Sequence() );
+        }
+    }
+    NMC_API_RETURN( NMC_DeviceGetIoImage, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceSubscribeInputEdge( I32_T DevID, U32_T OffsetByte, U8_T BitMask, I32_T Edge, I32_T *PRetSubID )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetSubID ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS && dev->State() == NMC_DEVICE_STATE_INIT ) ret = ERR_NEXMOTION_SYSTEM_NOT_READY;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->InputEdges().Subscribe( OffsetByte, BitMask, Edge, PRetSubID );
+    }
+    NMC_API_RETURN( NMC_DeviceSubscribeInputEdge, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceUnsubscribeInputEdge( I32_T DevID, I32_T SubID )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Ok() ? dev->InputEdges().Unsubscribe( SubID ) : dev.Error();
+    }
+    NMC_API_RETURN( NMC_DeviceUnsubscribeInputEdge, ret );
+}
+
+RTN_ERR FNTYPE NMC_DevicePopInputEdges( I32_T DevID, I32_T MaxCount, NmcInputEdge_T *PRetEdges, I32_T *PRetCount )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_COMMAND );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PRetEdges || !PRetCount ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS && MaxCount <= 0 ) ret = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetCount = dev->InputEdges().Pop( PRetEdges, MaxCount );
+    }
+    NMC_API_RETURN( NMC_DevicePopInputEdges, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceStartIoCapture( I32_T DevID, I32_T Count, const NmcIoCaptureRange_T *PRanges, const char *PFilePath )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_COMMAND );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PRanges || !PFilePath ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->StartIoCapture( Count, PRanges, PFilePath );
+    }
+    NMC_API_RETURN( NMC_DeviceStartIoCapture, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceStopIoCapture( I32_T DevID )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_COMMAND );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS ) dev->StopIoCapture();
+    }
+    NMC_API_RETURN( NMC_DeviceStopIoCapture, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceGetIoCaptureStatus( I32_T DevID, NmcIoCaptureStatus_T *PRetStatus )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_COMMAND );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetStatus ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) dev->IoCaptureStatus( PRetStatus );
+    }
+    NMC_API_RETURN( NMC_DeviceGetIoCaptureStatus, ret );
+}
+
+RTN_ERR FNTYPE NMC_MemEntryGetCount( I32_T DevID, I32_T Area, I32_T *PRetCount )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetCount ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS && Area != NMC_MEM_ENTRY_AREA_INPUT && Area != NMC_MEM_ENTRY_AREA_OUTPUT ) ret = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetCount = dev->IoEntries().Count( Area );
+    }
+    NMC_API_RETURN( NMC_MemEntryGetCount, ret );
+}
+
+RTN_ERR FNTYPE NMC_MemEntryGetInfo( I32_T DevID, I32_T Area, I32_T Index, MemEntryInfo_T *PRetInfo )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetInfo ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS && Area != NMC_MEM_ENTRY_AREA_INPUT && Area != NMC_MEM_ENTRY_AREA_OUTPUT ) ret = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS && ( Index < 0 || Index >= dev->IoEntries().Count( Area ) ) ) ret = ERR_NEXMOTION_OBJECT_ID_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetInfo = dev->IoEntries().Info( Area, Index );
+    }
+    NMC_API_RETURN( NMC_MemEntryGetInfo, ret );
+}
+
+RTN_ERR FNTYPE NMC_MemEntryFind( I32_T DevID, I32_T Area, const char *PName, I32_T *PRetHandle, MemEntryInfo_T *PRetInfo )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PName || !PRetHandle ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS && Area != NMC_MEM_ENTRY_AREA_INPUT && Area != NMC_MEM_ENTRY_AREA_OUTPUT ) ret = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        I32_T index = 0;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->IoEntries().Find( Area, PName, PRetHandle, &index );
+        if( ret == ERR_NEXMOTION_SUCCESS && PRetInfo ) *PRetInfo = dev->IoEntries().Info( Area, index );
+    }
+    NMC_API_RETURN( NMC_MemEntryFind, ret );
+}
+
+RTN_ERR FNTYPE NMC_MemEntryRead( I32_T DevID, I32_T Handle, void *PRetValue )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetValue ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->ReadEntry( Handle, PRetValue );
+    }
+    NMC_API_RETURN( NMC_MemEntryRead, ret );
+}
+
+RTN_ERR FNTYPE NMC_MemEntryWrite( I32_T DevID, I32_T Handle, const void *PValue )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PValue ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->WriteEntry( Handle, PValue );
+    }
+    NMC_API_RETURN( NMC_MemEntryWrite, ret );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputBit( I32_T DevID, U32_T OffsetByte, U32_T BitIndex, BOOL_T *PRetBitValue )
+{
+    NMC_API_RETURN( NMC_ReadInputBit, ReadBit( DevID, false, OffsetByte, BitIndex, PRetBitValue ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputI8( I32_T DevID, U32_T OffsetByte, I8_T *PRetI8Value )
+{
+    NMC_API_RETURN( NMC_ReadInputI8, ReadInputValue( DevID, OffsetByte, PRetI8Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputI16( I32_T DevID, U32_T OffsetByte, I16_T *PRetI16Value )
+{
+    NMC_API_RETURN( NMC_ReadInputI16, ReadInputValue( DevID, OffsetByte, PRetI16Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputI32( I32_T DevID, U32_T OffsetByte, I32_T *PRetI32Value )
+{
+    NMC_API_RETURN( NMC_ReadInputI32, ReadInputValue( DevID, OffsetByte, PRetI32Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputU8( I32_T DevID, U32_T OffsetByte, U8_T *PRetU8Value )
+{
+    NMC_API_RETURN( NMC_ReadInputU8, ReadInputValue( DevID, OffsetByte, PRetU8Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputU16( I32_T DevID, U32_T OffsetByte, U16_T *PRetU16Value )
+{
+    NMC_API_RETURN( NMC_ReadInputU16, ReadInputValue( DevID, OffsetByte, PRetU16Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputU32( I32_T DevID, U32_T OffsetByte, U32_T *PRetU32Value )
+{
+    NMC_API_RETURN( NMC_ReadInputU32, ReadInputValue( DevID, OffsetByte, PRetU32Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputI64( I32_T DevID, U32_T OffsetByte, I64_T *PRetI64Value )
+{
+    NMC_API_RETURN( NMC_ReadInputI64, ReadInputValue( DevID, OffsetByte, PRetI64Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputU64( I32_T DevID, U32_T OffsetByte, U64_T *PRetU64Value )
+{
+    NMC_API_RETURN( NMC_ReadInputU64, ReadInputValue( DevID, OffsetByte, PRetU64Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputF32( I32_T DevID, U32_T OffsetByte, F32_T *PRetF32Value )
+{
+    NMC_API_RETURN( NMC_ReadInputF32, ReadInputValue( DevID, OffsetByte, PRetF32Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputF64( I32_T DevID, U32_T OffsetByte, F64_T *PRetF64Value )
+{
+    NMC_API_RETURN( NMC_ReadInputF64, ReadInputValue( DevID, OffsetByte, PRetF64Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputBit( I32_T DevID, U32_T OffsetByte, U32_T BitIndex, BOOL_T *PRetBitValue )
+{
+    NMC_API_RETURN( NMC_ReadOutputBit, ReadBit( DevID, true, OffsetByte, BitIndex, PRetBitValue ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputI8( I32_T DevID, U32_T OffsetByte, I8_T *PRetI8Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputI8, ReadOutputValue( DevID, OffsetByte, PRetI8Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputI16( I32_T DevID, U32_T OffsetByte, I16_T *PRetI16Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputI16, ReadOutputValue( DevID, OffsetByte, PRetI16Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputI32( I32_T DevID, U32_T OffsetByte, I32_T *PRetI32Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputI32, ReadOutputValue( DevID, OffsetByte, PRetI32Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputU8( I32_T DevID, U32_T OffsetByte, U8_T *PRetU8Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputU8, ReadOutputValue( DevID, OffsetByte, PRetU8Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputU16( I32_T DevID, U32_T OffsetByte, U16_T *PRetU16Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputU16, ReadOutputValue( DevID, OffsetByte, PRetU16Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputU32( I32_T DevID, U32_T OffsetByte, U32_T *PRetU32Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputU32, ReadOutputValue( DevID, OffsetByte, PRetU32Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputI64( I32_T DevID, U32_T OffsetByte, I64_T *PRetI64Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputI64, ReadOutputValue( DevID, OffsetByte, PRetI64Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputU64( I32_T DevID, U32_T OffsetByte, U64_T *PRetU64Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputU64, ReadOutputValue( DevID, OffsetByte, PRetU64Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputF32( I32_T DevID, U32_T OffsetByte, F32_T *PRetF32Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputF32, ReadOutputValue( DevID, OffsetByte, PRetF32Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputF64( I32_T DevID, U32_T OffsetByte, F64_T *PRetF64Value )
+{
+    NMC_API_RETURN( NMC_ReadOutputF64, ReadOutputValue( DevID, OffsetByte, PRetF64Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputBit( I32_T DevID, U32_T OffsetByte, U32_T BitIndex, BOOL_T BitValue )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_NONE );
+        ret = dev.Ok() ? dev->WriteOutputBit( OffsetByte, BitIndex, BitValue != 0 ) : dev.Error();
+    }
+    NMC_API_RETURN( NMC_WriteOutputBit, ret );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputI8( I32_T DevID, U32_T OffsetByte, I8_T I8Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputI8, WriteOutputValue( DevID, OffsetByte, I8Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputI16( I32_T DevID, U32_T OffsetByte, I16_T I16Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputI16, WriteOutputValue( DevID, OffsetByte, I16Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputI32( I32_T DevID, U32_T OffsetByte, I32_T I32Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputI32, WriteOutputValue( DevID, OffsetByte, I32Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputU8( I32_T DevID, U32_T OffsetByte, U8_T U8Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputU8, WriteOutputValue( DevID, OffsetByte, U8Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputU16( I32_T DevID, U32_T OffsetByte, U16_T U16Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputU16, WriteOutputValue( DevID, OffsetByte, U16Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputU32( I32_T DevID, U32_T OffsetByte, U32_T U32Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputU32, WriteOutputValue( DevID, OffsetByte, U32Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputI64( I32_T DevID, U32_T OffsetByte, I64_T I64Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputI64, WriteOutputValue( DevID, OffsetByte, I64Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputU64( I32_T DevID, U32_T OffsetByte, U64_T U64Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputU64, WriteOutputValue( DevID, OffsetByte, U64Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputF32( I32_T DevID, U32_T OffsetByte, F32_T F32Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputF32, WriteOutputValue( DevID, OffsetByte, F32Value ) );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputF64( I32_T DevID, U32_T OffsetByte, F64_T F64Value )
+{
+    NMC_API_RETURN( NMC_WriteOutputF64, WriteOutputValue( DevID, OffsetByte, F64Value ) );
+}
+
+RTN_ERR FNTYPE NMC_ReadInputGather( I32_T DevID, I32_T Count, const NmcIoItem_T *PItems, NmcIoValue_T *PRetValues )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PItems || !PRetValues ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->GatherInput( Count, PItems, PRetValues );
+    }
+    NMC_API_RETURN( NMC_ReadInputGather, ret );
+}
+
+RTN_ERR FNTYPE NMC_ReadOutputGather( I32_T DevID, I32_T Count, const NmcIoItem_T *PItems, NmcIoValue_T *PRetValues )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PItems || !PRetValues ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->GatherOutput( Count, PItems, PRetValues );
+    }
+    NMC_API_RETURN( NMC_ReadOutputGather, ret );
+}
+
+RTN_ERR FNTYPE NMC_WriteOutputScatter( I32_T DevID, I32_T Count, const NmcIoItem_T *PItems, const NmcIoValue_T *PValues )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_NONE );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PItems || !PValues ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = dev->ScatterOutput( Count, PItems, PValues );
+    }
+    NMC_API_RETURN( NMC_WriteOutputScatter, ret );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      Device axes and groups
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_DeviceGetAxisCount( I32_T DevID, I32_T *PRetAxisCount )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetAxisCount ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetAxisCount = dev->AxisCount();
+    }
+    NMC_API_RETURN( NMC_DeviceGetAxisCount, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceGetGroupCount( I32_T DevID, I32_T *PRetGroupCount )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetGroupCount ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetGroupCount = dev->GroupCount();
+    }
+    NMC_API_RETURN( NMC_DeviceGetGroupCount, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceGetGroupAxisCount( I32_T DevID, I32_T GroupIndex, I32_T *PRetGroupAxisCount )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetGroupAxisCount ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetGroupAxisCount = grp->AxisCount();
+    }
+    NMC_API_RETURN( NMC_DeviceGetGroupAxisCount, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetDescription( I32_T DevID, I32_T AxisIndex, U32_T DescStrSize, char *PRetAxisDescription )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Ok() ? CopyDescription( ax->Description(), DescStrSize, PRetAxisDescription ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisGetDescription, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetDescription( I32_T DevID, I32_T GroupIndex, U32_T DescStrSize, char *PRetGroupDescription )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Ok() ? CopyDescription( grp->Description(), DescStrSize, PRetGroupDescription ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupGetDescription, ret );
+}
+
+RTN_ERR FNTYPE NMC_DeviceResetStateAll( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_DeviceResetStateAll, ForAll( DevID, true, true, &Axis::ResetState, &Group::ResetState ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceEnableAll( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_DeviceEnableAll, ForAll( DevID, true, true, &Axis::Enable, &Group::Enable ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceDisableAll( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_DeviceDisableAll, ForAll( DevID, true, true, &Axis::Disable, &Group::Disable ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceHaltAll( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_DeviceHaltAll, ForAll( DevID, true, true, &Axis::Halt, &Group::Halt ) );
+}
+
+RTN_ERR FNTYPE NMC_DeviceStopAll( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_DeviceStopAll, ForAll( DevID, true, true, &Axis::Stop, &Group::Stop ) );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      Axis
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_AxisSetParamI32( I32_T DevID, I32_T AxisIndex, I32_T ParamNum, I32_T SubIndex, I32_T ParaValueI32 )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Ok() ? ax->Params().SetI32( ParamNum, SubIndex, ParaValueI32, ax.Dev()->Operating() ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisSetParamI32, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetParamI32( I32_T DevID, I32_T AxisIndex, I32_T ParamNum, I32_T SubIndex, I32_T *PRetParaValueI32 )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetParaValueI32 ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = ax->Params().GetI32( ParamNum, SubIndex, PRetParaValueI32 );
+    }
+    NMC_API_RETURN( NMC_AxisGetParamI32, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisSetParamF64( I32_T DevID, I32_T AxisIndex, I32_T ParamNum, I32_T SubIndex, F64_T ParaValueF64 )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Ok() ? ax->Params().SetF64( ParamNum, SubIndex, ParaValueF64, ax.Dev()->Operating() ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisSetParamF64, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetParamF64( I32_T DevID, I32_T AxisIndex, I32_T ParamNum, I32_T SubIndex, F64_T *PRetParaValueF64 )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetParaValueF64 ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = ax->Params().GetF64( ParamNum, SubIndex, PRetParaValueF64 );
+    }
+    NMC_API_RETURN( NMC_AxisGetParamF64, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisEnable( I32_T DevID, I32_T AxisIndex )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->Enable() : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisEnable, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisDisable( I32_T DevID, I32_T AxisIndex )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->Disable() : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisDisable, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetStatus( I32_T DevID, I32_T AxisIndex, I32_T *PRetAxisStatus )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false, REF_LOCK_NONE );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetAxisStatus ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetAxisStatus = ax.Snap().status;
+    }
+    NMC_API_RETURN( NMC_AxisGetStatus, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisWaitStatus( I32_T DevID, I32_T AxisIndex, I32_T StatusMask, I32_T StatusValue, U32_T WaitMs, I32_T *PRetAxisStatus )
+{
+    RTN_ERR ret;
+    {
+        StatusBitsCond cond( false, AxisIndex, StatusMask, StatusValue, PRetAxisStatus );
+        ret = WaitStatus( DevID, cond, WaitMs );
+    }
+    NMC_API_RETURN( NMC_AxisWaitStatus, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetState( I32_T DevID, I32_T AxisIndex, I32_T *PRetAxisState )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false, REF_LOCK_NONE );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetAxisState ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetAxisState = ax.Snap().state;
+    }
+    NMC_API_RETURN( NMC_AxisGetState, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisResetState( I32_T DevID, I32_T AxisIndex )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->ResetState() : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisResetState, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisResetDriveAlm( I32_T DevID, I32_T AxisIndex )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->ResetDriveAlm() : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisResetDriveAlm, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetDriveAlmCode( I32_T DevID, I32_T AxisIndex, I32_T *PRetAlmCode )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetAlmCode ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetAlmCode = ax->DriveAlmCode();
+    }
+    NMC_API_RETURN( NMC_AxisGetDriveAlmCode, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetCommandPos( I32_T DevID, I32_T AxisIndex, F64_T *PRetCmdPos )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false, REF_LOCK_NONE );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetCmdPos ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetCmdPos = ax.Snap().cmdPos;
+    }
+    NMC_API_RETURN( NMC_AxisGetCommandPos, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetActualPos( I32_T DevID, I32_T AxisIndex, F64_T *PRetActPos )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false, REF_LOCK_NONE );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetActPos ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetActPos = ax.Snap().actPos;
+    }
+    NMC_API_RETURN( NMC_AxisGetActualPos, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetCommandVel( I32_T DevID, I32_T AxisIndex, F64_T *PRetCmdVel )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false, REF_LOCK_NONE );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetCmdVel ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetCmdVel = ax.Snap().cmdVel;
+    }
+    NMC_API_RETURN( NMC_AxisGetCommandVel, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetActualVel( I32_T DevID, I32_T AxisIndex, F64_T *PRetActVel )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false, REF_LOCK_NONE );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetActVel ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetActVel = ax.Snap().actVel;
+    }
+    NMC_API_RETURN( NMC_AxisGetActualVel, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetMotionBuffSpace( I32_T DevID, I32_T AxisIndex, I32_T *PRetFreeSpace )
+{
+    RTN_ERR ret;
+    {
+        // The indexes of the motion buffer are atomic, the axis is only kept alive.
+        DeviceRef dev( DevID, false, REF_LOCK_NONE );
+        std::shared_ptr<Axis> axis = dev.Ok() ? dev->FindAxis( AxisIndex ) : std::shared_ptr<Axis>();
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !axis ) ret = ERR_NEXMOTION_OBJECT_ID_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetFreeSpace ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetFreeSpace = axis->BuffSpace();
+    }
+    NMC_API_RETURN( NMC_AxisGetMotionBuffSpace, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisPtp( I32_T DevID, I32_T AxisIndex, F64_T TargetPos, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true, REF_LOCK_APPEND );
+        ret = ax.Ok() ? ax->Ptp( TargetPos, PMaxVel ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisPtp, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisPtpBatch( I32_T DevID, I32_T Count, const I32_T *PAxisIndex, const F64_T *PTargetPos, const F64_T *PMaxVel, RTN_ERR *PRetErrors )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, true );
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PAxisIndex || !PTargetPos ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS && ( Count <= 0 || Count > dev->AxisCount() ) ) ret = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS )
+        {
+            // Check every entry first, then submit all of them under the same device lock: the
+            // motions which start immediately are started by the same cycle.
+            AppendLocks appends( *dev.Dev() );
+            AxisCmd_T cmds[kMaxAxes];
+            bool      used[kMaxAxes] = { false };
+            for( I32_T k = 0; k < Count; ++k )
+            {
+                I32_T   index = PAxisIndex[k];
+                RTN_ERR err;
+                if( index < 0 || index >= dev->AxisCount() )
+                    err = ERR_NEXMOTION_OBJECT_ID_INVALID;
+                else if( used[index] )
+                    err = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+                else
+                    err = dev->AxisAt( index ).PreparePtp( PTargetPos[k], PMaxVel ? &PMaxVel[k] : 0, &cmds[k] );
+                if( index >= 0 && index < dev->AxisCount() ) used[index] = true;
+                if( PRetErrors ) PRetErrors[k] = err;
+                if( ret == ERR_NEXMOTION_SUCCESS ) ret = err;
+            }
+            for( I32_T k = 0; k < Count && ret == ERR_NEXMOTION_SUCCESS; ++k )
+            {
+                RTN_ERR err = dev->AxisAt( PAxisIndex[k] ).SubmitPtp( cmds[k], PMaxVel ? &PMaxVel[k] : 0 );
+                if( PRetErrors ) PRetErrors[k] = err;
+                if( err != ERR_NEXMOTION_SUCCESS ) ret = err;
+            }
+        }
+    }
+    NMC_API_RETURN( NMC_AxisPtpBatch, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisJog( I32_T DevID, I32_T AxisIndex, I32_T Dir, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->Jog( Dir, PMaxVel ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisJog, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisSetHomePos( I32_T DevID, I32_T AxisIndex, F64_T HomePos )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Ok() ? ax->SetHomePos( HomePos ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisSetHomePos, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisHomeDrive( I32_T DevID, I32_T AxisIndex )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->HomeDrive() : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisHomeDrive, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisHalt( I32_T DevID, I32_T AxisIndex )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->Halt() : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisHalt, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisStop( I32_T DevID, I32_T AxisIndex )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->Stop() : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisStop, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisHaltAll( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_AxisHaltAll, ForAll( DevID, true, false, &Axis::Halt, &Group::Halt ) );
+}
+
+RTN_ERR FNTYPE NMC_AxisStopAll( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_AxisStopAll, ForAll( DevID, true, false, &Axis::Stop, &Group::Stop ) );
+}
+
+RTN_ERR FNTYPE NMC_AxisVelOverride( I32_T DevID, I32_T AxisIndex, F64_T TargetVel )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->VelOverride( TargetVel ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisVelOverride, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisAccOverride( I32_T DevID, I32_T AxisIndex, F64_T TargetAcc )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->AccOverride( TargetAcc ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisAccOverride, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisDecOverride( I32_T DevID, I32_T AxisIndex, F64_T TargetDec )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, true );
+        ret = ax.Ok() ? ax->DecOverride( TargetDec ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisDecOverride, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisSetSpeedRatio( I32_T DevID, I32_T AxisIndex, F64_T Percentage )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Ok() ? ax->SetSpeedRatio( Percentage ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisSetSpeedRatio, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetSpeedRatio( I32_T DevID, I32_T AxisIndex, F64_T *PPercentage )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PPercentage ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PPercentage = ax->SpeedRatio();
+    }
+    NMC_API_RETURN( NMC_AxisGetSpeedRatio, ret );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      Group parameters
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_GroupSetParamI32( I32_T DevID, I32_T GroupIndex, I32_T ParamNum, I32_T SubIndex, I32_T ParaValueI32 )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Ok() ? grp->Params().SetI32( ParamNum, SubIndex, ParaValueI32, grp.Dev()->Operating() ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupSetParamI32, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetParamI32( I32_T DevID, I32_T GroupIndex, I32_T ParamNum, I32_T SubIndex, I32_T *PRetParaValueI32 )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetParaValueI32 ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->Params().GetI32( ParamNum, SubIndex, PRetParaValueI32 );
+    }
+    NMC_API_RETURN( NMC_GroupGetParamI32, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupSetParamF64( I32_T DevID, I32_T GroupIndex, I32_T ParamNum, I32_T SubIndex, F64_T ParaValueF64 )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Ok() ? grp->Params().SetF64( ParamNum, SubIndex, ParaValueF64, grp.Dev()->Operating() ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupSetParamF64, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetParamF64( I32_T DevID, I32_T GroupIndex, I32_T ParamNum, I32_T SubIndex, F64_T *PRetParaValueF64 )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetParaValueF64 ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->Params().GetF64( ParamNum, SubIndex, PRetParaValueF64 );
+    }
+    NMC_API_RETURN( NMC_GroupGetParamF64, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupAxSetParamI32( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex, I32_T ParamNum, I32_T SubIndex, I32_T ParaValueI32 )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.CheckAxis( GroupAxisIndex )
+            ? grp->AxisParams( GroupAxisIndex ).SetI32( ParamNum, SubIndex, ParaValueI32, grp.Dev()->Operating() )
+            : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupAxSetParamI32, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupAxGetParamI32( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex, I32_T ParamNum, I32_T SubIndex, I32_T *PRetParaValueI32 )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.CheckAxis( GroupAxisIndex ) ? ERR_NEXMOTION_SUCCESS : grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetParaValueI32 ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->AxisParams( GroupAxisIndex ).GetI32( ParamNum, SubIndex, PRetParaValueI32 );
+    }
+    NMC_API_RETURN( NMC_GroupAxGetParamI32, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupAxSetParamF64( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex, I32_T ParamNum, I32_T SubIndex, F64_T ParaValueF64 )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.CheckAxis( GroupAxisIndex )
+            ? grp->AxisParams( GroupAxisIndex ).SetF64( ParamNum, SubIndex, ParaValueF64, grp.Dev()->Operating() )
+            : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupAxSetParamF64, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupAxGetParamF64( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex, I32_T ParamNum, I32_T SubIndex, F64_T *PRetParaValueF64 )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.CheckAxis( GroupAxisIndex ) ? ERR_NEXMOTION_SUCCESS : grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetParaValueF64 ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->AxisParams( GroupAxisIndex ).GetF64( ParamNum, SubIndex, PRetParaValueF64 );
+    }
+    NMC_API_RETURN( NMC_GroupAxGetParamF64, ret );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      Group state and status
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_GroupEnable( I32_T DevID, I32_T GroupIndex )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.Ok() ? grp->Enable() : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupEnable, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupDisable( I32_T DevID, I32_T GroupIndex )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.Ok() ? grp->Disable() : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupDisable, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetStatus( I32_T DevID, I32_T GroupIndex, I32_T *PRetStatusInBit )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false, REF_LOCK_NONE );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetStatusInBit ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetStatusInBit = grp.Snap().status;
+    }
+    NMC_API_RETURN( NMC_GroupGetStatus, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupWaitStatus( I32_T DevID, I32_T GroupIndex, I32_T StatusMask, I32_T StatusValue, U32_T WaitMs, I32_T *PRetStatusInBit )
+{
+    RTN_ERR ret;
+    {
+        StatusBitsCond cond( true, GroupIndex, StatusMask, StatusValue, PRetStatusInBit );
+        ret = WaitStatus( DevID, cond, WaitMs );
+    }
+    NMC_API_RETURN( NMC_GroupWaitStatus, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupWaitMotionDone( I32_T DevID, I32_T GroupIndex, U32_T WaitMs, I32_T *PRetState )
+{
+    RTN_ERR ret;
+    {
+        GroupMotionDoneCond cond( GroupIndex, PRetState );
+        ret = WaitStatus( DevID, cond, WaitMs );
+    }
+    NMC_API_RETURN( NMC_GroupWaitMotionDone, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetState( I32_T DevID, I32_T GroupIndex, I32_T *PRetState )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false, REF_LOCK_NONE );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetState ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetState = grp.Snap().state;
+    }
+    NMC_API_RETURN( NMC_GroupGetState, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupResetState( I32_T DevID, I32_T GroupIndex )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.Ok() ? grp->ResetState() : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupResetState, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupResetDriveAlm( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex )
+{
+    RTN_ERR ret;
+    {
+        // The simulated drives never raise an alarm.
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.CheckAxis( GroupAxisIndex ) ? ERR_NEXMOTION_SUCCESS : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupResetDriveAlm, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupResetDriveAlmAll( I32_T DevID, I32_T GroupIndex )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupResetDriveAlmAll, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetDriveAlmCode( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex, I32_T *PRetAlmCode )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.CheckAxis( GroupAxisIndex ) ? ERR_NEXMOTION_SUCCESS : grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetAlmCode ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetAlmCode = 0;
+    }
+    NMC_API_RETURN( NMC_GroupGetDriveAlmCode, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupSetSpeedRatio( I32_T DevID, I32_T GroupIndex, F64_T Percentage )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Ok() ? grp->SetSpeedRatio( Percentage ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupSetSpeedRatio, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetSpeedRatio( I32_T DevID, I32_T GroupIndex, F64_T *PRetPercentage )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetPercentage ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetPercentage = grp->SpeedRatio();
+    }
+    NMC_API_RETURN( NMC_GroupGetSpeedRatio, ret );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      Group motion
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_GroupPtpAcs( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex, F64_T AcsPos, const F64_T *PAcsMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        if( grp.CheckAxis( GroupAxisIndex ) )
+        {
+            F64_T acs[kGroupCoords] = { 0.0 };
+            acs[GroupAxisIndex] = AcsPos;
+            ret = grp->PtpAcs( 1 << GroupAxisIndex, acs, GroupAxisIndex, PAcsMaxVel );
+        }
+        else
+        {
+            ret = grp.Error();
+        }
+    }
+    NMC_API_RETURN( NMC_GroupPtpAcs, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupPtpAcsAll( I32_T DevID, I32_T GroupIndex, I32_T GroupAxesIdxMask, const Pos_T *PAcsPos )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PAcsPos ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->PtpAcs( GroupAxesIdxMask, PAcsPos->pos, 0, 0 );
+    }
+    NMC_API_RETURN( NMC_GroupPtpAcsAll, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupJogAcs( I32_T DevID, I32_T GroupIndex, I32_T GroupAxisIndex, I32_T Dir, const F64_T *PAcsMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.CheckAxis( GroupAxisIndex ) ? grp->JogAcs( GroupAxisIndex, Dir, PAcsMaxVel ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupJogAcs, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupJogTcpFrame( I32_T DevID, I32_T GroupIndex, I32_T CartAxis, I32_T Dir, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.Ok() ? grp->JogCart( GROUP_JOG_FRAME_TCP, CartAxis, Dir, PMaxVel ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupJogTcpFrame, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupJogPcsFrame( I32_T DevID, I32_T GroupIndex, I32_T CartAxis, I32_T Dir, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.Ok() ? grp->JogCart( GROUP_JOG_FRAME_PCS, CartAxis, Dir, PMaxVel ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupJogPcsFrame, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupPtpCart( I32_T DevID, I32_T GroupIndex, I32_T CartAxis, F64_T CartPos )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( CartAxis < 0 || CartAxis >= kGroupCoords ) ) ret = ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS )
+        {
+            F64_T pos[kGroupCoords] = { 0.0 };
+            pos[CartAxis] = CartPos;
+            ret = grp->PtpCart( 1 << CartAxis, pos );
+        }
+    }
+    NMC_API_RETURN( NMC_GroupPtpCart, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupPtpCartAll( I32_T DevID, I32_T GroupIndex, I32_T CartAxesMask, const Pos_T *PTargetPos )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PTargetPos ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->PtpCart( CartAxesMask, PTargetPos->pos );
+    }
+    NMC_API_RETURN( NMC_GroupPtpCartAll, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupHalt( I32_T DevID, I32_T GroupIndex )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.Ok() ? grp->Halt() : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupHalt, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupStop( I32_T DevID, I32_T GroupIndex )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.Ok() ? grp->Stop() : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupStop, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupHaltAll( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_GroupHaltAll, ForAll( DevID, false, true, &Axis::Halt, &Group::Halt ) );
+}
+
+RTN_ERR FNTYPE NMC_GroupStopAll( I32_T DevID )
+{
+    NMC_API_RETURN( NMC_GroupStopAll, ForAll( DevID, false, true, &Axis::Stop, &Group::Stop ) );
+}
+
+// Group position read functions
+
+RTN_ERR FNTYPE NMC_GroupGetCommandPosAcs( I32_T DevID, I32_T GroupIndex, Pos_T *PRetCmdPosAcs )
+{
+    return NMC_GroupGetCommandPos( DevID, GroupIndex, NMC_COORD_ACS, PRetCmdPosAcs );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetActualPosAcs( I32_T DevID, I32_T GroupIndex, Pos_T *PRetActPosAcs )
+{
+    return NMC_GroupGetActualPos( DevID, GroupIndex, NMC_COORD_ACS, PRetActPosAcs );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetCommandPosPcs( I32_T DevID, I32_T GroupIndex, Pos_T *PRetCmdPosPcs )
+{
+    return NMC_GroupGetCommandPos( DevID, GroupIndex, NMC_COORD_PCS, PRetCmdPosPcs );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetActualPosPcs( I32_T DevID, I32_T GroupIndex, Pos_T *PRetActPosPcs )
+{
+    return NMC_GroupGetActualPos( DevID, GroupIndex, NMC_COORD_PCS, PRetActPosPcs );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetCommandPos( I32_T DevID, I32_T GroupIndex, I32_T CoordSys, Pos_T *PRetCmdPos )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false, REF_LOCK_NONE );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetCmdPos ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS )
+        {
+            GroupSnap_T snap = grp.Snap();
+            ret = SnapPos( snap, CoordSys, snap.cmdAcs, snap.cmdMcs, snap.cmdPcs, PRetCmdPos );
+        }
+    }
+    NMC_API_RETURN( NMC_GroupGetCommandPos, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetActualPos( I32_T DevID, I32_T GroupIndex, I32_T CoordSys, Pos_T *PRetActPos )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false, REF_LOCK_NONE );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetActPos ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS )
+        {
+            GroupSnap_T snap = grp.Snap();
+            ret = SnapPos( snap, CoordSys, snap.actAcs, snap.actMcs, snap.actPcs, PRetActPos );
+        }
+    }
+    NMC_API_RETURN( NMC_GroupGetActualPos, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetMotionBuffSpace( I32_T DevID, I32_T GroupIndex, I32_T *PRetFreeSpace )
+{
+    RTN_ERR ret;
+    {
+        DeviceRef dev( DevID, false, REF_LOCK_NONE );
+        std::shared_ptr<Group> group = dev.Ok() ? dev->FindGroup( GroupIndex ) : std::shared_ptr<Group>();
+        ret = dev.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !group ) ret = ERR_NEXMOTION_OBJECT_ID_INVALID;
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetFreeSpace ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetFreeSpace = group->BuffSpace();
+    }
+    NMC_API_RETURN( NMC_GroupGetMotionBuffSpace, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupSetHomePos( I32_T DevID, I32_T GroupIndex, I32_T GroupAxesIdxMask, const Pos_T *PHomePosAcs )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PHomePosAcs ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->SetHomePos( GroupAxesIdxMask, PHomePosAcs->pos );
+    }
+    NMC_API_RETURN( NMC_GroupSetHomePos, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupAxesHomeDrive( I32_T DevID, I32_T GroupIndex, I32_T GroupAxesIdxMask )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true );
+        ret = grp.Ok() ? grp->HomeDrive( GroupAxesIdxMask ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupAxesHomeDrive, ret );
+}
+
+// 2D interpolation on the XY plane
+
+RTN_ERR FNTYPE NMC_GroupLineXY( I32_T DevID, I32_T GroupIndex, const F64_T *PX, const F64_T *PY, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        F64_T pos[kGroupCoords];
+        I32_T mask = XyTarget( PX, PY, pos );
+        ret = grp.Ok() ? grp->Line( mask, pos, PMaxVel ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupLineXY, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCirc2R( I32_T DevID, I32_T GroupIndex, const F64_T *PEX, const F64_T *PEY, F64_T Radius, I32_T CW_CCW, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        const F64_T normal[3] = { 0.0, 0.0, 1.0 };
+        F64_T pos[kGroupCoords];
+        I32_T mask = XyTarget( PEX, PEY, pos );
+        ret = grp.Ok() ? grp->CircR( mask, pos, normal, Radius, CW_CCW, PMaxVel ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupCirc2R, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCirc2C( I32_T DevID, I32_T GroupIndex, const F64_T *PEX, const F64_T *PEY, const F64_T *PCXOffset, const F64_T *PCYOffset, I32_T CW_CCW, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        F64_T pos[kGroupCoords], cen[kGroupCoords];
+        I32_T mask    = XyTarget( PEX, PEY, pos );
+        I32_T cenMask = XyTarget( PCXOffset, PCYOffset, cen );
+        ret = grp.Ok() ? grp->CircC( mask, pos, cenMask, cen, CW_CCW, PMaxVel ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupCirc2C, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCirc2B( I32_T DevID, I32_T GroupIndex, const F64_T *PEX, const F64_T *PEY, const F64_T *PBX, const F64_T *PBY, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        F64_T pos[kGroupCoords], bor[kGroupCoords];
+        I32_T mask    = XyTarget( PEX, PEY, pos );
+        I32_T borMask = XyTarget( PBX, PBY, bor );
+        ret = grp.Ok() ? grp->CircB( mask, pos, borMask, bor, 0, PMaxVel ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupCirc2B, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCirc2BEx( I32_T DevID, I32_T GroupIndex, const F64_T *PEX, const F64_T *PEY, const F64_T *PBX, const F64_T *PBY, const F64_T *PAngleDeg, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        F64_T pos[kGroupCoords], bor[kGroupCoords];
+        I32_T mask    = XyTarget( PEX, PEY, pos );
+        I32_T borMask = XyTarget( PBX, PBY, bor );
+        ret = grp.Ok() ? grp->CircB( mask, pos, borMask, bor, PAngleDeg, PMaxVel ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupCirc2BEx, ret );
+}
+
+// 3D interpolation
+
+RTN_ERR FNTYPE NMC_GroupLine( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask, const Pos_T *PCartPos, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PCartPos ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->Line( CartAxisMask, PCartPos->pos, PMaxVel );
+    }
+    NMC_API_RETURN( NMC_GroupLine, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCircR( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask, const Pos_T *PCartPos, const Xyz_T *PNormalVector, F64_T Radius, I32_T CW_CCW, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PCartPos || !PNormalVector ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->CircR( CartAxisMask, PCartPos->pos, PNormalVector->pos, Radius, CW_CCW, PMaxVel );
+    }
+    NMC_API_RETURN( NMC_GroupCircR, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCircC( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask, const Pos_T *PCartPos, I32_T CenOfsMask, const Xyz_T *PCenOfs, I32_T CW_CCW, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PCartPos || !PCenOfs ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->CircC( CartAxisMask, PCartPos->pos, CenOfsMask, PCenOfs->pos, CW_CCW, PMaxVel );
+    }
+    NMC_API_RETURN( NMC_GroupCircC, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCircB( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask, const Pos_T *PCartPos, I32_T BorPosMask, const Xyz_T *PBorPoint, const F64_T *PMaxVel )
+{
+    return NMC_GroupCircBEx( DevID, GroupIndex, CartAxisMask, PCartPos, BorPosMask, PBorPoint, 0, PMaxVel );
+}
+
+RTN_ERR FNTYPE NMC_GroupCircBEx( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask, const Pos_T *PCartPos, I32_T BorPosMask, const Xyz_T *PBorPoint, const F64_T *PAngleDeg, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && ( !PCartPos || !PBorPoint ) ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->CircB( CartAxisMask, PCartPos->pos, BorPosMask, PBorPoint->pos, PAngleDeg, PMaxVel );
+    }
+    NMC_API_RETURN( NMC_GroupCircBEx, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupLineBatch( I32_T DevID, I32_T GroupIndex, I32_T Count, const I32_T *PCartAxisMask, const Pos_T *PCartPos, const F64_T *PMaxVel, I32_T *PRetAccepted )
+{
+    RTN_ERR ret;
+    {
+        LineBatch_T segs = { PCartAxisMask, PCartPos, PMaxVel };
+        ret = GroupBatch( DevID, GroupIndex, Count, segs, PRetAccepted );
+    }
+    NMC_API_RETURN( NMC_GroupLineBatch, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCircRBatch( I32_T DevID, I32_T GroupIndex, I32_T Count, const I32_T *PCartAxisMask, const Pos_T *PCartPos, const Xyz_T *PNormalVector, const F64_T *PRadius, const I32_T *PCW_CCW, const F64_T *PMaxVel, I32_T *PRetAccepted )
+{
+    RTN_ERR ret;
+    {
+        CircRBatch_T segs = { PCartAxisMask, PCartPos, PNormalVector, PRadius, PCW_CCW, PMaxVel };
+        ret = GroupBatch( DevID, GroupIndex, Count, segs, PRetAccepted );
+    }
+    NMC_API_RETURN( NMC_GroupCircRBatch, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCircCBatch( I32_T DevID, I32_T GroupIndex, I32_T Count, const I32_T *PCartAxisMask, const Pos_T *PCartPos, const I32_T *PCenOfsMask, const Xyz_T *PCenOfs, const I32_T *PCW_CCW, const F64_T *PMaxVel, I32_T *PRetAccepted )
+{
+    RTN_ERR ret;
+    {
+        CircCBatch_T segs = { PCartAxisMask, PCartPos, PCenOfsMask, PCenOfs, PCW_CCW, PMaxVel };
+        ret = GroupBatch( DevID, GroupIndex, Count, segs, PRetAccepted );
+    }
+    NMC_API_RETURN( NMC_GroupCircCBatch, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupCircBBatch( I32_T DevID, I32_T GroupIndex, I32_T Count, const I32_T *PCartAxisMask, const Pos_T *PCartPos, const I32_T *PBorPosMask, const Xyz_T *PBorPoint, const F64_T *PAngleDeg, const F64_T *PMaxVel, I32_T *PRetAccepted )
+{
+    RTN_ERR ret;
+    {
+        CircBBatch_T segs = { PCartAxisMask, PCartPos, PBorPosMask, PBorPoint, PAngleDeg, PMaxVel };
+        ret = GroupBatch( DevID, GroupIndex, Count, segs, PRetAccepted );
+    }
+    NMC_API_RETURN( NMC_GroupCircBBatch, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupSpline( I32_T DevID, I32_T GroupIndex, I32_T CartAxisMask, I32_T Degree, I32_T Count, const Pos_T *PCtrlPos, const F64_T *PKnots, const F64_T *PWeights, const F64_T *PMaxVel )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, true, REF_LOCK_APPEND );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PCtrlPos ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) ret = grp->Spline( CartAxisMask, Degree, Count, PCtrlPos, PKnots, PWeights, PMaxVel );
+    }
+    NMC_API_RETURN( NMC_GroupSpline, ret );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      Tool and base calibration
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_ToolCalib_4p( const Pos_T *PMcsKinP1, const Pos_T *PMcsKinP2, const Pos_T *PMcsKinP3, const Pos_T *PMcsKinP4, CoordTrans_T *PRetToolCoordTrans, F64_T *PRetTolerance )
+{
+    RTN_ERR ret = PRetToolCoordTrans ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_POINTER_NULL;
+    F64_T   pose[6];
+    if( ret == ERR_NEXMOTION_SUCCESS ) ret = ToolTranslation( PMcsKinP1, PMcsKinP2, PMcsKinP3, PMcsKinP4, pose, PRetTolerance );
+    if( ret == ERR_NEXMOTION_SUCCESS ) PoseToCoordTrans( pose, PRetToolCoordTrans );
+    NMC_API_RETURN( NMC_ToolCalib_4p, ret );
+}
+
+RTN_ERR FNTYPE NMC_ToolCalib_4pWithZ( const Pos_T *PMcsKinP1, const Pos_T *PMcsKinP2, const Pos_T *PMcsKinP3, const Pos_T *PMcsKinP4ZDir, CoordTrans_T *PRetToolCoordTrans, F64_T *PRetTolerance )
+{
+    // P4 touches the reference point with the tool Z axis pointing to -Z of the MCS.
+    RTN_ERR ret = PRetToolCoordTrans ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_POINTER_NULL;
+    F64_T   pose[6];
+    if( ret == ERR_NEXMOTION_SUCCESS ) ret = ToolTranslation( PMcsKinP1, PMcsKinP2, PMcsKinP3, PMcsKinP4ZDir, pose, PRetTolerance );
+    if( ret == ERR_NEXMOTION_SUCCESS ) ret = CalibToolZDirection( PMcsKinP4ZDir->pos, &pose[3] );
+    if( ret == ERR_NEXMOTION_SUCCESS ) PoseToCoordTrans( pose, PRetToolCoordTrans );
+    NMC_API_RETURN( NMC_ToolCalib_4pWithZ, ret );
+}
+
+RTN_ERR FNTYPE NMC_ToolCalib_4pWithOri( const Pos_T *PMcsKinP1, const Pos_T *PMcsKinP2, const Pos_T *PMcsKinP3, const Pos_T *PMcsKinP4, const Pos_T *PMcsKinMinusZAxisPt, const Pos_T *PMcsKinYZPlanPt, CoordTrans_T *PRetToolCoordTrans, F64_T *PRetTolerance )
+{
+    // The orientation points are taught from P4 without changing the orientation.
+    RTN_ERR ret = ( PRetToolCoordTrans && PMcsKinMinusZAxisPt && PMcsKinYZPlanPt ) ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_POINTER_NULL;
+    F64_T   pose[6];
+    if( ret == ERR_NEXMOTION_SUCCESS ) ret = ToolTranslation( PMcsKinP1, PMcsKinP2, PMcsKinP3, PMcsKinP4, pose, PRetTolerance );
+    if( ret == ERR_NEXMOTION_SUCCESS ) ret = CalibToolOrientation( PMcsKinP4->pos, PMcsKinMinusZAxisPt->pos, PMcsKinYZPlanPt->pos, &pose[3] );
+    if( ret == ERR_NEXMOTION_SUCCESS ) PoseToCoordTrans( pose, PRetToolCoordTrans );
+    NMC_API_RETURN( NMC_ToolCalib_4pWithOri, ret );
+}
+
+RTN_ERR FNTYPE NMC_ToolCalib_Ori( const Pos_T *PMcsKinOrg, const Pos_T *PMcsKinMinusZAxisPt, const Pos_T *PMcsKinYZPt, CoordTrans_T *PRetToolCoordTrans )
+{
+    RTN_ERR ret = ( PMcsKinOrg && PMcsKinMinusZAxisPt && PMcsKinYZPt && PRetToolCoordTrans ) ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_POINTER_NULL;
+    F64_T   pose[6] = { 0.0 };
+    if( ret == ERR_NEXMOTION_SUCCESS ) ret = CalibToolOrientation( PMcsKinOrg->pos, PMcsKinMinusZAxisPt->pos, PMcsKinYZPt->pos, &pose[3] );
+    if( ret == ERR_NEXMOTION_SUCCESS ) PoseToCoordTrans( pose, PRetToolCoordTrans );
+    NMC_API_RETURN( NMC_ToolCalib_Ori, ret );
+}
+
+RTN_ERR FNTYPE NMC_BaseCalib_1p( const Pos_T *PRefBaseP1, CoordTrans_T *PRetBaseCoordTrans )
+{
+    RTN_ERR ret = ( PRefBaseP1 && PRetBaseCoordTrans ) ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_POINTER_NULL;
+    F64_T   pose[6];
+    if( ret == ERR_NEXMOTION_SUCCESS ) ret = CalibBase( PRefBaseP1->pos, 0, 0, pose );
+    if( ret == ERR_NEXMOTION_SUCCESS ) PoseToCoordTrans( pose, PRetBaseCoordTrans );
+    NMC_API_RETURN( NMC_BaseCalib_1p, ret );
+}
+
+RTN_ERR FNTYPE NMC_BaseCalib_2p( const Pos_T *PRefBaseP1, const Pos_T *PRefBaseP2, CoordTrans_T *PRetBaseCoordTrans )
+{
+    RTN_ERR ret = ( PRefBaseP1 && PRefBaseP2 && PRetBaseCoordTrans ) ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_POINTER_NULL;
+    F64_T   pose[6];
+    if( ret == ERR_NEXMOTION_SUCCESS ) ret = CalibBase( PRefBaseP1->pos, PRefBaseP2->pos, 0, pose );
+    if( ret == ERR_NEXMOTION_SUCCESS ) PoseToCoordTrans( pose, PRetBaseCoordTrans );
+    NMC_API_RETURN( NMC_BaseCalib_2p, ret );
+}
+
+RTN_ERR FNTYPE NMC_BaseCalib_3p( const Pos_T *PRefBaseP1, const Pos_T *PRefBaseP2, const Pos_T *PRefBaseP3, CoordTrans_T *PRetBaseCoordTrans )
+{
+    RTN_ERR ret = ( PRefBaseP1 && PRefBaseP2 && PRefBaseP3 && PRetBaseCoordTrans ) ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_POINTER_NULL;
+    F64_T   pose[6];
+    if( ret == ERR_NEXMOTION_SUCCESS ) ret = CalibBase( PRefBaseP1->pos, PRefBaseP2->pos, PRefBaseP3->pos, pose );
+    if( ret == ERR_NEXMOTION_SUCCESS ) PoseToCoordTrans( pose, PRetBaseCoordTrans );
+    NMC_API_RETURN( NMC_BaseCalib_3p, ret );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      Messages and debugging
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_MessagePopFirst( NmcMsg_T *PRetMsg )
+{
+    NMC_API_RETURN( NMC_MessagePopFirst, PopMessage( PRetMsg ) );
+}
+
+void FNTYPE NMC_MessageOutputEnable( BOOL_T Enable )
+{
+    SetMessageOutput( Enable != 0 );
+    TraceApi( reinterpret_cast<const void *>( &NMC_MessageOutputEnable ), "NMC_MessageOutputEnable", ERR_NEXMOTION_SUCCESS );
+}
+
+// The debug functions are not traced: a hook function calling NMC_DebugGetApiAddress() would recurse.
+
+void FNTYPE NMC_DebugSetTraceMode( I32_T TraceMode )
+{
+    SetTraceMode( TraceMode );
+}
+
+void FNTYPE NMC_DebugSetHookData( void *PHookUserData )
+{
+    SetHookData( PHookUserData );
+}
+
+void FNTYPE NMC_DebugSetHookFunction( PF_NmcHookAPI PFHookFuncPtr )
+{
+    SetHookFunction( PFHookFuncPtr );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      Deprecated functions
+/////////////////////////////////////////////////////////////////////
+
+RTN_ERR FNTYPE NMC_AxisSetVelRatio( I32_T DevID, I32_T AxisIndex, F64_T Percentage )
+{
+    // The axis velocity ratio is a fraction (1.0 = 100%).
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Ok() ? ax->SetSpeedRatio( Percentage * 100.0 ) : ax.Error();
+    }
+    NMC_API_RETURN( NMC_AxisSetVelRatio, ret );
+}
+
+RTN_ERR FNTYPE NMC_AxisGetVelRatio( I32_T DevID, I32_T AxisIndex, F64_T *PPercentage )
+{
+    RTN_ERR ret;
+    {
+        AxisRef ax( DevID, AxisIndex, false );
+        ret = ax.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PPercentage ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PPercentage = ax->SpeedRatio() / 100.0;
+    }
+    NMC_API_RETURN( NMC_AxisGetVelRatio, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupSetVelRatio( I32_T DevID, I32_T GroupIndex, F64_T Percentage )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Ok() ? grp->SetSpeedRatio( Percentage ) : grp.Error();
+    }
+    NMC_API_RETURN( NMC_GroupSetVelRatio, ret );
+}
+
+RTN_ERR FNTYPE NMC_GroupGetVelRatio( I32_T DevID, I32_T GroupIndex, F64_T *PRetPercentage )
+{
+    RTN_ERR ret;
+    {
+        GroupRef grp( DevID, GroupIndex, false );
+        ret = grp.Error();
+        if( ret == ERR_NEXMOTION_SUCCESS && !PRetPercentage ) ret = ERR_NEXMOTION_POINTER_NULL;
+        if( ret == ERR_NEXMOTION_SUCCESS ) *PRetPercentage = grp->SpeedRatio();
+    }
+    NMC_API_RETURN( NMC_GroupGetVelRatio, ret );
+}
+
+/////////////////////////////////////////////////////////////////////
+//                      API address table
+/////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct ApiEntry_T
+{
+    const char *name;
+    const void *address;
+};
+
+#define NMC_API_ENTRY( Func ) { #Func, reinterpret_cast<const void *>( &Func ) }
+
+const ApiEntry_T kApiTable[] =
+{
+    NMC_API_ENTRY( NMC_GetLibVersion ),
+    NMC_API_ENTRY( NMC_GetLibVersionString ),
+    NMC_API_ENTRY( NMC_GetErrorDescription ),
+    NMC_API_ENTRY( NMC_DeviceOpenUp ),
+    NMC_API_ENTRY( NMC_DeviceShutdown ),
+    NMC_API_ENTRY( NMC_DeviceOpenUpRequest ),
+    NMC_API_ENTRY( NMC_DeviceOpenUpRequestEx ),
+    NMC_API_ENTRY( NMC_DeviceWaitOpenUpRequest ),
+    NMC_API_ENTRY( NMC_DeviceGetOpenUpProgress ),
+    NMC_API_ENTRY( NMC_DeviceShutdownRequest ),
+    NMC_API_ENTRY( NMC_DeviceWaitShutdownRequest ),
+    NMC_API_ENTRY( NMC_DeviceWatchdogTimerEnable ),
+    NMC_API_ENTRY( NMC_DeviceWatchdogTimerDisable ),
+    NMC_API_ENTRY( NMC_DeviceWatchdogTimerReset ),
+    NMC_API_ENTRY( NMC_DeviceCreate ),
+    NMC_API_ENTRY( NMC_DeviceDelete ),
+    NMC_API_ENTRY( NMC_DeviceLoadIniConfig ),
+    NMC_API_ENTRY( NMC_DeviceResetConfig ),
+    NMC_API_ENTRY( NMC_DeviceStart ),
+    NMC_API_ENTRY( NMC_DeviceStop ),
+    NMC_API_ENTRY( NMC_DeviceStartRequest ),
+    NMC_API_ENTRY( NMC_DeviceStopRequest ),
+    NMC_API_ENTRY( NMC_DeviceGetState ),
+    NMC_API_ENTRY( NMC_DeviceGetSnapshot ),
+    NMC_API_ENTRY( NMC_DeviceSubscribeEvents ),
+    NMC_API_ENTRY( NMC_DevicePopEvents ),
+    NMC_API_ENTRY( NMC_DeviceSetParam ),
+    NMC_API_ENTRY( NMC_DeviceGetParam ),
+    NMC_API_ENTRY( NMC_DeviceParamTxBegin ),
+    NMC_API_ENTRY( NMC_DeviceParamTxStageI32 ),
+    NMC_API_ENTRY( NMC_DeviceParamTxStageF64 ),
+    NMC_API_ENTRY( NMC_DeviceParamTxCommit ),
+    NMC_API_ENTRY( NMC_DeviceParamTxAbort ),
+    NMC_API_ENTRY( NMC_DeviceExportParams ),
+    NMC_API_ENTRY( NMC_DeviceImportParams ),
+    NMC_API_ENTRY( NMC_DiffParams ),
+    NMC_API_ENTRY( NMC_SetIniPath ),
+    NMC_API_ENTRY( NMC_GetInputMemorySize ),
+    NMC_API_ENTRY( NMC_GetOutputMemorySize ),
+    NMC_API_ENTRY( NMC_ReadInputMemory ),
+    NMC_API_ENTRY( NMC_ReadOutputMemory ),
+    NMC_API_ENTRY( NMC_WriteOutputMemory ),
+    NMC_API_ENTRY( NMC_WriteOutputMasked ),
+    NMC_API_ENTRY( NMC_DeviceGetIoImage ),
+    NMC_API_ENTRY( NMC_DeviceSubscribeInputEdge ),
+    NMC_API_ENTRY( NMC_DeviceUnsubscribeInputEdge ),
+    NMC_API_ENTRY( NMC_DevicePopInputEdges ),
+    NMC_API_ENTRY( NMC_DeviceStartIoCapture ),
+    NMC_API_ENTRY( NMC_DeviceStopIoCapture ),
+    NMC_API_ENTRY( NMC_DeviceGetIoCaptureStatus ),
+    NMC_API_ENTRY( NMC_MemEntryGetCount ),
+    NMC_API_ENTRY( NMC_MemEntryGetInfo ),
+    NMC_API_ENTRY( NMC_MemEntryFind ),
+    NMC_API_ENTRY( NMC_MemEntryRead ),
+    NMC_API_ENTRY( NMC_MemEntryWrite ),
+    NMC_API_ENTRY( NMC_ReadInputBit ),
+    NMC_API_ENTRY( NMC_ReadInputI8 ),
+    NMC_API_ENTRY( NMC_ReadInputI16 ),
+    NMC_API_ENTRY( NMC_ReadInputI32 ),
+    NMC_API_ENTRY( NMC_ReadInputU8 ),
+    NMC_API_ENTRY( NMC_ReadInputU16 ),
+    NMC_API_ENTRY( NMC_ReadInputU32 ),
+    NMC_API_ENTRY( NMC_ReadInputI64 ),
+    NMC_API_ENTRY( NMC_ReadInputU64 ),
+    NMC_API_ENTRY( NMC_ReadInputF32 ),
+    NMC_API_ENTRY( NMC_ReadInputF64 ),
+    NMC_API_ENTRY( NMC_ReadInputGather ),
+    NMC_API_ENTRY( NMC_ReadOutputBit ),
+    NMC_API_ENTRY( NMC_ReadOutputI8 ),
+    NMC_API_ENTRY( NMC_ReadOutputI16 ),
+    NMC_API_ENTRY( NMC_ReadOutputI32 ),
+    NMC_API_ENTRY( NMC_ReadOutputU8 ),
+    NMC_API_ENTRY( NMC_ReadOutputU16 ),
+    NMC_API_ENTRY( NMC_ReadOutputU32 ),
+    NMC_API_ENTRY( NMC_ReadOutputI64 ),
+    NMC_API_ENTRY( NMC_ReadOutputU64 ),
+    NMC_API_ENTRY( NMC_ReadOutputF32 ),
+    NMC_API_ENTRY( NMC_ReadOutputF64 ),
+    NMC_API_ENTRY( NMC_ReadOutputGather ),
+    NMC_API_ENTRY( NMC_WriteOutputBit ),
+    NMC_API_ENTRY( NMC_WriteOutputI8 ),
+    NMC_API_ENTRY( NMC_WriteOutputI16 ),
+    NMC_API_ENTRY( NMC_WriteOutputI32 ),
+    NMC_API_ENTRY( NMC_WriteOutputU8 ),
+    NMC_API_ENTRY( NMC_WriteOutputU16 ),
+    NMC_API_ENTRY( NMC_WriteOutputU32 ),
+    NMC_API_ENTRY( NMC_WriteOutputI64 ),
+    NMC_API_ENTRY( NMC_WriteOutputU64 ),
+    NMC_API_ENTRY( NMC_WriteOutputF32 ),
+    NMC_API_ENTRY( NMC_WriteOutputF64 ),
+    NMC_API_ENTRY( NMC_WriteOutputScatter ),
+    NMC_API_ENTRY( NMC_DeviceGetAxisCount ),
+    NMC_API_ENTRY( NMC_DeviceGetGroupCount ),
+    NMC_API_ENTRY( NMC_DeviceGetGroupAxisCount ),
+    NMC_API_ENTRY( NMC_AxisGetDescription ),
+    NMC_API_ENTRY( NMC_GroupGetDescription ),
+    NMC_API_ENTRY( NMC_DeviceResetStateAll ),
+    NMC_API_ENTRY( NMC_DeviceEnableAll ),
+    NMC_API_ENTRY( NMC_DeviceDisableAll ),
+    NMC_API_ENTRY( NMC_DeviceHaltAll ),
+    NMC_API_ENTRY( NMC_DeviceStopAll ),
+    NMC_API_ENTRY( NMC_AxisSetParamI32 ),
+    NMC_API_ENTRY( NMC_AxisGetParamI32 ),
+    NMC_API_ENTRY( NMC_AxisSetParamF64 ),
+    NMC_API_ENTRY( NMC_AxisGetParamF64 ),
+    NMC_API_ENTRY( NMC_AxisEnable ),
+    NMC_API_ENTRY( NMC_AxisDisable ),
+    NMC_API_ENTRY( NMC_AxisGetStatus ),
+    NMC_API_ENTRY( NMC_AxisWaitStatus ),
+    NMC_API_ENTRY( NMC_AxisGetState ),
+    NMC_API_ENTRY( NMC_AxisResetState ),
+    NMC_API_ENTRY( NMC_AxisResetDriveAlm ),
+    NMC_API_ENTRY( NMC_AxisGetDriveAlmCode ),
+    NMC_API_ENTRY( NMC_AxisGetCommandPos ),
+    NMC_API_ENTRY( NMC_AxisGetActualPos ),
+    NMC_API_ENTRY( NMC_AxisGetCommandVel ),
+    NMC_API_ENTRY( NMC_AxisGetActualVel ),
+    NMC_API_ENTRY( NMC_AxisGetMotionBuffSpace ),
+    NMC_API_ENTRY( NMC_AxisPtp ),
+    NMC_API_ENTRY( NMC_AxisPtpBatch ),
+    NMC_API_ENTRY( NMC_AxisJog ),
+    NMC_API_ENTRY( NMC_AxisSetHomePos ),
+    NMC_API_ENTRY( NMC_AxisHomeDrive ),
+    NMC_API_ENTRY( NMC_AxisHalt ),
+    NMC_API_ENTRY( NMC_AxisStop ),
+    NMC_API_ENTRY( NMC_AxisHaltAll ),
+    NMC_API_ENTRY( NMC_AxisStopAll ),
+    NMC_API_ENTRY( NMC_AxisVelOverride ),
+    NMC_API_ENTRY( NMC_AxisAccOverride ),
+    NMC_API_ENTRY( NMC_AxisDecOverride ),
+    NMC_API_ENTRY( NMC_AxisSetSpeedRatio ),
+    NMC_API_ENTRY( NMC_AxisGetSpeedRatio ),
+    NMC_API_ENTRY( NMC_GroupSetParamI32 ),
+    NMC_API_ENTRY( NMC_GroupGetParamI32 ),
+    NMC_API_ENTRY( NMC_GroupSetParamF64 ),
+    NMC_API_ENTRY( NMC_GroupGetParamF64 ),
+    NMC_API_ENTRY( NMC_GroupAxSetParamI32 ),
+    NMC_API_ENTRY( NMC_GroupAxGetParamI32 ),
+    NMC_API_ENTRY( NMC_GroupAxSetParamF64 ),
+    NMC_API_ENTRY( NMC_GroupAxGetParamF64 ),
+    NMC_API_ENTRY( NMC_GroupEnable ),
+    NMC_API_ENTRY( NMC_GroupDisable ),
+    NMC_API_ENTRY( NMC_GroupGetStatus ),
+    NMC_API_ENTRY( NMC_GroupWaitStatus ),
+    NMC_API_ENTRY( NMC_GroupWaitMotionDone ),
+    NMC_API_ENTRY( NMC_GroupGetState ),
+    NMC_API_ENTRY( NMC_GroupResetState ),
+    NMC_API_ENTRY( NMC_GroupResetDriveAlm ),
+    NMC_API_ENTRY( NMC_GroupResetDriveAlmAll ),
+    NMC_API_ENTRY( NMC_GroupGetDriveAlmCode ),
+    NMC_API_ENTRY( NMC_GroupSetSpeedRatio ),
+    NMC_API_ENTRY( NMC_GroupGetSpeedRatio ),
+    NMC_API_ENTRY( NMC_GroupPtpAcs ),
+    NMC_API_ENTRY( NMC_GroupPtpAcsAll ),
+    NMC_API_ENTRY( NMC_GroupJogAcs ),
+    NMC_API_ENTRY( NMC_GroupJogTcpFrame ),
+    NMC_API_ENTRY( NMC_GroupJogPcsFrame ),
+    NMC_API_ENTRY( NMC_GroupPtpCart ),
+    NMC_API_ENTRY( NMC_GroupPtpCartAll ),
+    NMC_API_ENTRY( NMC_GroupHalt ),
+    NMC_API_ENTRY( NMC_GroupStop ),
+    NMC_API_ENTRY( NMC_GroupHaltAll ),
+    NMC_API_ENTRY( NMC_GroupStopAll ),
+    NMC_API_ENTRY( NMC_GroupGetCommandPosAcs ),
+    NMC_API_ENTRY( NMC_GroupGetActualPosAcs ),
+    NMC_API_ENTRY( NMC_GroupGetCommandPosPcs ),
+    NMC_API_ENTRY( NMC_GroupGetActualPosPcs ),
+    NMC_API_ENTRY( NMC_GroupGetCommandPos ),
+    NMC_API_ENTRY( NMC_GroupGetActualPos ),
+    NMC_API_ENTRY( NMC_GroupGetMotionBuffSpace ),
+    NMC_API_ENTRY( NMC_GroupSetHomePos ),
+    NMC_API_ENTRY( NMC_GroupAxesHomeDrive ),
+    NMC_API_ENTRY( NMC_GroupLineXY ),
+    NMC_API_ENTRY( NMC_GroupCirc2R ),
+    NMC_API_ENTRY( NMC_GroupCirc2C ),
+    NMC_API_ENTRY( NMC_GroupCirc2B ),
+    NMC_API_ENTRY( NMC_GroupCirc2BEx ),
+    NMC_API_ENTRY( NMC_GroupLine ),
+    NMC_API_ENTRY( NMC_GroupCircR ),
+    NMC_API_ENTRY( NMC_GroupCircC ),
+    NMC_API_ENTRY( NMC_GroupCircB ),
+    NMC_API_ENTRY( NMC_GroupCircBEx ),
+    NMC_API_ENTRY( NMC_GroupLineBatch ),
+    NMC_API_ENTRY( NMC_GroupCircRBatch ),
+    NMC_API_ENTRY( NMC_GroupCircCBatch ),
+    NMC_API_ENTRY( NMC_GroupCircBBatch ),
+    NMC_API_ENTRY( NMC_GroupSpline ),
+    NMC_API_ENTRY( NMC_ToolCalib_4p ),
+    NMC_API_ENTRY( NMC_ToolCalib_4pWithZ ),
+    NMC_API_ENTRY( NMC_ToolCalib_4pWithOri ),
+    NMC_API_ENTRY( NMC_ToolCalib_Ori ),
+    NMC_API_ENTRY( NMC_BaseCalib_1p ),
+    NMC_API_ENTRY( NMC_BaseCalib_2p ),
+    NMC_API_ENTRY( NMC_BaseCalib_3p ),
+    NMC_API_ENTRY( NMC_MessagePopFirst ),
+    NMC_API_ENTRY( NMC_MessageOutputEnable ),
+    NMC_API_ENTRY( NMC_DebugSetTraceMode ),
+    NMC_API_ENTRY( NMC_DebugSetHookData ),
+    NMC_API_ENTRY( NMC_DebugSetHookFunction ),
+    NMC_API_ENTRY( NMC_DebugGetApiAddress ),
+    NMC_API_ENTRY( NMC_AxisSetVelRatio ),
+    NMC_API_ENTRY( NMC_AxisGetVelRatio ),
+    NMC_API_ENTRY( NMC_GroupSetVelRatio ),
+    NMC_API_ENTRY( NMC_GroupGetVelRatio ),
+};
+
+#undef NMC_API_ENTRY
+
+} // namespace
+
+const void* FNTYPE NMC_DebugGetApiAddress( const char *PApiName )
+{
+    if( !PApiName )
+        return 0;
+    for( size_t i = 0; i < sizeof( kApiTable ) / sizeof( kApiTable[0] ); ++i )
+    {
+        if( std::strcmp( kApiTable[i].name, PApiName ) == 0 )
+            return kApiTable[i].address;
+    }
+    return 0;
+}
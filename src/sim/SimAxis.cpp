@@ -0,0 +1,522 @@
+/*!
+ * @file        SimAxis.cpp
+ * @brief       Single axis of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimAxis.h"
+#include <cmath>
+
+namespace nmc
+{
+
+Axis::Axis()
+    : params_( PARAM_SCOPE_AXIS )
+    , mode_( AXIS_MODE_IDLE )
+    , state_( NMC_AXIS_STATE_DISABLE )
+    , lastTarget_( 0.0 )
+    , appendOnly_( false )
+    , scurveOk_( false )
+    , scurveTime_( 0.0 )
+    , sentPos_( 0.0 )
+    , actPos_( 0.0 )
+    , actVel_( 0.0 )
+    , pulsePerUnit_( 1.0 )
+    , encEnable_( true )
+    , homePos_( 0.0 )
+    , homed_( false )
+    , reached_( false )
+    , latch_( 0 )
+    , speedRatio_( 100.0 )
+{
+    cur_         = AxisCmd_T();
+    scurveLimit_ = ProfileLimit_T();
+}
+
+void Axis::Start( I32_T BuffSize )
+{
+    queue_.Resize( BuffSize );
+    pulsePerUnit_ = static_cast<F64_T>( params_.I32( AXP_ENC_RES ) ) * params_.I32( AXP_MOTOR_REV )
+                  / ( static_cast<F64_T>( params_.I32( AXP_MECH_REV ) ) * params_.I32( AXP_PITCH ) );
+    encEnable_    = params_.I32( AXP_ENC_ENABLE ) != 0;
+
+    // An incremental encoder starts from zero, an absolute encoder keeps the last position.
+    F64_T pos = ( params_.I32( AXP_ENC_TYPE ) != 0 ) ? Quantize( prof_.Pos() ) : 0.0;
+    Shutdown();
+    prof_.Reset( pos, 0.0 );
+    sentPos_    = pos;
+    actPos_     = pos;
+    lastTarget_ = pos;
+    latch_      = 0;
+    reached_    = false;
+}
+
+void Axis::Shutdown()
+{
+    queue_.Clear();
+    prof_.Reset( prof_.Pos(), 0.0 );
+    actVel_ = 0.0;
+    mode_   = AXIS_MODE_IDLE;
+    state_  = NMC_AXIS_STATE_DISABLE;
+}
+
+RTN_ERR Axis::Enable()
+{
+    if( state_ == NMC_AXIS_STATE_DISABLE )
+    {
+        queue_.Clear();
+        prof_.Reset( prof_.Pos(), 0.0 );
+        lastTarget_ = prof_.Pos();
+        state_      = NMC_AXIS_STATE_STAND_STILL;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::Disable()
+{
+    queue_.Clear();
+    prof_.Reset( prof_.Pos(), 0.0 );
+    mode_  = AXIS_MODE_IDLE;
+    state_ = NMC_AXIS_STATE_DISABLE;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::ResetState()
+{
+    switch( state_ )
+    {
+    case NMC_AXIS_STATE_STOPPING:
+        return ERR_NEXMOTION_OPERATION_BUSY;
+    case NMC_AXIS_STATE_ERROR:
+    case NMC_AXIS_STATE_STOPPED:
+        queue_.Clear();
+        latch_      = 0;
+        lastTarget_ = prof_.Pos();
+        state_      = NMC_AXIS_STATE_STAND_STILL;
+        break;
+    default:
+        latch_ = 0;
+        break;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::ResetDriveAlm()
+{
+    // The simulated drive never raises an alarm.
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::CheckMotionAllowed() const
+{
+    switch( state_ )
+    {
+    case NMC_AXIS_STATE_STAND_STILL:
+    case NMC_AXIS_STATE_DISCRETE_MOTION:
+    case NMC_AXIS_STATE_CONTINUOUS_MOTION:
+        return ERR_NEXMOTION_SUCCESS;
+    default:
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    }
+}
+
+RTN_ERR Axis::Enqueue( const AxisCmd_T &Cmd )
+{
+    if( appendOnly_ )
+    {
+        // The cycle may finish the current motion meanwhile, then it starts this command.
+        if( !queue_.Push( Cmd ) )
+            return ERR_NEXMOTION_OPERATION_BUSY;
+    }
+    else if( mode_ == AXIS_MODE_IDLE || !IsBuffered() )
+    {
+        queue_.Clear();
+        Begin( Cmd );
+    }
+    else if( !queue_.Push( Cmd ) )
+    {
+        return ERR_NEXMOTION_OPERATION_BUSY;
+    }
+    if( Cmd.type != AXIS_MODE_JOG ) lastTarget_ = Cmd.target;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void Axis::StartQueued()
+{
+    // A command appended while the previous motion was finishing is left in the buffer of an idle axis.
+    if( mode_ == AXIS_MODE_IDLE && state_ == NMC_AXIS_STATE_STAND_STILL && !queue_.Empty() )
+    {
+        AxisCmd_T next = queue_.Front();
+        queue_.Pop();
+        Begin( next );
+    }
+}
+
+void Axis::Begin( const AxisCmd_T &Cmd )
+{
+    cur_      = Cmd;
+    mode_     = Cmd.type;
+    reached_  = false;
+    scurveOk_ = false;
+    scurveLimit_.vm = -1.0;     // Plan in the next cycle
+    if( Cmd.type == AXIS_MODE_HOME )     state_ = NMC_AXIS_STATE_HOMING;
+    else if( Cmd.type == AXIS_MODE_JOG ) state_ = NMC_AXIS_STATE_CONTINUOUS_MOTION;
+    else                                 state_ = NMC_AXIS_STATE_DISCRETE_MOTION;
+}
+
+void Axis::Finish( bool Reached )
+{
+    if( mode_ == AXIS_MODE_HOME ) homed_ = true;
+    reached_ = Reached;
+    if( !queue_.Empty() && mode_ != AXIS_MODE_STOP && mode_ != AXIS_MODE_HALT )
+    {
+        AxisCmd_T next = queue_.Front();
+        queue_.Pop();
+        Begin( next );
+        return;
+    }
+    // lastTarget_ belongs to the API side, an idle axis starts the next command at prof_.Pos().
+    state_ = ( mode_ == AXIS_MODE_STOP ) ? NMC_AXIS_STATE_STOPPED : NMC_AXIS_STATE_STAND_STILL;
+    mode_  = AXIS_MODE_IDLE;
+}
+
+RTN_ERR Axis::Ptp( F64_T TargetPos, const F64_T *PMaxVel )
+{
+    AxisCmd_T cmd;
+    NMC_RETURN_IF_ERR( PreparePtp( TargetPos, PMaxVel, &cmd ) );
+    return SubmitPtp( cmd, PMaxVel );
+}
+
+RTN_ERR Axis::PreparePtp( F64_T TargetPos, const F64_T *PMaxVel, AxisCmd_T *PRetCmd )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+    if( PMaxVel )
+        NMC_RETURN_IF_ERR( params_.CheckF64( AXP_VM, 0, *PMaxVel, true ) );
+
+    bool queued = appendOnly_ || ( mode_ != AXIS_MODE_IDLE && IsBuffered() );
+    AxisCmd_T cmd;
+    cmd.type   = AXIS_MODE_PTP;
+    cmd.target = TargetPos;
+    if( params_.I32( AXP_ABS_REL ) != 0 )
+        cmd.target += queued ? lastTarget_ : prof_.Pos();
+    cmd.dir = 1.0;
+    cmd.vm  = PMaxVel ? *PMaxVel : params_.F64( AXP_VM );
+    cmd.acc = params_.F64( AXP_ACC );
+    cmd.dec = params_.F64( AXP_DEC );
+    cmd.jerk = params_.F64( AXP_JERK );
+    cmd.profType = params_.I32( AXP_PROF_TYPE );
+
+    if( params_.I32( AXP_SW_LIMIT_ENABLE ) != 0
+        && ( cmd.target > params_.F64( AXP_SW_LIMIT_POS ) || cmd.target < params_.F64( AXP_SW_LIMIT_NEG ) ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    if( queued && queue_.Free() <= 0 )
+        return ERR_NEXMOTION_OPERATION_BUSY;
+
+    *PRetCmd = cmd;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::SubmitPtp( const AxisCmd_T &Cmd, const F64_T *PMaxVel )
+{
+    if( PMaxVel )
+        NMC_RETURN_IF_ERR( params_.SetF64( AXP_VM, 0, *PMaxVel, true ) );
+    return Enqueue( Cmd );
+}
+
+RTN_ERR Axis::Jog( I32_T Dir, const F64_T *PMaxVel )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    StartQueued();
+    if( Dir != 1 && Dir != -1 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    AxisCmd_T cmd;
+    cmd.type   = AXIS_MODE_JOG;
+    cmd.target = 0.0;
+    cmd.dir    = Dir;
+    cmd.vm     = params_.F64( AXP_VM );
+    if( PMaxVel )
+    {
+        // A JOG velocity of 0 is accepted but cannot be stored in AXP_VM.
+        if( !( *PMaxVel >= 0.0 ) )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( *PMaxVel > 0.0 )
+            NMC_RETURN_IF_ERR( params_.SetF64( AXP_VM, 0, *PMaxVel, true ) );
+        cmd.vm = *PMaxVel;
+    }
+    cmd.acc = params_.F64( AXP_ACC );
+    cmd.dec = params_.F64( AXP_DEC );
+    cmd.jerk = params_.F64( AXP_JERK );
+    cmd.profType = params_.I32( AXP_PROF_TYPE );
+    return Enqueue( cmd );
+}
+
+RTN_ERR Axis::SetHomePos( F64_T HomePos )
+{
+    homePos_ = HomePos;
+    homed_   = false;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::HomeDrive()
+{
+    StartQueued();
+    if( state_ != NMC_AXIS_STATE_STAND_STILL )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+
+    AxisCmd_T cmd;
+    cmd.type   = AXIS_MODE_HOME;
+    cmd.target = homePos_;
+    cmd.dir    = 1.0;
+    cmd.vm     = params_.F64( AXP_VM );
+    cmd.acc    = params_.F64( AXP_ACC );
+    cmd.dec    = params_.F64( AXP_DEC );
+    cmd.jerk   = params_.F64( AXP_JERK );
+    cmd.profType = params_.I32( AXP_PROF_TYPE );
+    return Enqueue( cmd );
+}
+
+RTN_ERR Axis::Halt()
+{
+    StartQueued();
+    switch( state_ )
+    {
+    case NMC_AXIS_STATE_DISABLE:
+    case NMC_AXIS_STATE_STAND_STILL:
+        return ERR_NEXMOTION_SUCCESS;
+    case NMC_AXIS_STATE_DISCRETE_MOTION:
+    case NMC_AXIS_STATE_CONTINUOUS_MOTION:
+        break;
+    default:
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    }
+
+    queue_.Clear();
+    // A buffered halt lets the current point-to-point motion complete, a JOG motion never completes.
+    if( mode_ == AXIS_MODE_HALT || ( IsBuffered() && mode_ == AXIS_MODE_PTP ) )
+        return ERR_NEXMOTION_SUCCESS;
+    mode_  = AXIS_MODE_HALT;
+    state_ = NMC_AXIS_STATE_DISCRETE_MOTION;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::Stop()
+{
+    StartQueued();
+    switch( state_ )
+    {
+    case NMC_AXIS_STATE_HOMING:
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    case NMC_AXIS_STATE_STAND_STILL:
+        state_ = NMC_AXIS_STATE_STOPPED;
+        return ERR_NEXMOTION_SUCCESS;
+    case NMC_AXIS_STATE_DISCRETE_MOTION:
+    case NMC_AXIS_STATE_CONTINUOUS_MOTION:
+        queue_.Clear();
+        mode_  = AXIS_MODE_STOP;
+        state_ = NMC_AXIS_STATE_STOPPING;
+        return ERR_NEXMOTION_SUCCESS;
+    default:
+        return ERR_NEXMOTION_SUCCESS;
+    }
+}
+
+RTN_ERR Axis::VelOverride( F64_T TargetVel )
+{
+    if( mode_ != AXIS_MODE_PTP && mode_ != AXIS_MODE_JOG )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    if( !( TargetVel >= 0.0 ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    cur_.vm = TargetVel;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::AccOverride( F64_T TargetAcc )
+{
+    if( mode_ != AXIS_MODE_PTP && mode_ != AXIS_MODE_JOG )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    NMC_RETURN_IF_ERR( params_.SetF64( AXP_ACC, 0, TargetAcc, true ) );
+    cur_.acc = TargetAcc;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::DecOverride( F64_T TargetDec )
+{
+    if( mode_ != AXIS_MODE_PTP && mode_ != AXIS_MODE_HALT )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    NMC_RETURN_IF_ERR( params_.SetF64( AXP_DEC, 0, TargetDec, true ) );
+    cur_.dec = TargetDec;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Axis::SetSpeedRatio( F64_T Percentage )
+{
+    if( !( Percentage >= 0.0 && Percentage <= 100.0 ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    if( state_ == NMC_AXIS_STATE_HOMING || state_ == NMC_AXIS_STATE_STOPPING
+        || state_ == NMC_AXIS_STATE_STOPPED || state_ == NMC_AXIS_STATE_ERROR )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    speedRatio_ = Percentage;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+I32_T Axis::Status() const
+{
+    I32_T status = static_cast<I32_T>( latch_ );
+    if( state_ != NMC_AXIS_STATE_DISABLE ) status |= NMC_AXIS_STATUS_MASK_ENA;
+    if( state_ == NMC_AXIS_STATE_ERROR )   status |= NMC_AXIS_STATUS_MASK_ERR;
+    if( state_ == NMC_AXIS_STATE_STOPPED ) status |= NMC_AXIS_STATUS_MASK_STOP;
+
+    if( mode_ == AXIS_MODE_IDLE )
+    {
+        status |= NMC_AXIS_STATUS_MASK_CSTP;
+        if( reached_ ) status |= NMC_AXIS_STATUS_MASK_TAR;
+    }
+    else
+    {
+        status |= NMC_AXIS_STATUS_MASK_OP;
+        if( mode_ == AXIS_MODE_JOG && std::fabs( prof_.Vel() - cur_.dir * cur_.vm * speedRatio_ / 100.0 ) <= kVelEpsilon )
+            status |= NMC_AXIS_STATUS_MASK_TAR;
+        switch( prof_.Phase() )
+        {
+        case PROFILE_PHASE_ACC:   status |= NMC_AXIS_STATUS_MASK_ACC; break;
+        case PROFILE_PHASE_DEC:   status |= NMC_AXIS_STATUS_MASK_DEC; break;
+        case PROFILE_PHASE_CONST: status |= NMC_AXIS_STATUS_MASK_MV;  break;
+        default: break;
+        }
+    }
+    if( homed_ && std::fabs( actPos_ - homePos_ ) * pulsePerUnit_ <= 1.0 )
+        status |= NMC_AXIS_STATUS_MASK_RHOM;
+    return status;
+}
+
+void Axis::Snapshot( AxisSnap_T *PRet ) const
+{
+    PRet->state  = state_;
+    PRet->status = Status();
+    PRet->cmdPos = prof_.Pos();
+    PRet->actPos = actPos_;
+    PRet->cmdVel = prof_.Vel();
+    PRet->actVel = actVel_;
+}
+
+F64_T Axis::Quantize( F64_T Pos ) const
+{
+    return std::floor( Pos * pulsePerUnit_ + 0.5 ) / pulsePerUnit_;
+}
+
+bool Axis::StepSCurve( const ProfileLimit_T &Limit, F64_T Dt )
+{
+    // The profile is planned when the command starts and again from the current position and velocity when
+    // its limits change (overrides, speed ratio). A motion which cannot stop on the target within the jerk
+    // limit, such as a short command aborting a fast one, follows the trapezoidal profile instead.
+    if( Limit.vm != scurveLimit_.vm || Limit.acc != scurveLimit_.acc || Limit.dec != scurveLimit_.dec
+        || Limit.vBase != scurveLimit_.vBase )
+    {
+        SCurveLimit_T s = { Limit.vm, Limit.acc, Limit.dec, cur_.jerk, Limit.vBase };
+        scurveOk_    = scurve_.Plan( prof_.Pos(), prof_.Vel(), cur_.target, s );
+        scurveLimit_ = Limit;
+        scurveTime_  = 0.0;
+    }
+    if( !scurveOk_ )
+        return prof_.StepPosition( cur_.target, 0.0, Limit, Dt );
+
+    SCurveState_T state;
+    scurveTime_ += Dt;
+    scurve_.Evaluate( scurveTime_, &state );
+    prof_.Follow( state.pos, state.vel, state.acc, state.phase );
+    return scurveTime_ >= scurve_.Duration();
+}
+
+void Axis::RaiseLimitError( U32_T LatchMask, F64_T HoldPos )
+{
+    queue_.Clear();
+    prof_.Reset( HoldPos, 0.0 );
+    latch_   |= LatchMask;
+    reached_  = false;
+    mode_     = AXIS_MODE_IDLE;
+    state_    = NMC_AXIS_STATE_ERROR;
+}
+
+bool Axis::Cycle( F64_T Dt )
+{
+    // Feedback of the command sent in the previous cycle.
+    F64_T act = encEnable_ ? Quantize( sentPos_ ) : sentPos_;
+    actVel_   = ( act - actPos_ ) / Dt;
+    actPos_   = act;
+
+    StartQueued();
+
+    bool  error    = false;
+    F64_T prevPos  = prof_.Pos();
+    F64_T ratio    = speedRatio_ / 100.0;
+    bool  limitOn  = params_.I32( AXP_SW_LIMIT_ENABLE ) != 0;
+    F64_T limitPos = params_.F64( AXP_SW_LIMIT_POS );
+    F64_T limitNeg = params_.F64( AXP_SW_LIMIT_NEG );
+
+    ProfileLimit_T lim;
+    lim.vm    = cur_.vm * ratio;
+    lim.acc   = cur_.acc;
+    lim.dec   = cur_.dec;
+    lim.vBase = params_.F64( AXP_V_BASE );
+
+    switch( mode_ )
+    {
+    case AXIS_MODE_PTP:
+    case AXIS_MODE_HOME:
+        if( cur_.profType == NMC_PROF_TYPE_SCURVE ? StepSCurve( lim, Dt ) : prof_.StepPosition( cur_.target, 0.0, lim, Dt ) )
+            Finish( true );
+        break;
+
+    case AXIS_MODE_JOG:
+        if( limitOn && lim.vm > 0.0 )
+        {
+            // Decelerate in front of the software limit, then report the limit error.
+            F64_T end = ( cur_.dir > 0.0 ) ? limitPos : limitNeg;
+            if( prof_.StepPosition( end, 0.0, lim, Dt ) )
+            {
+                RaiseLimitError( ( cur_.dir > 0.0 ) ? NMC_AXIS_STATUS_MASK_PSEL : NMC_AXIS_STATUS_MASK_NSEL, end );
+                error = true;
+            }
+        }
+        else
+        {
+            prof_.StepVelocity( cur_.dir * lim.vm, lim, Dt );
+        }
+        break;
+
+    case AXIS_MODE_HALT:
+        if( prof_.StepVelocity( 0.0, lim, Dt ) )
+            Finish( true );
+        break;
+
+    case AXIS_MODE_STOP:
+        lim.dec = params_.F64( AXP_STOP_PROF_DEC );
+        if( prof_.StepVelocity( 0.0, lim, Dt ) )
+            Finish( false );
+        break;
+
+    default:
+        break;
+    }
+
+    if( !error && limitOn && state_ != NMC_AXIS_STATE_DISABLE )
+    {
+        if( prof_.Pos() > limitPos + kPosEpsilon && prof_.Pos() > prevPos )
+        {
+            RaiseLimitError( NMC_AXIS_STATUS_MASK_PSEL, prevPos );
+            error = true;
+        }
+        else if( prof_.Pos() < limitNeg - kPosEpsilon && prof_.Pos() < prevPos )
+        {
+            RaiseLimitError( NMC_AXIS_STATUS_MASK_NSEL, prevPos );
+            error = true;
+        }
+    }
+
+    sentPos_ = prof_.Pos();
+    return error;
+}
+
+} // namespace nmc
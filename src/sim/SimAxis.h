@@ -0,0 +1,160 @@
+/*!
+ * @file        SimAxis.h
+ * @brief       Single axis of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_AXIS_H
+#define __NEXMOTION_SIM_AXIS_H
+
+#include "SimParam.h"
+#include "SimProfile.h"
+#include "SimRealtime.h"
+#include "SimSCurve.h"
+#include "SimSnapshot.h"
+#include "SimSpscRing.h"
+#include <string>
+
+namespace nmc
+{
+
+//! Axis motion command stored in the motion buffer.
+struct AxisCmd_T
+{
+    I32_T type;     //!< AxisMode_E
+    F64_T target;   //!< Absolute target position (PTP, homing)
+    F64_T dir;      //!< Direction of a JOG motion, 1 or -1
+    F64_T vm;       //!< Maximum velocity, may be changed by NMC_AxisVelOverride()
+    F64_T acc;      //!< Acceleration, may be changed by NMC_AxisAccOverride()
+    F64_T dec;      //!< Deceleration, may be changed by NMC_AxisDecOverride()
+    F64_T jerk;     //!< Jerk of an S-curve profile
+    I32_T profType; //!< NMC_PROF_TYPE_*, AXP_PROF_TYPE when the command was given
+};
+
+//! What the profile generator of an axis is doing.
+enum AxisMode_E
+{
+    AXIS_MODE_IDLE = 0,
+    AXIS_MODE_PTP,
+    AXIS_MODE_JOG,
+    AXIS_MODE_HOME,
+    AXIS_MODE_HALT,
+    AXIS_MODE_STOP
+};
+
+/*!
+ * @brief A single axis: parameters, motion buffer, profile generator and simulated drive.
+ *
+ * The simulated drive follows the command position with a delay of one motion cycle. The actual
+ * position is quantized to the encoder resolution given by the unit parameters 0x00 ~ 0x03.
+ * All methods are called with the device lock held, except in append mode (see SetAppendOnly()).
+ */
+class Axis
+{
+public:
+    Axis();
+
+    ParamSet          &Params()            { return params_; }
+    const ParamSet    &Params() const      { return params_; }
+    const std::string &Description() const { return description_; }
+    void               SetDescription( const std::string &Text ) { description_ = Text; }
+
+    //! Prepare the axis when the device is started.
+    void    Start( I32_T BuffSize );
+    //! Stop and disable the axis immediately, used when the device leaves the operation state.
+    void    Shutdown();
+
+    RTN_ERR Enable();
+    RTN_ERR Disable();
+    RTN_ERR ResetState();
+    RTN_ERR ResetDriveAlm();
+
+    /*!
+     * @brief True if a buffered PTP command can be appended to the motion buffer without the device lock.
+     *
+     * Only AppendMutex() is required. A buffered command is appended while a PTP motion is running, so
+     * the cycle owns everything but the motion buffer and the end of the buffered commands.
+     */
+    bool    Appendable() const { return state_ == NMC_AXIS_STATE_DISCRETE_MOTION && mode_ == AXIS_MODE_PTP && IsBuffered(); }
+    //! Set while Ptp() is called without the device lock after Appendable() returned true.
+    void    SetAppendOnly( bool AppendOnly ) { appendOnly_ = AppendOnly; }
+    //! Serializes the producers of the motion buffer. Taken alone to append, or after the device lock.
+    PiMutex &AppendMutex() { return appendMutex_; }
+
+    RTN_ERR Ptp( F64_T TargetPos, const F64_T *PMaxVel );
+    //! Check a PTP command and build it without side effects other than starting a queued command.
+    RTN_ERR PreparePtp( F64_T TargetPos, const F64_T *PMaxVel, AxisCmd_T *PRetCmd );
+    //! Submit a command built by PreparePtp(), the axis must not have been modified in between.
+    RTN_ERR SubmitPtp( const AxisCmd_T &Cmd, const F64_T *PMaxVel );
+    RTN_ERR Jog( I32_T Dir, const F64_T *PMaxVel );
+    RTN_ERR SetHomePos( F64_T HomePos );
+    RTN_ERR HomeDrive();
+    RTN_ERR Halt();
+    RTN_ERR Stop();
+
+    RTN_ERR VelOverride( F64_T TargetVel );
+    RTN_ERR AccOverride( F64_T TargetAcc );
+    RTN_ERR DecOverride( F64_T TargetDec );
+    RTN_ERR SetSpeedRatio( F64_T Percentage );
+    F64_T   SpeedRatio() const { return speedRatio_; }
+
+    I32_T   State() const      { return state_; }
+    I32_T   Status() const;
+    F64_T   CommandPos() const { return prof_.Pos(); }
+    F64_T   CommandVel() const { return prof_.Vel(); }
+    F64_T   ActualPos() const  { return actPos_; }
+    F64_T   ActualVel() const  { return actVel_; }
+    I32_T   BuffSpace() const  { return queue_.Free(); }
+    I32_T   BuffCount() const  { return queue_.Size(); }
+    I32_T   DriveAlmCode() const { return 0; }
+    void    Snapshot( AxisSnap_T *PRet ) const;
+
+    //! Run one motion cycle. Return true if the axis entered the error state in this cycle.
+    bool    Cycle( F64_T Dt );
+
+private:
+    RTN_ERR CheckMotionAllowed() const;
+    RTN_ERR Enqueue( const AxisCmd_T &Cmd );
+    void    StartQueued();
+    void    Begin( const AxisCmd_T &Cmd );
+    void    Finish( bool Reached );
+    void    RaiseLimitError( U32_T LatchMask, F64_T HoldPos );
+    bool    StepSCurve( const ProfileLimit_T &Limit, F64_T Dt );
+    F64_T   Quantize( F64_T Pos ) const;
+    bool    IsBuffered() const { return params_.I32( AXP_BUFF_PARAM ) != 0; }
+
+    ParamSet              params_;
+    std::string           description_;
+
+    Axis( const Axis & );
+    Axis &operator=( const Axis & );
+
+    SpscRing<AxisCmd_T>   queue_;
+    AxisCmd_T             cur_;
+    std::atomic<I32_T>    mode_;        //!< AxisMode_E, read by Appendable() without the device lock
+    std::atomic<I32_T>    state_;
+    F64_T                 lastTarget_;  //!< End position of the last buffered command, base of relative commands
+    bool                  appendOnly_;
+    PiMutex               appendMutex_;
+
+    OnlineProfile         prof_;
+    SCurveProfile         scurve_;      //!< Plan of an S-curve PTP or homing motion
+    bool                  scurveOk_;    //!< False to follow prof_ instead, when the S-curve cannot be planned
+    ProfileLimit_T        scurveLimit_; //!< Limits scurve_ was planned with, a change replans it
+    F64_T                 scurveTime_;
+    F64_T                 sentPos_;     //!< Command position sent to the drive in the last cycle
+    F64_T                 actPos_;
+    F64_T                 actVel_;
+    F64_T                 pulsePerUnit_;
+    bool                  encEnable_;
+
+    F64_T                 homePos_;
+    bool                  homed_;
+    bool                  reached_;
+    U32_T                 latch_;
+    F64_T                 speedRatio_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_AXIS_H
@@ -0,0 +1,44 @@
+/*!
+ * @file        SimCommon.h
+ * @brief       Common definitions shared by the NexMotion simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_COMMON_H
+#define __NEXMOTION_SIM_COMMON_H
+
+#include "../NexMotion.h"
+#include "../NexMotionError.h"
+#include <cstddef>
+
+namespace nmc
+{
+
+const F64_T kPi          = 3.14159265358979323846;  //!< Pi
+const F64_T kPosEpsilon  = 1e-9;                    //!< Position tolerance (user unit) treated as zero
+const F64_T kVelEpsilon  = 1e-9;                    //!< Velocity tolerance (user unit/sec) treated as zero
+
+const I32_T kMaxDevices  = 16;                      //!< Maximum simultaneously created devices
+const I32_T kMaxAxes     = 64;                      //!< Range of system parameter 0x01
+const I32_T kMaxGroups   = 64;                      //!< Range of system parameter 0x02
+const I32_T kMaxBases    = 32;                      //!< Group parameters 0xC0 ~ 0xDF
+const I32_T kMaxTools    = 16;                      //!< Group parameters 0x80 ~ 0x8F
+const I32_T kMaxLookAhead = 512;                    //!< Range of group parameter 0x36:4
+
+inline F64_T Clamp( F64_T Value, F64_T Min, F64_T Max )
+{
+    return ( Value < Min ) ? Min : ( ( Value > Max ) ? Max : Value );
+}
+
+inline F64_T DegToRad( F64_T Deg ) { return Deg * ( kPi / 180.0 ); }
+inline F64_T RadToDeg( F64_T Rad ) { return Rad * ( 180.0 / kPi ); }
+
+inline F64_T Sign( F64_T Value ) { return ( Value < 0.0 ) ? -1.0 : 1.0; }
+
+} // namespace nmc
+
+//! Return the error code from the enclosing function if the expression fails.
+#define NMC_RETURN_IF_ERR( Expr ) \
+    do { RTN_ERR ret_ = ( Expr ); if( ret_ != ERR_NEXMOTION_SUCCESS ) return ret_; } while( 0 )
+
+#endif // #ifndef __NEXMOTION_SIM_COMMON_H
@@ -0,0 +1,406 @@
+/*!
+ * @file        SimConfig.cpp
+ * @brief       Device configuration file (NexMotionLibConfig.ini) of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimConfig.h"
+#include "SimIoMap.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace nmc
+{
+
+namespace
+{
+
+const I32_T kDefaultAxisCount     = 4;
+const I32_T kDefaultGroupCount    = 1;
+const I32_T kDefaultGroupAxes     = 3;
+const I32_T kDefaultAxisBuffSize  = 32;
+const I32_T kDefaultGroupBuffSize = 128;
+const U32_T kDefaultIoSize        = 64;
+const I32_T kMaxBuffSize          = 65536;
+
+const char *const kSystemIniDir   = "/etc/nexcobot";
+
+std::mutex  gIniPathLock;
+std::string gIniPath;
+
+std::string Trim( const std::string &Text )
+{
+    size_t first = 0, last = Text.size();
+    while( first < last && std::isspace( static_cast<unsigned char>( Text[first] ) ) ) ++first;
+    while( last > first && std::isspace( static_cast<unsigned char>( Text[last - 1] ) ) ) --last;
+    return Text.substr( first, last - first );
+}
+
+bool EqualNoCase( const std::string &A, const char *B )
+{
+    size_t n = std::strlen( B );
+    if( A.size() != n ) return false;
+    for( size_t i = 0; i < n; ++i )
+        if( std::tolower( static_cast<unsigned char>( A[i] ) ) != std::tolower( static_cast<unsigned char>( B[i] ) ) )
+            return false;
+    return true;
+}
+
+bool ParseI32( const std::string &Text, I32_T *PRetValue )
+{
+    if( Text.empty() ) return false;
+    char *end = 0;
+    long v = std::strtol( Text.c_str(), &end, 0 );
+    if( *end != '\0' || v < -2147483647L - 1 || v > 2147483647L ) return false;
+    *PRetValue = static_cast<I32_T>( v );
+    return true;
+}
+
+bool ParseF64( const std::string &Text, F64_T *PRetValue )
+{
+    if( Text.empty() ) return false;
+    char *end = 0;
+    *PRetValue = std::strtod( Text.c_str(), &end );
+    return *end == '\0';
+}
+
+//! Parse "Param.<num>.<sub>".
+bool ParseParamKey( const std::string &Key, I32_T *PRetNum, I32_T *PRetSub )
+{
+    if( Key.size() < 6 || !EqualNoCase( Key.substr( 0, 6 ), "Param." ) ) return false;
+    std::string rest = Key.substr( 6 );
+    size_t dot = rest.find( '.' );
+    if( dot == std::string::npos ) return false;
+    return ParseI32( rest.substr( 0, dot ), PRetNum ) && ParseI32( rest.substr( dot + 1 ), PRetSub );
+}
+
+//! Parse "<Prefix><index>" and return the index.
+bool ParseIndexed( const std::string &Name, const char *Prefix, I32_T *PRetIndex )
+{
+    size_t n = std::strlen( Prefix );
+    if( Name.size() <= n || !EqualNoCase( Name.substr( 0, n ), Prefix ) ) return false;
+    std::string digits = Name.substr( n );
+    for( size_t i = 0; i < digits.size(); ++i )
+        if( !std::isdigit( static_cast<unsigned char>( digits[i] ) ) ) return false;
+    return ParseI32( digits, PRetIndex );
+}
+
+bool FileExists( const std::string &Path )
+{
+    struct stat st;
+    return ::stat( Path.c_str(), &st ) == 0 && S_ISREG( st.st_mode );
+}
+
+bool DirExists( const std::string &Path )
+{
+    struct stat st;
+    return ::stat( Path.c_str(), &st ) == 0 && S_ISDIR( st.st_mode );
+}
+
+std::string JoinPath( const std::string &Dir, const char *Name )
+{
+    if( !Dir.empty() && Dir[Dir.size() - 1] == '/' ) return Dir + Name;
+    return Dir + "/" + Name;
+}
+
+void ResizeGroupAxes( GroupConfig_T *PGroup )
+{
+    PGroup->axes.resize( PGroup->axisCount );
+}
+
+void ResizeGroups( DeviceConfig_T *PConfig, I32_T Count )
+{
+    I32_T old = static_cast<I32_T>( PConfig->groups.size() );
+    PConfig->groups.resize( Count );
+    for( I32_T i = old; i < Count; ++i )
+    {
+        PConfig->groups[i].axisCount = kDefaultGroupAxes;
+        ResizeGroupAxes( &PConfig->groups[i] );
+    }
+}
+
+} // namespace
+
+void ConfigDefault( DeviceConfig_T *PRetConfig )
+{
+    PRetConfig->cycleTimeUs   = 1000;
+    PRetConfig->axisCount     = kDefaultAxisCount;
+    PRetConfig->groupCount    = kDefaultGroupCount;
+    PRetConfig->axisBuffSize  = kDefaultAxisBuffSize;
+    PRetConfig->groupBuffSize = kDefaultGroupBuffSize;
+    PRetConfig->inputSize     = kDefaultIoSize;
+    PRetConfig->outputSize    = kDefaultIoSize;
+    PRetConfig->ioLoopback    = true;
+    PRetConfig->ioExchangeCycles = 0;
+    PRetConfig->rtPriority    = 0;
+    PRetConfig->rtCpu         = -1;
+    PRetConfig->rtLockMemory  = 0;
+    PRetConfig->rtStackPrefaultKb = 64;
+    PRetConfig->axes.clear();
+    PRetConfig->axes.resize( kDefaultAxisCount );
+    PRetConfig->groups.clear();
+    ResizeGroups( PRetConfig, kDefaultGroupCount );
+    PRetConfig->inputMap.clear();
+    PRetConfig->outputMap.clear();
+}
+
+RTN_ERR ConfigReadFile( const std::string &Path, std::string *PRetText )
+{
+    std::ifstream file( Path.c_str(), std::ios::in | std::ios::binary );
+    if( !file.is_open() )
+        return FileExists( Path ) ? ERR_NEXMOTION_FILE_OPEN_FAILED : ERR_NEXMOTION_FILE_NOT_FOUND;
+    std::ostringstream text;
+    text << file.rdbuf();
+    if( file.bad() )
+        return ERR_NEXMOTION_FILE_OPEN_FAILED;
+    *PRetText = text.str();
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR ConfigLoad( const std::string &Path, DeviceConfig_T *PRetConfig, std::string *PRetErrorText )
+{
+    std::string text;
+    NMC_RETURN_IF_ERR( ConfigReadFile( Path, &text ) );
+    return ConfigParse( text, Path, PRetConfig, PRetErrorText );
+}
+
+RTN_ERR ConfigParse( const std::string &Text, const std::string &Path, DeviceConfig_T *PRetConfig, std::string *PRetErrorText )
+{
+    std::istringstream file( Text );
+
+    DeviceConfig_T cfg;
+    ConfigDefault( &cfg );
+    cfg.axes.clear();
+    cfg.groups.clear();
+
+    enum { SEC_NONE, SEC_SYSTEM, SEC_AXIS, SEC_GROUP, SEC_GROUP_AXIS, SEC_INPUT_MAP, SEC_OUTPUT_MAP } section = SEC_NONE;
+    I32_T index = 0, subIndex = 0;
+    std::string line;
+    I32_T lineNo = 0;
+    char  text[256];
+
+#define CONFIG_FAIL( Err, Fmt ) \
+    do { if( PRetErrorText ) { std::snprintf( text, sizeof( text ), "%s(%d): " Fmt, Path.c_str(), lineNo ); *PRetErrorText = text; } return ( Err ); } while( 0 )
+
+    while( std::getline( file, line ) )
+    {
+        ++lineNo;
+        size_t comment = line.find_first_of( ";#" );
+        if( comment != std::string::npos ) line.erase( comment );
+        line = Trim( line );
+        if( line.empty() ) continue;
+
+        if( line[0] == '[' )
+        {
+            if( line[line.size() - 1] != ']' )
+                CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "bad section header" );
+            std::string name = Trim( line.substr( 1, line.size() - 2 ) );
+            size_t dot = name.find( '.' );
+            if( EqualNoCase( name, "System" ) )
+            {
+                section = SEC_SYSTEM;
+            }
+            else if( EqualNoCase( name, "InputMap" ) )
+            {
+                section = SEC_INPUT_MAP;
+            }
+            else if( EqualNoCase( name, "OutputMap" ) )
+            {
+                section = SEC_OUTPUT_MAP;
+            }
+            else if( ParseIndexed( name, "Axis", &index ) )
+            {
+                if( index >= kMaxAxes )
+                    CONFIG_FAIL( ERR_NEXMOTION_AXIS_COUNT_INVALID, "axis index out of range" );
+                if( index >= static_cast<I32_T>( cfg.axes.size() ) ) cfg.axes.resize( index + 1 );
+                section = SEC_AXIS;
+            }
+            else if( dot != std::string::npos && ParseIndexed( name.substr( 0, dot ), "Group", &index )
+                     && ParseIndexed( name.substr( dot + 1 ), "Axis", &subIndex ) )
+            {
+                if( index >= kMaxGroups || subIndex >= NMC_MAX_AXES_IN_GROUP )
+                    CONFIG_FAIL( ERR_NEXMOTION_AXIS_COUNT_INVALID, "group axis index out of range" );
+                if( index >= static_cast<I32_T>( cfg.groups.size() ) ) ResizeGroups( &cfg, index + 1 );
+                section = SEC_GROUP_AXIS;
+            }
+            else if( ParseIndexed( name, "Group", &index ) )
+            {
+                if( index >= kMaxGroups )
+                    CONFIG_FAIL( ERR_NEXMOTION_GROUP_COUNT_INVALID, "group index out of range" );
+                if( index >= static_cast<I32_T>( cfg.groups.size() ) ) ResizeGroups( &cfg, index + 1 );
+                section = SEC_GROUP;
+            }
+            else
+            {
+                CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "unknown section" );
+            }
+            continue;
+        }
+
+        size_t eq = line.find( '=' );
+        if( eq == std::string::npos || section == SEC_NONE )
+            CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "entry outside of a section" );
+        std::string key   = Trim( line.substr( 0, eq ) );
+        std::string value = Trim( line.substr( eq + 1 ) );
+        I32_T i32;
+        F64_T f64;
+        ConfigParam_T param;
+        param.slot = -1;
+        param.type = PARAM_TYPE_F64;
+
+        if( section == SEC_SYSTEM )
+        {
+            if( !ParseI32( value, &i32 ) )
+                CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "integer value expected" );
+            if( EqualNoCase( key, "CycleTimeUs" ) )              cfg.cycleTimeUs = i32;
+            else if( EqualNoCase( key, "AxisCount" ) )           cfg.axisCount = i32;
+            else if( EqualNoCase( key, "GroupCount" ) )          cfg.groupCount = i32;
+            else if( EqualNoCase( key, "AxisMotionBuffSize" ) )  cfg.axisBuffSize = i32;
+            else if( EqualNoCase( key, "GroupMotionBuffSize" ) ) cfg.groupBuffSize = i32;
+            else if( EqualNoCase( key, "InputMemorySize" ) )     cfg.inputSize = static_cast<U32_T>( i32 );
+            else if( EqualNoCase( key, "OutputMemorySize" ) )    cfg.outputSize = static_cast<U32_T>( i32 );
+            else if( EqualNoCase( key, "IoLoopback" ) )          cfg.ioLoopback = ( i32 != 0 );
+            else if( EqualNoCase( key, "IoExchangeCycles" ) )    cfg.ioExchangeCycles = i32;
+            else if( EqualNoCase( key, "RtPriority" ) )          cfg.rtPriority = i32;
+            else if( EqualNoCase( key, "RtCpu" ) )               cfg.rtCpu = i32;
+            else if( EqualNoCase( key, "RtLockMemory" ) )        cfg.rtLockMemory = i32;
+            else if( EqualNoCase( key, "RtStackPrefaultKb" ) )   cfg.rtStackPrefaultKb = i32;
+            else CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "unknown key" );
+
+            // RtCpu = -1 disables the CPU affinity, its range is checked with the system parameter.
+            if( i32 < 0 && !EqualNoCase( key, "RtCpu" ) )
+                CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "negative value" );
+            continue;
+        }
+
+        if( section == SEC_INPUT_MAP || section == SEC_OUTPUT_MAP )
+        {
+            // The key is the entry name, the value its bit offset and type.
+            size_t comma = value.find( ',' );
+            MemEntryInfo_T entry;
+            U32_T type;
+            if( comma == std::string::npos || !ParseI32( Trim( value.substr( 0, comma ) ), &i32 ) || i32 < 0
+                || !MemEntryTypeFromName( Trim( value.substr( comma + 1 ) ), &type ) )
+                CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "<bit offset>, <type> expected" );
+            if( MemEntryMake( key, static_cast<U32_T>( i32 ), type, &entry ) != ERR_NEXMOTION_SUCCESS )
+                CONFIG_FAIL( ERR_NEXMOTION_PARAMETER_VALUE_INVALID, "bad entry name or unaligned entry" );
+            ( section == SEC_INPUT_MAP ? cfg.inputMap : cfg.outputMap ).push_back( entry );
+            continue;
+        }
+
+        if( EqualNoCase( key, "Description" ) )
+        {
+            if( section == SEC_AXIS )            cfg.axes[index].description = value;
+            else if( section == SEC_GROUP )      cfg.groups[index].description = value;
+            else CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "unknown key" );
+        }
+        else if( EqualNoCase( key, "AxisCount" ) && section == SEC_GROUP )
+        {
+            if( !ParseI32( value, &i32 ) )
+                CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "integer value expected" );
+            if( i32 < 1 || i32 > NMC_MAX_AXES_IN_GROUP )
+                CONFIG_FAIL( ERR_NEXMOTION_AXIS_COUNT_INVALID, "group axis count out of range" );
+            cfg.groups[index].axisCount = i32;
+            ResizeGroupAxes( &cfg.groups[index] );
+        }
+        else if( ParseParamKey( key, &param.paramNum, &param.subIndex ) )
+        {
+            if( !ParseF64( value, &f64 ) )
+                CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "numeric value expected" );
+            param.value = f64;
+            if( section == SEC_AXIS )
+            {
+                cfg.axes[index].params.push_back( param );
+            }
+            else if( section == SEC_GROUP )
+            {
+                cfg.groups[index].params.push_back( param );
+            }
+            else
+            {
+                GroupConfig_T &g = cfg.groups[index];
+                if( subIndex >= g.axisCount )
+                    CONFIG_FAIL( ERR_NEXMOTION_AXIS_COUNT_INVALID, "group axis index exceeds the group axis count" );
+                g.axes[subIndex].params.push_back( param );
+            }
+        }
+        else
+        {
+            CONFIG_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "unknown key" );
+        }
+    }
+
+#undef CONFIG_FAIL
+
+    if( cfg.axisCount > kMaxAxes || static_cast<I32_T>( cfg.axes.size() ) > cfg.axisCount )
+    {
+        if( PRetErrorText ) *PRetErrorText = Path + ": axis sections exceed AxisCount";
+        return ERR_NEXMOTION_AXIS_COUNT_INVALID;
+    }
+    if( cfg.groupCount > kMaxGroups || static_cast<I32_T>( cfg.groups.size() ) > cfg.groupCount )
+    {
+        if( PRetErrorText ) *PRetErrorText = Path + ": group sections exceed GroupCount";
+        return ERR_NEXMOTION_GROUP_COUNT_INVALID;
+    }
+    if( cfg.axisBuffSize < 1 || cfg.axisBuffSize > kMaxBuffSize || cfg.groupBuffSize < 1 || cfg.groupBuffSize > kMaxBuffSize
+        || cfg.inputSize > kMaxIoSize || cfg.outputSize > kMaxIoSize )
+    {
+        if( PRetErrorText ) *PRetErrorText = Path + ": [System] value out of range";
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    }
+    {
+        // Check the sizes and the names of the entries now, for the error text.
+        IoMap map;
+        std::string mapError;
+        RTN_ERR ret = map.Build( cfg.inputMap, cfg.inputSize, cfg.outputMap, cfg.outputSize, &mapError );
+        if( ret != ERR_NEXMOTION_SUCCESS )
+        {
+            if( PRetErrorText ) *PRetErrorText = Path + ": " + mapError;
+            return ret;
+        }
+    }
+    cfg.axes.resize( cfg.axisCount );
+    ResizeGroups( &cfg, cfg.groupCount );
+
+    *PRetConfig = cfg;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void ConfigSetIniPath( const char *PIniPath )
+{
+    std::lock_guard<std::mutex> guard( gIniPathLock );
+    gIniPath = PIniPath ? PIniPath : "";
+}
+
+RTN_ERR ConfigResolvePath( std::string *PRetPath )
+{
+    std::string path;
+    {
+        std::lock_guard<std::mutex> guard( gIniPathLock );
+        path = gIniPath;
+    }
+
+    if( !path.empty() )
+    {
+        if( DirExists( path ) ) path = JoinPath( path, kIniFileName );
+        if( !FileExists( path ) )
+            return ERR_NEXMOTION_FILE_NOT_FOUND;
+        *PRetPath = path;
+        return ERR_NEXMOTION_SUCCESS;
+    }
+
+    PRetPath->clear();
+    if( FileExists( kIniFileName ) )
+        *PRetPath = kIniFileName;
+    else if( FileExists( JoinPath( kSystemIniDir, kIniFileName ) ) )
+        *PRetPath = JoinPath( kSystemIniDir, kIniFileName );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+} // namespace nmc
@@ -0,0 +1,138 @@
+/*!
+ * @file        SimConfig.h
+ * @brief       Device configuration file (NexMotionLibConfig.ini) of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_CONFIG_H
+#define __NEXMOTION_SIM_CONFIG_H
+
+#include "SimCommon.h"
+#include "SimParam.h"
+#include <string>
+#include <vector>
+
+namespace nmc
+{
+
+//! Name of the configuration file searched by NMC_DeviceLoadIniConfig().
+const char *const kIniFileName = "NexMotionLibConfig.ini";
+//! Largest input or output memory of a configuration (byte).
+const U32_T kMaxIoSize = 65536;
+
+/*! @struct ConfigParam_T
+ *  @brief  One "Param.<num>.<sub> = <value>" entry of a configuration section.
+ */
+struct ConfigParam_T
+{
+    I32_T paramNum;
+    I32_T subIndex;
+    F64_T value;
+    I32_T slot;         //!< Storage slot resolved by ConfigCompile(), -1 if the entry is not compiled
+    I32_T type;         //!< ParamType_E of the slot, valid if slot >= 0
+};
+
+struct AxisConfig_T
+{
+    std::string                description;
+    std::vector<ConfigParam_T> params;
+};
+
+struct GroupConfig_T
+{
+    std::string                description;
+    I32_T                      axisCount;
+    std::vector<ConfigParam_T> params;
+    std::vector<AxisConfig_T>  axes;        //!< [GroupN.AxisM] sections, sized to axisCount
+};
+
+/*! @struct DeviceConfig_T
+ *  @brief  Content of a configuration file.
+ *
+ *  @code{.ini}
+ *  [System]
+ *  CycleTimeUs         = 1000
+ *  AxisCount           = 4
+ *  GroupCount          = 1
+ *  AxisMotionBuffSize  = 32
+ *  GroupMotionBuffSize = 128
+ *  InputMemorySize     = 64
+ *  OutputMemorySize    = 64
+ *  IoLoopback          = 1
+ *  IoExchangeCycles    = 1
+ *  RtPriority          = 80
+ *  RtCpu               = 3
+ *  RtLockMemory        = 1
+ *  RtStackPrefaultKb   = 64
+ *
+ *  [Axis0]
+ *  Description = Spindle
+ *  Param.0x32.0 = 200.0
+ *
+ *  [Group0]
+ *  Description = XYZ table
+ *  AxisCount   = 3
+ *  Param.0x36.0 = 2
+ *
+ *  [Group0.Axis2]
+ *  Param.0x10.0 = 300.0
+ *
+ *  [InputMap]
+ *  ; <name> = <bit offset>, <type>
+ *  Gripper_Closed = 19, BIT
+ *  Pressure       = 32, U16
+ *
+ *  [OutputMap]
+ *  Gripper_Close  = 3, BIT
+ *  @endcode
+ */
+struct DeviceConfig_T
+{
+    I32_T                      cycleTimeUs;
+    I32_T                      axisCount;
+    I32_T                      groupCount;
+    I32_T                      axisBuffSize;
+    I32_T                      groupBuffSize;
+    U32_T                      inputSize;
+    U32_T                      outputSize;
+    bool                       ioLoopback;
+    I32_T                      ioExchangeCycles;    //!< System parameter 0x14
+    I32_T                      rtPriority;      //!< System parameters 0x10 ~ 0x13
+    I32_T                      rtCpu;
+    I32_T                      rtLockMemory;
+    I32_T                      rtStackPrefaultKb;
+    std::vector<AxisConfig_T>  axes;
+    std::vector<GroupConfig_T> groups;
+    std::vector<MemEntryInfo_T> inputMap;       //!< [InputMap] entries, in the order of the file
+    std::vector<MemEntryInfo_T> outputMap;      //!< [OutputMap] entries
+};
+
+//! Built-in configuration used when no configuration file is found.
+void    ConfigDefault( DeviceConfig_T *PRetConfig );
+
+//! Parse a configuration file. Entries which are not specified keep the built-in default. PRetErrorText may be NULL.
+RTN_ERR ConfigLoad( const std::string &Path, DeviceConfig_T *PRetConfig, std::string *PRetErrorText );
+
+//! Parse the content of a configuration file. Path is only used in the error text.
+RTN_ERR ConfigParse( const std::string &Text, const std::string &Path, DeviceConfig_T *PRetConfig, std::string *PRetErrorText );
+
+//! Read a whole file.
+RTN_ERR ConfigReadFile( const std::string &Path, std::string *PRetText );
+
+/*!
+ * @brief Set the path given by NMC_SetIniPath(). A directory or a file name, an empty string restores the default search.
+ */
+void    ConfigSetIniPath( const char *PIniPath );
+
+/*!
+ * @brief Resolve the configuration file to be loaded.
+ *
+ * Search order when no path is set: the working directory, then /etc/nexcobot. PRetPath is empty
+ * if no file is found and the built-in configuration shall be used. If a path was set explicitly
+ * and the file does not exist, ERR_NEXMOTION_FILE_NOT_FOUND is returned.
+ */
+RTN_ERR ConfigResolvePath( std::string *PRetPath );
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_CONFIG_H
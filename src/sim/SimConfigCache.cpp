@@ -0,0 +1,486 @@
+/*!
+ * @file        SimConfigCache.cpp
+ * @brief       Compiled binary form of the device configuration file, memory mapped on warm starts
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimConfigCache.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nmc
+{
+
+namespace
+{
+
+const char  kMagic[8]   = { 'N', 'M', 'C', 'C', 'A', 'C', 'H', 'E' };
+const U64_T kFnvOffset  = 14695981039346656037ULL;
+const U64_T kFnvPrime   = 1099511628211ULL;
+
+//! [System] values of the body.
+struct SystemRec_T
+{
+    I32_T cycleTimeUs;
+    I32_T axisCount;
+    I32_T groupCount;
+    I32_T axisBuffSize;
+    I32_T groupBuffSize;
+    U32_T inputSize;
+    U32_T outputSize;
+    I32_T ioLoopback;
+    I32_T ioExchangeCycles;
+    I32_T rtPriority;
+    I32_T rtCpu;
+    I32_T rtLockMemory;
+    I32_T rtStackPrefaultKb;
+    U32_T inputEntryCount;  //!< MemEntryInfo_T records of [InputMap] after the sections
+    U32_T outputEntryCount; //!< MemEntryInfo_T records of [OutputMap] after those of [InputMap]
+    I32_T reserved;         //!< Keeps the records 8 byte aligned
+};
+
+//! Head of a section record, followed by the description padded to 8 bytes and paramCount ParamRec_T.
+struct SectionRec_T
+{
+    I32_T scope;            //!< PARAM_SCOPE_AXIS, PARAM_SCOPE_GROUP or PARAM_SCOPE_GROUP_AXIS
+    I32_T index;            //!< Axis or group index, axis index in the group for PARAM_SCOPE_GROUP_AXIS
+    I32_T axisCount;        //!< Group axis count, 0 for the other scopes
+    U32_T descBytes;
+    U32_T paramCount;
+    U32_T reserved;
+};
+
+struct ParamRec_T
+{
+    I32_T paramNum;
+    I32_T subIndex;
+    I32_T slot;
+    I32_T type;
+    F64_T value;
+};
+
+static_assert( sizeof( ConfigCacheHeader_T ) == 64, "ConfigCacheHeader_T layout" );
+static_assert( sizeof( SystemRec_T ) % 8 == 0 && sizeof( SectionRec_T ) % 8 == 0 && sizeof( ParamRec_T ) % 8 == 0
+               && sizeof( MemEntryInfo_T ) % 8 == 0,
+               "cache records must keep the 8 byte alignment" );
+
+U64_T Fnv( U64_T Hash, const void *PData, size_t Bytes )
+{
+    const U8_T *p = static_cast<const U8_T *>( PData );
+    for( size_t i = 0; i < Bytes; ++i )
+    {
+        Hash ^= p[i];
+        Hash *= kFnvPrime;
+    }
+    return Hash;
+}
+
+size_t Pad8( size_t Bytes )
+{
+    return ( Bytes + 7 ) & ~static_cast<size_t>( 7 );
+}
+
+//! Encoder of the body.
+class Writer
+{
+public:
+    template <typename T>
+    void Put( const T &Rec ) { data_.append( reinterpret_cast<const char *>( &Rec ), sizeof( Rec ) ); }
+
+    void PutSection( I32_T Scope, I32_T Index, I32_T AxisCount, const std::string &Description, const std::vector<ConfigParam_T> &Params )
+    {
+        SectionRec_T sec;
+        sec.scope      = Scope;
+        sec.index      = Index;
+        sec.axisCount  = AxisCount;
+        sec.descBytes  = static_cast<U32_T>( Description.size() );
+        sec.paramCount = static_cast<U32_T>( Params.size() );
+        sec.reserved   = 0;
+        Put( sec );
+        data_.append( Description );
+        data_.append( Pad8( Description.size() ) - Description.size(), '\0' );
+        for( size_t k = 0; k < Params.size(); ++k )
+        {
+            ParamRec_T rec;
+            rec.paramNum = Params[k].paramNum;
+            rec.subIndex = Params[k].subIndex;
+            rec.slot     = Params[k].slot;
+            rec.type     = Params[k].type;
+            rec.value    = Params[k].value;
+            Put( rec );
+        }
+    }
+
+    const std::string &Data() const { return data_; }
+
+private:
+    std::string data_;
+};
+
+//! Bounds checked decoder of the body.
+class Reader
+{
+public:
+    Reader( const U8_T *PData, size_t Bytes ) : p_( PData ), left_( Bytes ) {}
+
+    template <typename T>
+    bool Take( T *PRet )
+    {
+        if( left_ < sizeof( T ) ) return false;
+        std::memcpy( PRet, p_, sizeof( T ) );
+        p_ += sizeof( T );
+        left_ -= sizeof( T );
+        return true;
+    }
+
+    bool TakeText( size_t Bytes, std::string *PRet )
+    {
+        size_t padded = Pad8( Bytes );
+        if( Bytes > left_ || padded > left_ ) return false;
+        PRet->assign( reinterpret_cast<const char *>( p_ ), Bytes );
+        p_ += padded;
+        left_ -= padded;
+        return true;
+    }
+
+    //! Take a section of the expected scope and index.
+    bool TakeSection( I32_T Scope, I32_T Index, I32_T *PRetAxisCount, std::string *PRetDescription, std::vector<ConfigParam_T> *PRetParams )
+    {
+        SectionRec_T sec;
+        if( !Take( &sec ) || sec.scope != Scope || sec.index != Index ) return false;
+        if( !TakeText( sec.descBytes, PRetDescription ) ) return false;
+        if( sec.paramCount > left_ / sizeof( ParamRec_T ) ) return false;
+
+        I32_T slotCount = ParamTable::Get( Scope ).SlotCount();
+        PRetParams->resize( sec.paramCount );
+        for( U32_T k = 0; k < sec.paramCount; ++k )
+        {
+            ParamRec_T rec;
+            if( !Take( &rec ) ) return false;
+            if( rec.slot < 0 || rec.slot >= slotCount || ( rec.type != PARAM_TYPE_I32 && rec.type != PARAM_TYPE_F64 ) )
+                return false;
+            ConfigParam_T &p = ( *PRetParams )[k];
+            p.paramNum = rec.paramNum;
+            p.subIndex = rec.subIndex;
+            p.slot     = rec.slot;
+            p.type     = rec.type;
+            p.value    = rec.value;
+        }
+        if( PRetAxisCount ) *PRetAxisCount = sec.axisCount;
+        return true;
+    }
+
+    bool AtEnd() const { return left_ == 0; }
+
+private:
+    const U8_T *p_;
+    size_t      left_;
+};
+
+//! Read only mapping of a whole file.
+class MappedFile
+{
+public:
+    MappedFile() : data_( 0 ), bytes_( 0 ) {}
+    ~MappedFile() { if( data_ ) ::munmap( data_, bytes_ ); }
+
+    RTN_ERR Map( const std::string &Path )
+    {
+        int fd = ::open( Path.c_str(), O_RDONLY | O_CLOEXEC );
+        if( fd < 0 )
+            return ( errno == ENOENT ) ? ERR_NEXMOTION_FILE_NOT_FOUND : ERR_NEXMOTION_FILE_OPEN_FAILED;
+        struct stat st;
+        RTN_ERR ret = ERR_NEXMOTION_SUCCESS;
+        if( ::fstat( fd, &st ) != 0 || !S_ISREG( st.st_mode ) )
+            ret = ERR_NEXMOTION_FILE_OPEN_FAILED;
+        else if( static_cast<size_t>( st.st_size ) < sizeof( ConfigCacheHeader_T ) )
+            ret = ERR_NEXMOTION_FILE_BAD_FORMAT;
+        else
+        {
+            void *p = ::mmap( 0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if( p == MAP_FAILED )
+                ret = ERR_NEXMOTION_FILE_LOAD_FAILED;
+            else
+            {
+                data_  = p;
+                bytes_ = st.st_size;
+            }
+        }
+        ::close( fd );
+        return ret;
+    }
+
+    const U8_T *Data() const  { return static_cast<const U8_T *>( data_ ); }
+    size_t      Bytes() const { return bytes_; }
+
+private:
+    MappedFile( const MappedFile & );
+    MappedFile &operator=( const MappedFile & );
+
+    void   *data_;
+    size_t  bytes_;
+};
+
+//! Compile the entries of one section into PScratch, which only serves the checks.
+RTN_ERR CompileParams( ParamSet *PScratch, std::vector<ConfigParam_T> *PParams, const char *PSection, std::string *PRetErrorText )
+{
+    const ParamTable &table = ParamTable::Get( PScratch->Scope() );
+    for( size_t k = 0; k < PParams->size(); ++k )
+    {
+        ConfigParam_T &p = ( *PParams )[k];
+        const ParamDesc_T *desc = 0;
+        RTN_ERR ret = PScratch->SetFromConfig( p.paramNum, p.subIndex, p.value );
+        if( ret == ERR_NEXMOTION_SUCCESS )
+        {
+            p.slot = table.Find( p.paramNum, p.subIndex, &desc );
+            p.type = desc->type;
+            continue;
+        }
+        if( PRetErrorText )
+        {
+            char text[128];
+            std::snprintf( text, sizeof( text ), "[%s] Param.0x%X.%d = %g rejected", PSection, p.paramNum, p.subIndex, p.value );
+            *PRetErrorText = text;
+        }
+        return ret;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+} // namespace
+
+U64_T ConfigHash( const void *PData, size_t Bytes )
+{
+    return Fnv( kFnvOffset, PData, Bytes );
+}
+
+U64_T ConfigTableHash()
+{
+    static const U64_T hash = []()
+    {
+        U64_T h = kFnvOffset;
+        for( I32_T scope = 0; scope < PARAM_SCOPE_COUNT; ++scope )
+        {
+            const ParamTable &table = ParamTable::Get( scope );
+            for( I32_T i = 0; i < table.DescCount(); ++i )
+            {
+                const ParamDesc_T &d = table.Desc( i );
+                I32_T shape[] = { d.paramNum, d.paramNumLast, d.subIndex, d.subIndexLast, d.type, static_cast<I32_T>( d.flags ) };
+                F64_T range[] = { d.minValue, d.maxValue };
+                h = Fnv( h, shape, sizeof( shape ) );
+                h = Fnv( h, range, sizeof( range ) );
+            }
+            I32_T slots = table.SlotCount();
+            h = Fnv( h, &slots, sizeof( slots ) );
+        }
+        return h;
+    }();
+    return hash;
+}
+
+RTN_ERR ConfigCompile( DeviceConfig_T *PConfig, std::string *PRetErrorText )
+{
+    DeviceConfig_T cfg = *PConfig;
+    ParamSet axisScratch( PARAM_SCOPE_AXIS );
+    ParamSet groupScratch( PARAM_SCOPE_GROUP );
+    ParamSet groupAxisScratch( PARAM_SCOPE_GROUP_AXIS );
+    char section[32];
+
+    for( size_t i = 0; i < cfg.axes.size(); ++i )
+    {
+        std::snprintf( section, sizeof( section ), "Axis%d", static_cast<I32_T>( i ) );
+        NMC_RETURN_IF_ERR( CompileParams( &axisScratch, &cfg.axes[i].params, section, PRetErrorText ) );
+    }
+    for( size_t i = 0; i < cfg.groups.size(); ++i )
+    {
+        GroupConfig_T &g = cfg.groups[i];
+        std::snprintf( section, sizeof( section ), "Group%d", static_cast<I32_T>( i ) );
+        NMC_RETURN_IF_ERR( CompileParams( &groupScratch, &g.params, section, PRetErrorText ) );
+        for( size_t a = 0; a < g.axes.size(); ++a )
+        {
+            std::snprintf( section, sizeof( section ), "Group%d.Axis%d", static_cast<I32_T>( i ), static_cast<I32_T>( a ) );
+            NMC_RETURN_IF_ERR( CompileParams( &groupAxisScratch, &g.axes[a].params, section, PRetErrorText ) );
+        }
+    }
+    *PConfig = cfg;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+std::string ConfigCachePath( const std::string &IniPath )
+{
+    return IniPath + kConfigCacheSuffix;
+}
+
+RTN_ERR ConfigCacheWrite( const std::string &CachePath, const DeviceConfig_T &Config, U64_T SourceHash, U64_T SourceBytes )
+{
+    Writer body;
+    SystemRec_T sys;
+    sys.cycleTimeUs       = Config.cycleTimeUs;
+    sys.axisCount         = Config.axisCount;
+    sys.groupCount        = Config.groupCount;
+    sys.axisBuffSize      = Config.axisBuffSize;
+    sys.groupBuffSize     = Config.groupBuffSize;
+    sys.inputSize         = Config.inputSize;
+    sys.outputSize        = Config.outputSize;
+    sys.ioLoopback        = Config.ioLoopback ? 1 : 0;
+    sys.ioExchangeCycles  = Config.ioExchangeCycles;
+    sys.rtPriority        = Config.rtPriority;
+    sys.rtCpu             = Config.rtCpu;
+    sys.rtLockMemory      = Config.rtLockMemory;
+    sys.rtStackPrefaultKb = Config.rtStackPrefaultKb;
+    sys.inputEntryCount   = static_cast<U32_T>( Config.inputMap.size() );
+    sys.outputEntryCount  = static_cast<U32_T>( Config.outputMap.size() );
+    sys.reserved          = 0;
+    body.Put( sys );
+
+    for( size_t i = 0; i < Config.axes.size(); ++i )
+        body.PutSection( PARAM_SCOPE_AXIS, static_cast<I32_T>( i ), 0, Config.axes[i].description, Config.axes[i].params );
+    for( size_t i = 0; i < Config.groups.size(); ++i )
+    {
+        const GroupConfig_T &g = Config.groups[i];
+        body.PutSection( PARAM_SCOPE_GROUP, static_cast<I32_T>( i ), g.axisCount, g.description, g.params );
+        for( size_t a = 0; a < g.axes.size(); ++a )
+            body.PutSection( PARAM_SCOPE_GROUP_AXIS, static_cast<I32_T>( a ), 0, g.axes[a].description, g.axes[a].params );
+    }
+    for( size_t k = 0; k < Config.inputMap.size(); ++k )
+        body.Put( Config.inputMap[k] );
+    for( size_t k = 0; k < Config.outputMap.size(); ++k )
+        body.Put( Config.outputMap[k] );
+
+    ConfigCacheHeader_T header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic, kMagic, sizeof( kMagic ) );
+    header.version     = kConfigCacheVersion;
+    header.headerBytes = sizeof( header );
+    header.sourceHash  = SourceHash;
+    header.sourceBytes = SourceBytes;
+    header.tableHash   = ConfigTableHash();
+    header.bodyBytes   = body.Data().size();
+    header.bodyHash    = ConfigHash( body.Data().data(), body.Data().size() );
+    header.axisCount   = Config.axisCount;
+    header.groupCount  = Config.groupCount;
+
+    char suffix[32];
+    std::snprintf( suffix, sizeof( suffix ), ".tmp%d", static_cast<I32_T>( ::getpid() ) );
+    std::string tmpPath = CachePath + suffix;
+    int fd = ::open( tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+    if( fd < 0 )
+        return ERR_NEXMOTION_FILE_WRITE_PROHIBIT;
+    bool ok = ::write( fd, &header, sizeof( header ) ) == static_cast<ssize_t>( sizeof( header ) )
+              && ::write( fd, body.Data().data(), body.Data().size() ) == static_cast<ssize_t>( body.Data().size() );
+    ok = ( ::close( fd ) == 0 ) && ok;
+    if( !ok || ::rename( tmpPath.c_str(), CachePath.c_str() ) != 0 )
+    {
+        ::unlink( tmpPath.c_str() );
+        return ERR_NEXMOTION_FILE_WRITE_PROHIBIT;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR ConfigCacheRead( const std::string &CachePath, const U64_T *PSourceHash, DeviceConfig_T *PRetConfig, ConfigCacheHeader_T *PRetHeader )
+{
+    MappedFile file;
+    NMC_RETURN_IF_ERR( file.Map( CachePath ) );
+
+    ConfigCacheHeader_T header;
+    std::memcpy( &header, file.Data(), sizeof( header ) );
+    if( std::memcmp( header.magic, kMagic, sizeof( kMagic ) ) != 0 )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    if( header.version != kConfigCacheVersion || header.headerBytes != sizeof( header ) )
+        return ERR_NEXMOTION_FILE_VERSION_INCOMPTIBLE;
+    if( header.bodyBytes != file.Bytes() - sizeof( header ) )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    const U8_T *body = file.Data() + sizeof( header );
+    if( ConfigHash( body, header.bodyBytes ) != header.bodyHash )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    if( PRetHeader ) *PRetHeader = header;
+    if( header.tableHash != ConfigTableHash() || ( PSourceHash && header.sourceHash != *PSourceHash ) )
+        return ERR_NEXMOTION_FILE_VERSION_INCOMPTIBLE;
+    if( !PRetConfig )
+        return ERR_NEXMOTION_SUCCESS;
+
+    Reader in( body, header.bodyBytes );
+    SystemRec_T sys;
+    if( !in.Take( &sys ) || sys.axisCount < 0 || sys.axisCount > kMaxAxes || sys.groupCount < 0 || sys.groupCount > kMaxGroups )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+
+    DeviceConfig_T cfg;
+    cfg.cycleTimeUs       = sys.cycleTimeUs;
+    cfg.axisCount         = sys.axisCount;
+    cfg.groupCount        = sys.groupCount;
+    cfg.axisBuffSize      = sys.axisBuffSize;
+    cfg.groupBuffSize     = sys.groupBuffSize;
+    cfg.inputSize         = sys.inputSize;
+    cfg.outputSize        = sys.outputSize;
+    cfg.ioLoopback        = ( sys.ioLoopback != 0 );
+    cfg.ioExchangeCycles  = sys.ioExchangeCycles;
+    cfg.rtPriority        = sys.rtPriority;
+    cfg.rtCpu             = sys.rtCpu;
+    cfg.rtLockMemory      = sys.rtLockMemory;
+    cfg.rtStackPrefaultKb = sys.rtStackPrefaultKb;
+    cfg.axes.resize( sys.axisCount );
+    cfg.groups.resize( sys.groupCount );
+
+    for( I32_T i = 0; i < sys.axisCount; ++i )
+    {
+        if( !in.TakeSection( PARAM_SCOPE_AXIS, i, 0, &cfg.axes[i].description, &cfg.axes[i].params ) )
+            return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    }
+    for( I32_T i = 0; i < sys.groupCount; ++i )
+    {
+        GroupConfig_T &g = cfg.groups[i];
+        if( !in.TakeSection( PARAM_SCOPE_GROUP, i, &g.axisCount, &g.description, &g.params )
+            || g.axisCount < 1 || g.axisCount > NMC_MAX_AXES_IN_GROUP )
+            return ERR_NEXMOTION_FILE_BAD_FORMAT;
+        g.axes.resize( g.axisCount );
+        for( I32_T a = 0; a < g.axisCount; ++a )
+        {
+            if( !in.TakeSection( PARAM_SCOPE_GROUP_AXIS, a, 0, &g.axes[a].description, &g.axes[a].params ) )
+                return ERR_NEXMOTION_FILE_BAD_FORMAT;
+        }
+    }
+    // The entries are checked by IoMap::Build() when the configuration is applied.
+    if( sys.inputEntryCount > NMC_MAX_MEM_ENTRIES || sys.outputEntryCount > NMC_MAX_MEM_ENTRIES )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    cfg.inputMap.resize( sys.inputEntryCount );
+    cfg.outputMap.resize( sys.outputEntryCount );
+    for( size_t k = 0; k < cfg.inputMap.size(); ++k )
+        if( !in.Take( &cfg.inputMap[k] ) ) return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    for( size_t k = 0; k < cfg.outputMap.size(); ++k )
+        if( !in.Take( &cfg.outputMap[k] ) ) return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    if( !in.AtEnd() )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+
+    *PRetConfig = cfg;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR ConfigLoadCached( const std::string &Path, DeviceConfig_T *PRetConfig, bool *PRetCacheHit, std::string *PRetErrorText )
+{
+    std::string text;
+    NMC_RETURN_IF_ERR( ConfigReadFile( Path, &text ) );
+    U64_T sourceHash = ConfigHash( text.data(), text.size() );
+    std::string cachePath = ConfigCachePath( Path );
+
+    if( PRetCacheHit ) *PRetCacheHit = false;
+    if( ConfigCacheRead( cachePath, &sourceHash, PRetConfig, 0 ) == ERR_NEXMOTION_SUCCESS )
+    {
+        if( PRetCacheHit ) *PRetCacheHit = true;
+        return ERR_NEXMOTION_SUCCESS;
+    }
+
+    DeviceConfig_T cfg;
+    NMC_RETURN_IF_ERR( ConfigParse( text, Path, &cfg, PRetErrorText ) );
+    // A configuration with a rejected entry is not cached, it is reported when it is applied.
+    if( ConfigCompile( &cfg, 0 ) == ERR_NEXMOTION_SUCCESS )
+        ConfigCacheWrite( cachePath, cfg, sourceHash, text.size() );
+    *PRetConfig = cfg;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+} // namespace nmc
@@ -0,0 +1,85 @@
+/*!
+ * @file        SimConfigCache.h
+ * @brief       Compiled binary form of the device configuration file, memory mapped on warm starts
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_CONFIG_CACHE_H
+#define __NEXMOTION_SIM_CONFIG_CACHE_H
+
+#include "SimConfig.h"
+
+namespace nmc
+{
+
+//! Layout version of the cache file, a cache of another version is rebuilt.
+const U32_T kConfigCacheVersion = 3;
+
+//! Appended to the path of the configuration file to name its cache.
+const char *const kConfigCacheSuffix = ".cache";
+
+/*! @struct ConfigCacheHeader_T
+ *  @brief  Header of a cache file, followed by bodyBytes of records.
+ *
+ *  The body holds the [System] values, then one record per [AxisN], [GroupN] and [GroupN.AxisM] section with
+ *  its description and its entries. Each entry is already checked against the parameter tables and carries
+ *  its storage slot, so loading a cache skips both the text parsing and the parameter checks.
+ */
+struct ConfigCacheHeader_T
+{
+    char  magic[8];         //!< "NMCCACHE"
+    U32_T version;          //!< kConfigCacheVersion
+    U32_T headerBytes;      //!< sizeof( ConfigCacheHeader_T )
+    U64_T sourceHash;       //!< ConfigHash() of the content of the configuration file
+    U64_T sourceBytes;      //!< Size of the configuration file
+    U64_T tableHash;        //!< ConfigTableHash() of the parameter tables the slots are resolved with
+    U64_T bodyBytes;
+    U64_T bodyHash;         //!< ConfigHash() of the body
+    I32_T axisCount;
+    I32_T groupCount;
+};
+
+//! 64 bit FNV-1a hash.
+U64_T   ConfigHash( const void *PData, size_t Bytes );
+
+//! Hash of the parameter tables of every scope. A cache built by a library with other tables is rebuilt.
+U64_T   ConfigTableHash();
+
+/*!
+ * @brief Check every parameter entry of a configuration against the parameter tables and resolve its slot.
+ *
+ * The checks are the ones of ParamSet::SetFromConfig(). On failure no entry is left compiled.
+ */
+RTN_ERR ConfigCompile( DeviceConfig_T *PConfig, std::string *PRetErrorText );
+
+//! Path of the cache file of a configuration file.
+std::string ConfigCachePath( const std::string &IniPath );
+
+/*!
+ * @brief Write a compiled configuration to a cache file.
+ *
+ * The file is written to a temporary file which is renamed, a reader never sees a partial cache.
+ */
+RTN_ERR ConfigCacheWrite( const std::string &CachePath, const DeviceConfig_T &Config, U64_T SourceHash, U64_T SourceBytes );
+
+/*!
+ * @brief Map a cache file, verify it and decode the configuration.
+ *
+ * Returns ERR_NEXMOTION_FILE_BAD_FORMAT if the file is truncated or its checksum does not match, and
+ * ERR_NEXMOTION_FILE_VERSION_INCOMPTIBLE if it was built by another layout, other parameter tables or,
+ * when PSourceHash is not NULL, from another configuration file content. PRetConfig and PRetHeader may be NULL.
+ */
+RTN_ERR ConfigCacheRead( const std::string &CachePath, const U64_T *PSourceHash, DeviceConfig_T *PRetConfig, ConfigCacheHeader_T *PRetHeader );
+
+/*!
+ * @brief Load a configuration file through its cache.
+ *
+ * The file is hashed and the cache is used if it was built from the same content. Otherwise the file is
+ * parsed, and if every entry passes ConfigCompile() the cache is rebuilt. A cache which cannot be written,
+ * e.g. in a read only directory, is not an error. PRetCacheHit and PRetErrorText may be NULL.
+ */
+RTN_ERR ConfigLoadCached( const std::string &Path, DeviceConfig_T *PRetConfig, bool *PRetCacheHit, std::string *PRetErrorText );
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_CONFIG_CACHE_H
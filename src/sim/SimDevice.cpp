@@ -0,0 +1,1066 @@
+/*!
+ * @file        SimDevice.cpp
+ * @brief       Simulated device: lifecycle, motion cycle thread, watchdog and I/O images
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimDevice.h"
+#include "SimConfigCache.h"
+#include "SimParamBlob.h"
+#include "SimRuntime.h"
+#include <algorithm>
+#include <cstring>
+
+namespace nmc
+{
+
+namespace
+{
+
+const U32_T kWatchdogMinMs  = 20;
+const U32_T kWatchdogMaxMs  = 200000;
+const I32_T kIoPeriodUs     = 10000;    // Process image exchange period of the simulated bus for SYS_IO_CYCLES 0
+const I32_T kMaxWorkers     = 8;        // Threads of ParallelFor(), the calling thread included
+const I32_T kJobsPerWorker  = 8;        // Fewer jobs are not worth starting a thread
+const I64_T kMinParallelNs  = 1000000;  // Less remaining work is not worth starting threads, ~50 us each
+
+/*!
+ * Run Job( k ) for every k in [0, Count) on up to kMaxWorkers threads, the calling thread included.
+ * The jobs must be independent. Return the error of the lowest failed k, as a serial loop would.
+ *
+ * The calling thread starts alone and measures its jobs. Other threads are started only once the
+ * remaining jobs are estimated to take kMinParallelNs or more, so microsecond jobs run serially.
+ */
+template <typename Job>
+RTN_ERR ParallelFor( I32_T Count, const Job &Run )
+{
+    std::vector<RTN_ERR> results( Count, ERR_NEXMOTION_SUCCESS );
+    std::atomic<I32_T>   next( 0 );
+    auto work = [&]()
+    {
+        for( I32_T k = next.fetch_add( 1 ); k < Count; k = next.fetch_add( 1 ) )
+            results[k] = Run( k );
+    };
+
+    I64_T startNs = MonotonicNs();
+    I32_T done    = 0;
+    while( done < Count )
+    {
+        results[done] = Run( done );
+        ++done;
+        if( ( MonotonicNs() - startNs ) * ( Count - done ) >= kMinParallelNs * done )
+            break;
+    }
+    next = done;
+
+    I32_T workers = std::min( ( Count - done + kJobsPerWorker - 1 ) / kJobsPerWorker, kMaxWorkers );
+    workers = std::min( workers, static_cast<I32_T>( std::max( std::thread::hardware_concurrency(), 1u ) ) );
+    std::vector<std::thread> threads;
+    for( I32_T w = 1; w < workers; ++w )
+    {
+        try
+        {
+            threads.push_back( std::thread( work ) );
+        }
+        catch( ... )
+        {
+            break;      // The remaining threads share the jobs
+        }
+    }
+    work();
+    for( size_t w = 0; w < threads.size(); ++w )
+        threads[w].join();
+
+    for( I32_T k = 0; k < Count; ++k )
+        NMC_RETURN_IF_ERR( results[k] );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+//! Store a configuration entry. Entries compiled by ConfigCompile() skip the parameter search and checks.
+RTN_ERR ApplyParam( ParamSet *PParams, const ConfigParam_T &P )
+{
+    if( P.slot < 0 )
+        return PParams->SetFromConfig( P.paramNum, P.subIndex, P.value );
+    PParams->SetCompiled( P.slot, P.type, P.value );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+} // namespace
+
+Device::Device( I32_T DevType, I32_T DevIndex )
+    : devType_( DevType )
+    , devIndex_( DevIndex )
+    , state_( NMC_DEVICE_STATE_INIT )
+    , params_( PARAM_SCOPE_DEVICE )
+    , axisBuffSize_( 1 )
+    , groupBuffSize_( 1 )
+    , running_( false )
+    , cycleCount_( 0 )
+    , waiters_( 0 )
+    , nextTxId_( 0 )
+    , wdEnabled_( false )
+    , wdMode_( 0 )
+    , wdTimeout_( 0 )
+    , wdStopping_( false )
+    , ioLoopback_( true )
+    , ioDivider_( 1 )
+    , ioCounter_( 0 )
+    , ioLastNs_( 0 )
+    , outputMasks_( kMaxIoSize )
+{
+}
+
+Device::~Device()
+{
+    if( requestThread_.joinable() ) requestThread_.join();
+    Stop();
+}
+
+RTN_ERR Device::LoadIniConfig()
+{
+    DeviceConfig_T config;
+    std::string    source;
+    NMC_RETURN_IF_ERR( ReadIniConfig( &config, &source ) );
+    return LoadConfig( config, source );
+}
+
+RTN_ERR Device::ReadIniConfig( DeviceConfig_T *PRetConfig, std::string *PRetSource )
+{
+    {
+        std::lock_guard<std::mutex> command( cmdMutex_ );
+        std::lock_guard<PiMutex> guard( mutex_ );
+        if( state_ == NMC_DEVICE_STATE_OPERATION )
+            return ERR_NEXMOTION_OPERATION_DENIED;
+    }
+
+    std::string path, errorText;
+    NMC_RETURN_IF_ERR( ConfigResolvePath( &path ) );
+    if( path.empty() )
+    {
+        ConfigDefault( PRetConfig );
+        *PRetSource = "built-in defaults";
+        return ERR_NEXMOTION_SUCCESS;
+    }
+    bool cacheHit = false;
+    RTN_ERR ret = ConfigLoadCached( path, PRetConfig, &cacheHit, &errorText );
+    if( ret != ERR_NEXMOTION_SUCCESS )
+    {
+        PostMessage( NMC_MSG_TYPE_ERROR, ret, "Device", "Load configuration failed: %s", errorText.empty() ? path.c_str() : errorText.c_str() );
+        return ret;
+    }
+    *PRetSource = cacheHit ? ConfigCachePath( path ) : path;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::LoadConfig( const DeviceConfig_T &Config, const std::string &Source )
+{
+    std::lock_guard<std::mutex> lifecycle( lifecycleLock_ );
+    std::lock_guard<std::mutex> command( cmdMutex_ );
+    std::lock_guard<PiMutex> guard( mutex_ );
+    if( state_ == NMC_DEVICE_STATE_OPERATION )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    RTN_ERR ret = ApplyConfig( Config );
+    if( ret != ERR_NEXMOTION_SUCCESS )
+    {
+        Resize( 0, 0 );
+        state_ = NMC_DEVICE_STATE_INIT;
+        return ret;
+    }
+    state_ = NMC_DEVICE_STATE_READY;
+    PostMessage( NMC_MSG_TYPE_NORMAL, ERR_NEXMOTION_SUCCESS, "Device", "Configuration loaded from %s", Source.c_str() );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ApplyConfig( const DeviceConfig_T &Config )
+{
+    params_.Reset();
+    NMC_RETURN_IF_ERR( params_.SetI32( SYS_CYCLE_TIME_US, 0, Config.cycleTimeUs, false ) );
+    NMC_RETURN_IF_ERR( params_.SetI32( SYS_AXIS_COUNT, 0, Config.axisCount, false ) );
+    NMC_RETURN_IF_ERR( params_.SetI32( SYS_GROUP_COUNT, 0, Config.groupCount, false ) );
+    NMC_RETURN_IF_ERR( params_.SetI32( SYS_RT_PRIORITY, 0, Config.rtPriority, false ) );
+    NMC_RETURN_IF_ERR( params_.SetI32( SYS_RT_CPU, 0, Config.rtCpu, false ) );
+    NMC_RETURN_IF_ERR( params_.SetI32( SYS_RT_LOCK_MEMORY, 0, Config.rtLockMemory, false ) );
+    NMC_RETURN_IF_ERR( params_.SetI32( SYS_RT_STACK_KB, 0, Config.rtStackPrefaultKb, false ) );
+    NMC_RETURN_IF_ERR( params_.SetI32( SYS_IO_CYCLES, 0, Config.ioExchangeCycles, false ) );
+    axisBuffSize_  = Config.axisBuffSize;
+    groupBuffSize_ = Config.groupBuffSize;
+    ioLoopback_    = Config.ioLoopback;
+    capture_.SetActive( false );
+    capture_.Close();
+    ioMap_.Clear();
+    NMC_RETURN_IF_ERR( io_.Allocate( Config.inputSize, Config.outputSize ) );
+    outputMasks_.Resize( Config.outputSize );
+    inputEdges_.Resize( Config.inputSize );
+    std::string mapError;
+    RTN_ERR ret = ioMap_.Build( Config.inputMap, Config.inputSize, Config.outputMap, Config.outputSize, &mapError );
+    if( ret != ERR_NEXMOTION_SUCCESS )
+    {
+        PostMessage( NMC_MSG_TYPE_ERROR, ret, "Device", "%s", mapError.c_str() );
+        return ret;
+    }
+    outputBus_.assign( Config.outputSize, 0 );
+    inputBus_.assign( Config.inputSize, 0 );
+
+    axes_.clear();
+    groups_.clear();
+    Resize( Config.axisCount, Config.groupCount );
+
+    // The axes and groups are independent: download their parameters in parallel.
+    I32_T count = Config.axisCount + Config.groupCount;
+    return ParallelFor( count, [&]( I32_T k )
+    {
+        return ( k < Config.axisCount ) ? ApplyAxisConfig( Config, k ) : ApplyGroupConfig( Config, k - Config.axisCount );
+    } );
+}
+
+RTN_ERR Device::ApplyAxisConfig( const DeviceConfig_T &Config, I32_T Index )
+{
+    const AxisConfig_T &ac = Config.axes[Index];
+    axes_[Index]->SetDescription( ac.description );
+    for( size_t k = 0; k < ac.params.size(); ++k )
+    {
+        const ConfigParam_T &p = ac.params[k];
+        RTN_ERR ret = ApplyParam( &axes_[Index]->Params(), p );
+        if( ret != ERR_NEXMOTION_SUCCESS )
+        {
+            PostMessage( NMC_MSG_TYPE_ERROR, ret, "Device", "[Axis%d] Param.0x%X.%d = %g rejected", Index, p.paramNum, p.subIndex, p.value );
+            return ret;
+        }
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ApplyGroupConfig( const DeviceConfig_T &Config, I32_T Index )
+{
+    const GroupConfig_T &gc = Config.groups[Index];
+    Group &group = *groups_[Index];
+    group.SetDescription( gc.description );
+    group.SetAxisCount( gc.axisCount );
+    for( size_t k = 0; k < gc.params.size(); ++k )
+    {
+        const ConfigParam_T &p = gc.params[k];
+        RTN_ERR ret = ApplyParam( &group.Params(), p );
+        if( ret != ERR_NEXMOTION_SUCCESS )
+        {
+            PostMessage( NMC_MSG_TYPE_ERROR, ret, "Device", "[Group%d] Param.0x%X.%d = %g rejected", Index, p.paramNum, p.subIndex, p.value );
+            return ret;
+        }
+    }
+    for( I32_T a = 0; a < gc.axisCount; ++a )
+    {
+        for( size_t k = 0; k < gc.axes[a].params.size(); ++k )
+        {
+            const ConfigParam_T &p = gc.axes[a].params[k];
+            RTN_ERR ret = ApplyParam( &group.AxisParams( a ), p );
+            if( ret != ERR_NEXMOTION_SUCCESS )
+            {
+                PostMessage( NMC_MSG_TYPE_ERROR, ret, "Device", "[Group%d.Axis%d] Param.0x%X.%d = %g rejected", Index, a, p.paramNum, p.subIndex, p.value );
+                return ret;
+            }
+        }
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void Device::Resize( I32_T AxisCount, I32_T GroupCount )
+{
+    axes_.resize( AxisCount );
+    for( I32_T i = 0; i < AxisCount; ++i )
+        if( !axes_[i] ) axes_[i] = std::make_shared<Axis>();
+    groups_.resize( GroupCount );
+    for( I32_T g = 0; g < GroupCount; ++g )
+    {
+        if( groups_[g] ) continue;
+        groups_[g] = std::make_shared<Group>();
+        groups_[g]->SetAxisCount( 1 );
+    }
+    // A caller of FindAxis() or FindGroup() may keep a removed object until it returns.
+    for( I32_T i = 0; i < kMaxAxes; ++i )
+        std::atomic_store( &axisSlots_[i], ( i < AxisCount ) ? axes_[i] : std::shared_ptr<Axis>() );
+    for( I32_T g = 0; g < kMaxGroups; ++g )
+        std::atomic_store( &groupSlots_[g], ( g < GroupCount ) ? groups_[g] : std::shared_ptr<Group>() );
+    snapshot_.Resize( AxisCount, GroupCount );
+    events_.Resize( AxisCount, GroupCount );
+    PublishStatus();
+}
+
+std::shared_ptr<Axis> Device::FindAxis( I32_T Index ) const
+{
+    return ( Index >= 0 && Index < kMaxAxes ) ? std::atomic_load( &axisSlots_[Index] ) : std::shared_ptr<Axis>();
+}
+
+std::shared_ptr<Group> Device::FindGroup( I32_T Index ) const
+{
+    return ( Index >= 0 && Index < kMaxGroups ) ? std::atomic_load( &groupSlots_[Index] ) : std::shared_ptr<Group>();
+}
+
+AppendLocks::AppendLocks( Device &Dev )
+    : count_( 0 )
+{
+    for( I32_T i = 0; i < Dev.AxisCount(); ++i )
+        locks_[count_++] = &Dev.AxisAt( i ).AppendMutex();
+    for( I32_T g = 0; g < Dev.GroupCount(); ++g )
+        locks_[count_++] = &Dev.GroupAt( g ).AppendMutex();
+    for( I32_T k = 0; k < count_; ++k )
+        locks_[k]->lock();
+}
+
+AppendLocks::~AppendLocks()
+{
+    for( I32_T k = count_; k-- > 0; )
+        locks_[k]->unlock();
+}
+
+RTN_ERR Device::ResetConfig()
+{
+    std::lock_guard<std::mutex> lifecycle( lifecycleLock_ );
+    std::lock_guard<std::mutex> command( cmdMutex_ );
+    std::lock_guard<PiMutex> guard( mutex_ );
+    if( state_ == NMC_DEVICE_STATE_OPERATION )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    Resize( 0, 0 );
+    params_.Reset();
+    io_.Release();
+    outputMasks_.Resize( 0 );
+    ioMap_.Clear();
+    inputEdges_.Resize( 0 );
+    capture_.SetActive( false );
+    capture_.Close();
+    inputBus_.clear();
+    outputBus_.clear();
+    state_ = NMC_DEVICE_STATE_INIT;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::Start()
+{
+    std::lock_guard<std::mutex> lifecycle( lifecycleLock_ );
+    // The cycle thread may still exist after a watchdog timeout.
+    JoinCycleThread();
+
+    {
+        std::lock_guard<std::mutex> command( cmdMutex_ );
+        std::lock_guard<PiMutex> guard( mutex_ );
+        if( state_ == NMC_DEVICE_STATE_OPERATION )
+            return ERR_NEXMOTION_SUCCESS;
+        if( state_ != NMC_DEVICE_STATE_READY )
+            return ERR_NEXMOTION_SYSTEM_NOT_READY;
+        AppendLocks appends( *this );
+
+        // Set up the kinematics and motion buffers of the groups and axes in parallel.
+        I32_T groupCount = GroupCount();
+        NMC_RETURN_IF_ERR( ParallelFor( groupCount + AxisCount(), [&]( I32_T k ) -> RTN_ERR
+        {
+            if( k >= groupCount )
+            {
+                axes_[k - groupCount]->Start( axisBuffSize_ );
+                return ERR_NEXMOTION_SUCCESS;
+            }
+            RTN_ERR ret = groups_[k]->Start( groupBuffSize_ );
+            if( ret != ERR_NEXMOTION_SUCCESS )
+                PostMessage( NMC_MSG_TYPE_ERROR, ret, "Device", "Group%d: kinematics type %d is not supported by the simulator",
+                             k, groups_[k]->Params().I32( GRP_KIN ) );
+            return ret;
+        } ) );
+
+        UpdateIoDivider();
+        ioCounter_  = 0;
+        ioLastNs_   = 0;
+        ioStats_.Reset();
+        io_.Clear();
+        outputMasks_.Clear();
+        inputEdges_.Clear();
+        std::fill( outputBus_.begin(), outputBus_.end(), 0 );
+        std::fill( inputBus_.begin(), inputBus_.end(), 0 );
+        cycleCount_ = 0;
+        cycleStats_.Reset();
+        PublishStatus();
+        wdStopping_ = false;
+        wdDeadline_ = std::chrono::steady_clock::now() + wdTimeout_;
+        running_    = true;
+        state_      = NMC_DEVICE_STATE_OPERATION;
+    }
+
+    try
+    {
+        cycleThread_ = std::thread( &Device::CycleThread, this );
+    }
+    catch( ... )
+    {
+        std::lock_guard<std::mutex> command( cmdMutex_ );
+        std::lock_guard<PiMutex> guard( mutex_ );
+        AppendLocks appends( *this );
+        ShutdownMotion();
+        running_ = false;
+        state_   = NMC_DEVICE_STATE_READY;
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::Stop()
+{
+    std::lock_guard<std::mutex> lifecycle( lifecycleLock_ );
+    {
+        std::lock_guard<std::mutex> command( cmdMutex_ );
+        std::lock_guard<PiMutex> guard( mutex_ );
+        if( state_ == NMC_DEVICE_STATE_INIT )
+            return ERR_NEXMOTION_SYSTEM_NOT_READY;
+        running_ = false;
+    }
+    JoinCycleThread();
+
+    std::lock_guard<std::mutex> command( cmdMutex_ );
+    std::lock_guard<PiMutex> guard( mutex_ );
+    if( state_ == NMC_DEVICE_STATE_OPERATION )
+    {
+        AppendLocks appends( *this );
+        ShutdownMotion();
+        state_ = NMC_DEVICE_STATE_READY;
+        NotifyStatus();
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::RunRequest( RTN_ERR ( Device::*Func )() )
+{
+    if( requestThread_.joinable() ) requestThread_.join();
+    try
+    {
+        requestThread_ = std::thread( Func, this );
+    }
+    catch( ... )
+    {
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::StartRequest()
+{
+    return RunRequest( &Device::Start );
+}
+
+RTN_ERR Device::StopRequest()
+{
+    return RunRequest( &Device::Stop );
+}
+
+void Device::ShutdownMotion()
+{
+    for( size_t i = 0; i < axes_.size(); ++i )
+        axes_[i]->Shutdown();
+    for( size_t g = 0; g < groups_.size(); ++g )
+        groups_[g]->Shutdown();
+    wdStopping_ = false;
+    PublishStatus();
+}
+
+RTN_ERR Device::EnableAll()
+{
+    std::lock_guard<std::mutex> command( cmdMutex_ );
+    std::lock_guard<PiMutex> guard( mutex_ );
+    if( state_ != NMC_DEVICE_STATE_OPERATION )
+        return ERR_NEXMOTION_SYSTEM_NOT_READY;
+    AppendLocks appends( *this );
+    RTN_ERR ret = ERR_NEXMOTION_SUCCESS;
+    for( size_t i = 0; i < axes_.size() && ret == ERR_NEXMOTION_SUCCESS; ++i )
+        ret = axes_[i]->Enable();
+    for( size_t g = 0; g < groups_.size() && ret == ERR_NEXMOTION_SUCCESS; ++g )
+        ret = groups_[g]->Enable();
+    PublishStatus();
+    return ret;
+}
+
+void Device::PublishStatus()
+{
+    AxisSnap_T  axis;
+    GroupSnap_T group;
+    snapshot_.BeginPublish( cycleCount_ );
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        axes_[i]->Snapshot( &axis );
+        snapshot_.SetAxis( static_cast<I32_T>( i ), axis );
+        events_.UpdateAxis( static_cast<I32_T>( i ), axis.state, axes_[i]->BuffCount(), axes_[i]->DriveAlmCode() );
+    }
+    for( size_t g = 0; g < groups_.size(); ++g )
+    {
+        groups_[g]->Snapshot( &group );
+        snapshot_.SetGroup( static_cast<I32_T>( g ), group );
+        events_.UpdateGroup( static_cast<I32_T>( g ), group.state, groups_[g]->BuffCount() );
+    }
+    snapshot_.EndPublish();
+    NotifyStatus();
+    events_.UpdateMessages( NextMessageIndex() );
+    events_.Flush( cycleCount_ );
+}
+
+void Device::NotifyStatus()
+{
+    // Pairs with the fence of WaitStatus(): either the waiter sees the new status or it is counted here.
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    if( waiters_.load( std::memory_order_relaxed ) == 0 )
+        return;
+    // A waiter holds waitMutex_ from its test until it sleeps, so the notification cannot fall in between.
+    {
+        std::lock_guard<std::mutex> wait( waitMutex_ );
+    }
+    statusChanged_.notify_all();
+}
+
+RTN_ERR Device::WaitStatus( StatusCondition &Cond, U32_T WaitMs )
+{
+    std::unique_lock<std::mutex> lock( waitMutex_ );
+    waiters_.fetch_add( 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( WaitMs );
+    bool    timeout = false;
+    RTN_ERR ret;
+    for( ;; )
+    {
+        if( !Operating() )
+        {
+            ret = ERR_NEXMOTION_SYSTEM_NOT_READY;
+            break;
+        }
+        if( Cond.Test( snapshot_, &ret ) )
+            break;
+        if( timeout )
+        {
+            ret = ERR_NEXMOTION_PROCESS_TIMEOUT;
+            break;
+        }
+        if( WaitMs == NMC_WAIT_TIME_INFINITE )
+            statusChanged_.wait( lock );
+        else
+            timeout = ( statusChanged_.wait_until( lock, deadline ) == std::cv_status::timeout );
+    }
+
+    waiters_.fetch_sub( 1, std::memory_order_relaxed );
+    return ret;
+}
+
+void Device::JoinCycleThread()
+{
+    if( cycleThread_.joinable() ) cycleThread_.join();
+}
+
+RTN_ERR Device::WatchdogEnable( U32_T TimeoutMs, I32_T Mode )
+{
+    if( TimeoutMs < kWatchdogMinMs || TimeoutMs > kWatchdogMaxMs || ( Mode != 0 && Mode != 1 ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    wdEnabled_  = true;
+    wdMode_     = Mode;
+    wdTimeout_  = std::chrono::milliseconds( TimeoutMs );
+    wdDeadline_ = std::chrono::steady_clock::now() + wdTimeout_;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::WatchdogDisable()
+{
+    wdEnabled_ = false;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::WatchdogReset()
+{
+    if( !wdEnabled_ )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    wdDeadline_ = std::chrono::steady_clock::now() + wdTimeout_;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::SetParam( I32_T ParamNum, I32_T SubIndex, I32_T Value )
+{
+    NMC_RETURN_IF_ERR( params_.SetI32( ParamNum, SubIndex, Value, Operating() ) );
+    if( ParamNum == SYS_AXIS_COUNT || ParamNum == SYS_GROUP_COUNT )
+        Resize( params_.I32( SYS_AXIS_COUNT ), params_.I32( SYS_GROUP_COUNT ) );
+    else if( ParamNum == SYS_IO_CYCLES )
+        UpdateIoDivider();
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::GetParam( I32_T ParamNum, I32_T SubIndex, I32_T *PRetValue ) const
+{
+    NMC_RETURN_IF_ERR( params_.GetI32( ParamNum, SubIndex, PRetValue ) );
+    // The statistics of the cycle thread are not stored in the parameter set.
+    if( ParamNum == SYS_CYCLE_LATENCY )
+    {
+        switch( SubIndex )
+        {
+        case SYS_LATENCY_MIN: *PRetValue = cycleStats_.MinUs(); break;
+        case SYS_LATENCY_AVG: *PRetValue = cycleStats_.AvgUs(); break;
+        case SYS_LATENCY_MAX: *PRetValue = cycleStats_.MaxUs(); break;
+        case SYS_LATENCY_P99: *PRetValue = cycleStats_.PercentileUs( 99.0 ); break;
+        }
+    }
+    else if( ParamNum == SYS_CYCLE_OVERRUN )
+    {
+        *PRetValue = cycleStats_.Overruns();
+    }
+    else if( ParamNum == SYS_INPUT_EDGE_LOST )
+    {
+        *PRetValue = inputEdges_.Lost();
+    }
+    else if( ParamNum == SYS_EVENT_LOST )
+    {
+        *PRetValue = events_.Lost();
+    }
+    else if( ParamNum == SYS_IO_LATENCY )
+    {
+        switch( SubIndex )
+        {
+        case SYS_LATENCY_MIN: *PRetValue = ioStats_.MinUs(); break;
+        case SYS_LATENCY_AVG: *PRetValue = ioStats_.AvgUs(); break;
+        case SYS_LATENCY_MAX: *PRetValue = ioStats_.MaxUs(); break;
+        case SYS_LATENCY_P99: *PRetValue = ioStats_.PercentileUs( 99.0 ); break;
+        }
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ParamTxBegin( I32_T *PRetTxID )
+{
+    std::lock_guard<std::mutex> guard( txLock_ );
+    if( txs_.size() >= NMC_MAX_PARAM_TX )
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+    // Identifiers are not reused soon, a stale TxID of a closed transaction is rejected.
+    do { nextTxId_ = ( nextTxId_ + 1 ) & 0x7FFFFFFF; } while( txs_.count( nextTxId_ ) );
+    txs_[nextTxId_];
+    *PRetTxID = nextTxId_;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ParamTxStage( I32_T TxID, const ParamTxEntry_T &Entry )
+{
+    if( Entry.scope < 0 || Entry.scope >= PARAM_SCOPE_COUNT )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    std::lock_guard<std::mutex> guard( txLock_ );
+    std::map<I32_T, std::vector<ParamTxEntry_T> >::iterator tx = txs_.find( TxID );
+    if( tx == txs_.end() )
+        return ERR_NEXMOTION_OBJECT_ID_INVALID;
+    if( tx->second.size() >= NMC_MAX_PARAM_TX_ENTRIES )
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+    tx->second.push_back( Entry );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ParamTxAbort( I32_T TxID )
+{
+    std::lock_guard<std::mutex> guard( txLock_ );
+    return txs_.erase( TxID ) ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_OBJECT_ID_INVALID;
+}
+
+ParamSet *Device::ParamTxTarget( const ParamTxEntry_T &Entry, RTN_ERR *PRetErr )
+{
+    *PRetErr = ERR_NEXMOTION_OBJECT_ID_INVALID;
+    switch( Entry.scope )
+    {
+    case PARAM_SCOPE_DEVICE:
+        // The axis and group counts resize the device, they cannot be part of a transaction.
+        if( Entry.paramNum == SYS_AXIS_COUNT || Entry.paramNum == SYS_GROUP_COUNT )
+        {
+            *PRetErr = ERR_NEXMOTION_OPERATION_DENIED;
+            return 0;
+        }
+        return &params_;
+    case PARAM_SCOPE_AXIS:
+        return ( Entry.index >= 0 && Entry.index < AxisCount() ) ? &axes_[Entry.index]->Params() : 0;
+    case PARAM_SCOPE_GROUP:
+        return ( Entry.index >= 0 && Entry.index < GroupCount() ) ? &groups_[Entry.index]->Params() : 0;
+    default:
+        if( Entry.index < 0 || Entry.index >= GroupCount()
+            || Entry.groupAxisIndex < 0 || Entry.groupAxisIndex >= groups_[Entry.index]->AxisCount() )
+            return 0;
+        return &groups_[Entry.index]->AxisParams( Entry.groupAxisIndex );
+    }
+}
+
+RTN_ERR Device::ParamTxCommit( I32_T TxID, I32_T MaxCount, RTN_ERR *PRetEntryErrors, I32_T *PRetFailedCount )
+{
+    std::vector<ParamTxEntry_T> entries;
+    {
+        std::lock_guard<std::mutex> guard( txLock_ );
+        std::map<I32_T, std::vector<ParamTxEntry_T> >::iterator tx = txs_.find( TxID );
+        if( tx == txs_.end() )
+            return ERR_NEXMOTION_OBJECT_ID_INVALID;
+        entries.swap( tx->second );
+        txs_.erase( tx );
+    }
+
+    // Check every entry first. The device lock is held, so the motion cycle sees either none or all of the writes.
+    std::vector<ParamSet *> targets( entries.size() );
+    std::vector<I32_T>      slots( entries.size() );
+    RTN_ERR firstErr = ERR_NEXMOTION_SUCCESS;
+    I32_T   failed = 0;
+    for( size_t k = 0; k < entries.size(); ++k )
+    {
+        const ParamTxEntry_T &e = entries[k];
+        RTN_ERR ret;
+        targets[k] = ParamTxTarget( e, &ret );
+        if( targets[k] )
+            ret = targets[k]->Check( e.paramNum, e.subIndex, e.type, e.value, Operating(), &slots[k] );
+        if( PRetEntryErrors && static_cast<I32_T>( k ) < MaxCount )
+            PRetEntryErrors[k] = ret;
+        if( ret != ERR_NEXMOTION_SUCCESS )
+        {
+            if( failed++ == 0 ) firstErr = ret;
+        }
+    }
+    if( PRetFailedCount ) *PRetFailedCount = failed;
+    if( failed > 0 )
+        return firstErr;
+
+    AppendLocks appends( *this );
+    for( size_t k = 0; k < entries.size(); ++k )
+        targets[k]->SetCompiled( slots[k], entries[k].type, entries[k].value );
+    UpdateIoDivider();
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ExportParams( U32_T BufferSize, void *PRetBuffer, U32_T *PRetSizeByte )
+{
+    ParamBlobShape_T shape;
+    shape.axisCount = AxisCount();
+    for( I32_T g = 0; g < GroupCount(); ++g )
+        shape.groupAxisCounts.push_back( groups_[g]->AxisCount() );
+    *PRetSizeByte = ParamBlobBytes( shape );
+    if( !PRetBuffer )
+        return ERR_NEXMOTION_SUCCESS;
+    if( BufferSize < *PRetSizeByte )
+        return ERR_NEXMOTION_ACCESS_AREA_INVALID;
+
+    ParamBlobWriter out( shape, PRetBuffer );
+    out.Write( params_ );
+    for( I32_T i = 0; i < AxisCount(); ++i )
+        out.Write( axes_[i]->Params() );
+    for( I32_T g = 0; g < GroupCount(); ++g )
+    {
+        out.Write( groups_[g]->Params() );
+        for( I32_T a = 0; a < groups_[g]->AxisCount(); ++a )
+            out.Write( groups_[g]->AxisParams( a ) );
+    }
+    out.Finish();
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ImportParams( const void *PData, U32_T SizeByte, I32_T *PRetChangedCount )
+{
+    ParamBlobReader in;
+    NMC_RETURN_IF_ERR( in.Open( PData, SizeByte ) );
+    const ParamBlobShape_T &shape = in.Shape();
+    if( shape.axisCount != AxisCount() )
+        return ERR_NEXMOTION_AXIS_COUNT_INVALID;
+    if( static_cast<I32_T>( shape.groupAxisCounts.size() ) != GroupCount() )
+        return ERR_NEXMOTION_GROUP_COUNT_INVALID;
+    for( I32_T g = 0; g < GroupCount(); ++g )
+    {
+        if( shape.groupAxisCounts[g] != groups_[g]->AxisCount() )
+            return ERR_NEXMOTION_AXIS_COUNT_INVALID;
+    }
+
+    std::vector<ParamSet *> sets( 1, &params_ );
+    for( I32_T i = 0; i < AxisCount(); ++i )
+        sets.push_back( &axes_[i]->Params() );
+    for( I32_T g = 0; g < GroupCount(); ++g )
+    {
+        sets.push_back( &groups_[g]->Params() );
+        for( I32_T a = 0; a < groups_[g]->AxisCount(); ++a )
+            sets.push_back( &groups_[g]->AxisParams( a ) );
+    }
+
+    // Only the values which differ are checked, so an image exported in operation imports in operation as long as
+    // the parameters effective after start are unchanged. As for a transaction, the device lock is held and the
+    // motion cycle sees either none or all of the writes.
+    struct Change_T { ParamSet *set; I32_T slot; I32_T type; F64_T value; };
+    std::vector<Change_T> changes;
+    RTN_ERR firstErr = ERR_NEXMOTION_SUCCESS;
+    for( size_t k = 0; k < sets.size() && firstErr == ERR_NEXMOTION_SUCCESS; ++k )
+    {
+        ParamSet *set = sets[k];
+        ParamBlobForEach( set->Scope(), [&]( const ParamDesc_T &Desc, I32_T Slot, I32_T ParamNum, I32_T )
+        {
+            F64_T value = in.Next();
+            if( firstErr != ERR_NEXMOTION_SUCCESS || value == set->Compiled( Slot, Desc.type ) )
+                return;
+            if( set->Scope() == PARAM_SCOPE_DEVICE && ( ParamNum == SYS_AXIS_COUNT || ParamNum == SYS_GROUP_COUNT ) )
+                firstErr = ERR_NEXMOTION_OPERATION_DENIED;
+            else
+                firstErr = ParamSet::CheckValue( Desc, value, Operating() );
+            Change_T change = { set, Slot, Desc.type, value };
+            changes.push_back( change );
+        } );
+    }
+    if( firstErr != ERR_NEXMOTION_SUCCESS )
+        return firstErr;
+
+    AppendLocks appends( *this );
+    for( size_t k = 0; k < changes.size(); ++k )
+        changes[k].set->SetCompiled( changes[k].slot, changes[k].type, changes[k].value );
+    UpdateIoDivider();
+    if( PRetChangedCount ) *PRetChangedCount = static_cast<I32_T>( changes.size() );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ReadInput( U32_T OffsetByte, U32_T SizeByte, void *PRetValue ) const
+{
+    if( !PRetValue )
+        return ERR_NEXMOTION_POINTER_NULL;
+    if( OffsetByte > io_.InputSize() || SizeByte > io_.InputSize() - OffsetByte )
+        return ERR_NEXMOTION_ACCESS_AREA_INVALID;
+    if( SizeByte > 0 ) std::memcpy( PRetValue, io_.Input() + OffsetByte, SizeByte );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ReadOutput( U32_T OffsetByte, U32_T SizeByte, void *PRetValue ) const
+{
+    if( !PRetValue )
+        return ERR_NEXMOTION_POINTER_NULL;
+    if( OffsetByte > io_.OutputSize() || SizeByte > io_.OutputSize() - OffsetByte )
+        return ERR_NEXMOTION_ACCESS_AREA_INVALID;
+    if( SizeByte > 0 ) std::memcpy( PRetValue, io_.Output() + OffsetByte, SizeByte );
+    outputMasks_.Overlay( OffsetByte, SizeByte, static_cast<U8_T *>( PRetValue ) );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::WriteOutput( U32_T OffsetByte, U32_T SizeByte, const void *PValue )
+{
+    return outputMasks_.Write( OffsetByte, SizeByte, PValue, 0 );
+}
+
+RTN_ERR Device::WriteOutputBit( U32_T OffsetByte, U32_T BitIndex, bool Value )
+{
+    if( BitIndex > 7 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    U8_T mask  = static_cast<U8_T>( 1u << BitIndex );
+    U8_T value = Value ? mask : 0;
+    return outputMasks_.Write( OffsetByte, 1, &value, &mask );
+}
+
+RTN_ERR Device::WriteOutputMasked( U32_T OffsetByte, U32_T SizeByte, const void *PValue, const void *PMask )
+{
+    if( !PMask )
+        return ERR_NEXMOTION_POINTER_NULL;
+    return outputMasks_.Write( OffsetByte, SizeByte, PValue, PMask );
+}
+
+RTN_ERR Device::GatherInput( I32_T Count, const NmcIoItem_T *PItems, NmcIoValue_T *PRetValues ) const
+{
+    NMC_RETURN_IF_ERR( IoCheckItems( Count, PItems, io_.InputSize() ) );
+    IoGather( io_.Input(), 0, Count, PItems, PRetValues );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::GatherOutput( I32_T Count, const NmcIoItem_T *PItems, NmcIoValue_T *PRetValues ) const
+{
+    NMC_RETURN_IF_ERR( IoCheckItems( Count, PItems, io_.OutputSize() ) );
+    IoGather( io_.Output(), &outputMasks_, Count, PItems, PRetValues );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ScatterOutput( I32_T Count, const NmcIoItem_T *PItems, const NmcIoValue_T *PValues )
+{
+    NMC_RETURN_IF_ERR( IoCheckItems( Count, PItems, outputMasks_.Size() ) );
+    IoScatter( outputMasks_, Count, PItems, PValues );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::ReadEntry( I32_T Handle, void *PRetValue ) const
+{
+    const IoMapSlot_T *slot = ioMap_.Resolve( Handle );
+    if( !slot )
+        return ERR_NEXMOTION_OBJECT_ID_INVALID;
+    U8_T  data[sizeof( U64_T )];
+    U32_T size = ( slot->sizeByte == 0 ) ? 1 : slot->sizeByte;
+    if( slot->area == NMC_MEM_ENTRY_AREA_INPUT )
+        std::memcpy( data, io_.Input() + slot->offsetByte, size );
+    else
+        NMC_RETURN_IF_ERR( ReadOutput( slot->offsetByte, size, data ) );
+    if( slot->sizeByte == 0 )
+    {
+        BOOL_T bit = ( data[0] & slot->bitMask ) ? 1 : 0;
+        std::memcpy( PRetValue, &bit, sizeof( bit ) );
+    }
+    else
+    {
+        std::memcpy( PRetValue, data, size );
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Device::WriteEntry( I32_T Handle, const void *PValue )
+{
+    const IoMapSlot_T *slot = ioMap_.Resolve( Handle );
+    if( !slot )
+        return ERR_NEXMOTION_OBJECT_ID_INVALID;
+    if( slot->area != NMC_MEM_ENTRY_AREA_OUTPUT )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    if( slot->sizeByte == 0 )
+    {
+        BOOL_T bit;
+        std::memcpy( &bit, PValue, sizeof( bit ) );
+        U8_T value = bit ? slot->bitMask : 0;
+        return outputMasks_.Write( slot->offsetByte, 1, &value, &slot->bitMask );
+    }
+    return outputMasks_.Write( slot->offsetByte, slot->sizeByte, PValue, 0 );
+}
+
+RTN_ERR Device::StartIoCapture( I32_T Count, const NmcIoCaptureRange_T *PRanges, const char *PPath )
+{
+    // The memory sizes only change with the command lock held, the file is opened without blocking the cycle.
+    U32_T cycleTimeUs;
+    {
+        std::lock_guard<PiMutex> guard( mutex_ );
+        if( state_ == NMC_DEVICE_STATE_INIT )
+            return ERR_NEXMOTION_SYSTEM_NOT_READY;
+        cycleTimeUs = static_cast<U32_T>( params_.I32( SYS_CYCLE_TIME_US ) );
+    }
+    NMC_RETURN_IF_ERR( capture_.Open( Count, PRanges, io_.InputSize(), io_.OutputSize(), cycleTimeUs, PPath ) );
+    std::lock_guard<PiMutex> guard( mutex_ );
+    capture_.SetActive( true );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void Device::StopIoCapture()
+{
+    {
+        std::lock_guard<PiMutex> guard( mutex_ );
+        capture_.SetActive( false );
+    }
+    capture_.Close();
+}
+
+void Device::CycleThread()
+{
+    // The scheduling parameters cannot be modified in operation, they are read without the lock.
+    RtConfig_T rt;
+    rt.priority        = params_.I32( SYS_RT_PRIORITY );
+    rt.cpu             = params_.I32( SYS_RT_CPU );
+    rt.lockMemory      = params_.I32( SYS_RT_LOCK_MEMORY ) != 0;
+    rt.stackPrefaultKb = params_.I32( SYS_RT_STACK_KB );
+    RtApplyToCurrentThread( rt, "Device" );
+
+    CycleTimer timer;
+    timer.Start( params_.I32( SYS_CYCLE_TIME_US ) );
+    for( ;; )
+    {
+        I64_T latency = timer.WaitDeadline();
+
+        std::lock_guard<PiMutex> guard( mutex_ );
+        if( !running_ ) break;
+        Cycle();
+        cycleStats_.Add( latency, timer.Advance() );
+        if( !running_ ) break;
+    }
+}
+
+void Device::Cycle()
+{
+    F64_T dt = params_.I32( SYS_CYCLE_TIME_US ) * 1e-6;
+    ++cycleCount_;
+
+    if( wdEnabled_ && !wdStopping_ && std::chrono::steady_clock::now() >= wdDeadline_ )
+    {
+        PostMessage( NMC_MSG_TYPE_ERROR, ERR_NEXMOTION_PROCESS_TIMEOUT, "Device", "Watchdog timer expired (mode %d)", wdMode_ );
+        wdEnabled_ = false;
+        // As the API calls which stop every object, keep the appenders out of the buffers and endAcs_.
+        AppendLocks appends( *this );
+        if( wdMode_ == 0 )
+        {
+            ShutdownMotion();
+            running_ = false;
+            state_   = NMC_DEVICE_STATE_READY;
+            NotifyStatus();
+            return;
+        }
+        for( size_t i = 0; i < axes_.size(); ++i )
+            axes_[i]->Stop();
+        for( size_t g = 0; g < groups_.size(); ++g )
+            groups_[g]->Stop();
+        wdStopping_ = true;
+    }
+
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        if( axes_[i]->Cycle( dt ) )
+            PostMessage( NMC_MSG_TYPE_ERROR, ERR_NEXMOTION_SUCCESS, "Axis", "Axis%d: software limit reached, status 0x%08X",
+                         static_cast<I32_T>( i ), axes_[i]->Status() );
+    }
+    for( size_t g = 0; g < groups_.size(); ++g )
+    {
+        if( groups_[g]->Cycle( dt ) )
+            PostMessage( NMC_MSG_TYPE_ERROR, ERR_NEXMOTION_SUCCESS, "Group", "Group%d: motion aborted by an error, status 0x%08X",
+                         static_cast<I32_T>( g ), groups_[g]->Status() );
+    }
+
+    if( ++ioCounter_ >= ioDivider_ )
+    {
+        ioCounter_ = 0;
+        ExchangeIo();
+    }
+
+    if( wdStopping_ )
+    {
+        // Watchdog mode 1: leave the operation state once every axis and group has stopped.
+        bool stopping = false;
+        for( size_t i = 0; i < axes_.size(); ++i )
+            stopping |= ( axes_[i]->State() == NMC_AXIS_STATE_STOPPING );
+        for( size_t g = 0; g < groups_.size(); ++g )
+            stopping |= ( groups_[g]->State() == NMC_GROUP_STATE_STOPPING );
+        if( !stopping )
+        {
+            AppendLocks appends( *this );
+            ShutdownMotion();
+            running_ = false;
+            state_   = NMC_DEVICE_STATE_READY;
+            NotifyStatus();
+            return;
+        }
+    }
+    PublishStatus();
+}
+
+void Device::ExchangeIo()
+{
+    // The application image and the bus image form a double buffer: the application accesses its image at any
+    // time, the whole of it is latched to and from the bus here, at the end of a cycle and under the device lock.
+    // The output writes of the API since the last exchange are applied first, so they go out together.
+    I64_T now = MonotonicNs();
+    if( ioLastNs_ != 0 )
+        ioStats_.Add( now - ioLastNs_, 0 );
+    ioLastNs_ = now;
+
+    io_.BeginExchange();
+    outputMasks_.Apply( io_.Output() );
+    if( !outputBus_.empty() ) std::memcpy( &outputBus_[0], io_.Output(), outputBus_.size() );
+    if( ioLoopback_ )
+    {
+        // The simulated bus wires every output byte back to the input byte at the same offset.
+        size_t n = std::min( inputBus_.size(), outputBus_.size() );
+        if( n > 0 ) std::memcpy( &inputBus_[0], &outputBus_[0], n );
+    }
+    if( !inputBus_.empty() )
+    {
+        // The application image still holds the inputs of the previous exchange.
+        inputEdges_.Detect( io_.Input(), &inputBus_[0], cycleCount_ );
+        std::memcpy( io_.Input(), &inputBus_[0], inputBus_.size() );
+    }
+    io_.EndExchange();
+    if( capture_.Active() )
+        capture_.Capture( io_.Input(), outputBus_.empty() ? 0 : &outputBus_[0], cycleCount_ );
+}
+
+void Device::UpdateIoDivider()
+{
+    // The exchange rate may change in operation, the next exchange is due after the new number of cycles at most.
+    I32_T cycles = params_.I32( SYS_IO_CYCLES );
+    if( cycles == 0 )
+    {
+        I32_T cycleUs = params_.I32( SYS_CYCLE_TIME_US );
+        cycles = ( kIoPeriodUs + cycleUs - 1 ) / cycleUs;
+    }
+    ioDivider_ = cycles;
+}
+
+} // namespace nmc
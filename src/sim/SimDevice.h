@@ -0,0 +1,254 @@
+/*!
+ * @file        SimDevice.h
+ * @brief       Simulated device: lifecycle, motion cycle thread, watchdog and I/O images
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_DEVICE_H
+#define __NEXMOTION_SIM_DEVICE_H
+
+#include "SimAxis.h"
+#include "SimConfig.h"
+#include "SimEvent.h"
+#include "SimGroup.h"
+#include "SimInputEdge.h"
+#include "SimIoCapture.h"
+#include "SimIoGather.h"
+#include "SimIoImage.h"
+#include "SimIoMap.h"
+#include "SimOutputMask.h"
+#include "SimRealtime.h"
+#include "SimSnapshot.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nmc
+{
+
+//! Condition of Device::WaitStatus(), tested on the status snapshot.
+class StatusCondition
+{
+public:
+    virtual ~StatusCondition() {}
+    //! Return true when the wait is over, *PRetErr is then the result of the wait.
+    virtual bool Test( const StatusSnapshot &Snap, RTN_ERR *PRetErr ) = 0;
+};
+
+/*!
+ * @brief A simulated NexMotion device.
+ *
+ * The motion cycle runs on its own thread every system parameter 0x00 microseconds and calls
+ * Cycle() with the device lock held. The thread sleeps on absolute deadlines and is scheduled
+ * as configured by system parameters 0x10 ~ 0x13; its wake up latency is reported by the read
+ * only system parameters 0x20 and 0x21. The API functions take the same lock, so every API call
+ * sees the device between two cycles. It inherits the priority of the cycle (see PiMutex), so an API
+ * caller holding it is not preempted by the threads between its priority and that of the cycle.
+ *
+ * The API functions are serialized by CommandMutex(), which the cycle thread never takes. A buffered
+ * motion command is appended to the lock free motion buffer of a moving axis or group (see
+ * Axis::Appendable()) under the append lock of that axis or group only, and the free buffer space is
+ * read with no lock at all, so these calls wait neither for the cycle nor for the other API calls.
+ * FindAxis() and FindGroup() reach the objects without CommandMutex(). The locks are taken in the
+ * order lifecycle lock, CommandMutex(), Mutex(), append locks (see AppendLocks).
+ * The cycle takes the append locks only when the watchdog stops the motion, they inherit priority as
+ * Mutex() does.
+ *
+ * The status of the axes and groups is published to Snapshot() at the end of every cycle and after
+ * every API call which holds the device lock, the status getters read it without any lock.
+ * WaitStatus() sleeps until a publication satisfies a condition; the publisher wakes the waiting
+ * threads only if there are any, so the cycle does not pay for the waits. Each publication also
+ * feeds Events(), which detects the subscribed events for an event loop.
+ *
+ * Lifecycle functions (LoadIniConfig, LoadConfig, ResetConfig, Start, Stop, EnableAll) take the locks
+ * themselves and must be called without them. All the other functions require the caller to hold Mutex().
+ */
+class Device
+{
+public:
+    Device( I32_T DevType, I32_T DevIndex );
+    ~Device();
+
+    PiMutex    &Mutex()        { return mutex_; }
+    std::mutex &CommandMutex() { return cmdMutex_; }
+    I32_T       DevType() const  { return devType_; }
+    I32_T       DevIndex() const { return devIndex_; }
+    I32_T       State() const    { return state_; }
+
+    // Lifecycle
+    //! ReadIniConfig() and LoadConfig().
+    RTN_ERR LoadIniConfig();
+    //! Read the configuration file selected by NMC_SetIniPath(), PRetSource is its path for messages.
+    RTN_ERR ReadIniConfig( DeviceConfig_T *PRetConfig, std::string *PRetSource );
+    //! Apply a configuration, the axes and groups are configured in parallel.
+    RTN_ERR LoadConfig( const DeviceConfig_T &Config, const std::string &Source );
+    RTN_ERR ResetConfig();
+    RTN_ERR Start();
+    RTN_ERR Stop();
+    //! Run Start() or Stop() on the request thread of the device.
+    RTN_ERR StartRequest();
+    RTN_ERR StopRequest();
+    //! Enable every axis and group, as NMC_DeviceEnableAll().
+    RTN_ERR EnableAll();
+
+    RTN_ERR WatchdogEnable( U32_T TimeoutMs, I32_T Mode );
+    RTN_ERR WatchdogDisable();
+    RTN_ERR WatchdogReset();
+
+    RTN_ERR SetParam( I32_T ParamNum, I32_T SubIndex, I32_T Value );
+    RTN_ERR GetParam( I32_T ParamNum, I32_T SubIndex, I32_T *PRetValue ) const;
+
+    // Parameter transactions. Staging takes the transaction lock only, the commit requires the device lock.
+    RTN_ERR ParamTxBegin( I32_T *PRetTxID );
+    RTN_ERR ParamTxStage( I32_T TxID, const ParamTxEntry_T &Entry );
+    RTN_ERR ParamTxAbort( I32_T TxID );
+    /*!
+     * Check every staged write and apply them all, or none if one fails. The transaction is closed in both cases.
+     * PRetEntryErrors receives the result of the first MaxCount entries, in the staging order.
+     */
+    RTN_ERR ParamTxCommit( I32_T TxID, I32_T MaxCount, RTN_ERR *PRetEntryErrors, I32_T *PRetFailedCount );
+
+    // Parameter images, see SimParamBlob.h
+    //! Write the image of every parameter if BufferSize is enough. *PRetSizeByte is the size of the image.
+    RTN_ERR ExportParams( U32_T BufferSize, void *PRetBuffer, U32_T *PRetSizeByte );
+    //! Check every value of an image which differs from the current one, then apply them all or none.
+    RTN_ERR ImportParams( const void *PData, U32_T SizeByte, I32_T *PRetChangedCount );
+
+    I32_T   AxisCount() const  { return static_cast<I32_T>( axes_.size() ); }
+    I32_T   GroupCount() const { return static_cast<I32_T>( groups_.size() ); }
+    Axis   &AxisAt( I32_T Index )  { return *axes_[Index]; }
+    Group  &GroupAt( I32_T Index ) { return *groups_[Index]; }
+    //! Axis or group at Index without any device lock, null if there is none. The object lives as long as the pointer.
+    std::shared_ptr<Axis>  FindAxis( I32_T Index ) const;
+    std::shared_ptr<Group> FindGroup( I32_T Index ) const;
+    bool    Operating() const { return state_ == NMC_DEVICE_STATE_OPERATION; }
+
+    //! Lock free status of the axes and groups, its storage never moves.
+    const StatusSnapshot &Snapshot() const { return snapshot_; }
+    void    PublishStatus();
+    //! Wait until Cond is met by a published status or the device leaves the operation state. Called without any lock.
+    RTN_ERR WaitStatus( StatusCondition &Cond, U32_T WaitMs );
+    EventMonitor &Events() { return events_; }
+
+    // Process images
+    U32_T   InputSize() const  { return io_.InputSize(); }
+    U32_T   OutputSize() const { return io_.OutputSize(); }
+    //! Images of the application, also accessed directly through NMC_DeviceGetIoImage().
+    IoImage &Io() { return io_; }
+    RTN_ERR ReadInput( U32_T OffsetByte, U32_T SizeByte, void *PRetValue ) const;
+    //! Read the outputs with the writes not applied yet. The caller holds the device lock.
+    RTN_ERR ReadOutput( U32_T OffsetByte, U32_T SizeByte, void *PRetValue ) const;
+    // Output writes, merged into outputMasks_ and applied at the next exchange. Thread safe, with no lock.
+    RTN_ERR WriteOutput( U32_T OffsetByte, U32_T SizeByte, const void *PValue );
+    RTN_ERR WriteOutputBit( U32_T OffsetByte, U32_T BitIndex, bool Value );
+    RTN_ERR WriteOutputMasked( U32_T OffsetByte, U32_T SizeByte, const void *PValue, const void *PMask );
+    //! Typed fields of the images, the reads with the device lock and the write with no lock.
+    RTN_ERR GatherInput( I32_T Count, const NmcIoItem_T *PItems, NmcIoValue_T *PRetValues ) const;
+    RTN_ERR GatherOutput( I32_T Count, const NmcIoItem_T *PItems, NmcIoValue_T *PRetValues ) const;
+    RTN_ERR ScatterOutput( I32_T Count, const NmcIoItem_T *PItems, const NmcIoValue_T *PValues );
+    //! Named entries of the I/O memory, NMC_MemEntryFind() resolves a name to a handle of ReadEntry() and WriteEntry().
+    const IoMap &IoEntries() const { return ioMap_; }
+    RTN_ERR ReadEntry( I32_T Handle, void *PRetValue ) const;
+    RTN_ERR WriteEntry( I32_T Handle, const void *PValue );
+    //! Edges of the subscribed inputs, detected at each exchange.
+    InputEdgeMonitor &InputEdges() { return inputEdges_; }
+    //! Capture of I/O memory ranges to a file at each exchange. The caller holds CommandMutex() but not Mutex().
+    RTN_ERR StartIoCapture( I32_T Count, const NmcIoCaptureRange_T *PRanges, const char *PPath );
+    void    StopIoCapture();
+    void    IoCaptureStatus( NmcIoCaptureStatus_T *PRetStatus ) const { capture_.Status( PRetStatus ); }
+
+private:
+    Device( const Device & );
+    Device &operator=( const Device & );
+
+    RTN_ERR ApplyConfig( const DeviceConfig_T &Config );
+    RTN_ERR ApplyAxisConfig( const DeviceConfig_T &Config, I32_T Index );
+    RTN_ERR ApplyGroupConfig( const DeviceConfig_T &Config, I32_T Index );
+    void    Resize( I32_T AxisCount, I32_T GroupCount );
+    void    ShutdownMotion();
+    void    JoinCycleThread();
+    void    CycleThread();
+    void    Cycle();
+    void    ExchangeIo();
+    void    UpdateIoDivider();
+    RTN_ERR RunRequest( RTN_ERR ( Device::*Func )() );
+    ParamSet *ParamTxTarget( const ParamTxEntry_T &Entry, RTN_ERR *PRetErr );
+    void    NotifyStatus();
+
+    std::mutex                 lifecycleLock_;  //!< Serializes the lifecycle functions
+    std::mutex                 cmdMutex_;       //!< Serializes the API callers
+    PiMutex                    mutex_;          //!< Protects everything below
+    I32_T                      devType_;
+    I32_T                      devIndex_;
+    std::atomic<I32_T>         state_;
+    ParamSet                   params_;
+    I32_T                      axisBuffSize_;
+    I32_T                      groupBuffSize_;
+    std::vector<std::shared_ptr<Axis> >  axes_;
+    std::vector<std::shared_ptr<Group> > groups_;
+    std::shared_ptr<Axis>      axisSlots_[kMaxAxes];    //!< axes_ for FindAxis(), accessed by std::atomic_load/store only
+    std::shared_ptr<Group>     groupSlots_[kMaxGroups];
+
+    std::thread                cycleThread_;
+    std::thread                requestThread_;
+    bool                       running_;
+    U64_T                      cycleCount_;
+    CycleStats                 cycleStats_;
+    StatusSnapshot             snapshot_;
+    std::mutex                 waitMutex_;      //!< Taken after mutex_, orders the notifications with the tests of WaitStatus()
+    std::condition_variable    statusChanged_;
+    std::atomic<I32_T>         waiters_;
+    EventMonitor               events_;
+    std::mutex                 txLock_;         //!< Leaf lock, protects the staged parameter transactions
+    std::map<I32_T, std::vector<ParamTxEntry_T> > txs_;
+    I32_T                      nextTxId_;
+
+    bool                       wdEnabled_;
+    I32_T                      wdMode_;
+    std::chrono::milliseconds  wdTimeout_;
+    std::chrono::steady_clock::time_point wdDeadline_;
+    bool                       wdStopping_;     //!< Watchdog expired in mode 1, waiting for the motion to stop
+
+    bool                       ioLoopback_;
+    I32_T                      ioDivider_;      //!< Exchange the process images every ioDivider_ cycles
+    I32_T                      ioCounter_;
+    I64_T                      ioLastNs_;       //!< MonotonicNs() of the last exchange, 0 before the first one
+    CycleStats                 ioStats_;        //!< Interval between exchanges, system parameter 0x22
+    std::vector<U8_T>          outputBus_;      //!< Outputs sent in the last exchange
+    std::vector<U8_T>          inputBus_;       //!< Inputs received in the last exchange
+    IoImage                    io_;             //!< Inputs read and outputs written by the application
+    OutputMaskBuffer           outputMasks_;    //!< Output writes of the API, applied to io_ at each exchange
+    IoMap                      ioMap_;
+    InputEdgeMonitor           inputEdges_;
+    IoCapture                  capture_;
+};
+
+/*!
+ * @brief Append lock of every axis and group of a device, for the calls which modify several of them.
+ *
+ * Taken after the device lock, it keeps the appenders out of the motion buffers and parameters while
+ * the objects are reconfigured, started or stopped, by the API or by the watchdog in the motion cycle.
+ * It does not allocate.
+ */
+class AppendLocks
+{
+public:
+    explicit AppendLocks( Device &Dev );
+    ~AppendLocks();
+
+private:
+    AppendLocks( const AppendLocks & );
+    AppendLocks &operator=( const AppendLocks & );
+
+    PiMutex *locks_[kMaxAxes + kMaxGroups];
+    I32_T    count_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_DEVICE_H
@@ -0,0 +1,183 @@
+/*!
+ * @file        SimEvent.cpp
+ * @brief       Event records of a device, signalled on an eventfd for event loops
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimEvent.h"
+#include "SimRealtime.h"
+#include <algorithm>
+#include <cerrno>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace nmc
+{
+
+namespace
+{
+
+const size_t kMaxEvents = 1024;     // Queue size, a record is dropped beyond
+
+} // namespace
+
+EventMonitor::EventMonitor()
+    : mask_( 0 )
+    , lowWater_( 0 )
+    , messageValid_( false )
+    , nextMessage_( 0 )
+    , head_( 0 )
+    , count_( 0 )
+    , lost_( 0 )
+    , fd_( -1 )
+    , signalled_( false )
+{
+}
+
+EventMonitor::~EventMonitor()
+{
+    if( fd_ >= 0 ) ::close( fd_ );
+}
+
+RTN_ERR EventMonitor::Subscribe( U32_T EventMask, I32_T BuffLowWater, I32_T *PRetFd )
+{
+    if( ( EventMask & ~static_cast<U32_T>( NMC_EVENT_MASK_ALL ) ) != 0 || BuffLowWater < 0 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    std::lock_guard<std::mutex> guard( lock_ );
+    if( fd_ < 0 )
+    {
+        fd_ = ::eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+        if( fd_ < 0 )
+            return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+        if( count_ > 0 )
+        {
+            U64_T one = 1;
+            signalled_ = ( ::write( fd_, &one, sizeof( one ) ) == sizeof( one ) );
+        }
+    }
+    mask_     = EventMask;
+    lowWater_ = BuffLowWater;
+    if( PRetFd ) *PRetFd = fd_;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void EventMonitor::Resize( I32_T AxisCount, I32_T GroupCount )
+{
+    Last_T none = { false, 0, 0, 0 };
+    axes_.assign( AxisCount, none );
+    groups_.assign( GroupCount, none );
+    // Enough for every record of one update, the motion cycle does not allocate.
+    pending_.reserve( 3 * AxisCount + 2 * GroupCount + 1 );
+    std::lock_guard<std::mutex> guard( lock_ );
+    if( queue_.empty() )
+        queue_.resize( kMaxEvents );
+}
+
+void EventMonitor::Add( I32_T Type, I32_T Index, I32_T PrevValue, I32_T Value )
+{
+    if( ( mask_ & ( 1u << Type ) ) == 0 )
+        return;
+    NmcEvent_T ev;
+    ev.type      = Type;
+    ev.index     = Index;
+    ev.prevValue = PrevValue;
+    ev.value     = Value;
+    ev.cycleCount  = 0;
+    ev.timestampNs = 0;
+    pending_.push_back( ev );
+}
+
+void EventMonitor::UpdateAxis( I32_T Index, I32_T State, I32_T BuffCount, I32_T AlmCode )
+{
+    Last_T &last = axes_[Index];
+    if( last.valid )
+    {
+        if( State != last.state )
+            Add( NMC_EVENT_AXIS_STATE, Index, last.state, State );
+        if( last.buffCount > lowWater_ && BuffCount <= lowWater_ )
+            Add( NMC_EVENT_AXIS_BUFF_LOW, Index, last.buffCount, BuffCount );
+        if( AlmCode != last.almCode )
+            Add( NMC_EVENT_AXIS_DRIVE_ALM, Index, last.almCode, AlmCode );
+    }
+    last.valid     = true;
+    last.state     = State;
+    last.buffCount = BuffCount;
+    last.almCode   = AlmCode;
+}
+
+void EventMonitor::UpdateGroup( I32_T Index, I32_T State, I32_T BuffCount )
+{
+    Last_T &last = groups_[Index];
+    if( last.valid )
+    {
+        if( State != last.state )
+            Add( NMC_EVENT_GROUP_STATE, Index, last.state, State );
+        if( last.buffCount > lowWater_ && BuffCount <= lowWater_ )
+            Add( NMC_EVENT_GROUP_BUFF_LOW, Index, last.buffCount, BuffCount );
+    }
+    last.valid     = true;
+    last.state     = State;
+    last.buffCount = BuffCount;
+}
+
+void EventMonitor::UpdateMessages( U32_T NextIndex )
+{
+    if( messageValid_ && NextIndex != nextMessage_ )
+        Add( NMC_EVENT_MESSAGE, -1, static_cast<I32_T>( nextMessage_ ), static_cast<I32_T>( NextIndex ) );
+    messageValid_ = true;
+    nextMessage_  = NextIndex;
+}
+
+void EventMonitor::Flush( U64_T CycleCount )
+{
+    if( pending_.empty() )
+        return;
+    U64_T now = static_cast<U64_T>( MonotonicNs() );
+    for( size_t i = 0; i < pending_.size(); ++i )
+    {
+        pending_[i].cycleCount  = CycleCount;
+        pending_[i].timestampNs = now;
+    }
+
+    std::lock_guard<std::mutex> guard( lock_ );
+    for( size_t i = 0; i < pending_.size(); ++i )
+    {
+        if( count_ >= queue_.size() )
+        {
+            lost_.fetch_add( 1, std::memory_order_relaxed );
+            continue;
+        }
+        queue_[( head_ + count_++ ) % queue_.size()] = pending_[i];
+    }
+    pending_.clear();
+    if( !signalled_ && fd_ >= 0 )
+    {
+        U64_T one = 1;
+        signalled_ = ( ::write( fd_, &one, sizeof( one ) ) == sizeof( one ) );
+    }
+}
+
+I32_T EventMonitor::Pop( NmcEvent_T *PRetEvents, I32_T MaxCount )
+{
+    std::lock_guard<std::mutex> guard( lock_ );
+    I32_T count = static_cast<I32_T>( std::min( count_, static_cast<size_t>( MaxCount ) ) );
+    for( I32_T i = 0; i < count; ++i )
+    {
+        PRetEvents[i] = queue_[head_];
+        head_ = ( head_ + 1 ) % queue_.size();
+    }
+    count_ -= count;
+    if( count_ == 0 && signalled_ )
+    {
+        // Reset the counter: the fd is readable again with the next record.
+        U64_T value;
+        while( ::read( fd_, &value, sizeof( value ) ) < 0 && errno == EINTR )
+        {
+        }
+        signalled_ = false;
+    }
+    return count;
+}
+
+} // namespace nmc
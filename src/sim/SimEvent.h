@@ -0,0 +1,84 @@
+/*!
+ * @file        SimEvent.h
+ * @brief       Event records of a device, signalled on an eventfd for event loops
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_EVENT_H
+#define __NEXMOTION_SIM_EVENT_H
+
+#include "SimCommon.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace nmc
+{
+
+/*!
+ * @brief Detects the subscribed events of a device and queues their records.
+ *
+ * The device calls the Update functions after each status publication with the device lock held;
+ * they compare the new values with the last ones and collect the records, Flush() moves them to the
+ * queue. The queue has its own lock, taken last and only when there are records, so Pop() does not
+ * wait for the motion cycle. The eventfd is readable while the queue is not empty. The queue is a ring
+ * allocated by Resize(): a record which finds it full is dropped and counted by Lost().
+ */
+class EventMonitor
+{
+public:
+    EventMonitor();
+    ~EventMonitor();
+
+    //! Set the events to detect (NMC_EVENT_MASK_*), create the eventfd on the first call. The caller holds the device lock.
+    RTN_ERR Subscribe( U32_T EventMask, I32_T BuffLowWater, I32_T *PRetFd );
+    //! Set the number of axes and groups, the values seen next are not compared. The caller holds the device lock.
+    void    Resize( I32_T AxisCount, I32_T GroupCount );
+
+    // Detection, the caller holds the device lock.
+    void    UpdateAxis( I32_T Index, I32_T State, I32_T BuffCount, I32_T AlmCode );
+    void    UpdateGroup( I32_T Index, I32_T State, I32_T BuffCount );
+    void    UpdateMessages( U32_T NextIndex );
+    void    Flush( U64_T CycleCount );
+
+    //! Move up to MaxCount records to PRetEvents. Called without the device lock.
+    I32_T   Pop( NmcEvent_T *PRetEvents, I32_T MaxCount );
+    //! Records dropped because the queue was full (system parameter 0x24).
+    I32_T   Lost() const { return static_cast<I32_T>( lost_.load( std::memory_order_relaxed ) ); }
+
+private:
+    EventMonitor( const EventMonitor & );
+    EventMonitor &operator=( const EventMonitor & );
+
+    struct Last_T
+    {
+        bool  valid;
+        I32_T state;
+        I32_T buffCount;
+        I32_T almCode;
+    };
+
+    void    Add( I32_T Type, I32_T Index, I32_T PrevValue, I32_T Value );
+
+    // Detection, protected by the device lock
+    U32_T                   mask_;
+    I32_T                   lowWater_;
+    std::vector<Last_T>     axes_;
+    std::vector<Last_T>     groups_;
+    bool                    messageValid_;
+    U32_T                   nextMessage_;
+    std::vector<NmcEvent_T> pending_;
+
+    // Queue
+    std::mutex              lock_;
+    std::vector<NmcEvent_T> queue_;         //!< Ring of kMaxEvents records
+    size_t                  head_;          //!< Oldest record
+    size_t                  count_;
+    std::atomic<U32_T>      lost_;
+    int                     fd_;
+    bool                    signalled_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_EVENT_H
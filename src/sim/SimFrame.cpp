@@ -0,0 +1,342 @@
+/*!
+ * @file        SimFrame.cpp
+ * @brief       Homogeneous frame math for coordinate transforms and calibration
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimFrame.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace nmc
+{
+
+namespace
+{
+
+F64_T NearestAngle( F64_T Angle, F64_T Ref )
+{
+    return Angle + 360.0 * std::floor( ( Ref - Angle ) / 360.0 + 0.5 );
+}
+
+F64_T WrapAngle( F64_T Angle )
+{
+    return NearestAngle( Angle, 0.0 );
+}
+
+void RotationToAbc( const F64_T R[3][3], const F64_T *PRefAbc, F64_T PRetAbc[3] )
+{
+    F64_T ref[3] = { 0.0, 0.0, 0.0 };
+    if( PRefAbc ) std::memcpy( ref, PRefAbc, sizeof( ref ) );
+
+    F64_T cand[2][3];
+    F64_T cb = std::sqrt( R[0][0] * R[0][0] + R[1][0] * R[1][0] );
+    if( cb > 1e-9 )
+    {
+        cand[0][0] = RadToDeg( std::atan2( R[1][0], R[0][0] ) );
+        cand[0][1] = RadToDeg( std::atan2( -R[2][0], cb ) );
+        cand[0][2] = RadToDeg( std::atan2( R[2][1], R[2][2] ) );
+        cand[1][0] = cand[0][0] + 180.0;
+        cand[1][1] = 180.0 - cand[0][1];
+        cand[1][2] = cand[0][2] + 180.0;
+    }
+    else
+    {
+        // Gimbal lock, keep a at the reference and put the remaining rotation on c.
+        F64_T a = ref[0];
+        F64_T b = ( R[2][0] < 0.0 ) ? 90.0 : -90.0;
+        F64_T c = ( R[2][0] < 0.0 ) ? a + RadToDeg( std::atan2( R[0][1], R[0][2] ) )
+                                    : RadToDeg( std::atan2( -R[0][1], -R[0][2] ) ) - a;
+        cand[0][0] = cand[1][0] = a;
+        cand[0][1] = cand[1][1] = b;
+        cand[0][2] = cand[1][2] = c;
+    }
+
+    F64_T best = -1.0;
+    for( I32_T k = 0; k < 2; ++k )
+    {
+        F64_T abc[3];
+        F64_T cost = 0.0;
+        for( I32_T i = 0; i < 3; ++i )
+        {
+            abc[i] = PRefAbc ? NearestAngle( cand[k][i], ref[i] ) : WrapAngle( cand[k][i] );
+            cost += std::fabs( abc[i] - ref[i] );
+        }
+        if( best < 0.0 || cost < best - 1e-9 )
+        {
+            best = cost;
+            std::memcpy( PRetAbc, abc, sizeof( abc ) );
+        }
+    }
+}
+
+//! Solve the N x N linear system A x = b in place (Gaussian elimination with partial pivoting).
+bool SolveLinear( F64_T *A, F64_T *b, I32_T N )
+{
+    for( I32_T col = 0; col < N; ++col )
+    {
+        I32_T pivot = col;
+        for( I32_T row = col + 1; row < N; ++row )
+            if( std::fabs( A[row * N + col] ) > std::fabs( A[pivot * N + col] ) ) pivot = row;
+        if( std::fabs( A[pivot * N + col] ) < 1e-10 )
+            return false;
+        if( pivot != col )
+        {
+            for( I32_T k = 0; k < N; ++k ) std::swap( A[col * N + k], A[pivot * N + k] );
+            std::swap( b[col], b[pivot] );
+        }
+        for( I32_T row = col + 1; row < N; ++row )
+        {
+            F64_T f = A[row * N + col] / A[col * N + col];
+            for( I32_T k = col; k < N; ++k ) A[row * N + k] -= f * A[col * N + k];
+            b[row] -= f * b[col];
+        }
+    }
+    for( I32_T row = N - 1; row >= 0; --row )
+    {
+        F64_T s = b[row];
+        for( I32_T k = row + 1; k < N; ++k ) s -= A[row * N + k] * b[k];
+        b[row] = s / A[row * N + row];
+    }
+    return true;
+}
+
+} // namespace
+
+F64_T Vec3Dot( const F64_T *A, const F64_T *B ) { return A[0] * B[0] + A[1] * B[1] + A[2] * B[2]; }
+F64_T Vec3Norm( const F64_T *A ) { return std::sqrt( Vec3Dot( A, A ) ); }
+
+void Vec3Cross( const F64_T *A, const F64_T *B, F64_T *PRet )
+{
+    F64_T c[3] = { A[1] * B[2] - A[2] * B[1], A[2] * B[0] - A[0] * B[2], A[0] * B[1] - A[1] * B[0] };
+    std::memcpy( PRet, c, sizeof( c ) );
+}
+
+void Vec3Sub( const F64_T *A, const F64_T *B, F64_T *PRet )
+{
+    for( I32_T i = 0; i < 3; ++i ) PRet[i] = A[i] - B[i];
+}
+
+bool Vec3Normalize( F64_T *A )
+{
+    F64_T n = Vec3Norm( A );
+    if( n < 1e-12 ) return false;
+    for( I32_T i = 0; i < 3; ++i ) A[i] /= n;
+    return true;
+}
+
+void FrameIdentity( Frame_T *PFrame )
+{
+    std::memset( PFrame, 0, sizeof( *PFrame ) );
+    PFrame->r[0][0] = PFrame->r[1][1] = PFrame->r[2][2] = 1.0;
+}
+
+void FrameFromPose( const F64_T PPose[6], Frame_T *PFrame )
+{
+    F64_T sa = std::sin( DegToRad( PPose[3] ) ), ca = std::cos( DegToRad( PPose[3] ) );
+    F64_T sb = std::sin( DegToRad( PPose[4] ) ), cb = std::cos( DegToRad( PPose[4] ) );
+    F64_T sc = std::sin( DegToRad( PPose[5] ) ), cc = std::cos( DegToRad( PPose[5] ) );
+
+    PFrame->r[0][0] = ca * cb; PFrame->r[0][1] = ca * sb * sc - sa * cc; PFrame->r[0][2] = ca * sb * cc + sa * sc;
+    PFrame->r[1][0] = sa * cb; PFrame->r[1][1] = sa * sb * sc + ca * cc; PFrame->r[1][2] = sa * sb * cc - ca * sc;
+    PFrame->r[2][0] = -sb;     PFrame->r[2][1] = cb * sc;                PFrame->r[2][2] = cb * cc;
+    PFrame->p[0] = PPose[0];
+    PFrame->p[1] = PPose[1];
+    PFrame->p[2] = PPose[2];
+}
+
+void FrameToPose( const Frame_T &Frame, const F64_T *PRefAbc, F64_T PRetPose[6] )
+{
+    PRetPose[0] = Frame.p[0];
+    PRetPose[1] = Frame.p[1];
+    PRetPose[2] = Frame.p[2];
+    RotationToAbc( Frame.r, PRefAbc, &PRetPose[3] );
+}
+
+void FrameMul( const Frame_T &A, const Frame_T &B, Frame_T *PRet )
+{
+    Frame_T out;
+    for( I32_T i = 0; i < 3; ++i )
+    {
+        for( I32_T j = 0; j < 3; ++j )
+            out.r[i][j] = A.r[i][0] * B.r[0][j] + A.r[i][1] * B.r[1][j] + A.r[i][2] * B.r[2][j];
+        out.p[i] = A.r[i][0] * B.p[0] + A.r[i][1] * B.p[1] + A.r[i][2] * B.p[2] + A.p[i];
+    }
+    *PRet = out;
+}
+
+void FrameInv( const Frame_T &A, Frame_T *PRet )
+{
+    Frame_T out;
+    for( I32_T i = 0; i < 3; ++i )
+        for( I32_T j = 0; j < 3; ++j )
+            out.r[i][j] = A.r[j][i];
+    for( I32_T i = 0; i < 3; ++i )
+        out.p[i] = -( out.r[i][0] * A.p[0] + out.r[i][1] * A.p[1] + out.r[i][2] * A.p[2] );
+    *PRet = out;
+}
+
+void FrameApply( const Frame_T &Frame, const F64_T PIn[3], F64_T PRetOut[3] )
+{
+    F64_T out[3];
+    FrameRotate( Frame, PIn, out );
+    for( I32_T i = 0; i < 3; ++i ) PRetOut[i] = out[i] + Frame.p[i];
+}
+
+void FrameRotate( const Frame_T &Frame, const F64_T PIn[3], F64_T PRetOut[3] )
+{
+    F64_T out[3];
+    for( I32_T i = 0; i < 3; ++i )
+        out[i] = Frame.r[i][0] * PIn[0] + Frame.r[i][1] * PIn[1] + Frame.r[i][2] * PIn[2];
+    std::memcpy( PRetOut, out, sizeof( out ) );
+}
+
+void RotationAboutAxis( const F64_T PAxis[3], F64_T AngleDeg, F64_T PRetR[3][3] )
+{
+    F64_T s = std::sin( DegToRad( AngleDeg ) ), c = std::cos( DegToRad( AngleDeg ) ), t = 1.0 - c;
+    F64_T x = PAxis[0], y = PAxis[1], z = PAxis[2];
+    PRetR[0][0] = t * x * x + c;     PRetR[0][1] = t * x * y - s * z; PRetR[0][2] = t * x * z + s * y;
+    PRetR[1][0] = t * x * y + s * z; PRetR[1][1] = t * y * y + c;     PRetR[1][2] = t * y * z - s * x;
+    PRetR[2][0] = t * x * z - s * y; PRetR[2][1] = t * y * z + s * x; PRetR[2][2] = t * z * z + c;
+}
+
+RTN_ERR CalibToolTranslation( const F64_T PFlange[][6], I32_T Count, F64_T PRetTool[3], F64_T *PRetTolerance )
+{
+    // Each flange pose i touches the same reference point q: R_i * t + p_i = q.
+    // Least squares over the unknowns x = (t, q) with the normal equations.
+    F64_T ata[36] = { 0 };
+    F64_T atb[6]  = { 0 };
+    for( I32_T n = 0; n < Count; ++n )
+    {
+        Frame_T f;
+        FrameFromPose( PFlange[n], &f );
+        for( I32_T row = 0; row < 3; ++row )
+        {
+            F64_T a[6] = { f.r[row][0], f.r[row][1], f.r[row][2], 0.0, 0.0, 0.0 };
+            a[3 + row] = -1.0;
+            F64_T b = -f.p[row];
+            for( I32_T i = 0; i < 6; ++i )
+            {
+                for( I32_T j = 0; j < 6; ++j ) ata[i * 6 + j] += a[i] * a[j];
+                atb[i] += a[i] * b;
+            }
+        }
+    }
+    if( !SolveLinear( ata, atb, 6 ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    F64_T tol = 0.0;
+    for( I32_T n = 0; n < Count; ++n )
+    {
+        Frame_T f;
+        F64_T   tcp[3], err[3];
+        FrameFromPose( PFlange[n], &f );
+        FrameApply( f, atb, tcp );
+        Vec3Sub( tcp, &atb[3], err );
+        F64_T e = Vec3Norm( err );
+        if( e > tol ) tol = e;
+    }
+    PRetTool[0] = atb[0];
+    PRetTool[1] = atb[1];
+    PRetTool[2] = atb[2];
+    if( PRetTolerance ) *PRetTolerance = tol;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR CalibToolOrientation( const F64_T POrg[6], const F64_T PMinusZ[6], const F64_T PYz[6], F64_T PRetAbc[3] )
+{
+    // The three poses are taught with the same orientation. The reference point lies on the -Z axis
+    // of the TCP in PMinusZ and on the +Y axis of the TCP in PYz.
+    F64_T z[3], y[3], x[3];
+    Vec3Sub( PMinusZ, POrg, z );
+    Vec3Sub( POrg, PYz, y );
+    if( !Vec3Normalize( z ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    F64_T d = Vec3Dot( y, z );
+    for( I32_T i = 0; i < 3; ++i ) y[i] -= d * z[i];
+    if( !Vec3Normalize( y ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    Vec3Cross( y, z, x );
+
+    Frame_T flange, toolMcs, flangeInv, tool;
+    FrameFromPose( POrg, &flange );
+    FrameIdentity( &toolMcs );
+    for( I32_T i = 0; i < 3; ++i )
+    {
+        toolMcs.r[i][0] = x[i];
+        toolMcs.r[i][1] = y[i];
+        toolMcs.r[i][2] = z[i];
+    }
+    FrameInv( flange, &flangeInv );
+    flangeInv.p[0] = flangeInv.p[1] = flangeInv.p[2] = 0.0;
+    FrameMul( flangeInv, toolMcs, &tool );
+    RotationToAbc( tool.r, 0, PRetAbc );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR CalibToolZDirection( const F64_T PFlange[6], F64_T PRetAbc[3] )
+{
+    // In PFlange the +Z axis of the TCP points to the -Z direction of the MCS.
+    Frame_T flange;
+    FrameFromPose( PFlange, &flange );
+    F64_T zf[3] = { -flange.r[2][0], -flange.r[2][1], -flange.r[2][2] };
+    F64_T ez[3] = { 0.0, 0.0, 1.0 };
+    F64_T axis[3];
+    F64_T R[3][3];
+    Vec3Cross( ez, zf, axis );
+    if( Vec3Normalize( axis ) )
+    {
+        RotationAboutAxis( axis, RadToDeg( std::acos( Clamp( Vec3Dot( ez, zf ), -1.0, 1.0 ) ) ), R );
+    }
+    else
+    {
+        F64_T ex[3] = { 1.0, 0.0, 0.0 };
+        RotationAboutAxis( ex, ( zf[2] > 0.0 ) ? 0.0 : 180.0, R );
+    }
+    RotationToAbc( R, 0, PRetAbc );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR CalibBase( const F64_T *P1, const F64_T *P2, const F64_T *P3, F64_T PRetPose[6] )
+{
+    std::memset( PRetPose, 0, sizeof( F64_T ) * 6 );
+    PRetPose[0] = P1[0];
+    PRetPose[1] = P1[1];
+    PRetPose[2] = P1[2];
+    if( !P2 )
+        return ERR_NEXMOTION_SUCCESS;
+
+    F64_T x[3];
+    Vec3Sub( P2, P1, x );
+    if( !P3 )
+    {
+        // 2 points: the X axis of the base is the projection of P1->P2 on the XY plane.
+        if( std::sqrt( x[0] * x[0] + x[1] * x[1] ) < 1e-9 )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        PRetPose[3] = RadToDeg( std::atan2( x[1], x[0] ) );
+        return ERR_NEXMOTION_SUCCESS;
+    }
+
+    // 3 points: P2 is on the +X axis, P3 is on the XY plane (+Y side).
+    F64_T y[3], z[3];
+    Vec3Sub( P3, P1, y );
+    if( !Vec3Normalize( x ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    Vec3Cross( x, y, z );
+    if( !Vec3Normalize( z ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    Vec3Cross( z, x, y );
+
+    F64_T R[3][3];
+    for( I32_T i = 0; i < 3; ++i )
+    {
+        R[i][0] = x[i];
+        R[i][1] = y[i];
+        R[i][2] = z[i];
+    }
+    RotationToAbc( R, 0, &PRetPose[3] );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+} // namespace nmc
@@ -0,0 +1,54 @@
+/*!
+ * @file        SimFrame.h
+ * @brief       Homogeneous frame math for coordinate transforms and calibration
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_FRAME_H
+#define __NEXMOTION_SIM_FRAME_H
+
+#include "SimCommon.h"
+
+namespace nmc
+{
+
+/*! @struct Frame_T
+ *  @brief  Rigid transform: rotation matrix and translation.
+ *
+ *  Poses are written as (x, y, z, a, b, c) in degrees with R = Rz(a) * Ry(b) * Rx(c), the same
+ *  order as the base parameters 0xC0~0xDF (sub-index 3: about z, 4: about y, 5: about x).
+ */
+struct Frame_T
+{
+    F64_T r[3][3];
+    F64_T p[3];
+};
+
+void  FrameIdentity( Frame_T *PFrame );
+void  FrameFromPose( const F64_T PPose[6], Frame_T *PFrame );
+//! Convert to a pose. The Euler angles nearest to PRefAbc (may be NULL) are selected.
+void  FrameToPose( const Frame_T &Frame, const F64_T *PRefAbc, F64_T PRetPose[6] );
+void  FrameMul( const Frame_T &A, const Frame_T &B, Frame_T *PRet );
+void  FrameInv( const Frame_T &A, Frame_T *PRet );
+void  FrameApply( const Frame_T &Frame, const F64_T PIn[3], F64_T PRetOut[3] );
+void  FrameRotate( const Frame_T &Frame, const F64_T PIn[3], F64_T PRetOut[3] );
+
+//! Rotation matrix of angle (deg) about a unit axis.
+void  RotationAboutAxis( const F64_T PAxis[3], F64_T AngleDeg, F64_T PRetR[3][3] );
+
+// Small vector helpers
+F64_T Vec3Dot( const F64_T *A, const F64_T *B );
+F64_T Vec3Norm( const F64_T *A );
+void  Vec3Cross( const F64_T *A, const F64_T *B, F64_T *PRet );
+void  Vec3Sub( const F64_T *A, const F64_T *B, F64_T *PRet );
+bool  Vec3Normalize( F64_T *A );
+
+// Tool and base calibration, see NMC_ToolCalib_4p() and NMC_BaseCalib_1p()
+RTN_ERR CalibToolTranslation( const F64_T PFlange[][6], I32_T Count, F64_T PRetTool[3], F64_T *PRetTolerance );
+RTN_ERR CalibToolOrientation( const F64_T POrg[6], const F64_T PMinusZ[6], const F64_T PYz[6], F64_T PRetAbc[3] );
+RTN_ERR CalibToolZDirection( const F64_T PFlange[6], F64_T PRetAbc[3] );
+RTN_ERR CalibBase( const F64_T *P1, const F64_T *P2, const F64_T *P3, F64_T PRetPose[6] );
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_FRAME_H
@@ -0,0 +1,1544 @@
+/*!
+ * @file        SimGroup.cpp
+ * @brief       Axis group (linear kinematics) of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimGroup.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace nmc
+{
+
+namespace
+{
+
+const F64_T kKinTolerance = 1e-6;   // Deviation (user unit or degree) accepted on a coordinate without group axis
+const F64_T kArcTolerance = 1e-4;   // Accepted radius mismatch of an arc definition
+
+// look_ is indexed by the free running buffer index modulo kMaxLookAhead, which must survive its wrap at 2^32.
+static_assert( ( kMaxLookAhead & ( kMaxLookAhead - 1 ) ) == 0, "kMaxLookAhead must be a power of two" );
+
+enum
+{
+    STOPPING_NONE = 0,
+    STOPPING_HALT,
+    STOPPING_STOP
+};
+
+bool IsPathSeg( const GroupSeg_T &Seg )
+{
+    return Seg.type == GROUP_SEG_LINE || Seg.type == GROUP_SEG_ARC || Seg.type == GROUP_SEG_SPLINE;
+}
+
+//! Angle (rad, [0, 2*pi)) rotating A to B about the unit vector Axis. A and B are perpendicular to Axis.
+F64_T AngleAbout( const F64_T *A, const F64_T *B, const F64_T *Axis )
+{
+    F64_T c[3];
+    Vec3Cross( A, B, c );
+    F64_T angle = std::atan2( Vec3Dot( c, Axis ), Vec3Dot( A, B ) );
+    return ( angle < 0.0 ) ? angle + 2.0 * kPi : angle;
+}
+
+bool MaskValid( I32_T Mask, I32_T Count )
+{
+    return Mask > 0 && ( Mask >> Count ) == 0;
+}
+
+//! Acceleration and deceleration times of the time-optimal trapezoidal move of Dist from rest to rest.
+void PtpRamps( F64_T Dist, F64_T Vm, F64_T Acc, F64_T Dec, F64_T *PRetTa, F64_T *PRetTd )
+{
+    F64_T vp = ( Dist >= 0.5 * Vm * Vm * ( 1.0 / Acc + 1.0 / Dec ) ) ? Vm : std::sqrt( 2.0 * Dist * Acc * Dec / ( Acc + Dec ) );
+    *PRetTa = vp / Acc;
+    *PRetTd = vp / Dec;
+}
+
+} // namespace
+
+Group::Group()
+    : params_( PARAM_SCOPE_GROUP )
+    , curType_( GROUP_SEG_NONE )
+    , state_( NMC_GROUP_STATE_DISABLE )
+    , stopping_( STOPPING_NONE )
+    , appendOnly_( false )
+    , look_( kMaxLookAhead )
+    , lookFirst_( 0 )
+    , lookCount_( 0 )
+    , splines_( kMaxSplines )
+    , latch_( 0 )
+    , speedRatio_( 100.0 )
+{
+    for( I32_T i = 0; i < kMaxSplines; ++i )
+        splineBusy_[i] = false;
+    std::memset( &cur_, 0, sizeof( cur_ ) );
+    std::memset( endAcs_, 0, sizeof( endAcs_ ) );
+    std::memset( cmdAcs_, 0, sizeof( cmdAcs_ ) );
+    std::memset( cmdPose_, 0, sizeof( cmdPose_ ) );
+    std::memset( cartVel_, 0, sizeof( cartVel_ ) );
+}
+
+void Group::SetAxisCount( I32_T Count )
+{
+    axes_.resize( Count );
+}
+
+RTN_ERR Group::Start( I32_T BuffSize )
+{
+    if( params_.I32( GRP_KIN ) != 0 )
+        return ERR_NEXMOTION_KINEMATICS_TYPE_INVALID;
+
+    queue_.Resize( BuffSize );
+    lookCount_ = 0;
+    for( I32_T i = 0; i < kMaxSplines; ++i )
+        splineBusy_[i] = false;
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        GroupAxis_T &ax = axes_[i];
+        const ParamSet &p = ax.params;
+        ax.pulsePerUnit = static_cast<F64_T>( p.I32( AXP_ENC_RES ) ) * p.I32( AXP_MOTOR_REV )
+                        / ( static_cast<F64_T>( p.I32( AXP_MECH_REV ) ) * p.I32( AXP_PITCH ) );
+        ax.encEnable    = p.I32( AXP_ENC_ENABLE ) != 0;
+
+        F64_T pos = 0.0;
+        if( p.I32( AXP_ENC_TYPE ) != 0 )
+            pos = std::floor( ax.prof.Pos() * ax.pulsePerUnit + 0.5 ) / ax.pulsePerUnit;
+        ax.prof.Reset( pos, 0.0 );
+        ax.vel     = 0.0;
+        ax.sentPos = pos;
+        ax.actPos  = pos;
+        ax.actVel  = 0.0;
+        ax.done    = true;
+        cmdAcs_[i] = pos;
+    }
+    for( I32_T i = AxisCount(); i < kGroupCoords; ++i )
+        cmdAcs_[i] = 0.0;
+
+    Shutdown();
+    ForwardKin( cmdAcs_, cmdPose_ );
+    std::memset( cartVel_, 0, sizeof( cartVel_ ) );
+    latch_ = 0;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void Group::Shutdown()
+{
+    Disable();
+}
+
+RTN_ERR Group::Enable()
+{
+    if( state_ == NMC_GROUP_STATE_DISABLE )
+    {
+        ClearQueue();
+        std::memcpy( endAcs_, cmdAcs_, sizeof( endAcs_ ) );
+        state_ = NMC_GROUP_STATE_STAND_STILL;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::Disable()
+{
+    ClearQueue();
+    SetCurType( GROUP_SEG_NONE );
+    stopping_ = STOPPING_NONE;
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        axes_[i].prof.Reset( cmdAcs_[i], 0.0 );
+        axes_[i].vel = 0.0;
+    }
+    pathProf_.Reset( 0.0, 0.0 );
+    std::memcpy( endAcs_, cmdAcs_, sizeof( endAcs_ ) );
+    state_ = NMC_GROUP_STATE_DISABLE;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::ResetState()
+{
+    switch( state_ )
+    {
+    case NMC_GROUP_STATE_STOPPING:
+        return ERR_NEXMOTION_OPERATION_BUSY;
+    case NMC_GROUP_STATE_ERROR:
+    case NMC_GROUP_STATE_STOPPED:
+        latch_ = 0;
+        ClearQueue();
+        std::memcpy( endAcs_, cmdAcs_, sizeof( endAcs_ ) );
+        state_ = NMC_GROUP_STATE_STAND_STILL;
+        break;
+    default:
+        latch_ = 0;
+        break;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::SetSpeedRatio( F64_T Percentage )
+{
+    if( !( Percentage >= 0.0 && Percentage <= 100.0 ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    if( state_ == NMC_GROUP_STATE_HOMING || state_ == NMC_GROUP_STATE_STOPPING
+        || state_ == NMC_GROUP_STATE_STOPPED || state_ == NMC_GROUP_STATE_ERROR )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    speedRatio_ = Percentage;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::CheckMotionAllowed() const
+{
+    if( state_ == NMC_GROUP_STATE_STAND_STILL || state_ == NMC_GROUP_STATE_MOVING )
+        return ERR_NEXMOTION_SUCCESS;
+    return ERR_NEXMOTION_OPERATION_DENIED;
+}
+
+void Group::InitSeg( I32_T Type, GroupSeg_T *PSeg ) const
+{
+    std::memset( PSeg, 0, sizeof( *PSeg ) );
+    PSeg->type       = Type;
+    PSeg->bufferMode = params_.I32( GRP_BUFF, 0 );
+    PSeg->vm         = params_.F64( GRP_VM );
+    PSeg->acc        = params_.F64( GRP_ACC );
+    PSeg->dec        = params_.F64( GRP_DEC );
+    PSeg->blendMode  = params_.I32( GRP_BUFF, 1 );
+    PSeg->blendValue = params_.F64( GRP_BUFF, 2 + PSeg->blendMode );
+    PSeg->lookAhead  = params_.I32( GRP_BUFF, 4 );
+}
+
+bool Group::Appendable() const
+{
+    I32_T type = curType_;
+    return state_ == NMC_GROUP_STATE_MOVING && stopping_ == STOPPING_NONE && params_.I32( GRP_BUFF, 0 ) != 0
+        && ( type == GROUP_SEG_PTP || type == GROUP_SEG_LINE || type == GROUP_SEG_ARC || type == GROUP_SEG_SPLINE );
+}
+
+const F64_T *Group::StartAcs( const GroupSeg_T &Seg ) const
+{
+    // A buffered command starts where the last buffered command ends, an aborting command starts here.
+    if( appendOnly_ )
+        return endAcs_;
+    return ( cur_.type != GROUP_SEG_NONE && Seg.bufferMode != 0 ) ? endAcs_ : cmdAcs_;
+}
+
+RTN_ERR Group::SetCartVel( const F64_T *PMaxVel, GroupSeg_T *PSeg )
+{
+    if( !PMaxVel )
+        return ERR_NEXMOTION_SUCCESS;
+    NMC_RETURN_IF_ERR( params_.SetF64( GRP_VM, 0, *PMaxVel, true ) );
+    PSeg->vm = *PMaxVel;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::CheckSoftLimit( const F64_T *PAcs ) const
+{
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        const ParamSet &p = axes_[i].params;
+        if( p.I32( AXP_SW_LIMIT_ENABLE ) != 0
+            && ( PAcs[i] > p.F64( AXP_SW_LIMIT_POS ) || PAcs[i] < p.F64( AXP_SW_LIMIT_NEG ) ) )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void Group::SyncPtp( const F64_T *PStartAcs, GroupSeg_T *PSeg ) const
+{
+    // All axes accelerate for ta, cruise and decelerate for td, so they start and finish together and the
+    // motion is a straight line in ACS. ta and td are the longest ramps of the time-optimal profiles of the
+    // axes, then the duration is the shortest one keeping every axis within its limits: the leading axis.
+    F64_T dist[kGroupCoords];
+    F64_T ta = 0.0, td = 0.0;
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        const ParamSet &p = axes_[i].params;
+        PSeg->axisVm[i]  = p.F64( AXP_VM );
+        PSeg->axisAcc[i] = p.F64( AXP_ACC );
+        PSeg->axisDec[i] = p.F64( AXP_DEC );
+        dist[i] = ( PSeg->axisMask & ( 1 << i ) ) ? std::fabs( PSeg->acs[i] - PStartAcs[i] ) : 0.0;
+        if( dist[i] <= kPosEpsilon )
+            continue;
+        F64_T a, d;
+        PtpRamps( dist[i], PSeg->axisVm[i], PSeg->axisAcc[i], PSeg->axisDec[i], &a, &d );
+        ta = std::max( ta, a );
+        td = std::max( td, d );
+    }
+
+    // With the common ramps, an axis at peak velocity v covers dist = v * ( duration - ( ta + td ) / 2 ).
+    F64_T span = 0.5 * ( ta + td );     // Duration - ( ta + td ) / 2, at least ( ta + td ) / 2 for a cruise >= 0
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        if( dist[i] <= kPosEpsilon )
+            continue;
+        F64_T vp = std::min( PSeg->axisVm[i], std::min( PSeg->axisAcc[i] * ta, PSeg->axisDec[i] * td ) );
+        span = std::max( span, dist[i] / vp );
+    }
+    if( span <= 0.0 )
+        return;
+
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        if( dist[i] <= kPosEpsilon )
+            continue;
+        F64_T v = dist[i] / span;
+        PSeg->axisVm[i]  = v;
+        PSeg->axisAcc[i] = v / ta;
+        PSeg->axisDec[i] = v / td;
+    }
+    PSeg->sync = true;
+}
+
+RTN_ERR Group::Enqueue( const GroupSeg_T &Seg )
+{
+    if( appendOnly_ )
+    {
+        // The cycle may finish the current motion meanwhile, then it starts this command.
+        if( !queue_.Push( Seg ) )
+            return ERR_NEXMOTION_OPERATION_BUSY;
+    }
+    else if( cur_.type == GROUP_SEG_NONE || Seg.bufferMode == 0 )
+    {
+        ClearQueue();
+        Begin( Seg );
+    }
+    else if( !queue_.Push( Seg ) )
+    {
+        return ERR_NEXMOTION_OPERATION_BUSY;
+    }
+
+    switch( Seg.type )
+    {
+    case GROUP_SEG_PTP:
+    case GROUP_SEG_HOME:
+        std::memcpy( endAcs_, Seg.acs, sizeof( endAcs_ ) );
+        break;
+    case GROUP_SEG_LINE:
+    case GROUP_SEG_ARC:
+    case GROUP_SEG_SPLINE:
+        InverseKin( Seg.end, endAcs_, endAcs_ );
+        break;
+    case GROUP_SEG_HALT:
+        break;
+    default:
+        // The end of a JOG motion is unknown.
+        std::memcpy( endAcs_, cmdAcs_, sizeof( endAcs_ ) );
+        break;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void Group::ClearQueue()
+{
+    // As queue_.Clear(): drop the commands pushed so far, and free their spline slots.
+    for( I32_T n = queue_.Size(); n > 0; --n )
+    {
+        ReleaseSpline( queue_.Front() );
+        queue_.Pop();
+    }
+}
+
+void Group::ReleaseSpline( const GroupSeg_T &Seg )
+{
+    if( Seg.type == GROUP_SEG_SPLINE && Seg.spline )
+        splineBusy_[Seg.spline - &splines_[0]].store( false, std::memory_order_release );
+}
+
+void Group::StartQueued()
+{
+    // A command appended while the previous motion was finishing is left in the buffer of an idle group.
+    if( cur_.type != GROUP_SEG_NONE || state_ != NMC_GROUP_STATE_STAND_STILL )
+        return;
+    while( !queue_.Empty() )
+    {
+        GroupSeg_T next = queue_.Front();
+        queue_.Pop();
+        if( next.type != GROUP_SEG_HALT )
+        {
+            Begin( next );
+            return;
+        }
+    }
+}
+
+void Group::Begin( const GroupSeg_T &Seg )
+{
+    ReleaseSpline( cur_ );
+    cur_      = Seg;
+    curType_  = Seg.type;
+    stopping_ = STOPPING_NONE;
+    state_    = ( Seg.type == GROUP_SEG_HOME ) ? NMC_GROUP_STATE_HOMING : NMC_GROUP_STATE_MOVING;
+
+    F64_T dir[3];
+    switch( Seg.type )
+    {
+    case GROUP_SEG_PTP:
+    case GROUP_SEG_HOME:
+        for( size_t i = 0; i < axes_.size(); ++i )
+            axes_[i].done = false;
+        break;
+
+    case GROUP_SEG_LINE:
+    case GROUP_SEG_ARC:
+    case GROUP_SEG_SPLINE:
+        // Keep the part of the current TCP velocity which points along the new path.
+        pathProf_.Reset( 0.0, PathTangent( Seg, false, dir ) ? std::max( 0.0, Vec3Dot( cartVel_, dir ) ) : 0.0 );
+        break;
+
+    case GROUP_SEG_JOG_CART:
+        pathProf_.Reset( 0.0, ( Seg.jogAxis < 3 && JogDirection( Seg, dir ) ) ? Vec3Dot( cartVel_, dir ) * Seg.jogDir : 0.0 );
+        break;
+
+    default:
+        break;
+    }
+}
+
+void Group::Finish()
+{
+    if( stopping_ == STOPPING_NONE )
+    {
+        while( !queue_.Empty() )
+        {
+            GroupSeg_T next = queue_.Front();
+            queue_.Pop();
+            if( next.type != GROUP_SEG_HALT )
+            {
+                Begin( next );
+                return;
+            }
+        }
+    }
+
+    // endAcs_ belongs to the API side, an idle group starts the next command at cmdAcs_.
+    ClearQueue();
+    SetCurType( GROUP_SEG_NONE );
+    state_    = ( stopping_ == STOPPING_STOP ) ? NMC_GROUP_STATE_STOPPED : NMC_GROUP_STATE_STAND_STILL;
+    stopping_ = STOPPING_NONE;
+}
+
+void Group::RaiseError( U32_T LatchMask, const F64_T *PHoldAcs )
+{
+    ClearQueue();
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        cmdAcs_[i] = PHoldAcs[i];
+        axes_[i].prof.Reset( PHoldAcs[i], 0.0 );
+    }
+    pathProf_.Reset( 0.0, 0.0 );
+    SetCurType( GROUP_SEG_NONE );
+    stopping_ = STOPPING_NONE;
+    latch_   |= LatchMask;
+    state_    = NMC_GROUP_STATE_ERROR;
+}
+
+RTN_ERR Group::PtpAcs( I32_T AxisMask, const F64_T *PAcsPos, I32_T VelAxis, const F64_T *PMaxVel )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+    if( !MaskValid( AxisMask, AxisCount() ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_PTP, &seg );
+    const F64_T *start = StartAcs( seg );
+    bool         rel   = params_.I32( GRP_ABS_REL ) != 0;
+    for( I32_T i = 0; i < kGroupCoords; ++i )
+    {
+        seg.acs[i] = start[i];
+        if( AxisMask & ( 1 << i ) ) seg.acs[i] = rel ? start[i] + PAcsPos[i] : PAcsPos[i];
+    }
+    seg.axisMask = AxisMask;
+    NMC_RETURN_IF_ERR( CheckSoftLimit( seg.acs ) );
+
+    if( PMaxVel )
+        NMC_RETURN_IF_ERR( axes_[VelAxis].params.SetF64( AXP_VM, 0, *PMaxVel, true ) );
+    if( params_.I32( GRP_PTP_SYNC ) != 0 )
+        SyncPtp( start, &seg );
+    return Enqueue( seg );
+}
+
+RTN_ERR Group::JogAcs( I32_T AxisIndex, I32_T Dir, const F64_T *PMaxVel )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+    if( Dir != 1 && Dir != -1 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_JOG_ACS, &seg );
+    seg.jogAxis = AxisIndex;
+    seg.jogDir  = Dir;
+    seg.vm      = axes_[AxisIndex].params.F64( AXP_VM );
+    if( PMaxVel )
+    {
+        if( !( *PMaxVel >= 0.0 ) )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( *PMaxVel > 0.0 )
+            NMC_RETURN_IF_ERR( axes_[AxisIndex].params.SetF64( AXP_VM, 0, *PMaxVel, true ) );
+        seg.vm = *PMaxVel;
+    }
+    return Enqueue( seg );
+}
+
+bool Group::JogDirection( const GroupSeg_T &Seg, F64_T PRetDir[3] ) const
+{
+    // Translation or rotation axis of a Cartesian JOG in MCS.
+    I32_T k = ( Seg.jogAxis < 3 ) ? Seg.jogAxis : 5 - Seg.jogAxis;
+    if( Seg.jogAxis >= 6 )
+        return false;
+
+    Frame_T frame;
+    if( Seg.jogFrame == GROUP_JOG_FRAME_TCP )
+        FrameFromPose( cmdPose_, &frame );
+    else if( BaseFrame( TargetBase(), &frame ) != ERR_NEXMOTION_SUCCESS )
+        FrameIdentity( &frame );
+    for( I32_T i = 0; i < 3; ++i )
+        PRetDir[i] = frame.r[i][k] * Seg.jogDir;
+    return true;
+}
+
+RTN_ERR Group::JogCart( I32_T Frame, I32_T CartAxis, I32_T Dir, const F64_T *PMaxVel )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+    if( CartAxis < 0 || CartAxis >= kGroupCoords || ( Dir != 0 && Dir != 1 ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    Frame_T base;
+    NMC_RETURN_IF_ERR( BaseFrame( TargetBase(), &base ) );
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_JOG_CART, &seg );
+    seg.jogAxis  = CartAxis;
+    seg.jogFrame = Frame;
+    seg.jogDir   = ( Dir == 0 ) ? 1.0 : -1.0;
+
+    // The motion must stay on the coordinates driven by the group axes.
+    I32_T n = AxisCount();
+    F64_T dir[3];
+    if( CartAxis >= 6 || ( CartAxis >= 3 && n < 6 ) )
+    {
+        if( CartAxis >= n )
+            return ERR_NEXMOTION_INVERSE_KINEMATICS_FAILED;
+    }
+    else if( CartAxis < 3 && JogDirection( seg, dir ) )
+    {
+        for( I32_T i = n; i < 3; ++i )
+            if( std::fabs( dir[i] ) > kKinTolerance )
+                return ERR_NEXMOTION_INVERSE_KINEMATICS_FAILED;
+    }
+
+    NMC_RETURN_IF_ERR( SetCartVel( PMaxVel, &seg ) );
+    return Enqueue( seg );
+}
+
+RTN_ERR Group::CartTarget( const F64_T *PStartAcs, I32_T CartMask, const F64_T *PCartPos, F64_T PRetStart[kGroupCoords], F64_T PRetEnd[kGroupCoords] ) const
+{
+    if( !MaskValid( CartMask, kGroupCoords ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    F64_T startPcs[kGroupCoords], endPcs[kGroupCoords];
+    ForwardKin( PStartAcs, PRetStart );
+    NMC_RETURN_IF_ERR( McsToPcs( TargetBase(), PRetStart, startPcs ) );
+
+    bool rel = params_.I32( GRP_ABS_REL ) != 0;
+    for( I32_T i = 0; i < kGroupCoords; ++i )
+    {
+        endPcs[i] = startPcs[i];
+        if( CartMask & ( 1 << i ) ) endPcs[i] = rel ? startPcs[i] + PCartPos[i] : PCartPos[i];
+    }
+    return PcsToMcs( TargetBase(), endPcs, PRetStart + 3, PRetEnd );
+}
+
+RTN_ERR Group::CheckCartEnd( const F64_T *PStartAcs, const F64_T *PEnd ) const
+{
+    F64_T acs[kGroupCoords];
+    NMC_RETURN_IF_ERR( InverseKin( PEnd, PStartAcs, acs ) );
+    return CheckSoftLimit( acs );
+}
+
+RTN_ERR Group::PtpCart( I32_T CartMask, const F64_T *PCartPos )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_PTP, &seg );
+    const F64_T *startAcs = StartAcs( seg );
+    F64_T start[kGroupCoords], end[kGroupCoords];
+    NMC_RETURN_IF_ERR( CartTarget( startAcs, CartMask, PCartPos, start, end ) );
+    NMC_RETURN_IF_ERR( InverseKin( end, startAcs, seg.acs ) );
+    NMC_RETURN_IF_ERR( CheckSoftLimit( seg.acs ) );
+    seg.axisMask = ( 1 << AxisCount() ) - 1;
+    if( params_.I32( GRP_PTP_SYNC ) != 0 )
+        SyncPtp( startAcs, &seg );
+    return Enqueue( seg );
+}
+
+RTN_ERR Group::Line( I32_T CartMask, const F64_T *PCartPos, const F64_T *PMaxVel )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_LINE, &seg );
+    const F64_T *startAcs = StartAcs( seg );
+    NMC_RETURN_IF_ERR( CartTarget( startAcs, CartMask, PCartPos, seg.start, seg.end ) );
+    NMC_RETURN_IF_ERR( CheckCartEnd( startAcs, seg.end ) );
+
+    F64_T d[3];
+    Vec3Sub( seg.end, seg.start, d );
+    seg.length = Vec3Norm( d );
+    if( seg.length <= kPosEpsilon )
+    {
+        // Orientation or auxiliary axes only: the path parameter is the largest coordinate change.
+        seg.length = 0.0;
+        for( I32_T i = 3; i < kGroupCoords; ++i )
+            seg.length = std::max( seg.length, std::fabs( seg.end[i] - seg.start[i] ) );
+    }
+
+    NMC_RETURN_IF_ERR( SetCartVel( PMaxVel, &seg ) );
+    LimitPathByAxes( &seg );
+    return Enqueue( seg );
+}
+
+RTN_ERR Group::BuildArc( const F64_T *PCenter, const F64_T *PAxis, F64_T Sweep, GroupSeg_T *PSeg ) const
+{
+    F64_T r0[3];
+    Vec3Sub( PSeg->start, PCenter, r0 );
+    F64_T radius = Vec3Norm( r0 );
+    if( radius <= kPosEpsilon || Sweep * radius <= kPosEpsilon )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    std::memcpy( PSeg->center, PCenter, sizeof( PSeg->center ) );
+    for( I32_T i = 0; i < 3; ++i )
+        PSeg->u[i] = r0[i] / radius;
+    Vec3Cross( PAxis, PSeg->u, PSeg->v );
+    PSeg->radius = radius;
+    PSeg->sweep  = Sweep;
+    PSeg->length = radius * Sweep;
+
+    // The arc plane must not leave the coordinates driven by the group axes.
+    for( I32_T i = AxisCount(); i < 3; ++i )
+        if( std::fabs( PSeg->u[i] ) > kKinTolerance || std::fabs( PSeg->v[i] ) > kKinTolerance )
+            return ERR_NEXMOTION_INVERSE_KINEMATICS_FAILED;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::CircR( I32_T CartMask, const F64_T *PCartPos, const F64_T *PNormal, F64_T Radius, I32_T CwCcw, const F64_T *PMaxVel )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+    if( CwCcw != 0 && CwCcw != 1 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_ARC, &seg );
+    const F64_T *startAcs = StartAcs( seg );
+    NMC_RETURN_IF_ERR( CartTarget( startAcs, CartMask, PCartPos, seg.start, seg.end ) );
+
+    Frame_T base;
+    NMC_RETURN_IF_ERR( BaseFrame( TargetBase(), &base ) );
+    F64_T normal[3] = { PNormal[0], PNormal[1], PNormal[2] };
+    if( !Vec3Normalize( normal ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    // A normal along X, Y or Z is a 2D arc and CW_CCW is applied with the right-hand rule.
+    F64_T axisPcs[3] = { normal[0], normal[1], normal[2] };
+    for( I32_T i = 0; i < 3; ++i )
+    {
+        if( std::fabs( normal[i] ) >= 1.0 - 1e-9 )
+        {
+            axisPcs[0] = axisPcs[1] = axisPcs[2] = 0.0;
+            axisPcs[i] = ( CwCcw == 1 ) ? 1.0 : -1.0;
+        }
+    }
+    F64_T axis[3];
+    FrameRotate( base, axisPcs, axis );
+
+    F64_T chord[3];
+    Vec3Sub( seg.end, seg.start, chord );
+    F64_T len = Vec3Norm( chord );
+    if( len <= kPosEpsilon || std::fabs( Vec3Dot( chord, axis ) ) > kArcTolerance * std::max( 1.0, len ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    F64_T half = 0.5 * len;
+    F64_T r    = std::fabs( Radius );
+    if( r < half - kArcTolerance * std::max( 1.0, r ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    F64_T dist = ( r > half ) ? std::sqrt( r * r - half * half ) : 0.0;
+
+    // Moving counterclockwise about the axis, the center of the small arc is on the left of the chord.
+    F64_T side[3], center[3];
+    Vec3Cross( axis, chord, side );
+    Vec3Normalize( side );
+    for( I32_T i = 0; i < 3; ++i )
+        center[i] = 0.5 * ( seg.start[i] + seg.end[i] ) + ( Radius >= 0.0 ? dist : -dist ) * side[i];
+
+    F64_T r0[3], r1[3];
+    Vec3Sub( seg.start, center, r0 );
+    Vec3Sub( seg.end, center, r1 );
+    NMC_RETURN_IF_ERR( BuildArc( center, axis, AngleAbout( r0, r1, axis ), &seg ) );
+    NMC_RETURN_IF_ERR( CheckCartEnd( startAcs, seg.end ) );
+    NMC_RETURN_IF_ERR( SetCartVel( PMaxVel, &seg ) );
+    LimitPathByAxes( &seg );
+    return Enqueue( seg );
+}
+
+RTN_ERR Group::CircC( I32_T CartMask, const F64_T *PCartPos, I32_T CenMask, const F64_T *PCenOfs, I32_T CwCcw, const F64_T *PMaxVel )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+    if( ( CwCcw != 0 && CwCcw != 1 ) || CenMask < 0 || ( CenMask >> 3 ) != 0 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_ARC, &seg );
+    const F64_T *startAcs = StartAcs( seg );
+    NMC_RETURN_IF_ERR( CartTarget( startAcs, CartMask, PCartPos, seg.start, seg.end ) );
+
+    Frame_T base;
+    NMC_RETURN_IF_ERR( BaseFrame( TargetBase(), &base ) );
+    F64_T ofsPcs[3], ofs[3], center[3];
+    for( I32_T i = 0; i < 3; ++i )
+        ofsPcs[i] = ( CenMask & ( 1 << i ) ) ? PCenOfs[i] : 0.0;
+    FrameRotate( base, ofsPcs, ofs );
+    for( I32_T i = 0; i < 3; ++i )
+        center[i] = seg.start[i] + ofs[i];
+
+    F64_T r0[3], r1[3];
+    Vec3Sub( seg.start, center, r0 );
+    Vec3Sub( seg.end, center, r1 );
+    F64_T rad0 = Vec3Norm( r0 ), rad1 = Vec3Norm( r1 );
+    if( std::fabs( rad0 - rad1 ) > kArcTolerance * std::max( 1.0, rad0 ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    // 2D: start, end and center on a plane of constant PCS X, Y or Z (the XY plane is checked first).
+    F64_T startPcs[3], endPcs[3], cenPcs[3];
+    Frame_T baseInv;
+    FrameInv( base, &baseInv );
+    FrameApply( baseInv, seg.start, startPcs );
+    FrameApply( baseInv, seg.end, endPcs );
+    FrameApply( baseInv, center, cenPcs );
+
+    F64_T axis[3] = { 0.0, 0.0, 0.0 };
+    F64_T sweep   = 0.0;
+    static const I32_T planeNormal[3] = { 2, 0, 1 };
+    bool  planar  = false;
+    for( I32_T k = 0; k < 3 && !planar; ++k )
+    {
+        I32_T i = planeNormal[k];
+        F64_T tol = kArcTolerance * std::max( 1.0, rad0 );
+        if( std::fabs( startPcs[i] - endPcs[i] ) <= tol && std::fabs( startPcs[i] - cenPcs[i] ) <= tol )
+        {
+            F64_T axisPcs[3] = { 0.0, 0.0, 0.0 };
+            axisPcs[i] = ( CwCcw == 1 ) ? 1.0 : -1.0;
+            FrameRotate( base, axisPcs, axis );
+            sweep  = AngleAbout( r0, r1, axis );
+            if( sweep <= 1e-12 ) sweep = 2.0 * kPi;     // Full circle
+            planar = true;
+        }
+    }
+    if( !planar )
+    {
+        // 3D: CW is the small arc and CCW the large arc about the normal of the start and end vectors.
+        Vec3Cross( r0, r1, axis );
+        if( !Vec3Normalize( axis ) )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( CwCcw == 1 )
+            for( I32_T i = 0; i < 3; ++i ) axis[i] = -axis[i];
+        sweep = AngleAbout( r0, r1, axis );
+    }
+
+    NMC_RETURN_IF_ERR( BuildArc( center, axis, sweep, &seg ) );
+    NMC_RETURN_IF_ERR( CheckCartEnd( startAcs, seg.end ) );
+    NMC_RETURN_IF_ERR( SetCartVel( PMaxVel, &seg ) );
+    LimitPathByAxes( &seg );
+    return Enqueue( seg );
+}
+
+RTN_ERR Group::CircB( I32_T CartMask, const F64_T *PCartPos, I32_T BorMask, const F64_T *PBorPoint, const F64_T *PAngleDeg, const F64_T *PMaxVel )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+    if( BorMask < 0 || ( BorMask >> 3 ) != 0 || ( PAngleDeg && !( *PAngleDeg > 0.0 ) ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_ARC, &seg );
+    const F64_T *startAcs = StartAcs( seg );
+    NMC_RETURN_IF_ERR( CartTarget( startAcs, CartMask, PCartPos, seg.start, seg.end ) );
+
+    // The pass-through point follows the absolute/relative setting of the target, unmasked coordinates stay at the start.
+    Frame_T base, baseInv;
+    NMC_RETURN_IF_ERR( BaseFrame( TargetBase(), &base ) );
+    FrameInv( base, &baseInv );
+    F64_T startPcs[3], borPcs[3], bor[3];
+    FrameApply( baseInv, seg.start, startPcs );
+    bool rel = params_.I32( GRP_ABS_REL ) != 0;
+    for( I32_T i = 0; i < 3; ++i )
+    {
+        borPcs[i] = startPcs[i];
+        if( BorMask & ( 1 << i ) ) borPcs[i] = rel ? startPcs[i] + PBorPoint[i] : PBorPoint[i];
+    }
+    FrameApply( base, borPcs, bor );
+
+    // Circumcenter of start, pass-through point and end.
+    F64_T a[3], b[3], n[3];
+    Vec3Sub( bor, seg.start, a );
+    Vec3Sub( seg.end, seg.start, b );
+    Vec3Cross( a, b, n );
+    F64_T nn = Vec3Dot( n, n );
+    if( nn <= kPosEpsilon * kPosEpsilon )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    F64_T t[3], na[3], bn[3], center[3];
+    Vec3Cross( n, a, na );
+    Vec3Cross( b, n, bn );
+    F64_T aa = Vec3Dot( a, a ), bb = Vec3Dot( b, b );
+    for( I32_T i = 0; i < 3; ++i )
+    {
+        t[i]      = ( aa * bn[i] + bb * na[i] ) / ( 2.0 * nn );
+        center[i] = seg.start[i] + t[i];
+    }
+
+    // Rotation sense from start through the pass-through point to the end.
+    F64_T ab[3], be[3], axis[3];
+    Vec3Sub( bor, seg.start, ab );
+    Vec3Sub( seg.end, bor, be );
+    Vec3Cross( ab, be, axis );
+    Vec3Normalize( axis );
+
+    F64_T r0[3], r1[3];
+    Vec3Sub( seg.start, center, r0 );
+    Vec3Sub( seg.end, center, r1 );
+    F64_T sweep = PAngleDeg ? DegToRad( *PAngleDeg ) : AngleAbout( r0, r1, axis );
+
+    NMC_RETURN_IF_ERR( BuildArc( center, axis, sweep, &seg ) );
+    if( PAngleDeg )
+    {
+        // The swept angle overrides the target position.
+        for( I32_T i = 0; i < 3; ++i )
+            seg.end[i] = center[i] + seg.radius * ( std::cos( sweep ) * seg.u[i] + std::sin( sweep ) * seg.v[i] );
+    }
+    NMC_RETURN_IF_ERR( CheckCartEnd( startAcs, seg.end ) );
+    NMC_RETURN_IF_ERR( SetCartVel( PMaxVel, &seg ) );
+    LimitPathByAxes( &seg );
+    return Enqueue( seg );
+}
+
+RTN_ERR Group::Spline( I32_T CartMask, I32_T Degree, I32_T Count, const Pos_T *PCtrlPos, const F64_T *PKnots, const F64_T *PWeights, const F64_T *PMaxVel )
+{
+    NMC_RETURN_IF_ERR( CheckMotionAllowed() );
+    if( !appendOnly_ ) StartQueued();
+    if( Degree < 1 || Degree > kMaxSplineDegree || Count <= Degree || Count > kMaxSplinePoints )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_SPLINE, &seg );
+    const F64_T *startAcs = StartAcs( seg );
+
+    // Control points in MCS. The path stays within their convex hull, each one must be reachable.
+    std::vector<F64_T> ctrl( Count * kGroupCoords );
+    for( I32_T k = 0; k < Count; ++k )
+    {
+        F64_T *p = &ctrl[k * kGroupCoords];
+        NMC_RETURN_IF_ERR( CartTarget( startAcs, CartMask, PCtrlPos[k].pos, seg.start, p ) );
+        NMC_RETURN_IF_ERR( CheckCartEnd( startAcs, p ) );
+    }
+
+    // The path starts on its first control point: it must be the start position.
+    for( I32_T i = 0; i < kGroupCoords; ++i )
+    {
+        if( std::fabs( ctrl[i] - seg.start[i] ) > kArcTolerance )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        ctrl[i] = seg.start[i];
+    }
+
+    I32_T slot = 0;
+    while( slot < kMaxSplines && splineBusy_[slot].load( std::memory_order_acquire ) )
+        ++slot;
+    if( slot == kMaxSplines )
+        return ERR_NEXMOTION_OPERATION_BUSY;
+    SplinePath &path = splines_[slot];
+    NMC_RETURN_IF_ERR( path.Build( Degree, Count, &ctrl[0], PKnots, PWeights ) );
+    seg.spline = &path;
+    seg.length = path.Length();
+    std::memcpy( seg.end, &ctrl[( Count - 1 ) * kGroupCoords], sizeof( seg.end ) );
+
+    NMC_RETURN_IF_ERR( SetCartVel( PMaxVel, &seg ) );
+    LimitPathByAxes( &seg );
+
+    // The slot is taken before the command is visible to the cycle, which frees it when the command is dropped.
+    splineBusy_[slot].store( true, std::memory_order_relaxed );
+    RTN_ERR ret = Enqueue( seg );
+    if( ret != ERR_NEXMOTION_SUCCESS )
+        splineBusy_[slot].store( false, std::memory_order_relaxed );
+    return ret;
+}
+
+RTN_ERR Group::Halt()
+{
+    StartQueued();
+    switch( state_ )
+    {
+    case NMC_GROUP_STATE_DISABLE:
+    case NMC_GROUP_STATE_STAND_STILL:
+        return ERR_NEXMOTION_SUCCESS;
+    case NMC_GROUP_STATE_MOVING:
+        break;
+    default:
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    }
+    if( cur_.type == GROUP_SEG_NONE || stopping_ != STOPPING_NONE )
+        return ERR_NEXMOTION_SUCCESS;
+
+    // A buffered halt waits for the buffered commands, a JOG motion never completes and is halted at once.
+    if( params_.I32( GRP_BUFF, 0 ) != 0 && cur_.type != GROUP_SEG_JOG_ACS && cur_.type != GROUP_SEG_JOG_CART )
+    {
+        GroupSeg_T seg;
+        InitSeg( GROUP_SEG_HALT, &seg );
+        return queue_.Push( seg ) ? ERR_NEXMOTION_SUCCESS : ERR_NEXMOTION_OPERATION_BUSY;
+    }
+
+    ClearQueue();
+    stopping_ = STOPPING_HALT;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::Stop()
+{
+    StartQueued();
+    switch( state_ )
+    {
+    case NMC_GROUP_STATE_HOMING:
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    case NMC_GROUP_STATE_STAND_STILL:
+        state_ = NMC_GROUP_STATE_STOPPED;
+        return ERR_NEXMOTION_SUCCESS;
+    case NMC_GROUP_STATE_MOVING:
+        ClearQueue();
+        stopping_ = STOPPING_STOP;
+        state_    = NMC_GROUP_STATE_STOPPING;
+        return ERR_NEXMOTION_SUCCESS;
+    default:
+        return ERR_NEXMOTION_SUCCESS;
+    }
+}
+
+RTN_ERR Group::SetHomePos( I32_T AxisMask, const F64_T *PHomePos )
+{
+    if( !MaskValid( AxisMask, AxisCount() ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    for( size_t i = 0; i < axes_.size(); ++i )
+        if( AxisMask & ( 1 << i ) ) axes_[i].homePos = PHomePos[i];
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::HomeDrive( I32_T AxisMask )
+{
+    StartQueued();
+    if( state_ != NMC_GROUP_STATE_STAND_STILL )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    if( !MaskValid( AxisMask, AxisCount() ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    GroupSeg_T seg;
+    InitSeg( GROUP_SEG_HOME, &seg );
+    std::memcpy( seg.acs, cmdAcs_, sizeof( seg.acs ) );
+    for( size_t i = 0; i < axes_.size(); ++i )
+        if( AxisMask & ( 1 << i ) ) seg.acs[i] = axes_[i].homePos;
+    seg.axisMask = AxisMask;
+    return Enqueue( seg );
+}
+
+I32_T Group::Status() const
+{
+    I32_T status = static_cast<I32_T>( latch_ );
+    if( state_ != NMC_GROUP_STATE_DISABLE ) status |= NMC_GROUP_STATUS_MASK_ENA;
+    if( state_ == NMC_GROUP_STATE_ERROR )   status |= NMC_GROUP_STATUS_MASK_ERR;
+    if( state_ == NMC_GROUP_STATE_STOPPED ) status |= NMC_GROUP_STATUS_MASK_STOP;
+    if( state_ == NMC_GROUP_STATE_MOVING || state_ == NMC_GROUP_STATE_HOMING || state_ == NMC_GROUP_STATE_STOPPING )
+        status |= NMC_GROUP_STATUS_MASK_OP;
+
+    bool still = true;
+    for( size_t i = 0; i < axes_.size(); ++i )
+        if( std::fabs( axes_[i].vel ) > kVelEpsilon ) still = false;
+    if( still ) status |= NMC_GROUP_STATUS_MASK_CSTP;
+
+    if( IsPathSeg( cur_ ) )
+    {
+        switch( pathProf_.Phase() )
+        {
+        case PROFILE_PHASE_ACC:   status |= NMC_GROUP_STATUS_MASK_ACC; break;
+        case PROFILE_PHASE_DEC:   status |= NMC_GROUP_STATUS_MASK_DEC; break;
+        case PROFILE_PHASE_CONST: status |= NMC_GROUP_STATUS_MASK_MV;  break;
+        default: break;
+        }
+    }
+    return status;
+}
+
+RTN_ERR Group::ToolFrame( Frame_T *PRet ) const
+{
+    I32_T index = params_.I32( GRP_TOOL_SEL );
+    if( index < 0 )
+    {
+        FrameIdentity( PRet );
+        return ERR_NEXMOTION_SUCCESS;
+    }
+    F64_T pose[6];
+    for( I32_T i = 0; i < 6; ++i )
+        pose[i] = params_.F64( GRP_TOOL_FIRST + index, i );
+    FrameFromPose( pose, PRet );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::BaseFrame( I32_T Index, Frame_T *PRet ) const
+{
+    // A base may refer to another base (sub-index 6), walk up to MCS.
+    FrameIdentity( PRet );
+    for( I32_T depth = 0; depth <= kMaxBases; ++depth )
+    {
+        if( Index < 0 )
+            return ERR_NEXMOTION_SUCCESS;
+        F64_T pose[6];
+        for( I32_T i = 0; i < 6; ++i )
+            pose[i] = params_.F64( GRP_BASE_FIRST + Index, i );
+        Frame_T b, tmp;
+        FrameFromPose( pose, &b );
+        FrameMul( b, *PRet, &tmp );
+        *PRet = tmp;
+        Index = params_.I32( GRP_BASE_FIRST + Index, 6 );
+    }
+    return ERR_NEXMOTION_KINEMATICS_PARAMETER_INVALID;
+}
+
+void Group::ForwardKin( const F64_T *PAcs, F64_T PRetPose[kGroupCoords] ) const
+{
+    I32_T n = AxisCount();
+    F64_T flange[6];
+    for( I32_T i = 0; i < 6; ++i )
+        flange[i] = ( i < n ) ? PAcs[i] : 0.0;
+
+    Frame_T f, tool, tcp;
+    FrameFromPose( flange, &f );
+    ToolFrame( &tool );
+    FrameMul( f, tool, &tcp );
+    FrameToPose( tcp, flange + 3, PRetPose );
+    for( I32_T i = 6; i < kGroupCoords; ++i )
+        PRetPose[i] = ( i < n ) ? PAcs[i] : 0.0;
+}
+
+RTN_ERR Group::InverseKin( const F64_T *PPose, const F64_T *PRefAcs, F64_T PRetAcs[kGroupCoords] ) const
+{
+    I32_T n = AxisCount();
+    Frame_T tcp, tool, toolInv, f;
+    FrameFromPose( PPose, &tcp );
+    ToolFrame( &tool );
+    FrameInv( tool, &toolInv );
+    FrameMul( tcp, toolInv, &f );
+
+    F64_T ref[3], flange[6], acs[kGroupCoords];
+    for( I32_T i = 0; i < 3; ++i )
+        ref[i] = ( i + 3 < n ) ? PRefAcs[i + 3] : 0.0;
+    FrameToPose( f, ref, flange );
+
+    for( I32_T i = 0; i < kGroupCoords; ++i )
+    {
+        F64_T v = ( i < 6 ) ? flange[i] : PPose[i];
+        if( i >= n )
+        {
+            if( std::fabs( v ) > kKinTolerance )
+                return ERR_NEXMOTION_INVERSE_KINEMATICS_FAILED;
+            v = 0.0;
+        }
+        acs[i] = v;
+    }
+    std::memcpy( PRetAcs, acs, sizeof( acs ) );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::PcsToMcs( I32_T Base, const F64_T *PPcs, const F64_T *PRefAbc, F64_T PRetMcs[kGroupCoords] ) const
+{
+    Frame_T base, pcs, mcs;
+    NMC_RETURN_IF_ERR( BaseFrame( Base, &base ) );
+    FrameFromPose( PPcs, &pcs );
+    FrameMul( base, pcs, &mcs );
+    F64_T aux[2] = { PPcs[6], PPcs[7] };
+    FrameToPose( mcs, PRefAbc, PRetMcs );
+    PRetMcs[6] = aux[0];
+    PRetMcs[7] = aux[1];
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR Group::McsToPcs( I32_T Base, const F64_T *PMcs, F64_T PRetPcs[kGroupCoords] ) const
+{
+    Frame_T base, baseInv, mcs, pcs;
+    NMC_RETURN_IF_ERR( BaseFrame( Base, &base ) );
+    FrameInv( base, &baseInv );
+    FrameFromPose( PMcs, &mcs );
+    FrameMul( baseInv, mcs, &pcs );
+    F64_T aux[2] = { PMcs[6], PMcs[7] };
+    FrameToPose( pcs, ( Base < 0 ) ? PMcs + 3 : 0, PRetPcs );
+    PRetPcs[6] = aux[0];
+    PRetPcs[7] = aux[1];
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void Group::Snapshot( GroupSnap_T *PRet ) const
+{
+    std::memset( PRet, 0, sizeof( *PRet ) );
+    PRet->state  = state_;
+    PRet->status = Status();
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        PRet->cmdAcs[i] = cmdAcs_[i];
+        PRet->actAcs[i] = axes_[i].actPos;
+        PRet->cmdVel[i] = axes_[i].vel;
+        PRet->actVel[i] = axes_[i].actVel;
+    }
+
+    // The Cartesian positions are converted here, the readers of the snapshot do not access the parameters.
+    I32_T base = params_.I32( GRP_BASE_SEL, 1 );
+    if( base == -2 ) base = TargetBase();
+    ForwardKin( PRet->cmdAcs, PRet->cmdMcs );
+    ForwardKin( PRet->actAcs, PRet->actMcs );
+    PRet->pcsError = McsToPcs( base, PRet->cmdMcs, PRet->cmdPcs );
+    if( PRet->pcsError == ERR_NEXMOTION_SUCCESS )
+        PRet->pcsError = McsToPcs( base, PRet->actMcs, PRet->actPcs );
+    if( PRet->pcsError != ERR_NEXMOTION_SUCCESS )
+    {
+        std::memset( PRet->cmdPcs, 0, sizeof( PRet->cmdPcs ) );
+        std::memset( PRet->actPcs, 0, sizeof( PRet->actPcs ) );
+    }
+}
+
+void Group::PathPose( const GroupSeg_T &Seg, F64_T S, F64_T PRetPose[kGroupCoords] )
+{
+    if( Seg.type == GROUP_SEG_SPLINE )
+    {
+        Seg.spline->Pose( S, PRetPose );
+        return;
+    }
+
+    F64_T f = ( Seg.length > 0.0 ) ? Clamp( S / Seg.length, 0.0, 1.0 ) : 1.0;
+    for( I32_T i = 0; i < kGroupCoords; ++i )
+        PRetPose[i] = Seg.start[i] + ( Seg.end[i] - Seg.start[i] ) * f;
+
+    if( Seg.type == GROUP_SEG_ARC )
+    {
+        F64_T th = Seg.sweep * f;
+        F64_T c  = std::cos( th ), s = std::sin( th );
+        for( I32_T i = 0; i < 3; ++i )
+            PRetPose[i] = Seg.center[i] + Seg.radius * ( c * Seg.u[i] + s * Seg.v[i] );
+    }
+}
+
+bool Group::PathTangent( const GroupSeg_T &Seg, bool AtEnd, F64_T PRetDir[3] )
+{
+    if( Seg.type == GROUP_SEG_SPLINE )
+    {
+        F64_T rate[kGroupCoords];
+        Seg.spline->Rate( AtEnd ? Seg.length : 0.0, rate );
+        std::memcpy( PRetDir, rate, sizeof( F64_T ) * 3 );
+        return Vec3Norm( PRetDir ) > kPosEpsilon && Vec3Normalize( PRetDir );
+    }
+    if( Seg.type == GROUP_SEG_ARC )
+    {
+        F64_T th = AtEnd ? Seg.sweep : 0.0;
+        F64_T c  = std::cos( th ), s = std::sin( th );
+        for( I32_T i = 0; i < 3; ++i )
+            PRetDir[i] = -s * Seg.u[i] + c * Seg.v[i];
+        return true;
+    }
+    Vec3Sub( Seg.end, Seg.start, PRetDir );
+    return Vec3Norm( PRetDir ) > kPosEpsilon && Vec3Normalize( PRetDir );
+}
+
+F64_T Group::CornerVelocity( const GroupSeg_T &Cur, const GroupSeg_T &Next )
+{
+    F64_T t1[3], t2[3];
+    if( !PathTangent( Cur, true, t1 ) || !PathTangent( Next, false, t2 ) )
+        return 0.0;
+
+    F64_T v     = std::min( Cur.vm, Next.vm );
+    F64_T theta = std::acos( Clamp( Vec3Dot( t1, t2 ), -1.0, 1.0 ) );
+    if( theta > 1e-6 )
+    {
+        // Radius of the corner rounding defined by the corner distance (mode 0) or the corner deviation (mode 1).
+        if( theta > kPi - 1e-6 || Next.blendValue <= 0.0 )
+            return 0.0;
+        F64_T half   = 0.5 * theta;
+        F64_T radius = ( Next.blendMode == 0 ) ? Next.blendValue / std::tan( half )
+                                               : Next.blendValue * std::cos( half ) / ( 1.0 - std::cos( half ) );
+        v = std::min( v, std::sqrt( std::min( Cur.acc, Next.acc ) * radius ) );
+    }
+    return v;
+}
+
+F64_T Group::BlendVelocity( const GroupSeg_T &Cur, const GroupSeg_T &Next, F64_T Dt ) const
+{
+    F64_T v = std::min( CornerVelocity( Cur, Next ), std::min( Cur.vm, Next.vm ) * speedRatio_ / 100.0 );
+    return std::min( v, OnlineProfile::BrakeVelocity( Next.length, 0.0, Next.dec, Dt ) );
+}
+
+void Group::PathRate( const GroupSeg_T &Seg, bool AtEnd, F64_T PRetRate[kGroupCoords] )
+{
+    if( Seg.type == GROUP_SEG_SPLINE )
+    {
+        Seg.spline->Rate( AtEnd ? Seg.length : 0.0, PRetRate );
+        return;
+    }
+    for( I32_T i = 0; i < kGroupCoords; ++i )
+        PRetRate[i] = ( Seg.length > 0.0 ) ? ( Seg.end[i] - Seg.start[i] ) / Seg.length : 0.0;
+    if( Seg.type == GROUP_SEG_ARC )
+        PathTangent( Seg, AtEnd, PRetRate );
+}
+
+F64_T Group::AxisCornerVelocity( const GroupSeg_T &Cur, const GroupSeg_T &Next, F64_T Dt ) const
+{
+    // Where the blend leaves a direction change, the path turns within a cycle and the velocity of each
+    // axis changes by v * ( r2 - r1 ) at once. A turn of the XYZ tangent is rounded by the blend and
+    // bounded by CornerVelocity(), only the other coordinates change their rate there.
+    F64_T t1[3], t2[3];
+    size_t first = ( PathTangent( Cur, true, t1 ) && PathTangent( Next, false, t2 )
+                     && std::acos( Clamp( Vec3Dot( t1, t2 ), -1.0, 1.0 ) ) > 1e-6 ) ? 3 : 0;
+    F64_T r1[kGroupCoords], r2[kGroupCoords];
+    PathRate( Cur, true, r1 );
+    PathRate( Next, false, r2 );
+    F64_T v = std::min( Cur.vm, Next.vm );
+    for( size_t i = first; i < axes_.size(); ++i )
+    {
+        F64_T jump = std::fabs( r2[i] - r1[i] );
+        if( jump > 1e-12 )
+            v = std::min( v, std::min( axes_[i].params.F64( AXP_ACC ), axes_[i].params.F64( AXP_DEC ) ) * Dt / jump );
+    }
+    return v;
+}
+
+void Group::LimitPathByAxes( GroupSeg_T *PSeg ) const
+{
+    if( PSeg->lookAhead <= 0 || PSeg->length <= kPosEpsilon )
+        return;
+
+    // Rate of each coordinate per unit of path length, the largest one along an arc or a spline. Group
+    // axis i drives coordinate i, exactly without a tool.
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        bool  onArc    = PSeg->type == GROUP_SEG_ARC && i < 3;
+        bool  onSpline = PSeg->type == GROUP_SEG_SPLINE;
+        F64_T rate     = onSpline ? PSeg->spline->MaxRate()[i]
+                       : onArc    ? std::sqrt( PSeg->u[i] * PSeg->u[i] + PSeg->v[i] * PSeg->v[i] )
+                                  : std::fabs( PSeg->end[i] - PSeg->start[i] ) / PSeg->length;
+        if( rate <= 1e-12 )
+            continue;
+        const ParamSet &p = axes_[i].params;
+        PSeg->vm  = std::min( PSeg->vm, p.F64( AXP_VM ) / rate );
+        PSeg->acc = std::min( PSeg->acc, p.F64( AXP_ACC ) / rate );
+        PSeg->dec = std::min( PSeg->dec, p.F64( AXP_DEC ) / rate );
+        // Centripetal acceleration of the axis: v^2 / radius on an arc, v^2 * |d2x/ds2| on a spline.
+        F64_T axisAcc = std::min( p.F64( AXP_ACC ), p.F64( AXP_DEC ) );
+        if( onArc )
+            PSeg->vm = std::min( PSeg->vm, std::sqrt( axisAcc * PSeg->radius / rate ) );
+        else if( onSpline && PSeg->spline->MaxBend()[i] > 1e-12 )
+            PSeg->vm = std::min( PSeg->vm, std::sqrt( axisAcc / PSeg->spline->MaxBend()[i] ) );
+    }
+}
+
+F64_T Group::LookAheadVelocity( F64_T Dt )
+{
+    // Forget the segments which left the buffer, started or cleared.
+    U32_T head = queue_.Head();
+    I32_T gone = static_cast<I32_T>( head - lookFirst_ );
+    lookCount_ = ( gone < 0 || gone >= lookCount_ ) ? 0 : lookCount_ - gone;
+    lookFirst_ = head;
+
+    // Append the blended path segments which entered the window, the last one stops at its end.
+    I32_T window = std::min( std::min( cur_.lookAhead, kMaxLookAhead ), queue_.Size() );
+    I32_T known  = lookCount_;
+    for( ; lookCount_ < window; ++lookCount_ )
+    {
+        U32_T             index = head + lookCount_;
+        const GroupSeg_T &seg   = queue_.At( index );
+        if( !IsPathSeg( seg ) || seg.bufferMode != 2 )
+            break;
+        LookAhead_T &e = look_[index % kMaxLookAhead];
+        const GroupSeg_T &prev = ( lookCount_ == 0 ) ? cur_ : queue_.At( index - 1 );
+        e.corner = std::min( CornerVelocity( prev, seg ), AxisCornerVelocity( prev, seg, Dt ) );
+        e.vEntry = std::min( e.corner, OnlineProfile::BrakeVelocity( seg.length, 0.0, seg.dec, Dt ) );
+    }
+
+    // Backward pass from the new end of the window. Appending only raises the entry velocities, an old
+    // segment which keeps its velocity is limited by its own corner or length and so are those before it.
+    for( I32_T k = lookCount_ - 2; k >= 0 && lookCount_ > known; --k )
+    {
+        U32_T        index = head + k;
+        LookAhead_T &e     = look_[index % kMaxLookAhead];
+        const GroupSeg_T &seg = queue_.At( index );
+        F64_T v = std::min( e.corner, OnlineProfile::BrakeVelocity( seg.length, look_[( index + 1 ) % kMaxLookAhead].vEntry, seg.dec, Dt ) );
+        if( k < known && v == e.vEntry )
+            break;
+        e.vEntry = v;
+    }
+    return ( lookCount_ > 0 ) ? look_[head % kMaxLookAhead].vEntry : 0.0;
+}
+
+bool Group::ApplyPose( const F64_T *PPose )
+{
+    F64_T acs[kGroupCoords];
+    if( InverseKin( PPose, cmdAcs_, acs ) != ERR_NEXMOTION_SUCCESS )
+    {
+        RaiseError( 0, cmdAcs_ );
+        return false;
+    }
+    for( size_t i = 0; i < axes_.size(); ++i )
+        cmdAcs_[i] = acs[i];
+    return true;
+}
+
+bool Group::StepAcs( F64_T Dt )
+{
+    F64_T ratio = speedRatio_ / 100.0;
+    bool  done  = true;
+
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        GroupAxis_T    &ax = axes_[i];
+        const ParamSet &p  = ax.params;
+        ProfileLimit_T lim;
+        lim.vm    = p.F64( AXP_VM ) * ratio;
+        lim.acc   = p.F64( AXP_ACC );
+        lim.dec   = p.F64( AXP_DEC );
+        lim.vBase = 0.0;
+        bool jogAxis = ( cur_.type == GROUP_SEG_JOG_ACS && static_cast<I32_T>( i ) == cur_.jogAxis );
+        if( jogAxis ) lim.vm = cur_.vm * ratio;
+
+        if( stopping_ != STOPPING_NONE )
+        {
+            if( stopping_ == STOPPING_STOP ) lim.dec = p.F64( AXP_STOP_PROF_DEC );
+            done &= ax.prof.StepVelocity( 0.0, lim, Dt );
+        }
+        else if( cur_.type == GROUP_SEG_JOG_ACS )
+        {
+            done = false;
+            if( !jogAxis )
+            {
+                ax.prof.StepVelocity( 0.0, lim, Dt );
+            }
+            else if( p.I32( AXP_SW_LIMIT_ENABLE ) != 0 && lim.vm > 0.0 )
+            {
+                // Decelerate in front of the software limit, then report the limit error.
+                bool  fwd = cur_.jogDir > 0.0;
+                F64_T end = fwd ? p.F64( AXP_SW_LIMIT_POS ) : p.F64( AXP_SW_LIMIT_NEG );
+                if( ax.prof.StepPosition( end, 0.0, lim, Dt ) )
+                {
+                    cmdAcs_[i] = end;
+                    RaiseError( fwd ? NMC_GROUP_STATUS_MASK_PSEL : NMC_GROUP_STATUS_MASK_NSEL, cmdAcs_ );
+                    return false;
+                }
+            }
+            else
+            {
+                ax.prof.StepVelocity( cur_.jogDir * lim.vm, lim, Dt );
+            }
+        }
+        else
+        {
+            if( cur_.sync )
+            {
+                lim.vm  = cur_.axisVm[i] * ratio;
+                lim.acc = cur_.axisAcc[i];
+                lim.dec = cur_.axisDec[i];
+            }
+            if( !ax.done ) ax.done = ax.prof.StepPosition( cur_.acs[i], 0.0, lim, Dt );
+            done &= ax.done;
+        }
+        cmdAcs_[i] = ax.prof.Pos();
+    }
+
+    if( done ) Finish();
+    return true;
+}
+
+bool Group::StepPath( F64_T Dt )
+{
+    ProfileLimit_T lim;
+    lim.vm    = cur_.vm * speedRatio_ / 100.0;
+    lim.acc   = cur_.acc;
+    lim.dec   = cur_.dec;
+    lim.vBase = 0.0;
+    F64_T pose[kGroupCoords];
+
+    if( stopping_ != STOPPING_NONE )
+    {
+        if( stopping_ == STOPPING_STOP ) lim.dec = params_.F64( GRP_STOP_PROF_DEC );
+        bool stopped = pathProf_.StepVelocity( 0.0, lim, Dt );
+        if( pathProf_.Pos() >= cur_.length )
+        {
+            // Not enough path left to decelerate, stop at the end of the segment.
+            pathProf_.Reset( cur_.length, 0.0 );
+            stopped = true;
+        }
+        PathPose( cur_, pathProf_.Pos(), pose );
+        if( !ApplyPose( pose ) ) return false;
+        if( stopped ) Finish();
+        return true;
+    }
+
+    const GroupSeg_T *next = 0;
+    if( !queue_.Empty() && queue_.Front().bufferMode == 2 && IsPathSeg( queue_.Front() ) )
+        next = &queue_.Front();
+    F64_T vEnd = 0.0;
+    if( next && cur_.lookAhead > 0 )
+        vEnd = std::min( LookAheadVelocity( Dt ), std::min( cur_.vm, next->vm ) * speedRatio_ / 100.0 );
+    else if( next )
+        vEnd = BlendVelocity( cur_, *next, Dt );
+
+    if( !pathProf_.StepPosition( cur_.length, vEnd, lim, Dt ) )
+    {
+        PathPose( cur_, pathProf_.Pos(), pose );
+        return ApplyPose( pose );
+    }
+
+    F64_T vel = pathProf_.Vel();
+    if( next && vel > kVelEpsilon )
+    {
+        // Blend into the next segment: carry the velocity and the distance travelled past the end. With
+        // look-ahead the path may be fast enough to cross several short segments in one cycle.
+        F64_T carry = pathProf_.Pos() - cur_.length;
+        for( ;; )
+        {
+            GroupSeg_T seg = queue_.Front();
+            queue_.Pop();
+            Begin( seg );
+            if( carry <= seg.length || seg.lookAhead <= 0 || queue_.Empty()
+                || queue_.Front().bufferMode != 2 || !IsPathSeg( queue_.Front() ) )
+                break;
+            carry -= seg.length;
+        }
+        pathProf_.Reset( Clamp( carry, 0.0, cur_.length ), vel );
+        PathPose( cur_, pathProf_.Pos(), pose );
+        return ApplyPose( pose );
+    }
+
+    if( !ApplyPose( cur_.end ) ) return false;
+    Finish();
+    return true;
+}
+
+bool Group::StepJogCart( F64_T Dt )
+{
+    ProfileLimit_T lim;
+    lim.vm    = cur_.vm * speedRatio_ / 100.0;
+    lim.acc   = cur_.acc;
+    lim.dec   = cur_.dec;
+    lim.vBase = 0.0;
+    if( stopping_ == STOPPING_STOP ) lim.dec = params_.F64( GRP_STOP_PROF_DEC );
+
+    F64_T s0      = pathProf_.Pos();
+    bool  stopped = pathProf_.StepVelocity( ( stopping_ != STOPPING_NONE ) ? 0.0 : cur_.jogDir * lim.vm, lim, Dt );
+    F64_T ds      = pathProf_.Pos() - s0;
+
+    F64_T pose[kGroupCoords];
+    std::memcpy( pose, cmdPose_, sizeof( pose ) );
+    F64_T dir[3];
+    if( cur_.jogAxis >= 6 )
+    {
+        pose[cur_.jogAxis] += ds;
+    }
+    else if( JogDirection( cur_, dir ) )
+    {
+        // JogDirection() includes the sign of the direction, ds already carries it.
+        for( I32_T i = 0; i < 3; ++i ) dir[i] *= cur_.jogDir;
+        Frame_T tcp;
+        FrameFromPose( cmdPose_, &tcp );
+        if( cur_.jogAxis < 3 )
+        {
+            for( I32_T i = 0; i < 3; ++i ) tcp.p[i] += ds * dir[i];
+        }
+        else
+        {
+            F64_T rot[3][3], r[3][3];
+            RotationAboutAxis( dir, ds, rot );
+            for( I32_T i = 0; i < 3; ++i )
+                for( I32_T j = 0; j < 3; ++j )
+                    r[i][j] = rot[i][0] * tcp.r[0][j] + rot[i][1] * tcp.r[1][j] + rot[i][2] * tcp.r[2][j];
+            std::memcpy( tcp.r, r, sizeof( r ) );
+        }
+        FrameToPose( tcp, cmdPose_ + 3, pose );
+    }
+
+    if( !ApplyPose( pose ) ) return false;
+    if( stopping_ != STOPPING_NONE && stopped ) Finish();
+    return true;
+}
+
+bool Group::Cycle( F64_T Dt )
+{
+    // Feedback of the command sent in the previous cycle.
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        GroupAxis_T &ax = axes_[i];
+        F64_T act = ax.encEnable ? std::floor( ax.sentPos * ax.pulsePerUnit + 0.5 ) / ax.pulsePerUnit : ax.sentPos;
+        ax.actVel = ( act - ax.actPos ) / Dt;
+        ax.actPos = act;
+    }
+
+    F64_T prevAcs[kGroupCoords], prevPose[kGroupCoords];
+    std::memcpy( prevAcs, cmdAcs_, sizeof( prevAcs ) );
+    std::memcpy( prevPose, cmdPose_, sizeof( prevPose ) );
+
+    StartQueued();
+    bool ok = true;
+    switch( cur_.type )
+    {
+    case GROUP_SEG_PTP:
+    case GROUP_SEG_HOME:
+    case GROUP_SEG_JOG_ACS:
+        ok = StepAcs( Dt );
+        break;
+    case GROUP_SEG_LINE:
+    case GROUP_SEG_ARC:
+    case GROUP_SEG_SPLINE:
+        ok = StepPath( Dt );
+        break;
+    case GROUP_SEG_JOG_CART:
+        ok = StepJogCart( Dt );
+        break;
+    default:
+        break;
+    }
+
+    if( ok && state_ != NMC_GROUP_STATE_DISABLE )
+    {
+        for( size_t i = 0; i < axes_.size() && ok; ++i )
+        {
+            const ParamSet &p = axes_[i].params;
+            if( p.I32( AXP_SW_LIMIT_ENABLE ) == 0 )
+                continue;
+            if( cmdAcs_[i] > p.F64( AXP_SW_LIMIT_POS ) + kPosEpsilon && cmdAcs_[i] > prevAcs[i] )
+            {
+                RaiseError( NMC_GROUP_STATUS_MASK_PSEL, prevAcs );
+                ok = false;
+            }
+            else if( cmdAcs_[i] < p.F64( AXP_SW_LIMIT_NEG ) - kPosEpsilon && cmdAcs_[i] < prevAcs[i] )
+            {
+                RaiseError( NMC_GROUP_STATUS_MASK_NSEL, prevAcs );
+                ok = false;
+            }
+        }
+    }
+
+    // Keep the axis profiles on the command of Cartesian motions so an ACS command can take over.
+    for( size_t i = 0; i < axes_.size(); ++i )
+    {
+        GroupAxis_T &ax = axes_[i];
+        ax.vel = ( cmdAcs_[i] - prevAcs[i] ) / Dt;
+        if( ax.prof.Pos() != cmdAcs_[i] ) ax.prof.Reset( cmdAcs_[i], ax.vel );
+        ax.sentPos = cmdAcs_[i];
+    }
+    ForwardKin( cmdAcs_, cmdPose_ );
+    for( I32_T i = 0; i < 3; ++i )
+        cartVel_[i] = ( cmdPose_[i] - prevPose[i] ) / Dt;
+    return !ok;
+}
+
+} // namespace nmc
@@ -0,0 +1,247 @@
+/*!
+ * @file        SimGroup.h
+ * @brief       Axis group (linear kinematics) of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_GROUP_H
+#define __NEXMOTION_SIM_GROUP_H
+
+#include "SimFrame.h"
+#include "SimParam.h"
+#include "SimProfile.h"
+#include "SimRealtime.h"
+#include "SimSnapshot.h"
+#include "SimSpline.h"
+#include "SimSpscRing.h"
+#include <string>
+#include <vector>
+
+namespace nmc
+{
+
+const I32_T kGroupCoords = NMC_MAX_POS_SIZE;   //!< Coordinates of a group position: X, Y, Z, A, B, C, U, V
+const I32_T kMaxSplines  = 8;                  //!< Spline commands of a group buffered or running at once
+
+//! Frame of a Cartesian JOG motion.
+enum GroupJogFrame_E
+{
+    GROUP_JOG_FRAME_PCS = 0,
+    GROUP_JOG_FRAME_TCP
+};
+
+//! Type of a group motion command stored in the motion buffer.
+enum GroupSegType_E
+{
+    GROUP_SEG_NONE = 0,
+    GROUP_SEG_PTP,          //!< Point-to-point in ACS
+    GROUP_SEG_HOME,         //!< Point-to-point in ACS to the home position
+    GROUP_SEG_JOG_ACS,      //!< JOG of one group axis
+    GROUP_SEG_JOG_CART,     //!< JOG along or about a Cartesian axis
+    GROUP_SEG_LINE,         //!< Linear interpolation in MCS
+    GROUP_SEG_ARC,          //!< Circular interpolation in MCS
+    GROUP_SEG_SPLINE,       //!< B-spline / NURBS interpolation in MCS
+    GROUP_SEG_HALT          //!< Buffered NMC_GroupHalt()
+};
+
+/*! @struct GroupSeg_T
+ *  @brief  A group motion command. Cartesian paths are stored in MCS (TCP pose) when they are enqueued.
+ */
+struct GroupSeg_T
+{
+    I32_T type;                     //!< GroupSegType_E
+    I32_T bufferMode;               //!< Group parameter 0x36:0 when the command was issued
+
+    I32_T axisMask;                 //!< PTP, HOME: group axes to move
+    F64_T acs[kGroupCoords];        //!< PTP, HOME: ACS targets
+    bool  sync;                     //!< PTP: group parameter 0x39, the axes run with the limits below
+    F64_T axisVm[kGroupCoords];     //!< PTP with sync: limits of each axis scaled to the common duration
+    F64_T axisAcc[kGroupCoords];
+    F64_T axisDec[kGroupCoords];
+
+    I32_T jogAxis;                  //!< JOG: group axis (ACS) or Cartesian axis
+    I32_T jogFrame;                 //!< JOG_CART: GroupJogFrame_E
+    F64_T jogDir;                   //!< JOG: 1 or -1
+
+    F64_T start[kGroupCoords];      //!< LINE, ARC, SPLINE: start pose (MCS)
+    F64_T end[kGroupCoords];        //!< LINE, ARC, SPLINE: end pose (MCS)
+    F64_T length;                   //!< LINE, ARC, SPLINE: path length
+    F64_T center[3];                //!< ARC: center
+    F64_T u[3];                     //!< ARC: unit vector from the center to the start point
+    F64_T v[3];                     //!< ARC: unit vector completing the arc plane (rotation axis x u)
+    F64_T radius;                   //!< ARC: radius
+    F64_T sweep;                    //!< ARC: swept angle (rad)
+    const SplinePath *spline;       //!< SPLINE: path in a spline slot of the group, held until the command is dropped
+
+    F64_T vm;                       //!< Cartesian velocity (LINE, ARC, JOG_CART, JOG_ACS)
+    F64_T acc;
+    F64_T dec;
+    I32_T blendMode;                //!< Group parameter 0x36:1
+    F64_T blendValue;               //!< Group parameter 0x36:2 or 0x36:3
+    I32_T lookAhead;                //!< Group parameter 0x36:4
+};
+
+//! One axis of a group.
+struct GroupAxis_T
+{
+    GroupAxis_T()
+        : params( PARAM_SCOPE_GROUP_AXIS ), vel( 0.0 ), sentPos( 0.0 ), actPos( 0.0 ), actVel( 0.0 )
+        , pulsePerUnit( 1.0 ), encEnable( true ), homePos( 0.0 ), done( true ) {}
+
+    ParamSet      params;
+    OnlineProfile prof;             //!< Used by ACS motions (PTP, HOME, JOG_ACS)
+    F64_T         vel;              //!< Command velocity of the last cycle
+    F64_T         sentPos;
+    F64_T         actPos;
+    F64_T         actVel;
+    F64_T         pulsePerUnit;
+    bool          encEnable;
+    F64_T         homePos;
+    bool          done;             //!< PTP, HOME: the axis reached its target
+};
+
+/*!
+ * @brief An axis group with linear kinematics (group parameter 0x00:0 = 0).
+ *
+ * The group axis i drives the Cartesian coordinate i (X, Y, Z, A, B, C, U, V) of the flange, the
+ * coordinates without a group axis are fixed to 0. The TCP is the flange transformed by the
+ * selected tool (0x47) and PCS positions are relative to the selected base (0x48).
+ * All methods are called with the device lock held, except in append mode (see SetAppendOnly()).
+ */
+class Group
+{
+public:
+    Group();
+
+    ParamSet          &Params()                    { return params_; }
+    ParamSet          &AxisParams( I32_T Index )   { return axes_[Index].params; }
+    const std::string &Description() const         { return description_; }
+    void               SetDescription( const std::string &Text ) { description_ = Text; }
+    I32_T              AxisCount() const           { return static_cast<I32_T>( axes_.size() ); }
+    void               SetAxisCount( I32_T Count );
+
+    RTN_ERR Start( I32_T BuffSize );
+    void    Shutdown();
+
+    RTN_ERR Enable();
+    RTN_ERR Disable();
+    RTN_ERR ResetState();
+    RTN_ERR SetSpeedRatio( F64_T Percentage );
+    F64_T   SpeedRatio() const { return speedRatio_; }
+
+    /*!
+     * @brief True if a buffered PTP, line or arc command can be appended without the device lock.
+     *
+     * Only AppendMutex() is required. The group runs a PTP, line or arc motion which is not halted or
+     * stopped, so the cycle owns everything but the motion buffer and endAcs_.
+     */
+    bool    Appendable() const;
+    //! Set while a motion command is called without the device lock after Appendable() returned true.
+    void    SetAppendOnly( bool AppendOnly ) { appendOnly_ = AppendOnly; }
+    //! Serializes the producers of the motion buffer. Taken alone to append, or after the device lock.
+    PiMutex &AppendMutex() { return appendMutex_; }
+
+    RTN_ERR PtpAcs( I32_T AxisMask, const F64_T *PAcsPos, I32_T VelAxis, const F64_T *PMaxVel );
+    RTN_ERR JogAcs( I32_T AxisIndex, I32_T Dir, const F64_T *PMaxVel );
+    RTN_ERR JogCart( I32_T Frame, I32_T CartAxis, I32_T Dir, const F64_T *PMaxVel );
+    RTN_ERR PtpCart( I32_T CartMask, const F64_T *PCartPos );
+    RTN_ERR Line( I32_T CartMask, const F64_T *PCartPos, const F64_T *PMaxVel );
+    RTN_ERR CircR( I32_T CartMask, const F64_T *PCartPos, const F64_T *PNormal, F64_T Radius, I32_T CwCcw, const F64_T *PMaxVel );
+    RTN_ERR CircC( I32_T CartMask, const F64_T *PCartPos, I32_T CenMask, const F64_T *PCenOfs, I32_T CwCcw, const F64_T *PMaxVel );
+    RTN_ERR CircB( I32_T CartMask, const F64_T *PCartPos, I32_T BorMask, const F64_T *PBorPoint, const F64_T *PAngleDeg, const F64_T *PMaxVel );
+    RTN_ERR Spline( I32_T CartMask, I32_T Degree, I32_T Count, const Pos_T *PCtrlPos, const F64_T *PKnots, const F64_T *PWeights, const F64_T *PMaxVel );
+    RTN_ERR Halt();
+    RTN_ERR Stop();
+    RTN_ERR SetHomePos( I32_T AxisMask, const F64_T *PHomePos );
+    RTN_ERR HomeDrive( I32_T AxisMask );
+
+    I32_T   State() const     { return state_; }
+    I32_T   Status() const;
+    I32_T   BuffSpace() const { return queue_.Free(); }
+    I32_T   BuffCount() const { return queue_.Size(); }
+    void    Snapshot( GroupSnap_T *PRet ) const;
+
+    //! Run one motion cycle. Return true if the group entered the error state in this cycle.
+    bool    Cycle( F64_T Dt );
+
+private:
+    RTN_ERR CheckMotionAllowed() const;
+    void    InitSeg( I32_T Type, GroupSeg_T *PSeg ) const;
+    const F64_T *StartAcs( const GroupSeg_T &Seg ) const;
+    RTN_ERR SetCartVel( const F64_T *PMaxVel, GroupSeg_T *PSeg );
+    RTN_ERR CheckSoftLimit( const F64_T *PAcs ) const;
+    void    SyncPtp( const F64_T *PStartAcs, GroupSeg_T *PSeg ) const;
+    RTN_ERR Enqueue( const GroupSeg_T &Seg );
+    void    ClearQueue();
+    void    ReleaseSpline( const GroupSeg_T &Seg );
+    void    StartQueued();
+    void    Begin( const GroupSeg_T &Seg );
+    void    SetCurType( I32_T Type ) { ReleaseSpline( cur_ ); cur_.type = Type; curType_ = Type; }
+    void    Finish();
+    void    RaiseError( U32_T LatchMask, const F64_T *PHoldAcs );
+
+    RTN_ERR ToolFrame( Frame_T *PRet ) const;
+    RTN_ERR BaseFrame( I32_T Index, Frame_T *PRet ) const;
+    I32_T   TargetBase() const { return params_.I32( GRP_BASE_SEL, 0 ); }
+    void    ForwardKin( const F64_T *PAcs, F64_T PRetPose[kGroupCoords] ) const;
+    RTN_ERR InverseKin( const F64_T *PPose, const F64_T *PRefAcs, F64_T PRetAcs[kGroupCoords] ) const;
+    RTN_ERR PcsToMcs( I32_T Base, const F64_T *PPcs, const F64_T *PRefAbc, F64_T PRetMcs[kGroupCoords] ) const;
+    RTN_ERR McsToPcs( I32_T Base, const F64_T *PMcs, F64_T PRetPcs[kGroupCoords] ) const;
+    RTN_ERR CartTarget( const F64_T *PStartAcs, I32_T CartMask, const F64_T *PCartPos, F64_T PRetStart[kGroupCoords], F64_T PRetEnd[kGroupCoords] ) const;
+    RTN_ERR CheckCartEnd( const F64_T *PStartAcs, const F64_T *PEnd ) const;
+    RTN_ERR BuildArc( const F64_T *PCenter, const F64_T *PAxis, F64_T Sweep, GroupSeg_T *PSeg ) const;
+    bool    JogDirection( const GroupSeg_T &Seg, F64_T PRetDir[3] ) const;
+    static void PathPose( const GroupSeg_T &Seg, F64_T S, F64_T PRetPose[kGroupCoords] );
+    static bool PathTangent( const GroupSeg_T &Seg, bool AtEnd, F64_T PRetDir[3] );
+    static F64_T CornerVelocity( const GroupSeg_T &Cur, const GroupSeg_T &Next );
+    static void  PathRate( const GroupSeg_T &Seg, bool AtEnd, F64_T PRetRate[kGroupCoords] );
+    F64_T   AxisCornerVelocity( const GroupSeg_T &Cur, const GroupSeg_T &Next, F64_T Dt ) const;
+    F64_T   BlendVelocity( const GroupSeg_T &Cur, const GroupSeg_T &Next, F64_T Dt ) const;
+    void    LimitPathByAxes( GroupSeg_T *PSeg ) const;
+    F64_T   LookAheadVelocity( F64_T Dt );
+
+    // Cycle steps, return false if the group entered the error state.
+    bool    ApplyPose( const F64_T *PPose );
+    bool    StepAcs( F64_T Dt );
+    bool    StepPath( F64_T Dt );
+    bool    StepJogCart( F64_T Dt );
+
+    ParamSet                 params_;
+    std::string              description_;
+    std::vector<GroupAxis_T> axes_;
+
+    Group( const Group & );
+    Group &operator=( const Group & );
+
+    SpscRing<GroupSeg_T>     queue_;
+    GroupSeg_T               cur_;
+    std::atomic<I32_T>       curType_;      //!< cur_.type, read by Appendable() without the device lock
+    std::atomic<I32_T>       state_;
+    std::atomic<I32_T>       stopping_;     //!< Halt or stop in progress
+    F64_T                    endAcs_[kGroupCoords];     //!< ACS position at the end of the buffered commands
+    bool                     appendOnly_;
+    PiMutex                  appendMutex_;
+
+    OnlineProfile            pathProf_;     //!< Path length of LINE/ARC/SPLINE, travel of JOG_CART
+    //! Look-ahead of a blended segment in the buffer.
+    struct LookAhead_T
+    {
+        F64_T corner;       //!< Velocity limit of the corner with the previous segment
+        F64_T vEntry;       //!< Highest entry velocity which still allows to stop at the end of the window
+    };
+    std::vector<LookAhead_T> look_;         //!< By buffer index modulo kMaxLookAhead
+    U32_T                    lookFirst_;    //!< Buffer index of the first segment of look_
+    I32_T                    lookCount_;
+    std::vector<SplinePath>  splines_;      //!< Paths of the spline commands, kMaxSplines slots
+    std::atomic<bool>        splineBusy_[kMaxSplines];  //!< Set by the API side, cleared by the cycle when the command is dropped
+    F64_T                    cmdAcs_[kGroupCoords];
+    F64_T                    cmdPose_[kGroupCoords];    //!< MCS pose of cmdAcs_
+    F64_T                    cartVel_[3];               //!< Translational velocity of the TCP in the last cycle
+
+    U32_T                    latch_;
+    F64_T                    speedRatio_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_GROUP_H
@@ -0,0 +1,148 @@
+/*!
+ * @file        SimInputEdge.cpp
+ * @brief       Edge detection of subscribed input bits, NMC_DeviceSubscribeInputEdge() and NMC_DevicePopInputEdges()
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimInputEdge.h"
+#include "SimRealtime.h"
+#include <algorithm>
+#include <cstring>
+
+namespace nmc
+{
+
+namespace
+{
+
+U64_T LoadWord( const U8_T *P )
+{
+    U64_T w;
+    std::memcpy( &w, P, sizeof( w ) );
+    return w;
+}
+
+} // namespace
+
+InputEdgeMonitor::InputEdgeMonitor()
+    : inputSize_( 0 )
+    , nextId_( 0 )
+    , lost_( 0 )
+{
+    queue_.Resize( NMC_MAX_INPUT_EDGES );
+}
+
+void InputEdgeMonitor::Resize( U32_T InputSize )
+{
+    if( InputSize == inputSize_ )
+        return;
+    inputSize_ = InputSize;
+    subs_.clear();
+    watch_.assign( InputSize, 0 );
+    Clear();
+}
+
+RTN_ERR InputEdgeMonitor::Subscribe( U32_T OffsetByte, U8_T BitMask, I32_T Edge, I32_T *PRetSubID )
+{
+    if( OffsetByte >= inputSize_ )
+        return ERR_NEXMOTION_ACCESS_AREA_INVALID;
+    if( BitMask == 0 || Edge < NMC_INPUT_EDGE_RISING || Edge > NMC_INPUT_EDGE_BOTH )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    if( subs_.size() >= NMC_MAX_INPUT_EDGE_SUBS )
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+
+    // Identifiers are not reused soon, as the parameter transactions.
+    nextId_ = ( nextId_ + 1 ) & 0x7FFFFFFF;
+    Sub_T sub = { OffsetByte, nextId_, BitMask, static_cast<U8_T>( Edge ) };
+    std::vector<Sub_T>::iterator at = std::upper_bound( subs_.begin(), subs_.end(), sub,
+        []( const Sub_T &A, const Sub_T &B ) { return A.offset < B.offset; } );
+    subs_.insert( at, sub );
+    watch_[OffsetByte] |= BitMask;
+    *PRetSubID = sub.id;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR InputEdgeMonitor::Unsubscribe( I32_T SubID )
+{
+    std::vector<Sub_T>::iterator it = std::find_if( subs_.begin(), subs_.end(),
+        [SubID]( const Sub_T &S ) { return S.id == SubID; } );
+    if( it == subs_.end() )
+        return ERR_NEXMOTION_OBJECT_ID_INVALID;
+    U32_T offset = it->offset;
+    subs_.erase( it );
+
+    U8_T watch = 0;
+    for( size_t k = 0; k < subs_.size(); ++k )
+        if( subs_[k].offset == offset ) watch |= subs_[k].mask;
+    watch_[offset] = watch;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void InputEdgeMonitor::Detect( const U8_T *PPrev, const U8_T *PNext, U64_T CycleCount )
+{
+    if( subs_.empty() )
+        return;
+    U64_T  now = 0;
+    size_t words = inputSize_ / sizeof( U64_T );
+    const U8_T *watch = &watch_[0];
+    for( size_t w = 0; w < words; ++w )
+    {
+        size_t off = w * sizeof( U64_T );
+        U64_T changed = ( LoadWord( PPrev + off ) ^ LoadWord( PNext + off ) ) & LoadWord( watch + off );
+        if( changed == 0 )
+            continue;
+        for( size_t k = 0; k < sizeof( U64_T ); ++k )
+        {
+            if( PPrev[off + k] != PNext[off + k] && watch[off + k] != 0 )
+                Match( static_cast<U32_T>( off + k ), PPrev[off + k], PNext[off + k], CycleCount, &now );
+        }
+    }
+    for( size_t off = words * sizeof( U64_T ); off < inputSize_; ++off )
+    {
+        if( ( PPrev[off] ^ PNext[off] ) & watch[off] )
+            Match( static_cast<U32_T>( off ), PPrev[off], PNext[off], CycleCount, &now );
+    }
+}
+
+void InputEdgeMonitor::Match( U32_T Offset, U8_T Prev, U8_T Next, U64_T CycleCount, U64_T *PNowNs )
+{
+    U8_T changed = static_cast<U8_T>( Prev ^ Next );
+    std::vector<Sub_T>::const_iterator it = std::lower_bound( subs_.begin(), subs_.end(), Offset,
+        []( const Sub_T &S, U32_T O ) { return S.offset < O; } );
+    for( ; it != subs_.end() && it->offset == Offset; ++it )
+    {
+        NmcInputEdge_T edge;
+        std::memset( &edge, 0, sizeof( edge ) );
+        if( it->edge & NMC_INPUT_EDGE_RISING )  edge.risingBits  = static_cast<U8_T>( changed & Next & it->mask );
+        if( it->edge & NMC_INPUT_EDGE_FALLING ) edge.fallingBits = static_cast<U8_T>( changed & Prev & it->mask );
+        if( ( edge.risingBits | edge.fallingBits ) == 0 )
+            continue;
+        if( *PNowNs == 0 ) *PNowNs = static_cast<U64_T>( MonotonicNs() );
+        edge.subscriptionId = it->id;
+        edge.offsetByte     = Offset;
+        edge.value          = Next;
+        edge.cycleCount     = CycleCount;
+        edge.timestampNs    = *PNowNs;
+        if( !queue_.Push( edge ) )
+            lost_.fetch_add( 1, std::memory_order_relaxed );
+    }
+}
+
+I32_T InputEdgeMonitor::Pop( NmcInputEdge_T *PRetEdges, I32_T MaxCount )
+{
+    I32_T count = 0;
+    while( count < MaxCount && !queue_.Empty() )
+    {
+        PRetEdges[count++] = queue_.Front();
+        queue_.Pop();
+    }
+    return count;
+}
+
+void InputEdgeMonitor::Clear()
+{
+    queue_.Clear();
+    lost_.store( 0, std::memory_order_relaxed );
+}
+
+} // namespace nmc
@@ -0,0 +1,75 @@
+/*!
+ * @file        SimInputEdge.h
+ * @brief       Edge detection of subscribed input bits, NMC_DeviceSubscribeInputEdge() and NMC_DevicePopInputEdges()
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_INPUT_EDGE_H
+#define __NEXMOTION_SIM_INPUT_EDGE_H
+
+#include "SimSpscRing.h"
+#include <atomic>
+#include <vector>
+
+namespace nmc
+{
+
+/*!
+ * @brief Compares the inputs of each exchange with the previous ones and queues the subscribed edges.
+ *
+ * The subscriptions are modified with the device lock held, which the motion cycle holds while it calls
+ * Detect(). Detect() compares the images 8 bytes at a time, masked by the OR of the subscribed bits of each
+ * byte, so the unchanged and unsubscribed bytes cost one XOR per word. The records go to a lock free ring:
+ * the motion cycle is the producer and the API callers, serialized by the command lock of the device, are
+ * the consumer, so popping never waits for the cycle. A record which finds the ring full is dropped and
+ * counted by Lost(), the records in the ring are never overwritten.
+ */
+class InputEdgeMonitor
+{
+public:
+    InputEdgeMonitor();
+
+    //! Set the size of the inputs. The subscriptions and the records are dropped if it changes, as the mapping of IoImage.
+    //! Called by the lifecycle functions with the command lock and the device lock.
+    void    Resize( U32_T InputSize );
+
+    // Subscriptions, the caller holds the device lock.
+    RTN_ERR Subscribe( U32_T OffsetByte, U8_T BitMask, I32_T Edge, I32_T *PRetSubID );
+    RTN_ERR Unsubscribe( I32_T SubID );
+
+    //! Producer: queue the subscribed edges between two input images of InputSize bytes. The caller holds the device lock.
+    void    Detect( const U8_T *PPrev, const U8_T *PNext, U64_T CycleCount );
+
+    //! Consumer: move up to MaxCount records to PRetEdges, oldest first. The caller holds the command lock.
+    I32_T   Pop( NmcInputEdge_T *PRetEdges, I32_T MaxCount );
+    //! Consumer: discard the records and reset Lost(). The caller holds the command lock.
+    void    Clear();
+    I32_T   Lost() const { return static_cast<I32_T>( lost_.load( std::memory_order_relaxed ) ); }
+
+private:
+    InputEdgeMonitor( const InputEdgeMonitor & );
+    InputEdgeMonitor &operator=( const InputEdgeMonitor & );
+
+    struct Sub_T
+    {
+        U32_T offset;
+        I32_T id;
+        U8_T  mask;
+        U8_T  edge;
+    };
+
+    void    Match( U32_T Offset, U8_T Prev, U8_T Next, U64_T CycleCount, U64_T *PNowNs );
+
+    // Subscriptions, protected by the device lock
+    U32_T                    inputSize_;
+    std::vector<Sub_T>       subs_;     //!< Sorted by offset, then by id
+    std::vector<U8_T>        watch_;    //!< OR of the subscribed bits of each input byte
+    I32_T                    nextId_;
+
+    SpscRing<NmcInputEdge_T> queue_;
+    std::atomic<U32_T>       lost_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_INPUT_EDGE_H
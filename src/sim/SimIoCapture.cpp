@@ -0,0 +1,416 @@
+/*!
+ * @file        SimIoCapture.cpp
+ * @brief       Capture of I/O memory ranges at each exchange to a file, NMC_DeviceStartIoCapture(), and its reader
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimIoCapture.h"
+#include "SimConfig.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace nmc
+{
+
+namespace
+{
+
+const char   kMagic[8]       = { 'N', 'M', 'C', 'I', 'O', 'C', 'A', 'P' };
+const size_t kRingBytes      = 4 << 20;    //!< Memory of the ring, about 1 s of the largest frames at 1 kHz
+const U32_T  kMinSlots       = 256;
+const U32_T  kMaxSlots       = 65536;
+const I32_T  kWriterPeriodMs = 10;
+const U32_T  kMaxRunGap      = 2;          //!< Unchanged bytes merged into a run, cheaper than starting a new one
+
+void PutVarint( std::vector<U8_T> *POut, U64_T Value )
+{
+    while( Value >= 0x80 )
+    {
+        POut->push_back( static_cast<U8_T>( Value | 0x80 ) );
+        Value >>= 7;
+    }
+    POut->push_back( static_cast<U8_T>( Value ) );
+}
+
+U64_T ZigZag( I64_T Value )   { return ( static_cast<U64_T>( Value ) << 1 ) ^ static_cast<U64_T>( Value >> 63 ); }
+I64_T UnZigZag( U64_T Value ) { return static_cast<I64_T>( Value >> 1 ) ^ -static_cast<I64_T>( Value & 1 ); }
+
+bool WriteAll( int Fd, const void *PData, size_t Bytes )
+{
+    const char *p = static_cast<const char *>( PData );
+    while( Bytes > 0 )
+    {
+        ssize_t n = ::write( Fd, p, Bytes );
+        if( n < 0 && errno == EINTR )
+            continue;
+        if( n <= 0 )
+            return false;
+        p     += n;
+        Bytes -= static_cast<size_t>( n );
+    }
+    return true;
+}
+
+//! Call Func( Offset, Length ) for each run of bytes which differ between PPrev and PNext.
+template <typename F>
+U32_T ForEachRun( const U8_T *PPrev, const U8_T *PNext, U32_T Bytes, F Func )
+{
+    U32_T runs = 0;
+    for( U32_T i = 0; i < Bytes; )
+    {
+        if( PPrev[i] == PNext[i] ) { ++i; continue; }
+        U32_T start = i, end = i + 1;
+        for( U32_T k = end; k < Bytes && k - end <= kMaxRunGap; ++k )
+            if( PPrev[k] != PNext[k] ) end = k + 1;
+        Func( start, end - start );
+        ++runs;
+        i = end;
+    }
+    return runs;
+}
+
+} // namespace
+
+IoCapture::IoCapture()
+    : frameBytes_( 0 )
+    , slotBytes_( 0 )
+    , slotCount_( 0 )
+    , fd_( -1 )
+    , active_( false )
+    , pushed_( false )
+    , pendingLost_( 0 )
+    , head_( 0 )
+    , tail_( 0 )
+    , stop_( false )
+    , prevCycle_( 0 )
+    , frames_( 0 )
+    , lost_( 0 )
+    , fileBytes_( 0 )
+    , error_( ERR_NEXMOTION_SUCCESS )
+{
+}
+
+IoCapture::~IoCapture()
+{
+    active_ = false;
+    Close();
+}
+
+RTN_ERR IoCapture::Open( I32_T Count, const NmcIoCaptureRange_T *PRanges, U32_T InputSize, U32_T OutputSize,
+                         U32_T CycleTimeUs, const char *PPath )
+{
+    if( fd_ >= 0 )
+        return ERR_NEXMOTION_OPERATION_BUSY;
+    if( Count <= 0 || Count > NMC_MAX_IO_CAPTURE_RANGES )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    U32_T frameBytes = 0;
+    for( I32_T i = 0; i < Count; ++i )
+    {
+        const NmcIoCaptureRange_T &r = PRanges[i];
+        if( r.area != NMC_MEM_ENTRY_AREA_INPUT && r.area != NMC_MEM_ENTRY_AREA_OUTPUT )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        U32_T size = ( r.area == NMC_MEM_ENTRY_AREA_INPUT ) ? InputSize : OutputSize;
+        if( r.sizeByte == 0 || r.sizeByte > NMC_MAX_IO_CAPTURE_BYTES )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        if( r.offsetByte >= size || r.sizeByte > size - r.offsetByte )
+            return ERR_NEXMOTION_ACCESS_AREA_INVALID;
+        frameBytes += r.sizeByte;
+        if( frameBytes > NMC_MAX_IO_CAPTURE_BYTES )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    }
+
+    IoCaptureHeader_T header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic, kMagic, sizeof( header.magic ) );
+    header.version     = kIoCaptureVersion;
+    header.headerBytes = sizeof( header );
+    header.rangeCount  = static_cast<U32_T>( Count );
+    header.frameBytes  = frameBytes;
+    header.cycleTimeUs = CycleTimeUs;
+    header.startUnixNs = static_cast<U64_T>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch() ).count() );
+
+    int fd = ::open( PPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+    if( fd < 0 )
+        return ERR_NEXMOTION_FILE_OPEN_FAILED;
+    if( !WriteAll( fd, &header, sizeof( header ) ) || !WriteAll( fd, PRanges, Count * sizeof( NmcIoCaptureRange_T ) ) )
+    {
+        ::close( fd );
+        return ERR_NEXMOTION_FILE_WRITE_PROHIBIT;
+    }
+
+    // Everything the cycle touches is allocated here, a capture does not allocate. fd_ is set last: until
+    // then, a failed allocation or thread start leaves the capture closed.
+    frameBytes_ = frameBytes;
+    slotBytes_  = static_cast<U32_T>( sizeof( SlotHeader_T ) ) + ( ( frameBytes + 7 ) & ~7u );
+    slotCount_  = std::min( kMaxSlots, std::max( kMinSlots, static_cast<U32_T>( kRingBytes / slotBytes_ ) ) );
+    out_.clear();
+    pushed_      = false;
+    pendingLost_ = 0;
+    prevCycle_   = 0;
+    head_.store( 0, std::memory_order_relaxed );
+    tail_.store( 0, std::memory_order_relaxed );
+    frames_.store( 0, std::memory_order_relaxed );
+    lost_.store( 0, std::memory_order_relaxed );
+    fileBytes_.store( sizeof( header ) + Count * sizeof( NmcIoCaptureRange_T ), std::memory_order_relaxed );
+    error_.store( ERR_NEXMOTION_SUCCESS, std::memory_order_relaxed );
+    stop_ = false;
+    try
+    {
+        ranges_.assign( PRanges, PRanges + Count );
+        ring_.assign( static_cast<size_t>( slotCount_ ) * slotBytes_, 0 );
+        frame_.assign( frameBytes, 0 );
+        last_.assign( frameBytes, 0 );
+        prev_.assign( frameBytes, 0 );
+        writer_ = std::thread( &IoCapture::WriterThread, this, fd );
+    }
+    catch( ... )
+    {
+        ::close( fd );
+        std::vector<U8_T>().swap( ring_ );
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+    }
+    fd_ = fd;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void IoCapture::Close()
+{
+    if( fd_ < 0 )
+        return;
+    {
+        std::lock_guard<std::mutex> lock( wakeMutex_ );
+        stop_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+    // The producer is inactive: the frames dropped after the last pushed one are final.
+    if( pendingLost_ > 0 )
+    {
+        out_.push_back( IO_CAPTURE_RECORD_LOST );
+        PutVarint( &out_, pendingLost_ );
+        pendingLost_ = 0;
+        Flush( fd_ );
+    }
+    ::close( fd_ );
+    fd_ = -1;
+    std::vector<U8_T>().swap( ring_ );
+}
+
+void IoCapture::Capture( const U8_T *PInput, const U8_T *POutput, U64_T CycleCount )
+{
+    U8_T *frame = &frame_[0];
+    for( size_t i = 0; i < ranges_.size(); ++i )
+    {
+        const NmcIoCaptureRange_T &r = ranges_[i];
+        std::memcpy( frame, ( r.area == NMC_MEM_ENTRY_AREA_INPUT ? PInput : POutput ) + r.offsetByte, r.sizeByte );
+        frame += r.sizeByte;
+    }
+    if( pushed_ && std::memcmp( &frame_[0], &last_[0], frameBytes_ ) == 0 )
+        return;
+
+    U64_T tail = tail_.load( std::memory_order_relaxed );
+    if( tail - head_.load( std::memory_order_acquire ) >= slotCount_ )
+    {
+        // The ring is full: drop the frame, but keep comparing with the last pushed one so the next frame
+        // which goes through brings the writer up to date.
+        ++pendingLost_;
+        lost_.fetch_add( 1, std::memory_order_relaxed );
+        return;
+    }
+    U8_T *slot = &ring_[static_cast<size_t>( tail % slotCount_ ) * slotBytes_];
+    SlotHeader_T header = { CycleCount, pendingLost_, 0 };
+    std::memcpy( slot, &header, sizeof( header ) );
+    std::memcpy( slot + sizeof( header ), &frame_[0], frameBytes_ );
+    tail_.store( tail + 1, std::memory_order_release );
+    pendingLost_ = 0;
+    pushed_      = true;
+    last_.swap( frame_ );
+}
+
+void IoCapture::Status( NmcIoCaptureStatus_T *PRetStatus ) const
+{
+    std::memset( PRetStatus, 0, sizeof( *PRetStatus ) );
+    PRetStatus->active     = ( fd_ >= 0 ) ? 1 : 0;
+    PRetStatus->error      = error_.load( std::memory_order_relaxed );
+    PRetStatus->frameBytes = frameBytes_;
+    PRetStatus->frameCount = frames_.load( std::memory_order_relaxed );
+    PRetStatus->lostCount  = lost_.load( std::memory_order_relaxed );
+    PRetStatus->fileBytes  = fileBytes_.load( std::memory_order_relaxed );
+}
+
+void IoCapture::WriterThread( int Fd )
+{
+    // The cycle does not signal the writer, it would cost a system call per exchange: the writer polls
+    // the ring, which holds far more than one period of frames.
+    std::unique_lock<std::mutex> lock( wakeMutex_ );
+    while( !stop_ )
+    {
+        wake_.wait_for( lock, std::chrono::milliseconds( kWriterPeriodMs ) );
+        lock.unlock();
+        Drain( Fd );
+        lock.lock();
+    }
+    lock.unlock();
+    Drain( Fd );
+}
+
+void IoCapture::Drain( int Fd )
+{
+    U64_T tail = tail_.load( std::memory_order_acquire );
+    for( U64_T head = head_.load( std::memory_order_relaxed ); head != tail; ++head )
+    {
+        const U8_T  *slot = &ring_[static_cast<size_t>( head % slotCount_ ) * slotBytes_];
+        SlotHeader_T header;
+        std::memcpy( &header, slot, sizeof( header ) );
+        Encode( header, slot + sizeof( header ) );
+        head_.store( head + 1, std::memory_order_release );
+    }
+    Flush( Fd );
+}
+
+void IoCapture::Encode( const SlotHeader_T &Slot, const U8_T *PFrame )
+{
+    if( Slot.lostBefore > 0 )
+    {
+        out_.push_back( IO_CAPTURE_RECORD_LOST );
+        PutVarint( &out_, Slot.lostBefore );
+    }
+    out_.push_back( IO_CAPTURE_RECORD_FRAME );
+    PutVarint( &out_, ZigZag( static_cast<I64_T>( Slot.cycle - prevCycle_ ) ) );
+    U32_T runs = ForEachRun( &prev_[0], PFrame, frameBytes_, []( U32_T, U32_T ) {} );
+    PutVarint( &out_, runs );
+    U32_T at = 0;
+    ForEachRun( &prev_[0], PFrame, frameBytes_, [&]( U32_T Offset, U32_T Length )
+    {
+        PutVarint( &out_, Offset - at );
+        PutVarint( &out_, Length );
+        out_.insert( out_.end(), PFrame + Offset, PFrame + Offset + Length );
+        at = Offset + Length;
+    } );
+    std::memcpy( &prev_[0], PFrame, frameBytes_ );
+    prevCycle_ = Slot.cycle;
+    frames_.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void IoCapture::Flush( int Fd )
+{
+    if( out_.empty() )
+        return;
+    // After a write error the frames are still drained, so the ring does not fill up, but no longer written.
+    if( error_.load( std::memory_order_relaxed ) == ERR_NEXMOTION_SUCCESS )
+    {
+        if( WriteAll( Fd, &out_[0], out_.size() ) )
+            fileBytes_.fetch_add( out_.size(), std::memory_order_relaxed );
+        else
+            error_.store( ERR_NEXMOTION_FILE_WRITE_PROHIBIT, std::memory_order_relaxed );
+    }
+    out_.clear();
+}
+
+IoCaptureReader::IoCaptureReader()
+    : pos_( 0 )
+    , cycle_( 0 )
+{
+    std::memset( &header_, 0, sizeof( header_ ) );
+}
+
+RTN_ERR IoCaptureReader::Open( const std::string &Path )
+{
+    NMC_RETURN_IF_ERR( ConfigReadFile( Path, &data_ ) );
+    if( data_.size() < sizeof( header_ ) || std::memcmp( data_.data(), kMagic, sizeof( kMagic ) ) != 0 )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    std::memcpy( &header_, data_.data(), sizeof( header_ ) );
+    if( header_.version != kIoCaptureVersion )
+        return ERR_NEXMOTION_FILE_VERSION_INCOMPTIBLE;
+    if( header_.headerBytes < sizeof( header_ ) || header_.rangeCount == 0 || header_.rangeCount > NMC_MAX_IO_CAPTURE_RANGES )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    size_t rangeBytes = header_.rangeCount * sizeof( NmcIoCaptureRange_T );
+    if( data_.size() < header_.headerBytes + rangeBytes )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    ranges_.resize( header_.rangeCount );
+    std::memcpy( &ranges_[0], data_.data() + header_.headerBytes, rangeBytes );
+    U32_T frameBytes = 0;
+    for( size_t i = 0; i < ranges_.size(); ++i )
+        frameBytes += std::min<U32_T>( ranges_[i].sizeByte, NMC_MAX_IO_CAPTURE_BYTES );
+    if( frameBytes == 0 || frameBytes != header_.frameBytes || frameBytes > NMC_MAX_IO_CAPTURE_BYTES )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    pos_   = header_.headerBytes + rangeBytes;
+    cycle_ = 0;
+    frame_.assign( frameBytes, 0 );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+U32_T IoCaptureReader::RangeOffset( I32_T Index ) const
+{
+    U32_T offset = 0;
+    for( I32_T i = 0; i < Index; ++i )
+        offset += ranges_[i].sizeByte;
+    return offset;
+}
+
+RTN_ERR IoCaptureReader::ReadVarint( U64_T *PRetValue )
+{
+    U64_T value = 0;
+    for( U32_T shift = 0; shift < 64; shift += 7 )
+    {
+        if( pos_ >= data_.size() )
+            return ERR_NEXMOTION_QUEUE_EMPTY;
+        U8_T byte = static_cast<U8_T>( data_[pos_++] );
+        value |= static_cast<U64_T>( byte & 0x7F ) << shift;
+        if( ( byte & 0x80 ) == 0 )
+        {
+            *PRetValue = value;
+            return ERR_NEXMOTION_SUCCESS;
+        }
+    }
+    return ERR_NEXMOTION_FILE_BAD_FORMAT;
+}
+
+RTN_ERR IoCaptureReader::Next( U64_T *PRetCycle, U32_T *PRetLostBefore, const std::vector<U8_T> **PRetFrame )
+{
+    *PRetLostBefore = 0;
+    while( pos_ < data_.size() )
+    {
+        U8_T  tag = static_cast<U8_T>( data_[pos_++] );
+        U64_T value;
+        if( tag == IO_CAPTURE_RECORD_LOST )
+        {
+            NMC_RETURN_IF_ERR( ReadVarint( &value ) );
+            *PRetLostBefore += static_cast<U32_T>( value );
+            continue;
+        }
+        if( tag != IO_CAPTURE_RECORD_FRAME )
+            return ERR_NEXMOTION_FILE_BAD_FORMAT;
+
+        U64_T runs;
+        NMC_RETURN_IF_ERR( ReadVarint( &value ) );
+        NMC_RETURN_IF_ERR( ReadVarint( &runs ) );
+        U64_T at = 0;
+        for( U64_T r = 0; r < runs; ++r )
+        {
+            U64_T gap, length;
+            NMC_RETURN_IF_ERR( ReadVarint( &gap ) );
+            NMC_RETURN_IF_ERR( ReadVarint( &length ) );
+            if( gap > frame_.size() || length > frame_.size() || at + gap + length > frame_.size() )
+                return ERR_NEXMOTION_FILE_BAD_FORMAT;
+            if( length > data_.size() - pos_ )
+                return ERR_NEXMOTION_QUEUE_EMPTY;
+            at += gap;
+            std::memcpy( &frame_[at], data_.data() + pos_, length );
+            pos_ += length;
+            at   += length;
+        }
+        cycle_     += static_cast<U64_T>( UnZigZag( value ) );
+        *PRetCycle  = cycle_;
+        *PRetFrame  = &frame_;
+        return ERR_NEXMOTION_SUCCESS;
+    }
+    return ERR_NEXMOTION_QUEUE_EMPTY;
+}
+
+} // namespace nmc
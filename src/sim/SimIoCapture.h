@@ -0,0 +1,181 @@
+/*!
+ * @file        SimIoCapture.h
+ * @brief       Capture of I/O memory ranges at each exchange to a file, NMC_DeviceStartIoCapture(), and its reader
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_IO_CAPTURE_H
+#define __NEXMOTION_SIM_IO_CAPTURE_H
+
+#include "SimSpscRing.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nmc
+{
+
+//! Layout version of the capture file.
+const U32_T kIoCaptureVersion = 1;
+
+/*! @struct IoCaptureHeader_T
+ *  @brief  Header of a capture file, followed by rangeCount NmcIoCaptureRange_T, then by the records.
+ *
+ *  A frame is the concatenation of the captured ranges, in the order of the range table. Each record starts
+ *  with a tag byte, the numbers are unsigned LEB128 varints:
+ *  - IO_CAPTURE_RECORD_FRAME: the cycle delta, zigzag encoded, from the cycle of the previous frame (from 0
+ *    for the first one), then the number of runs, then per run the gap from the end of the previous run (from
+ *    offset 0 for the first one), the length and the bytes. The runs hold the bytes which differ from the
+ *    previous frame; the frame before the first one is all 0.
+ *  - IO_CAPTURE_RECORD_LOST: the number of frames dropped before the next one because the ring was full.
+ *  The file is only appended to, a truncated last record is the end of a capture which was not stopped.
+ */
+struct IoCaptureHeader_T
+{
+    char  magic[8];         //!< "NMCIOCAP"
+    U32_T version;          //!< kIoCaptureVersion
+    U32_T headerBytes;      //!< sizeof( IoCaptureHeader_T )
+    U32_T rangeCount;
+    U32_T frameBytes;       //!< Sum of the sizes of the ranges
+    U32_T cycleTimeUs;      //!< System parameter 0x00 when the capture started
+    U32_T reserved;
+    U64_T startUnixNs;      //!< Wall clock time when the capture started (ns since 1970)
+};
+
+enum IoCaptureRecord_E
+{
+    IO_CAPTURE_RECORD_FRAME = 1,
+    IO_CAPTURE_RECORD_LOST  = 2,
+};
+
+/*!
+ * @brief Copies I/O memory ranges to a preallocated ring at each exchange and streams them to a file.
+ *
+ * The motion cycle is the producer: Capture() copies the ranges of the latched inputs and of the sent outputs
+ * to a frame, and pushes it to the ring unless it equals the last pushed frame, so a capture costs a copy and
+ * a compare per exchange and no allocation. A writer thread is the consumer: it encodes the frames as the
+ * bytes changed since the previous one and appends them to the file. A frame which finds the ring full is
+ * dropped and counted, the count is written before the next frame which goes through; the next frame still
+ * holds the whole state, only the transitions in between are missing.
+ *
+ * Open(), Close() and Status() are called with the command lock of the device, SetActive() and Capture()
+ * with its device lock.
+ */
+class IoCapture
+{
+public:
+    IoCapture();
+    ~IoCapture();
+
+    //! Check the ranges against the memory sizes, allocate the ring, write the header to PPath and start the writer.
+    RTN_ERR Open( I32_T Count, const NmcIoCaptureRange_T *PRanges, U32_T InputSize, U32_T OutputSize,
+                  U32_T CycleTimeUs, const char *PPath );
+    //! Write the frames left in the ring and close the file. The producer is inactive.
+    void    Close();
+    bool    Opened() const { return fd_ >= 0; }
+
+    void    SetActive( bool Active ) { active_ = Active; }
+    bool    Active() const { return active_; }
+    //! Producer: capture the ranges of the images of one exchange, POutput may be 0 if the output memory is empty.
+    void    Capture( const U8_T *PInput, const U8_T *POutput, U64_T CycleCount );
+
+    void    Status( NmcIoCaptureStatus_T *PRetStatus ) const;
+
+private:
+    IoCapture( const IoCapture & );
+    IoCapture &operator=( const IoCapture & );
+
+    //! A slot of the ring: the cycle, the frames dropped before it, then the frame.
+    struct SlotHeader_T
+    {
+        U64_T cycle;
+        U32_T lostBefore;
+        U32_T reserved;
+    };
+
+    //! Fd is the file of fd_, which is only set once the thread runs.
+    void    WriterThread( int Fd );
+    void    Drain( int Fd );
+    void    Encode( const SlotHeader_T &Slot, const U8_T *PFrame );
+    void    Flush( int Fd );
+
+    // Configuration, set by Open()
+    std::vector<NmcIoCaptureRange_T> ranges_;
+    U32_T                    frameBytes_;
+    U32_T                    slotBytes_;
+    U32_T                    slotCount_;
+    std::vector<U8_T>        ring_;
+    int                      fd_;
+
+    // Producer, protected by the device lock
+    bool                     active_;
+    std::vector<U8_T>        frame_;
+    std::vector<U8_T>        last_;         //!< Last pushed frame
+    bool                     pushed_;
+    U32_T                    pendingLost_;
+
+    char                     padHead_[kCacheLineSize];
+    std::atomic<U64_T>       head_;         //!< Written by the writer
+    char                     padTail_[kCacheLineSize - sizeof( std::atomic<U64_T> )];
+    std::atomic<U64_T>       tail_;         //!< Written by the producer
+    char                     padEnd_[kCacheLineSize - sizeof( std::atomic<U64_T> )];
+
+    // Writer
+    std::thread              writer_;
+    std::mutex               wakeMutex_;
+    std::condition_variable  wake_;
+    bool                     stop_;
+    std::vector<U8_T>        prev_;         //!< Last encoded frame
+    U64_T                    prevCycle_;
+    std::vector<U8_T>        out_;          //!< Encoded records not yet written
+
+    std::atomic<U64_T>       frames_;
+    std::atomic<U64_T>       lost_;
+    std::atomic<U64_T>       fileBytes_;
+    std::atomic<RTN_ERR>     error_;
+};
+
+/*!
+ * @brief Offline decoder of a capture file.
+ *
+ * Next() returns the frames in order, each one with its cycle and the number of frames dropped before it.
+ * The whole file is read by Open(), a capture file holds about a byte per changed byte of the captured ranges.
+ */
+class IoCaptureReader
+{
+public:
+    IoCaptureReader();
+
+    //! Read the whole file and check its header.
+    RTN_ERR Open( const std::string &Path );
+
+    const IoCaptureHeader_T                &Header() const { return header_; }
+    const std::vector<NmcIoCaptureRange_T> &Ranges() const { return ranges_; }
+    //! Byte offset of range Index in a frame.
+    U32_T   RangeOffset( I32_T Index ) const;
+
+    /*!
+     * @brief Decode the next frame.
+     * @return ERR_NEXMOTION_SUCCESS, ERR_NEXMOTION_QUEUE_EMPTY at the end of the file (a truncated last record
+     *         included) with *PRetLostBefore the frames dropped after the last one, ERR_NEXMOTION_FILE_BAD_FORMAT
+     *         if a record is corrupt.
+     */
+    RTN_ERR Next( U64_T *PRetCycle, U32_T *PRetLostBefore, const std::vector<U8_T> **PRetFrame );
+
+private:
+    RTN_ERR ReadVarint( U64_T *PRetValue );
+
+    IoCaptureHeader_T                header_;
+    std::vector<NmcIoCaptureRange_T> ranges_;
+    std::string                      data_;
+    size_t                           pos_;
+    std::vector<U8_T>                frame_;
+    U64_T                            cycle_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_IO_CAPTURE_H
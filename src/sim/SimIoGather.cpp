@@ -0,0 +1,150 @@
+/*!
+ * @file        SimIoGather.cpp
+ * @brief       Typed gather and scatter of I/O memory fields, NMC_ReadInputGather() and NMC_WriteOutputScatter()
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimIoGather.h"
+#include "SimIoMap.h"
+#include <algorithm>
+#include <cstring>
+
+namespace nmc
+{
+
+namespace
+{
+
+static_assert( sizeof( NmcIoValue_T ) == sizeof( U64_T ), "a value holds the largest field and nothing else" );
+
+//! Size of a field (byte), 0 for NMC_MEM_ENTRY_TYPE_BIT.
+U32_T ItemSize( U32_T Type )
+{
+    return MemEntryTypeBits( Type ) / 8;
+}
+
+//! Number of items from PItems[0] of the same type at consecutive offsets.
+I32_T RunLength( I32_T Count, const NmcIoItem_T *PItems, U32_T Size )
+{
+    I32_T n = 1;
+    while( n < Count && PItems[n].type == PItems[0].type && PItems[n].offsetByte == PItems[n - 1].offsetByte + Size )
+        ++n;
+    return n;
+}
+
+// The fields are little endian as the values, so a field is the low bytes of its value.
+template <typename T>
+void ExpandRun( const U8_T *PSource, I32_T Count, NmcIoValue_T *PRetValues )
+{
+    for( I32_T k = 0; k < Count; ++k )
+    {
+        T field;
+        std::memcpy( &field, PSource + k * sizeof( T ), sizeof( T ) );
+        PRetValues[k].u64 = field;
+    }
+}
+
+template <size_t N>
+void PackRun( const NmcIoValue_T *PValues, I32_T Count, U8_T *PTarget )
+{
+    for( I32_T k = 0; k < Count; ++k )
+        std::memcpy( PTarget + k * N, &PValues[k], N );
+}
+
+} // namespace
+
+RTN_ERR IoCheckItems( I32_T Count, const NmcIoItem_T *PItems, U32_T SizeByte )
+{
+    if( Count < 0 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    for( I32_T i = 0; i < Count; ++i )
+    {
+        const NmcIoItem_T &item = PItems[i];
+        U32_T bits = MemEntryTypeBits( item.type );
+        if( bits == 0 || ( bits == 1 && item.bitIndex > 7 ) )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        U32_T size = ( bits == 1 ) ? 1 : bits / 8;
+        if( item.offsetByte >= SizeByte || size > SizeByte - item.offsetByte )
+            return ERR_NEXMOTION_ACCESS_AREA_INVALID;
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void IoGather( const U8_T *PMemory, const OutputMaskBuffer *PMasks, I32_T Count, const NmcIoItem_T *PItems,
+               NmcIoValue_T *PRetValues )
+{
+    for( I32_T i = 0; i < Count; )
+    {
+        const NmcIoItem_T &item = PItems[i];
+        U32_T size = ItemSize( item.type );
+        if( size == 0 )
+        {
+            U8_T byte = PMemory[item.offsetByte];
+            if( PMasks ) PMasks->Overlay( item.offsetByte, 1, &byte );
+            std::memset( &PRetValues[i], 0, sizeof( PRetValues[i] ) );
+            PRetValues[i].bitValue = ( byte >> item.bitIndex ) & 1;
+            ++i;
+            continue;
+        }
+
+        I32_T n = RunLength( Count - i, PItems + i, size );
+        const U8_T *source = PMemory + item.offsetByte;
+        switch( size )
+        {
+        case 1:  ExpandRun<U8_T>( source, n, PRetValues + i ); break;
+        case 2:  ExpandRun<U16_T>( source, n, PRetValues + i ); break;
+        case 4:  ExpandRun<U32_T>( source, n, PRetValues + i ); break;
+        default: std::memcpy( PRetValues + i, source, n * sizeof( NmcIoValue_T ) ); break;
+        }
+        if( PMasks )
+        {
+            for( I32_T k = 0; k < n; ++k )
+                PMasks->Overlay( item.offsetByte + k * size, size, reinterpret_cast<U8_T *>( &PRetValues[i + k] ) );
+        }
+        i += n;
+    }
+}
+
+void IoScatter( OutputMaskBuffer &Masks, I32_T Count, const NmcIoItem_T *PItems, const NmcIoValue_T *PValues )
+{
+    U8_T  packed[512];
+    I32_T bank = Masks.BeginWrite();
+    for( I32_T i = 0; i < Count; )
+    {
+        const NmcIoItem_T &item = PItems[i];
+        U32_T size = ItemSize( item.type );
+        if( size == 0 )
+        {
+            U8_T mask  = static_cast<U8_T>( 1u << item.bitIndex );
+            U8_T value = PValues[i].bitValue ? mask : 0;
+            Masks.Merge( bank, item.offsetByte, 1, &value, &mask );
+            ++i;
+            continue;
+        }
+
+        I32_T n = RunLength( Count - i, PItems + i, size );
+        if( size == sizeof( NmcIoValue_T ) )
+        {
+            Masks.Merge( bank, item.offsetByte, n * size, reinterpret_cast<const U8_T *>( PValues + i ), 0 );
+        }
+        else
+        {
+            for( I32_T done = 0; done < n; )
+            {
+                I32_T chunk = std::min<I32_T>( n - done, sizeof( packed ) / size );
+                switch( size )
+                {
+                case 1:  PackRun<1>( PValues + i + done, chunk, packed ); break;
+                case 2:  PackRun<2>( PValues + i + done, chunk, packed ); break;
+                default: PackRun<4>( PValues + i + done, chunk, packed ); break;
+                }
+                Masks.Merge( bank, item.offsetByte + done * size, chunk * size, packed, 0 );
+                done += chunk;
+            }
+        }
+        i += n;
+    }
+    Masks.EndWrite( bank );
+}
+
+} // namespace nmc
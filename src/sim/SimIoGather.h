@@ -0,0 +1,32 @@
+/*!
+ * @file        SimIoGather.h
+ * @brief       Typed gather and scatter of I/O memory fields, NMC_ReadInputGather() and NMC_WriteOutputScatter()
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_IO_GATHER_H
+#define __NEXMOTION_SIM_IO_GATHER_H
+
+#include "SimOutputMask.h"
+
+namespace nmc
+{
+
+//! Check the type, bit index and range of Count items in a memory of SizeByte bytes.
+RTN_ERR IoCheckItems( I32_T Count, const NmcIoItem_T *PItems, U32_T SizeByte );
+
+/*!
+ * @brief Read Count checked items of PMemory to PRetValues, with the pending writes of PMasks if not 0.
+ *
+ * Consecutive items of the same type at consecutive offsets form a run, copied by a loop of a fixed
+ * element size which the compiler vectorizes; a run of 8 byte fields is a single block copy.
+ */
+void    IoGather( const U8_T *PMemory, const OutputMaskBuffer *PMasks, I32_T Count, const NmcIoItem_T *PItems,
+                  NmcIoValue_T *PRetValues );
+
+//! Write Count checked items to PMasks, as a single write which goes out in one exchange. Runs as IoGather().
+void    IoScatter( OutputMaskBuffer &Masks, I32_T Count, const NmcIoItem_T *PItems, const NmcIoValue_T *PValues );
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_IO_GATHER_H
@@ -0,0 +1,106 @@
+/*!
+ * @file        SimIoImage.cpp
+ * @brief       Application side of the I/O process images, mapped for direct access by NMC_DeviceGetIoImage()
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimIoImage.h"
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nmc
+{
+
+namespace
+{
+
+const size_t kCacheLine = 64;
+
+size_t RoundUp( size_t Bytes, size_t Unit )
+{
+    return ( Bytes + Unit - 1 ) / Unit * Unit;
+}
+
+} // namespace
+
+static_assert( sizeof( std::atomic<U32_T> ) == sizeof( U32_T ), "the sequence counter is read as a U32_T by the application" );
+
+IoImage::IoImage()
+    : map_( 0 )
+    , mapBytes_( 0 )
+    , seq_( &idleSeq_ )
+    , idleSeq_( 0 )
+    , input_( 0 )
+    , output_( 0 )
+    , inputSize_( 0 )
+    , outputSize_( 0 )
+{
+}
+
+IoImage::~IoImage()
+{
+    Release();
+}
+
+RTN_ERR IoImage::Allocate( U32_T InputSize, U32_T OutputSize )
+{
+    if( map_ && InputSize == inputSize_ && OutputSize == outputSize_ )
+    {
+        Clear();
+        return ERR_NEXMOTION_SUCCESS;
+    }
+    Release();
+
+    size_t page  = static_cast<size_t>( ::sysconf( _SC_PAGESIZE ) );
+    size_t bytes = RoundUp( kCacheLine + RoundUp( InputSize, kCacheLine ) + OutputSize, page );
+    // A shared mapping of whole pages: the images stay in place for the pointers handed out, and can be locked
+    // in memory with the rest of the process (system parameter 0x12).
+    void *map = ::mmap( 0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+    if( map == MAP_FAILED )
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+
+    map_        = map;
+    mapBytes_   = bytes;
+    seq_        = new( map ) std::atomic<U32_T>( 0 );
+    input_      = static_cast<U8_T *>( map ) + kCacheLine;
+    output_     = input_ + RoundUp( InputSize, kCacheLine );
+    inputSize_  = InputSize;
+    outputSize_ = OutputSize;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void IoImage::Release()
+{
+    if( map_ )
+        ::munmap( map_, mapBytes_ );
+    map_        = 0;
+    mapBytes_   = 0;
+    seq_        = &idleSeq_;
+    input_      = 0;
+    output_     = 0;
+    inputSize_  = 0;
+    outputSize_ = 0;
+}
+
+void IoImage::BeginExchange()
+{
+    seq_->store( seq_->load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+}
+
+void IoImage::EndExchange()
+{
+    seq_->store( seq_->load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+}
+
+void IoImage::Clear()
+{
+    BeginExchange();
+    if( inputSize_ > 0 )  std::memset( input_, 0, inputSize_ );
+    if( outputSize_ > 0 ) std::memset( output_, 0, outputSize_ );
+    EndExchange();
+}
+
+} // namespace nmc
@@ -0,0 +1,66 @@
+/*!
+ * @file        SimIoImage.h
+ * @brief       Application side of the I/O process images, mapped for direct access by NMC_DeviceGetIoImage()
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_IO_IMAGE_H
+#define __NEXMOTION_SIM_IO_IMAGE_H
+
+#include "SimCommon.h"
+#include <atomic>
+
+namespace nmc
+{
+
+/*!
+ * @brief Input and output images read and written by the application, in one shared memory mapping.
+ *
+ * The mapping holds the exchange sequence counter, then the input image, then the output image, each on its own
+ * cache line. The application accesses the images through the API functions under the device lock, or directly
+ * through the pointers of NMC_DeviceGetIoImage() with no call at all. The motion cycle brackets every exchange
+ * with BeginExchange() and EndExchange(): the counter is odd while the images change and grows by 2 per exchange,
+ * so a direct reader retries as with SeqLockBuffer.
+ *
+ * Allocate() keeps the mapping, and the pointers handed out, if the sizes are unchanged.
+ */
+class IoImage
+{
+public:
+    IoImage();
+    ~IoImage();
+
+    //! Map zeroed images. Not thread safe, called by the lifecycle functions with the device lock.
+    RTN_ERR Allocate( U32_T InputSize, U32_T OutputSize );
+    void    Release();
+
+    U32_T   InputSize() const  { return inputSize_; }
+    U32_T   OutputSize() const { return outputSize_; }
+    U8_T   *Input()            { return input_; }
+    U8_T   *Output()           { return output_; }
+    const U8_T *Input() const  { return input_; }
+    const U8_T *Output() const { return output_; }
+    const std::atomic<U32_T> &Sequence() const { return *seq_; }
+
+    void    BeginExchange();
+    void    EndExchange();
+    //! Zero both images as one exchange.
+    void    Clear();
+
+private:
+    IoImage( const IoImage & );
+    IoImage &operator=( const IoImage & );
+
+    void                *map_;
+    size_t               mapBytes_;
+    std::atomic<U32_T>  *seq_;            //!< In the mapping, or idleSeq_ without a mapping
+    std::atomic<U32_T>   idleSeq_;
+    U8_T                *input_;
+    U8_T                *output_;
+    U32_T                inputSize_;
+    U32_T                outputSize_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_IO_IMAGE_H
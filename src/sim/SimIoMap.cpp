@@ -0,0 +1,193 @@
+/*!
+ * @file        SimIoMap.cpp
+ * @brief       Named entries of the I/O memory ([InputMap] and [OutputMap]), looked up by NMC_MemEntryFind()
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimIoMap.h"
+#include "SimConfigCache.h"
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+
+namespace nmc
+{
+
+namespace
+{
+
+// A handle holds the entry index in bits 0 ~ 15, the area in bit 16 and the generation of the map in bits 17 ~ 30.
+const I32_T kHandleIndexBits = 16;
+const I32_T kHandleGenMask   = 0x3FFF;
+
+static_assert( NMC_MAX_MEM_ENTRIES <= ( 1 << kHandleIndexBits ), "the entry index must fit in a handle" );
+
+const struct TypeName_T
+{
+    const char *name;
+    U32_T       type;
+    U32_T       bits;
+} kTypes[] =
+{
+    { "BIT", NMC_MEM_ENTRY_TYPE_BIT, 1 },
+    { "I8",  NMC_MEM_ENTRY_TYPE_I8,  8 },
+    { "U8",  NMC_MEM_ENTRY_TYPE_U8,  8 },
+    { "I16", NMC_MEM_ENTRY_TYPE_I16, 16 },
+    { "U16", NMC_MEM_ENTRY_TYPE_U16, 16 },
+    { "I32", NMC_MEM_ENTRY_TYPE_I32, 32 },
+    { "U32", NMC_MEM_ENTRY_TYPE_U32, 32 },
+    { "I64", NMC_MEM_ENTRY_TYPE_I64, 64 },
+    { "U64", NMC_MEM_ENTRY_TYPE_U64, 64 },
+    { "F32", NMC_MEM_ENTRY_TYPE_F32, 32 },
+    { "F64", NMC_MEM_ENTRY_TYPE_F64, 64 },
+};
+
+U64_T NameHash( const char *PName )
+{
+    return ConfigHash( PName, std::strlen( PName ) );
+}
+
+} // namespace
+
+bool MemEntryTypeFromName( const std::string &Name, U32_T *PRetType )
+{
+    for( size_t i = 0; i < sizeof( kTypes ) / sizeof( kTypes[0] ); ++i )
+    {
+        if( ::strcasecmp( Name.c_str(), kTypes[i].name ) == 0 )
+        {
+            *PRetType = kTypes[i].type;
+            return true;
+        }
+    }
+    return false;
+}
+
+U32_T MemEntryTypeBits( U32_T Type )
+{
+    for( size_t i = 0; i < sizeof( kTypes ) / sizeof( kTypes[0] ); ++i )
+        if( kTypes[i].type == Type ) return kTypes[i].bits;
+    return 0;
+}
+
+RTN_ERR MemEntryMake( const std::string &Name, U32_T BitStartOffset, U32_T Type, MemEntryInfo_T *PRetEntry )
+{
+    U32_T bits = MemEntryTypeBits( Type );
+    if( bits == 0 || ( Type != NMC_MEM_ENTRY_TYPE_BIT && BitStartOffset % 8 != 0 ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    if( Name.empty() || Name.size() >= NMC_MEM_ENTRY_NAME_SIZE )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    std::memset( PRetEntry, 0, sizeof( *PRetEntry ) );
+    PRetEntry->bitStartOffset = BitStartOffset;
+    PRetEntry->bitLen         = bits;
+    PRetEntry->dataType       = Type;
+    PRetEntry->fclass         = ( Type == NMC_MEM_ENTRY_TYPE_BIT ) ? NMC_MEM_ENTRY_CLASS_DIO : NMC_MEM_ENTRY_CLASS_DATA;
+    std::memcpy( PRetEntry->name, Name.c_str(), Name.size() );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+IoMap::IoMap()
+    : generation_( 0 )
+{
+}
+
+RTN_ERR IoMap::BuildArea( I32_T Area, const std::vector<MemEntryInfo_T> &Entries, U32_T SizeByte,
+                          Area_T *PRetArea, std::string *PRetErrorText )
+{
+    const char *areaName = ( Area == NMC_MEM_ENTRY_AREA_INPUT ) ? "InputMap" : "OutputMap";
+    char text[NMC_MEM_ENTRY_NAME_SIZE + 64];
+#define IO_MAP_FAIL( Err, Fmt, Arg ) \
+    do { if( PRetErrorText ) { std::snprintf( text, sizeof( text ), "[%s] " Fmt, areaName, Arg ); *PRetErrorText = text; } return ( Err ); } while( 0 )
+
+    if( Entries.size() > NMC_MAX_MEM_ENTRIES )
+        IO_MAP_FAIL( ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES, "%s", "too many entries" );
+
+    size_t buckets = 16;
+    while( buckets < Entries.size() * 2 ) buckets *= 2;
+    PRetArea->entries = Entries;
+    PRetArea->slots.resize( Entries.size() );
+    PRetArea->index.assign( buckets, 0 );
+
+    for( size_t i = 0; i < Entries.size(); ++i )
+    {
+        const MemEntryInfo_T &e = Entries[i];
+        if( std::memchr( e.name, '\0', sizeof( e.name ) ) == 0 || e.name[0] == '\0' )
+            IO_MAP_FAIL( ERR_NEXMOTION_FILE_BAD_FORMAT, "%s", "bad entry name" );
+        U32_T bits = MemEntryTypeBits( e.dataType );
+        if( bits == 0 || e.bitLen != bits || ( bits > 1 && e.bitStartOffset % 8 != 0 ) )
+            IO_MAP_FAIL( ERR_NEXMOTION_PARAMETER_VALUE_INVALID, "%s: bad type or alignment", e.name );
+        if( static_cast<U64_T>( e.bitStartOffset ) + bits > static_cast<U64_T>( SizeByte ) * 8 )
+            IO_MAP_FAIL( ERR_NEXMOTION_ACCESS_AREA_INVALID, "%s exceeds the memory size", e.name );
+
+        IoMapSlot_T &slot = PRetArea->slots[i];
+        slot.offsetByte = e.bitStartOffset / 8;
+        slot.sizeByte   = ( bits > 1 ) ? bits / 8 : 0;
+        slot.bitMask    = ( bits > 1 ) ? 0 : static_cast<U8_T>( 1u << ( e.bitStartOffset % 8 ) );
+        slot.area       = Area;
+
+        size_t b = static_cast<size_t>( NameHash( e.name ) ) & ( buckets - 1 );
+        for( ; PRetArea->index[b] != 0; b = ( b + 1 ) & ( buckets - 1 ) )
+        {
+            if( std::strcmp( PRetArea->entries[PRetArea->index[b] - 1].name, e.name ) == 0 )
+                IO_MAP_FAIL( ERR_NEXMOTION_PARAMETER_VALUE_INVALID, "%s is defined twice", e.name );
+        }
+        PRetArea->index[b] = static_cast<I32_T>( i ) + 1;
+    }
+#undef IO_MAP_FAIL
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR IoMap::Build( const std::vector<MemEntryInfo_T> &Input, U32_T InputSize,
+                      const std::vector<MemEntryInfo_T> &Output, U32_T OutputSize, std::string *PRetErrorText )
+{
+    Area_T areas[2];
+    NMC_RETURN_IF_ERR( BuildArea( NMC_MEM_ENTRY_AREA_INPUT, Input, InputSize, &areas[0], PRetErrorText ) );
+    NMC_RETURN_IF_ERR( BuildArea( NMC_MEM_ENTRY_AREA_OUTPUT, Output, OutputSize, &areas[1], PRetErrorText ) );
+    for( I32_T a = 0; a < 2; ++a )
+    {
+        areas_[a].entries.swap( areas[a].entries );
+        areas_[a].slots.swap( areas[a].slots );
+        areas_[a].index.swap( areas[a].index );
+    }
+    generation_ = ( generation_ + 1 ) & kHandleGenMask;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void IoMap::Clear()
+{
+    for( I32_T a = 0; a < 2; ++a )
+    {
+        areas_[a].entries.clear();
+        areas_[a].slots.clear();
+        areas_[a].index.clear();
+    }
+    generation_ = ( generation_ + 1 ) & kHandleGenMask;
+}
+
+RTN_ERR IoMap::Find( I32_T Area, const char *PName, I32_T *PRetHandle, I32_T *PRetIndex ) const
+{
+    const Area_T &area = areas_[Area];
+    if( area.index.empty() )
+        return ERR_NEXMOTION_OBJECT_ID_INVALID;
+    size_t mask = area.index.size() - 1;
+    for( size_t b = static_cast<size_t>( NameHash( PName ) ) & mask; area.index[b] != 0; b = ( b + 1 ) & mask )
+    {
+        I32_T i = area.index[b] - 1;
+        if( std::strcmp( area.entries[i].name, PName ) != 0 )
+            continue;
+        *PRetHandle = ( generation_ << ( kHandleIndexBits + 1 ) ) | ( Area << kHandleIndexBits ) | i;
+        if( PRetIndex ) *PRetIndex = i;
+        return ERR_NEXMOTION_SUCCESS;
+    }
+    return ERR_NEXMOTION_OBJECT_ID_INVALID;
+}
+
+const IoMapSlot_T *IoMap::Resolve( I32_T Handle ) const
+{
+    if( Handle < 0 || ( ( Handle >> ( kHandleIndexBits + 1 ) ) & kHandleGenMask ) != generation_ )
+        return 0;
+    const Area_T &area = areas_[( Handle >> kHandleIndexBits ) & 1];
+    size_t index = static_cast<size_t>( Handle & ( ( 1 << kHandleIndexBits ) - 1 ) );
+    return ( index < area.slots.size() ) ? &area.slots[index] : 0;
+}
+
+} // namespace nmc
@@ -0,0 +1,79 @@
+/*!
+ * @file        SimIoMap.h
+ * @brief       Named entries of the I/O memory ([InputMap] and [OutputMap]), looked up by NMC_MemEntryFind()
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_IO_MAP_H
+#define __NEXMOTION_SIM_IO_MAP_H
+
+#include "SimCommon.h"
+#include <string>
+#include <vector>
+
+namespace nmc
+{
+
+//! NMC_MEM_ENTRY_TYPE_* of a type name of the configuration file ("BIT", "U16", ...), case insensitive.
+bool    MemEntryTypeFromName( const std::string &Name, U32_T *PRetType );
+//! Number of bits of an entry of Type, 0 for an unknown type.
+U32_T   MemEntryTypeBits( U32_T Type );
+//! Fill an entry of Type at BitStartOffset, check the name and the alignment.
+RTN_ERR MemEntryMake( const std::string &Name, U32_T BitStartOffset, U32_T Type, MemEntryInfo_T *PRetEntry );
+
+/*! @struct IoMapSlot_T
+ *  @brief  An entry resolved for access: where it is and how many bytes it takes.
+ */
+struct IoMapSlot_T
+{
+    U32_T offsetByte;
+    U32_T sizeByte;     //!< Size of the value, 0 for NMC_MEM_ENTRY_TYPE_BIT
+    U8_T  bitMask;      //!< The bit of a NMC_MEM_ENTRY_TYPE_BIT entry
+    I32_T area;         //!< NMC_MEM_ENTRY_AREA_*
+};
+
+/*!
+ * @brief The memory entries of a device with a hash index over their names.
+ *
+ * Build() checks the entries of both areas, resolves each one to an IoMapSlot_T and indexes the names in an
+ * open addressing table of at least twice the number of entries, so a lookup costs one hash and a probe or
+ * two. NMC_MemEntryFind() looks a name up once and returns a handle, which holds the area and the index of
+ * the entry: Resolve() is then a bounds check and an array access, with no string operation. The handle also
+ * holds the generation of the map, so a handle of a previous configuration is rejected instead of addressing
+ * another entry. Built and read with the device lock held.
+ */
+class IoMap
+{
+public:
+    IoMap();
+
+    //! Replace the entries, they must fit in memory areas of InputSize and OutputSize bytes.
+    RTN_ERR Build( const std::vector<MemEntryInfo_T> &Input, U32_T InputSize,
+                   const std::vector<MemEntryInfo_T> &Output, U32_T OutputSize, std::string *PRetErrorText );
+    void    Clear();
+
+    I32_T   Count( I32_T Area ) const { return static_cast<I32_T>( areas_[Area].entries.size() ); }
+    const MemEntryInfo_T &Info( I32_T Area, I32_T Index ) const { return areas_[Area].entries[Index]; }
+    //! Handle and index of the entry named PName, ERR_NEXMOTION_OBJECT_ID_INVALID if there is none.
+    RTN_ERR Find( I32_T Area, const char *PName, I32_T *PRetHandle, I32_T *PRetIndex ) const;
+    //! The entry of a handle of the current map, 0 otherwise.
+    const IoMapSlot_T *Resolve( I32_T Handle ) const;
+
+private:
+    struct Area_T
+    {
+        std::vector<MemEntryInfo_T> entries;
+        std::vector<IoMapSlot_T>    slots;
+        std::vector<I32_T>          index;      //!< Entry index + 1 by name hash, 0 for an empty bucket
+    };
+
+    static RTN_ERR BuildArea( I32_T Area, const std::vector<MemEntryInfo_T> &Entries, U32_T SizeByte,
+                              Area_T *PRetArea, std::string *PRetErrorText );
+
+    Area_T  areas_[2];
+    I32_T   generation_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_IO_MAP_H
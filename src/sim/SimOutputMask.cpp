@@ -0,0 +1,200 @@
+/*!
+ * @file        SimOutputMask.cpp
+ * @brief       Lock free set/clear masks of the output writes, applied once per exchange
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimOutputMask.h"
+
+namespace nmc
+{
+
+namespace
+{
+
+const U32_T kBytesPerWord = 4;
+const U32_T kClearShift   = 32;
+
+U32_T WordCount( U32_T SizeByte )  { return ( SizeByte + kBytesPerWord - 1 ) / kBytesPerWord; }
+U32_T DirtyCount( U32_T Words )    { return ( Words + 63 ) / 64; }
+
+U8_T ApplyByte( U8_T Value, U64_T Masks, U32_T Byte )
+{
+    U8_T set   = static_cast<U8_T>( Masks >> ( 8 * Byte ) );
+    U8_T clear = static_cast<U8_T>( Masks >> ( kClearShift + 8 * Byte ) );
+    return static_cast<U8_T>( ( Value & ~clear ) | set );
+}
+
+} // namespace
+
+OutputMaskBuffer::OutputMaskBuffer( U32_T Capacity )
+    : capacity_( Capacity )
+    , size_( 0 )
+    , active_( 0 )
+    , pending_( -1 )
+{
+    for( I32_T b = 0; b < 2; ++b )
+    {
+        banks_[b].any.store( false, std::memory_order_relaxed );
+        banks_[b].writers.store( 0, std::memory_order_relaxed );
+    }
+}
+
+void OutputMaskBuffer::Resize( U32_T OutputSize )
+{
+    if( OutputSize > 0 && !banks_[0].masks )
+    {
+        // Allocated once: a writer which loaded a non zero size may still use the banks.
+        U32_T words = WordCount( capacity_ );
+        for( I32_T b = 0; b < 2; ++b )
+        {
+            banks_[b].masks.reset( new std::atomic<U64_T>[words] );
+            banks_[b].dirty.reset( new std::atomic<U64_T>[DirtyCount( words )] );
+        }
+    }
+    Clear();
+    size_.store( OutputSize < capacity_ ? OutputSize : capacity_, std::memory_order_release );
+}
+
+void OutputMaskBuffer::Clear()
+{
+    pending_ = -1;
+    if( !banks_[0].masks )
+        return;
+    U32_T words = WordCount( capacity_ );
+    for( I32_T b = 0; b < 2; ++b )
+    {
+        Bank_T &bank = banks_[b];
+        for( U32_T w = 0; w < words; ++w )
+            bank.masks[w].store( 0, std::memory_order_relaxed );
+        for( U32_T d = 0; d < DirtyCount( words ); ++d )
+            bank.dirty[d].store( 0, std::memory_order_relaxed );
+        bank.any.store( false, std::memory_order_relaxed );
+    }
+}
+
+RTN_ERR OutputMaskBuffer::Write( U32_T OffsetByte, U32_T SizeByte, const void *PValue, const void *PMask )
+{
+    if( !PValue )
+        return ERR_NEXMOTION_POINTER_NULL;
+    U32_T size = size_.load( std::memory_order_acquire );
+    if( OffsetByte > size || SizeByte > size - OffsetByte )
+        return ERR_NEXMOTION_ACCESS_AREA_INVALID;
+    if( SizeByte == 0 )
+        return ERR_NEXMOTION_SUCCESS;
+    I32_T bank = BeginWrite();
+    Merge( bank, OffsetByte, SizeByte, static_cast<const U8_T *>( PValue ), static_cast<const U8_T *>( PMask ) );
+    EndWrite( bank );
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+I32_T OutputMaskBuffer::BeginWrite()
+{
+    // Enter the active bank. If Apply() switched the banks in between, it may already have checked the
+    // writers of this one, so leave it and enter the other.
+    for( ;; )
+    {
+        I32_T b = active_.load();
+        banks_[b].writers.fetch_add( 1 );
+        if( active_.load() == b )
+            return b;
+        banks_[b].writers.fetch_sub( 1 );
+    }
+}
+
+void OutputMaskBuffer::Merge( I32_T Bank, U32_T OffsetByte, U32_T SizeByte, const U8_T *PValue, const U8_T *PMask )
+{
+    Bank_T &bank = banks_[Bank];
+    U32_T   end  = OffsetByte + SizeByte;
+    for( U32_T w = OffsetByte / kBytesPerWord; w * kBytesPerWord < end; ++w )
+    {
+        U64_T touched = 0, masks = 0;
+        for( U32_T k = 0; k < kBytesPerWord; ++k )
+        {
+            U32_T i = w * kBytesPerWord + k;
+            if( i < OffsetByte || i >= end )
+                continue;
+            U64_T m = PMask ? PMask[i - OffsetByte] : 0xFF;
+            U64_T v = PValue[i - OffsetByte] & m;
+            touched |= ( m << ( 8 * k ) ) | ( m << ( kClearShift + 8 * k ) );
+            masks   |= ( v << ( 8 * k ) ) | ( ( m & ~v ) << ( kClearShift + 8 * k ) );
+        }
+        if( touched == 0 )
+            continue;
+        U64_T old = bank.masks[w].load( std::memory_order_relaxed );
+        while( !bank.masks[w].compare_exchange_weak( old, ( old & ~touched ) | masks, std::memory_order_relaxed ) )
+            ;
+        bank.dirty[w / 64].fetch_or( U64_T( 1 ) << ( w % 64 ), std::memory_order_relaxed );
+    }
+    bank.any.store( true, std::memory_order_relaxed );
+}
+
+void OutputMaskBuffer::EndWrite( I32_T Bank )
+{
+    banks_[Bank].writers.fetch_sub( 1, std::memory_order_release );
+}
+
+void OutputMaskBuffer::Apply( U8_T *POutput )
+{
+    if( pending_ >= 0 )
+    {
+        if( !Drain( banks_[pending_], POutput ) )
+            return;
+        pending_ = -1;
+    }
+    I32_T b = active_.load( std::memory_order_relaxed );
+    if( !banks_[b].any.load( std::memory_order_relaxed ) )
+        return;
+    active_.store( 1 - b );
+    if( !Drain( banks_[b], POutput ) )
+        pending_ = b;
+}
+
+bool OutputMaskBuffer::Drain( Bank_T &Bank, U8_T *POutput )
+{
+    if( Bank.writers.load() != 0 )
+        return false;
+    Bank.any.store( false, std::memory_order_relaxed );
+    U32_T size  = size_.load( std::memory_order_relaxed );
+    U32_T words = WordCount( size );
+    for( U32_T d = 0; d < DirtyCount( words ); ++d )
+    {
+        U64_T dirty = Bank.dirty[d].exchange( 0, std::memory_order_relaxed );
+        for( U32_T bit = 0; dirty != 0; ++bit, dirty >>= 1 )
+        {
+            if( ( dirty & 1 ) == 0 )
+                continue;
+            U32_T w     = d * 64 + bit;
+            U64_T masks = Bank.masks[w].exchange( 0, std::memory_order_relaxed );
+            for( U32_T k = 0; k < kBytesPerWord && w * kBytesPerWord + k < size; ++k )
+            {
+                // A byte the writes did not touch is left alone, with the direct stores of the application.
+                if( ( masks & ( ( U64_T( 0xFF ) << ( 8 * k ) ) | ( U64_T( 0xFF ) << ( kClearShift + 8 * k ) ) ) ) == 0 )
+                    continue;
+                POutput[w * kBytesPerWord + k] = ApplyByte( POutput[w * kBytesPerWord + k], masks, k );
+            }
+        }
+    }
+    return true;
+}
+
+void OutputMaskBuffer::Overlay( U32_T OffsetByte, U32_T SizeByte, U8_T *PData ) const
+{
+    if( !banks_[0].masks )
+        return;
+    // The other bank is older than the active one: it is empty, or left to apply.
+    I32_T b = active_.load();
+    OverlayBank( banks_[1 - b], OffsetByte, SizeByte, PData );
+    OverlayBank( banks_[b], OffsetByte, SizeByte, PData );
+}
+
+void OutputMaskBuffer::OverlayBank( const Bank_T &Bank, U32_T OffsetByte, U32_T SizeByte, U8_T *PData ) const
+{
+    for( U32_T i = 0; i < SizeByte; ++i )
+    {
+        U32_T at = OffsetByte + i;
+        PData[i] = ApplyByte( PData[i], Bank.masks[at / kBytesPerWord].load( std::memory_order_relaxed ), at % kBytesPerWord );
+    }
+}
+
+} // namespace nmc
@@ -0,0 +1,81 @@
+/*!
+ * @file        SimOutputMask.h
+ * @brief       Lock free set/clear masks of the output writes, applied once per exchange
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_OUTPUT_MASK_H
+#define __NEXMOTION_SIM_OUTPUT_MASK_H
+
+#include "SimCommon.h"
+#include <atomic>
+#include <memory>
+
+namespace nmc
+{
+
+/*!
+ * @brief Output writes accumulated as set and clear masks, applied to the output image in one pass.
+ *
+ * Every write of the API (NMC_WriteOutputBit(), NMC_WriteOutputMemory(), NMC_WriteOutputMasked(), ...) is
+ * merged into the masks of a bank with one compare and swap per 4 output bytes, without any lock: a later
+ * write of a bit replaces the earlier one, the bits not in the mask of a write are left alone. The motion
+ * cycle calls Apply() in the exchange: it switches the writers to the other bank and applies the masks of
+ * the previous one to the image, so all the bits of a write go out in the same exchange. A writer which
+ * still uses the previous bank defers its application to the next exchange, the cycle never waits.
+ *
+ * The writes are not in the image until they are applied, Overlay() adds the pending ones to a copy.
+ * The banks are allocated for Capacity bytes on the first Resize() and kept, so a writer may run while
+ * the lifecycle functions resize the masks; the writes then address the previous configuration.
+ */
+class OutputMaskBuffer
+{
+public:
+    explicit OutputMaskBuffer( U32_T Capacity );
+
+    //! Set the size of the outputs and drop the pending writes. Called by the lifecycle functions with the device lock.
+    void    Resize( U32_T OutputSize );
+    //! Drop the pending writes. The caller holds the device lock.
+    void    Clear();
+
+    U32_T   Size() const { return size_.load( std::memory_order_acquire ); }
+    //! Any thread, no lock: write the bits of PMask (all of them if 0) of SizeByte bytes at OffsetByte to PValue.
+    RTN_ERR Write( U32_T OffsetByte, U32_T SizeByte, const void *PValue, const void *PMask );
+
+    // Any thread, no lock: several writes which go out in the same exchange. Merge() writes as Write(), the
+    // caller has checked the range against Size().
+    I32_T   BeginWrite();
+    void    Merge( I32_T Bank, U32_T OffsetByte, U32_T SizeByte, const U8_T *PValue, const U8_T *PMask );
+    void    EndWrite( I32_T Bank );
+
+    //! Motion cycle, with the device lock: apply the pending writes to POutput.
+    void    Apply( U8_T *POutput );
+    //! With the device lock: apply the pending writes to a copy of SizeByte output bytes at OffsetByte.
+    void    Overlay( U32_T OffsetByte, U32_T SizeByte, U8_T *PData ) const;
+
+private:
+    OutputMaskBuffer( const OutputMaskBuffer & );
+    OutputMaskBuffer &operator=( const OutputMaskBuffer & );
+
+    //! Masks of 4 output bytes in one word: the set bits in the low half, the clear bits in the high half.
+    struct Bank_T
+    {
+        std::unique_ptr<std::atomic<U64_T>[]> masks;
+        std::unique_ptr<std::atomic<U64_T>[]> dirty;    //!< One bit per word of masks
+        std::atomic<bool>                     any;
+        std::atomic<U32_T>                    writers;
+    };
+
+    bool    Drain( Bank_T &Bank, U8_T *POutput );
+    void    OverlayBank( const Bank_T &Bank, U32_T OffsetByte, U32_T SizeByte, U8_T *PData ) const;
+
+    U32_T               capacity_;
+    std::atomic<U32_T>  size_;
+    std::atomic<I32_T>  active_;    //!< Bank of the writers
+    I32_T               pending_;   //!< Bank left to apply because a writer was still in it, -1 if none
+    Bank_T              banks_[2];
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_OUTPUT_MASK_H
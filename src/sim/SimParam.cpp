@@ -0,0 +1,208 @@
+/*!
+ * @file        SimParam.cpp
+ * @brief       Parameter tables and parameter storage of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimParam.h"
+#include "NexMotionParam.h"
+
+namespace nmc
+{
+
+static_assert( PARAM_SCOPE_DEVICE == NMC_PARAM_SCOPE_DEVICE && PARAM_SCOPE_AXIS == NMC_PARAM_SCOPE_AXIS
+               && PARAM_SCOPE_GROUP == NMC_PARAM_SCOPE_GROUP && PARAM_SCOPE_GROUP_AXIS == NMC_PARAM_SCOPE_GROUP_AXIS,
+               "ParamScope_E must match NMC_PARAM_SCOPE_*" );
+static_assert( PARAM_TYPE_I32 == NMC_PARAM_TYPE_I32 && PARAM_TYPE_F64 == NMC_PARAM_TYPE_F64, "ParamType_E must match NMC_PARAM_TYPE_*" );
+static_assert( PARAM_FLAG_AFTER_START == NMC_PARAM_FLAG_AFTER_START && PARAM_FLAG_READ_ONLY == NMC_PARAM_FLAG_READ_ONLY,
+               "PARAM_FLAG_* must match NMC_PARAM_FLAG_*" );
+
+namespace
+{
+
+const F64_T kI32Max = NMC_PARAM_I32_LIMIT;
+
+#define PARAM_DESC_ROW( Tag, Num, NumLast, Sub, SubLast, Type, Flags, Min, Max, Def, Name ) \
+    { Num, NumLast, Sub, SubLast, PARAM_TYPE_##Type, Flags, Min, Max, Def, Name },
+
+// The rows are those of the public tables in NexMotionParam.h, shared with the typed C++ accessors.
+
+//! System parameters, user manual 2.1
+const ParamDesc_T kDeviceParams[] = { NMC_PARAM_TABLE_DEVICE( PARAM_DESC_ROW ) };
+
+//! Axis parameters, user manual 2.2
+const ParamDesc_T kAxisParams[] = { NMC_PARAM_TABLE_AXIS( PARAM_DESC_ROW ) };
+
+//! Group parameters, user manual 2.3
+const ParamDesc_T kGroupParams[] = { NMC_PARAM_TABLE_GROUP( PARAM_DESC_ROW ) };
+
+//! Group axis parameters, user manual 2.3
+const ParamDesc_T kGroupAxisParams[] = { NMC_PARAM_TABLE_GROUP_AXIS( PARAM_DESC_ROW ) };
+
+#undef PARAM_DESC_ROW
+
+} // namespace
+
+ParamTable::ParamTable( const ParamDesc_T *PDescs, I32_T Count )
+    : descs_( PDescs, PDescs + Count )
+    , firstSlot_( Count )
+    , slotCount_( 0 )
+{
+    for( I32_T i = 0; i < Count; ++i )
+    {
+        firstSlot_[i] = slotCount_;
+        slotCount_ += ( PDescs[i].paramNumLast - PDescs[i].paramNum + 1 ) * ( PDescs[i].subIndexLast - PDescs[i].subIndex + 1 );
+    }
+}
+
+const ParamTable &ParamTable::Get( I32_T Scope )
+{
+    static const ParamTable tables[PARAM_SCOPE_COUNT] =
+    {
+        ParamTable( kDeviceParams,    sizeof( kDeviceParams ) / sizeof( kDeviceParams[0] ) ),
+        ParamTable( kAxisParams,      sizeof( kAxisParams ) / sizeof( kAxisParams[0] ) ),
+        ParamTable( kGroupParams,     sizeof( kGroupParams ) / sizeof( kGroupParams[0] ) ),
+        ParamTable( kGroupAxisParams, sizeof( kGroupAxisParams ) / sizeof( kGroupAxisParams[0] ) ),
+    };
+    return tables[Scope];
+}
+
+I32_T ParamTable::Find( I32_T ParamNum, I32_T SubIndex, const ParamDesc_T **PRetDesc ) const
+{
+    for( size_t i = 0; i < descs_.size(); ++i )
+    {
+        const ParamDesc_T &d = descs_[i];
+        if( ParamNum < d.paramNum || ParamNum > d.paramNumLast || SubIndex < d.subIndex || SubIndex > d.subIndexLast )
+            continue;
+        if( PRetDesc ) *PRetDesc = &d;
+        I32_T subCount = d.subIndexLast - d.subIndex + 1;
+        return firstSlot_[i] + ( ParamNum - d.paramNum ) * subCount + ( SubIndex - d.subIndex );
+    }
+    return -1;
+}
+
+ParamSet::ParamSet( I32_T Scope )
+    : scope_( Scope )
+    , table_( &ParamTable::Get( Scope ) )
+    , values_( table_->SlotCount() )
+{
+    Reset();
+}
+
+void ParamSet::Reset()
+{
+    for( I32_T i = 0; i < table_->DescCount(); ++i )
+    {
+        const ParamDesc_T &d = table_->Desc( i );
+        I32_T count = ( d.paramNumLast - d.paramNum + 1 ) * ( d.subIndexLast - d.subIndex + 1 );
+        for( I32_T k = 0; k < count; ++k )
+        {
+            ParamValue_T &v = values_[table_->DescFirstSlot( i ) + k];
+            if( d.type == PARAM_TYPE_I32 ) v.i32 = static_cast<I32_T>( d.defValue );
+            else                           v.f64 = d.defValue;
+        }
+    }
+}
+
+RTN_ERR ParamSet::Check( I32_T ParamNum, I32_T SubIndex, I32_T Type, F64_T Value, bool Operating, I32_T *PRetSlot ) const
+{
+    const ParamDesc_T *desc = 0;
+    I32_T slot = table_->Find( ParamNum, SubIndex, &desc );
+    if( slot < 0 || desc->type != Type )
+        return ERR_NEXMOTION_PARAMETER_NUMBER_INVALID;
+    NMC_RETURN_IF_ERR( CheckValue( *desc, Value, Operating ) );
+    *PRetSlot = slot;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR ParamSet::CheckValue( const ParamDesc_T &Desc, F64_T Value, bool Operating )
+{
+    if( Desc.flags & PARAM_FLAG_READ_ONLY )
+        return ERR_NEXMOTION_PARAMETER_READ_ONLY;
+    if( Operating && ( Desc.flags & PARAM_FLAG_AFTER_START ) )
+        return ERR_NEXMOTION_OPERATION_DENIED;
+    if( !( Value >= Desc.minValue && Value <= Desc.maxValue ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    if( Desc.type == PARAM_TYPE_I32 && Value != static_cast<F64_T>( static_cast<I32_T>( Value ) ) )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR ParamSet::SetI32( I32_T ParamNum, I32_T SubIndex, I32_T Value, bool Operating )
+{
+    I32_T slot;
+    NMC_RETURN_IF_ERR( Check( ParamNum, SubIndex, PARAM_TYPE_I32, Value, Operating, &slot ) );
+    values_[slot].i32 = Value;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR ParamSet::SetF64( I32_T ParamNum, I32_T SubIndex, F64_T Value, bool Operating )
+{
+    I32_T slot;
+    NMC_RETURN_IF_ERR( Check( ParamNum, SubIndex, PARAM_TYPE_F64, Value, Operating, &slot ) );
+    values_[slot].f64 = Value;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR ParamSet::CheckF64( I32_T ParamNum, I32_T SubIndex, F64_T Value, bool Operating ) const
+{
+    I32_T slot;
+    return Check( ParamNum, SubIndex, PARAM_TYPE_F64, Value, Operating, &slot );
+}
+
+RTN_ERR ParamSet::GetI32( I32_T ParamNum, I32_T SubIndex, I32_T *PRetValue ) const
+{
+    const ParamDesc_T *desc = 0;
+    I32_T slot = table_->Find( ParamNum, SubIndex, &desc );
+    if( slot < 0 || desc->type != PARAM_TYPE_I32 )
+        return ERR_NEXMOTION_PARAMETER_NUMBER_INVALID;
+    *PRetValue = values_[slot].i32;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR ParamSet::GetF64( I32_T ParamNum, I32_T SubIndex, F64_T *PRetValue ) const
+{
+    const ParamDesc_T *desc = 0;
+    I32_T slot = table_->Find( ParamNum, SubIndex, &desc );
+    if( slot < 0 || desc->type != PARAM_TYPE_F64 )
+        return ERR_NEXMOTION_PARAMETER_NUMBER_INVALID;
+    *PRetValue = values_[slot].f64;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR ParamSet::SetFromConfig( I32_T ParamNum, I32_T SubIndex, F64_T Value )
+{
+    const ParamDesc_T *desc = 0;
+    if( table_->Find( ParamNum, SubIndex, &desc ) < 0 )
+        return ERR_NEXMOTION_PARAMETER_NUMBER_INVALID;
+    if( desc->type == PARAM_TYPE_I32 )
+    {
+        if( !( Value >= -kI32Max - 1.0 && Value <= kI32Max ) || Value != static_cast<F64_T>( static_cast<I32_T>( Value ) ) )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        return SetI32( ParamNum, SubIndex, static_cast<I32_T>( Value ), false );
+    }
+    return SetF64( ParamNum, SubIndex, Value, false );
+}
+
+void ParamSet::SetCompiled( I32_T Slot, I32_T Type, F64_T Value )
+{
+    if( Type == PARAM_TYPE_I32 ) values_[Slot].i32 = static_cast<I32_T>( Value );
+    else                         values_[Slot].f64 = Value;
+}
+
+F64_T ParamSet::Compiled( I32_T Slot, I32_T Type ) const
+{
+    return ( Type == PARAM_TYPE_I32 ) ? static_cast<F64_T>( values_[Slot].i32 ) : values_[Slot].f64;
+}
+
+I32_T ParamSet::I32( I32_T ParamNum, I32_T SubIndex ) const
+{
+    return values_[table_->Find( ParamNum, SubIndex, 0 )].i32;
+}
+
+F64_T ParamSet::F64( I32_T ParamNum, I32_T SubIndex ) const
+{
+    return values_[table_->Find( ParamNum, SubIndex, 0 )].f64;
+}
+
+} // namespace nmc
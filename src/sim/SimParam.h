@@ -0,0 +1,207 @@
+/*!
+ * @file        SimParam.h
+ * @brief       Parameter tables and parameter storage of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_PARAM_H
+#define __NEXMOTION_SIM_PARAM_H
+
+#include "SimCommon.h"
+#include <vector>
+
+namespace nmc
+{
+
+//! Parameter scopes, one table per scope.
+enum ParamScope_E
+{
+    PARAM_SCOPE_DEVICE = 0,     //!< System parameters, NMC_DeviceSetParam()
+    PARAM_SCOPE_AXIS,           //!< Axis parameters, NMC_AxisSetParamI32()
+    PARAM_SCOPE_GROUP,          //!< Group parameters, NMC_GroupSetParamI32()
+    PARAM_SCOPE_GROUP_AXIS,     //!< Group axis parameters, NMC_GroupAxSetParamI32()
+    PARAM_SCOPE_COUNT
+};
+
+//! Data type of a parameter.
+enum ParamType_E
+{
+    PARAM_TYPE_I32 = 0,
+    PARAM_TYPE_F64 = 1
+};
+
+const U32_T PARAM_FLAG_AFTER_START = 0x01;  //!< (*1) Effective after the system is started, cannot be modified in operation.
+const U32_T PARAM_FLAG_READ_ONLY   = 0x02;  //!< (*4) Read only.
+
+//! Parameter numbers used by the engine. See the tables of the user manual, chapter 2.
+enum AxisParamNum_E
+{
+    AXP_PITCH           = 0x00,
+    AXP_MECH_REV        = 0x01,
+    AXP_MOTOR_REV       = 0x02,
+    AXP_ENC_RES         = 0x03,
+    AXP_ENC_DIR         = 0x04,
+    AXP_ENC_TYPE        = 0x05,
+    AXP_ENC_ENABLE      = 0x06,
+    AXP_SW_LIMIT_POS    = 0x10,
+    AXP_SW_LIMIT_NEG    = 0x11,
+    AXP_SW_LIMIT_ENABLE = 0x12,
+    AXP_ABS_REL         = 0x30,
+    AXP_PROF_TYPE       = 0x31,
+    AXP_VM              = 0x32,
+    AXP_ACC             = 0x33,
+    AXP_DEC             = 0x34,
+    AXP_JERK            = 0x35,
+    AXP_BUFF_PARAM      = 0x36,
+    AXP_V_BASE          = 0x37,
+    AXP_STOP_PROF_DEC   = 0x38
+};
+
+enum GroupParamNum_E
+{
+    GRP_KIN             = 0x00,
+    GRP_ABS_REL         = 0x30,
+    GRP_PROF_TYPE       = 0x31,
+    GRP_VM              = 0x32,
+    GRP_ACC             = 0x33,
+    GRP_DEC             = 0x34,
+    GRP_JERK            = 0x35,
+    GRP_BUFF            = 0x36,
+    GRP_STOP_PROF_DEC   = 0x38,
+    GRP_PTP_SYNC        = 0x39,
+    GRP_TOOL_SEL        = 0x47,
+    GRP_BASE_SEL        = 0x48,
+    GRP_TOOL_FIRST      = 0x80,
+    GRP_BASE_FIRST      = 0xC0
+};
+
+enum SysParamNum_E
+{
+    SYS_CYCLE_TIME_US   = 0x00,
+    SYS_AXIS_COUNT      = 0x01,
+    SYS_GROUP_COUNT     = 0x02,
+    SYS_RT_PRIORITY     = 0x10,
+    SYS_RT_CPU          = 0x11,
+    SYS_RT_LOCK_MEMORY  = 0x12,
+    SYS_RT_STACK_KB     = 0x13,
+    SYS_IO_CYCLES       = 0x14,     //!< Motion cycles per I/O exchange, 0 for every 10 ms
+    SYS_CYCLE_LATENCY   = 0x20,     //!< Sub-index: SysLatencySub_E
+    SYS_CYCLE_OVERRUN   = 0x21,
+    SYS_IO_LATENCY      = 0x22,     //!< Sub-index: SysLatencySub_E
+    SYS_INPUT_EDGE_LOST = 0x23,
+    SYS_EVENT_LOST      = 0x24
+};
+
+//! Sub-indexes of SYS_CYCLE_LATENCY and SYS_IO_LATENCY
+enum SysLatencySub_E
+{
+    SYS_LATENCY_MIN     = 0,
+    SYS_LATENCY_AVG     = 1,
+    SYS_LATENCY_MAX     = 2,
+    SYS_LATENCY_P99     = 3
+};
+
+/*! @struct ParamDesc_T
+ *  @brief  Describe a rectangular block of parameters (number range x sub-index range) sharing the same properties.
+ */
+struct ParamDesc_T
+{
+    I32_T       paramNum;       //!< First parameter number of the block.
+    I32_T       paramNumLast;   //!< Last parameter number of the block (inclusive).
+    I32_T       subIndex;       //!< First sub-index of the block.
+    I32_T       subIndexLast;   //!< Last sub-index of the block (inclusive).
+    I32_T       type;           //!< ParamType_E
+    U32_T       flags;          //!< PARAM_FLAG_*
+    F64_T       minValue;       //!< Minimum value (inclusive).
+    F64_T       maxValue;       //!< Maximum value (inclusive).
+    F64_T       defValue;       //!< Default value.
+    const char *name;           //!< Name used in messages and configuration files.
+};
+
+//! Storage of one parameter value.
+union ParamValue_T
+{
+    I32_T i32;
+    F64_T f64;
+};
+
+/*!
+ * @brief Table of parameter descriptors of a scope. Maps (ParamNum, SubIndex) to a storage slot.
+ */
+class ParamTable
+{
+public:
+    static const ParamTable &Get( I32_T Scope );
+
+    //! Return the slot of the parameter or -1 if the parameter does not exist.
+    I32_T Find( I32_T ParamNum, I32_T SubIndex, const ParamDesc_T **PRetDesc ) const;
+    I32_T SlotCount() const { return slotCount_; }
+    I32_T DescCount() const { return static_cast<I32_T>( descs_.size() ); }
+    const ParamDesc_T &Desc( I32_T Index ) const { return descs_[Index]; }
+    I32_T DescFirstSlot( I32_T Index ) const { return firstSlot_[Index]; }
+
+private:
+    ParamTable( const ParamDesc_T *PDescs, I32_T Count );
+
+    std::vector<ParamDesc_T> descs_;
+    std::vector<I32_T>       firstSlot_;
+    I32_T                    slotCount_;
+};
+
+//! A write staged in a parameter transaction, see NMC_DeviceParamTxStageI32().
+struct ParamTxEntry_T
+{
+    I32_T scope;            //!< ParamScope_E
+    I32_T index;            //!< Axis or group index, unused for PARAM_SCOPE_DEVICE
+    I32_T groupAxisIndex;   //!< Axis index in the group for PARAM_SCOPE_GROUP_AXIS
+    I32_T paramNum;
+    I32_T subIndex;
+    I32_T type;             //!< ParamType_E of the staging call
+    F64_T value;
+};
+
+/*!
+ * @brief Parameter values of one device, axis, group or group axis.
+ */
+class ParamSet
+{
+public:
+    explicit ParamSet( I32_T Scope );
+
+    void    Reset();
+    I32_T   Scope() const { return scope_; }
+
+    //! Set/get with the checks of the NMC_*SetParam*() APIs. Operating is true if the device is in operation.
+    RTN_ERR SetI32( I32_T ParamNum, I32_T SubIndex, I32_T Value, bool Operating );
+    RTN_ERR SetF64( I32_T ParamNum, I32_T SubIndex, F64_T Value, bool Operating );
+    //! Run the checks of SetF64() without storing the value.
+    RTN_ERR CheckF64( I32_T ParamNum, I32_T SubIndex, F64_T Value, bool Operating ) const;
+    RTN_ERR GetI32( I32_T ParamNum, I32_T SubIndex, I32_T *PRetValue ) const;
+    RTN_ERR GetF64( I32_T ParamNum, I32_T SubIndex, F64_T *PRetValue ) const;
+
+    //! Set a value from a configuration file regardless of its type. Read only parameters are rejected.
+    RTN_ERR SetFromConfig( I32_T ParamNum, I32_T SubIndex, F64_T Value );
+    //! Run the checks of SetI32() or SetF64() and return the slot of the parameter, to be stored by SetCompiled().
+    RTN_ERR Check( I32_T ParamNum, I32_T SubIndex, I32_T Type, F64_T Value, bool Operating, I32_T *PRetSlot ) const;
+    //! Store a value already checked and resolved to its slot, by ConfigCompile() or Check().
+    void    SetCompiled( I32_T Slot, I32_T Type, F64_T Value );
+    //! Value of a slot, the reverse of SetCompiled().
+    F64_T   Compiled( I32_T Slot, I32_T Type ) const;
+    const ParamTable &Table() const { return *table_; }
+
+    //! The value checks of Check() on the descriptor of the parameter. An I32_T value must be an integer.
+    static RTN_ERR CheckValue( const ParamDesc_T &Desc, F64_T Value, bool Operating );
+
+    //! Unchecked accessors used by the engine, the parameter must exist.
+    I32_T   I32( I32_T ParamNum, I32_T SubIndex = 0 ) const;
+    F64_T   F64( I32_T ParamNum, I32_T SubIndex = 0 ) const;
+
+private:
+    I32_T                     scope_;
+    const ParamTable         *table_;
+    std::vector<ParamValue_T> values_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_PARAM_H
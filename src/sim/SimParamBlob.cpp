@@ -0,0 +1,202 @@
+/*!
+ * @file        SimParamBlob.cpp
+ * @brief       Binary image of every parameter of a device, NMC_DeviceExportParams() and NMC_DeviceImportParams()
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimParamBlob.h"
+#include "SimConfigCache.h"
+#include <cstring>
+
+namespace nmc
+{
+
+namespace
+{
+
+const char kMagic[8] = { 'N', 'M', 'C', 'P', 'A', 'R', 'A', 'M' };
+
+//! Number of values of a parameter set of Scope.
+U32_T SetCount( I32_T Scope )
+{
+    static const struct Counts
+    {
+        Counts()
+        {
+            for( I32_T s = 0; s < PARAM_SCOPE_COUNT; ++s )
+            {
+                U32_T &n = value[s];
+                n = 0;
+                ParamBlobForEach( s, [&n]( const ParamDesc_T &, I32_T, I32_T, I32_T ) { ++n; } );
+            }
+        }
+        U32_T value[PARAM_SCOPE_COUNT];
+    } counts;
+    return counts.value[Scope];
+}
+
+//! Bytes of the group axis counts, padded to 8.
+U32_T CountsBytes( size_t GroupCount )
+{
+    return static_cast<U32_T>( ( GroupCount * sizeof( I32_T ) + 7 ) & ~static_cast<size_t>( 7 ) );
+}
+
+} // namespace
+
+U32_T ParamBlobBytes( const ParamBlobShape_T &Shape )
+{
+    U32_T values = SetCount( PARAM_SCOPE_DEVICE ) + Shape.axisCount * SetCount( PARAM_SCOPE_AXIS );
+    for( size_t g = 0; g < Shape.groupAxisCounts.size(); ++g )
+        values += SetCount( PARAM_SCOPE_GROUP ) + Shape.groupAxisCounts[g] * SetCount( PARAM_SCOPE_GROUP_AXIS );
+    return static_cast<U32_T>( sizeof( ParamBlobHeader_T ) ) + CountsBytes( Shape.groupAxisCounts.size() ) + values * sizeof( F64_T );
+}
+
+ParamBlobWriter::ParamBlobWriter( const ParamBlobShape_T &Shape, void *PBuffer )
+    : base_( static_cast<U8_T *>( PBuffer ) )
+    , body_( base_ + sizeof( ParamBlobHeader_T ) )
+    , cursor_( body_ )
+{
+    ParamBlobHeader_T header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic, kMagic, sizeof( kMagic ) );
+    header.version     = kParamBlobVersion;
+    header.headerBytes = sizeof( header );
+    header.tableHash   = ConfigTableHash();
+    header.axisCount   = Shape.axisCount;
+    header.groupCount  = static_cast<I32_T>( Shape.groupAxisCounts.size() );
+    std::memcpy( base_, &header, sizeof( header ) );
+
+    U32_T countsBytes = CountsBytes( Shape.groupAxisCounts.size() );
+    std::memset( cursor_, 0, countsBytes );
+    if( !Shape.groupAxisCounts.empty() )
+        std::memcpy( cursor_, &Shape.groupAxisCounts[0], Shape.groupAxisCounts.size() * sizeof( I32_T ) );
+    cursor_ += countsBytes;
+}
+
+void ParamBlobWriter::Write( const ParamSet &Params )
+{
+    U8_T *out = cursor_;
+    ParamBlobForEach( Params.Scope(), [&]( const ParamDesc_T &Desc, I32_T Slot, I32_T, I32_T )
+    {
+        F64_T v = Params.Compiled( Slot, Desc.type );
+        std::memcpy( out, &v, sizeof( v ) );
+        out += sizeof( v );
+    } );
+    cursor_ = out;
+}
+
+void ParamBlobWriter::Finish()
+{
+    ParamBlobHeader_T header;
+    std::memcpy( &header, base_, sizeof( header ) );
+    header.bodyBytes = static_cast<U64_T>( cursor_ - body_ );
+    header.bodyHash  = ConfigHash( body_, static_cast<size_t>( header.bodyBytes ) );
+    std::memcpy( base_, &header, sizeof( header ) );
+}
+
+RTN_ERR ParamBlobReader::Open( const void *PData, U32_T Bytes )
+{
+    const U8_T *data = static_cast<const U8_T *>( PData );
+    ParamBlobHeader_T header;
+    if( Bytes < sizeof( header ) )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    std::memcpy( &header, data, sizeof( header ) );
+    if( std::memcmp( header.magic, kMagic, sizeof( kMagic ) ) != 0 )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    if( header.version != kParamBlobVersion || header.headerBytes != sizeof( header ) )
+        return ERR_NEXMOTION_FILE_VERSION_INCOMPTIBLE;
+    if( header.bodyBytes != Bytes - sizeof( header ) )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    const U8_T *body = data + sizeof( header );
+    if( ConfigHash( body, static_cast<size_t>( header.bodyBytes ) ) != header.bodyHash )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    // The position of a value identifies its parameter, which holds only for the same parameter tables.
+    if( header.tableHash != ConfigTableHash() )
+        return ERR_NEXMOTION_FILE_VERSION_INCOMPTIBLE;
+    if( header.axisCount < 0 || header.axisCount > kMaxAxes || header.groupCount < 0 || header.groupCount > kMaxGroups
+        || header.bodyBytes < CountsBytes( header.groupCount ) )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+
+    ParamBlobShape_T shape;
+    shape.axisCount = header.axisCount;
+    shape.groupAxisCounts.resize( header.groupCount );
+    if( header.groupCount > 0 )
+        std::memcpy( &shape.groupAxisCounts[0], body, header.groupCount * sizeof( I32_T ) );
+    for( size_t g = 0; g < shape.groupAxisCounts.size(); ++g )
+    {
+        if( shape.groupAxisCounts[g] < 0 || shape.groupAxisCounts[g] > NMC_MAX_AXES_IN_GROUP )
+            return ERR_NEXMOTION_FILE_BAD_FORMAT;
+    }
+    if( ParamBlobBytes( shape ) != Bytes )
+        return ERR_NEXMOTION_FILE_BAD_FORMAT;
+
+    shape_.axisCount = shape.axisCount;
+    shape_.groupAxisCounts.swap( shape.groupAxisCounts );
+    values_ = body + CountsBytes( header.groupCount );
+    cursor_ = values_;
+    end_    = data + Bytes;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+F64_T ParamBlobReader::Next()
+{
+    F64_T v = 0.0;
+    if( cursor_ + sizeof( v ) <= end_ )
+    {
+        std::memcpy( &v, cursor_, sizeof( v ) );
+        cursor_ += sizeof( v );
+    }
+    return v;
+}
+
+RTN_ERR ParamBlobDiff( const void *PDataA, U32_T BytesA, const void *PDataB, U32_T BytesB,
+                       I32_T MaxCount, NmcParamDiff_T *PRetDiffs, I32_T *PRetDiffCount )
+{
+    ParamBlobReader a, b;
+    NMC_RETURN_IF_ERR( a.Open( PDataA, BytesA ) );
+    NMC_RETURN_IF_ERR( b.Open( PDataB, BytesB ) );
+    if( a.Shape().axisCount != b.Shape().axisCount )
+        return ERR_NEXMOTION_AXIS_COUNT_INVALID;
+    if( a.Shape().groupAxisCounts.size() != b.Shape().groupAxisCounts.size() )
+        return ERR_NEXMOTION_GROUP_COUNT_INVALID;
+    if( a.Shape().groupAxisCounts != b.Shape().groupAxisCounts )
+        return ERR_NEXMOTION_AXIS_COUNT_INVALID;
+
+    I32_T count = 0;
+    auto compare = [&]( I32_T Scope, I32_T Index, I32_T GroupAxisIndex )
+    {
+        ParamBlobForEach( Scope, [&]( const ParamDesc_T &Desc, I32_T, I32_T ParamNum, I32_T SubIndex )
+        {
+            F64_T oldValue = a.Next();
+            F64_T newValue = b.Next();
+            if( oldValue == newValue )
+                return;
+            if( PRetDiffs && count < MaxCount )
+            {
+                NmcParamDiff_T &d = PRetDiffs[count];
+                d.scope          = Scope;
+                d.index          = Index;
+                d.groupAxisIndex = GroupAxisIndex;
+                d.paramNum       = ParamNum;
+                d.subIndex       = SubIndex;
+                d.type           = Desc.type;
+                d.oldValue       = oldValue;
+                d.newValue       = newValue;
+            }
+            ++count;
+        } );
+    };
+    compare( PARAM_SCOPE_DEVICE, 0, 0 );
+    for( I32_T i = 0; i < a.Shape().axisCount; ++i )
+        compare( PARAM_SCOPE_AXIS, i, 0 );
+    for( size_t g = 0; g < a.Shape().groupAxisCounts.size(); ++g )
+    {
+        compare( PARAM_SCOPE_GROUP, static_cast<I32_T>( g ), 0 );
+        for( I32_T k = 0; k < a.Shape().groupAxisCounts[g]; ++k )
+            compare( PARAM_SCOPE_GROUP_AXIS, static_cast<I32_T>( g ), k );
+    }
+    *PRetDiffCount = count;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+} // namespace nmc
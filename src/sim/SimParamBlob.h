@@ -0,0 +1,120 @@
+/*!
+ * @file        SimParamBlob.h
+ * @brief       Binary image of every parameter of a device, NMC_DeviceExportParams() and NMC_DeviceImportParams()
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_PARAM_BLOB_H
+#define __NEXMOTION_SIM_PARAM_BLOB_H
+
+#include "SimParam.h"
+#include <vector>
+
+namespace nmc
+{
+
+//! Layout version of a parameter image, an image of another version is rejected.
+const U32_T kParamBlobVersion = 1;
+
+/*! @struct ParamBlobHeader_T
+ *  @brief  Header of a parameter image, followed by bodyBytes of group axis counts and values.
+ *
+ *  The body holds the axis count of each group as I32_T, padded to 8 bytes, then the values as F64_T: the
+ *  system parameters, the parameters of each axis, then the parameters of each group followed by those of its
+ *  group axes. A parameter set holds every slot of its scope which is not read only, in the order of the
+ *  parameter table (ParamBlobForEach()), so the position of a value identifies its parameter. The image is in
+ *  the byte order of the host and may be stored at any alignment.
+ */
+struct ParamBlobHeader_T
+{
+    char  magic[8];         //!< "NMCPARAM"
+    U32_T version;          //!< kParamBlobVersion
+    U32_T headerBytes;      //!< sizeof( ParamBlobHeader_T )
+    U64_T tableHash;        //!< ConfigTableHash() of the parameter tables of the exporting library
+    U64_T bodyBytes;
+    U64_T bodyHash;         //!< ConfigHash() of the body
+    I32_T axisCount;
+    I32_T groupCount;
+};
+
+//! Axis count of the device and of each of its groups, which decide the layout of the values.
+struct ParamBlobShape_T
+{
+    I32_T              axisCount;
+    std::vector<I32_T> groupAxisCounts;
+};
+
+//! Call Func( const ParamDesc_T &Desc, I32_T Slot, I32_T ParamNum, I32_T SubIndex ) for each value of a set of Scope, in image order.
+template <typename F>
+void ParamBlobForEach( I32_T Scope, F Func )
+{
+    const ParamTable &table = ParamTable::Get( Scope );
+    for( I32_T i = 0; i < table.DescCount(); ++i )
+    {
+        const ParamDesc_T &d = table.Desc( i );
+        if( d.flags & PARAM_FLAG_READ_ONLY )
+            continue;
+        I32_T slot = table.DescFirstSlot( i );
+        for( I32_T num = d.paramNum; num <= d.paramNumLast; ++num )
+            for( I32_T sub = d.subIndex; sub <= d.subIndexLast; ++sub )
+                Func( d, slot++, num, sub );
+    }
+}
+
+//! Size in bytes of the image of a device of Shape.
+U32_T   ParamBlobBytes( const ParamBlobShape_T &Shape );
+
+/*!
+ * @brief Write a parameter image to a buffer of ParamBlobBytes( Shape ) bytes.
+ *
+ * Write() every parameter set in the order of the image, then Finish().
+ */
+class ParamBlobWriter
+{
+public:
+    ParamBlobWriter( const ParamBlobShape_T &Shape, void *PBuffer );
+
+    void    Write( const ParamSet &Params );
+    //! Complete the header once every set is written.
+    void    Finish();
+
+private:
+    U8_T  *base_;
+    U8_T  *body_;
+    U8_T  *cursor_;
+};
+
+/*!
+ * @brief Read the values of a parameter image in the order of the image.
+ */
+class ParamBlobReader
+{
+public:
+    ParamBlobReader() : values_( 0 ), cursor_( 0 ), end_( 0 ) {}
+
+    //! Check the header, the hash and the size of an image. The image must outlive the reader.
+    RTN_ERR Open( const void *PData, U32_T Bytes );
+    const ParamBlobShape_T &Shape() const { return shape_; }
+
+    //! Next value of the image, Open() succeeded and the values are read in the order of ParamBlobForEach().
+    F64_T   Next();
+
+private:
+    ParamBlobShape_T shape_;
+    const U8_T      *values_;
+    const U8_T      *cursor_;
+    const U8_T      *end_;
+};
+
+/*!
+ * @brief Compare two parameter images of the same shape, as NMC_DiffParams().
+ *
+ * The first MaxCount differences are written to PRetDiffs in the order of the images, *PRetDiffCount is the
+ * number of differences.
+ */
+RTN_ERR ParamBlobDiff( const void *PDataA, U32_T BytesA, const void *PDataB, U32_T BytesB,
+                       I32_T MaxCount, NmcParamDiff_T *PRetDiffs, I32_T *PRetDiffCount );
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_PARAM_BLOB_H
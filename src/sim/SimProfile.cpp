@@ -0,0 +1,122 @@
+/*!
+ * @file        SimProfile.cpp
+ * @brief       Cyclic (online) velocity profile generator of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimProfile.h"
+#include <cmath>
+
+namespace nmc
+{
+
+void OnlineProfile::Reset( F64_T Pos, F64_T Vel )
+{
+    pos_   = Pos;
+    vel_   = Vel;
+    acc_   = 0.0;
+    phase_ = PROFILE_PHASE_IDLE;
+}
+
+F64_T OnlineProfile::BrakeVelocity( F64_T Dist, F64_T VEnd, F64_T Dec, F64_T Dt )
+{
+    // Distance covered by v, v - Dec*Dt, ... down to VEnd is v^2/(2*Dec) + v*Dt/2 - VEnd^2/(2*Dec).
+    F64_T adt = Dec * Dt;
+    F64_T disc = adt * adt + 4.0 * ( 2.0 * Dec * Dist + VEnd * VEnd );
+    return 0.5 * ( -adt + std::sqrt( disc ) );
+}
+
+void OnlineProfile::Update( F64_T NewVel, F64_T Dt, F64_T Vm )
+{
+    F64_T oldSpeed = std::fabs( vel_ );
+    F64_T newSpeed = std::fabs( NewVel );
+
+    if( newSpeed > oldSpeed + kVelEpsilon )      phase_ = PROFILE_PHASE_ACC;
+    else if( newSpeed < oldSpeed - kVelEpsilon ) phase_ = PROFILE_PHASE_DEC;
+    else if( newSpeed > kVelEpsilon )            phase_ = ( newSpeed >= Vm - kVelEpsilon ) ? PROFILE_PHASE_CONST : phase_;
+    else                                         phase_ = PROFILE_PHASE_IDLE;
+
+    acc_  = ( NewVel - vel_ ) / Dt;
+    vel_  = NewVel;
+    pos_ += NewVel * Dt;
+}
+
+bool OnlineProfile::StepPosition( F64_T Target, F64_T VEnd, const ProfileLimit_T &Limit, F64_T Dt )
+{
+    F64_T d    = Target - pos_;
+    F64_T dist = std::fabs( d );
+
+    if( dist <= kPosEpsilon && VEnd <= kVelEpsilon && std::fabs( vel_ ) <= Limit.dec * Dt + Limit.vBase )
+    {
+        acc_   = -vel_ / Dt;
+        pos_   = Target;
+        vel_   = 0.0;
+        phase_ = PROFILE_PHASE_IDLE;
+        return true;
+    }
+
+    F64_T dir  = Sign( d );
+    F64_T vDir = vel_ * dir;
+    F64_T vDes = 0.0;
+    F64_T newV;
+
+    if( vDir < 0.0 )
+    {
+        // Moving away from the target: brake first, then come back.
+        newV = vDir + Limit.dec * Dt;
+    }
+    else
+    {
+        vDes = BrakeVelocity( dist, VEnd, Limit.dec, Dt );
+        if( vDes > Limit.vm ) vDes = Limit.vm;
+
+        if( vDes >= vDir ) newV = ( vDir + Limit.acc * Dt < vDes ) ? vDir + Limit.acc * Dt : vDes;
+        else               newV = ( vDir - Limit.dec * Dt > vDes ) ? vDir - Limit.dec * Dt : vDes;
+
+        if( newV < Limit.vBase ) newV = Limit.vBase;
+    }
+
+    // Arrive in this cycle unless the axis is too fast to stop (aborting command), then it overshoots and returns.
+    if( newV > 0.0 && newV * Dt >= dist && newV <= vDes + Limit.vBase + kVelEpsilon )
+    {
+        if( VEnd <= kVelEpsilon )
+        {
+            // Arrive exactly on the target in this cycle.
+            acc_   = -vel_ / Dt;
+            pos_   = Target;
+            vel_   = 0.0;
+            phase_ = PROFILE_PHASE_DEC;
+            return true;
+        }
+        // Pass the target with the blending velocity, the caller carries the remaining distance over.
+        Update( newV * dir, Dt, Limit.vm );
+        return true;
+    }
+
+    Update( newV * dir, Dt, Limit.vm );
+    return false;
+}
+
+bool OnlineProfile::StepVelocity( F64_T TargetVel, const ProfileLimit_T &Limit, F64_T Dt )
+{
+    F64_T dv = TargetVel - vel_;
+    if( std::fabs( dv ) <= kVelEpsilon )
+    {
+        Update( TargetVel, Dt, Limit.vm );
+        return true;
+    }
+
+    bool  speedUp = ( vel_ * TargetVel >= 0.0 ) && ( std::fabs( TargetVel ) > std::fabs( vel_ ) );
+    F64_T step    = ( speedUp ? Limit.acc : Limit.dec ) * Dt;
+    F64_T newV    = vel_ + Clamp( dv, -step, step );
+
+    if( speedUp && std::fabs( newV ) < Limit.vBase )
+        newV = Sign( TargetVel ) * ( Limit.vBase < std::fabs( TargetVel ) ? Limit.vBase : std::fabs( TargetVel ) );
+    else if( !speedUp && TargetVel == 0.0 && std::fabs( newV ) <= Limit.vBase )
+        newV = 0.0;
+
+    Update( newV, Dt, Limit.vm );
+    return std::fabs( TargetVel - newV ) <= kVelEpsilon;
+}
+
+} // namespace nmc
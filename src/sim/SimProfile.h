@@ -0,0 +1,78 @@
+/*!
+ * @file        SimProfile.h
+ * @brief       Cyclic (online) velocity profile generator of the simulator runtime
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_PROFILE_H
+#define __NEXMOTION_SIM_PROFILE_H
+
+#include "SimCommon.h"
+
+namespace nmc
+{
+
+/*! @struct ProfileLimit_T
+ *  @brief  Kinematic limits of a trapezoidal (T-curve) profile.
+ */
+struct ProfileLimit_T
+{
+    F64_T vm;       //!< Maximum velocity (> 0)
+    F64_T acc;      //!< Acceleration (> 0)
+    F64_T dec;      //!< Deceleration (> 0)
+    F64_T vBase;    //!< Base velocity. Motion starts from and stops at this velocity.
+};
+
+//! Phase of the profile in the last cycle. Used for the ACC/DEC/MV status bits.
+enum ProfilePhase_E
+{
+    PROFILE_PHASE_IDLE = 0,
+    PROFILE_PHASE_ACC,
+    PROFILE_PHASE_CONST,
+    PROFILE_PHASE_DEC
+};
+
+/*!
+ * @brief One dimensional trapezoidal profile generator stepped once per motion cycle.
+ *
+ * The generator is "online": the target and the limits may change in any cycle (aborting
+ * commands, velocity override, halt) and the profile continues from the current position and
+ * velocity. The deceleration distance is evaluated with the discrete-time formula so the target
+ * is reached without overshoot.
+ */
+class OnlineProfile
+{
+public:
+    OnlineProfile() { Reset( 0.0, 0.0 ); }
+
+    void  Reset( F64_T Pos, F64_T Vel );
+
+    //! Move to the target position and arrive with velocity VEnd (>= 0). Return true when the target is reached.
+    bool  StepPosition( F64_T Target, F64_T VEnd, const ProfileLimit_T &Limit, F64_T Dt );
+
+    //! Change the velocity toward TargetVel. Return true when the target velocity is reached.
+    bool  StepVelocity( F64_T TargetVel, const ProfileLimit_T &Limit, F64_T Dt );
+
+    //! Maximum velocity which still allows to reach VEnd within Dist using deceleration Dec.
+    static F64_T BrakeVelocity( F64_T Dist, F64_T VEnd, F64_T Dec, F64_T Dt );
+
+    //! Take the state of a profile planned elsewhere (SCurveProfile), so the next step continues from it.
+    void  Follow( F64_T Pos, F64_T Vel, F64_T Acc, I32_T Phase ) { pos_ = Pos; vel_ = Vel; acc_ = Acc; phase_ = Phase; }
+
+    F64_T Pos()   const { return pos_; }
+    F64_T Vel()   const { return vel_; }
+    F64_T Acc()   const { return acc_; }
+    I32_T Phase() const { return phase_; }
+
+private:
+    void  Update( F64_T NewVel, F64_T Dt, F64_T Vm );
+
+    F64_T pos_;
+    F64_T vel_;
+    F64_T acc_;
+    I32_T phase_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_PROFILE_H
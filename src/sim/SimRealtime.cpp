@@ -0,0 +1,202 @@
+/*!
+ * @file        SimRealtime.cpp
+ * @brief       Real-time scheduling of the motion cycle thread and cycle latency statistics
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimRealtime.h"
+#include "SimRuntime.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <system_error>
+
+namespace nmc
+{
+
+namespace
+{
+
+const I64_T kNsPerSec      = 1000000000LL;
+const I32_T kLatencyBinsUs = 4096;      // Histogram range, beyond is counted in the last bin
+const I32_T kMaxPrefaultKb = 1024;
+
+I64_T TimespecToNs( const struct timespec &Ts )
+{
+    return static_cast<I64_T>( Ts.tv_sec ) * kNsPerSec + Ts.tv_nsec;
+}
+
+void TimespecAddNs( struct timespec *PTs, I64_T Ns )
+{
+    I64_T ns = PTs->tv_nsec + Ns;
+    PTs->tv_sec  += static_cast<time_t>( ns / kNsPerSec );
+    PTs->tv_nsec  = static_cast<long>( ns % kNsPerSec );
+}
+
+//! Touch the stack so the pages are mapped before the first cycle. Kept out of line so the frame is really allocated.
+__attribute__(( noinline )) void PrefaultStack( I32_T SizeKb )
+{
+    volatile U8_T stack[kMaxPrefaultKb * 1024];
+    size_t size = static_cast<size_t>( SizeKb ) * 1024;
+    // The stack grows downwards: start next to the caller's frame.
+    for( size_t i = 0; i < size; i += 4096 )
+        stack[sizeof( stack ) - 1 - i] = 0;
+}
+
+} // namespace
+
+I64_T MonotonicNs()
+{
+    struct timespec now;
+    ::clock_gettime( CLOCK_MONOTONIC, &now );
+    return TimespecToNs( now );
+}
+
+void RtApplyToCurrentThread( const RtConfig_T &Config, const char *PSource )
+{
+    if( Config.lockMemory && ::mlockall( MCL_CURRENT | MCL_FUTURE ) != 0 )
+        PostMessage( NMC_MSG_TYPE_WARNING, ERR_NEXMOTION_EXTERNAL_CALL_FAILED, PSource, "mlockall() failed: %s", std::strerror( errno ) );
+
+    if( Config.cpu >= 0 )
+    {
+        cpu_set_t set;
+        CPU_ZERO( &set );
+        CPU_SET( Config.cpu, &set );
+        int err = ::pthread_setaffinity_np( ::pthread_self(), sizeof( set ), &set );
+        if( err != 0 )
+            PostMessage( NMC_MSG_TYPE_WARNING, ERR_NEXMOTION_EXTERNAL_CALL_FAILED, PSource, "Pin cycle thread to CPU %d failed: %s", Config.cpu, std::strerror( err ) );
+    }
+
+    if( Config.priority > 0 )
+    {
+        struct sched_param sp;
+        std::memset( &sp, 0, sizeof( sp ) );
+        sp.sched_priority = Config.priority;
+        int err = ::pthread_setschedparam( ::pthread_self(), SCHED_FIFO, &sp );
+        if( err != 0 )
+            PostMessage( NMC_MSG_TYPE_WARNING, ERR_NEXMOTION_EXTERNAL_CALL_FAILED, PSource, "SCHED_FIFO priority %d failed: %s", Config.priority, std::strerror( err ) );
+    }
+
+    if( Config.stackPrefaultKb > 0 )
+        PrefaultStack( Config.stackPrefaultKb < kMaxPrefaultKb ? Config.stackPrefaultKb : kMaxPrefaultKb );
+}
+
+PiMutex::PiMutex()
+{
+    pthread_mutexattr_t attr;
+    ::pthread_mutexattr_init( &attr );
+    ::pthread_mutexattr_setprotocol( &attr, PTHREAD_PRIO_INHERIT );
+    if( ::pthread_mutex_init( &mutex_, &attr ) != 0 )
+        ::pthread_mutex_init( &mutex_, 0 );
+    ::pthread_mutexattr_destroy( &attr );
+}
+
+PiMutex::~PiMutex()
+{
+    ::pthread_mutex_destroy( &mutex_ );
+}
+
+void PiMutex::lock()
+{
+    // As std::mutex::lock()
+    int err = ::pthread_mutex_lock( &mutex_ );
+    if( err != 0 )
+        throw std::system_error( err, std::system_category() );
+}
+
+bool PiMutex::try_lock()
+{
+    return ::pthread_mutex_trylock( &mutex_ ) == 0;
+}
+
+void PiMutex::unlock()
+{
+    ::pthread_mutex_unlock( &mutex_ );
+}
+
+void CycleTimer::Start( I32_T PeriodUs )
+{
+    periodNs_ = static_cast<I64_T>( PeriodUs ) * 1000;
+    ::clock_gettime( CLOCK_MONOTONIC, &deadline_ );
+    TimespecAddNs( &deadline_, periodNs_ );
+}
+
+I64_T CycleTimer::WaitDeadline()
+{
+    while( ::clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline_, 0 ) == EINTR )
+    {
+    }
+    return MonotonicNs() - TimespecToNs( deadline_ );
+}
+
+I32_T CycleTimer::Advance()
+{
+    // Skip the deadlines which passed while the cycle was executed instead of running them back to back.
+    I64_T late = MonotonicNs() - TimespecToNs( deadline_ );
+    I32_T missed = ( late >= periodNs_ ) ? static_cast<I32_T>( late / periodNs_ ) : 0;
+    TimespecAddNs( &deadline_, periodNs_ * ( missed + 1 ) );
+    return missed;
+}
+
+CycleStats::CycleStats()
+    : histogram_( kLatencyBinsUs )
+{
+    Reset();
+}
+
+void CycleStats::Reset()
+{
+    std::fill( histogram_.begin(), histogram_.end(), 0 );
+    count_    = 0;
+    sumNs_    = 0;
+    minNs_    = 0;
+    maxNs_    = 0;
+    overruns_ = 0;
+}
+
+void CycleStats::Add( I64_T LatencyNs, I32_T Overruns )
+{
+    if( LatencyNs < 0 ) LatencyNs = 0;
+    I64_T bin = LatencyNs / 1000;
+    ++histogram_[bin < kLatencyBinsUs ? static_cast<size_t>( bin ) : kLatencyBinsUs - 1];
+    if( count_ == 0 || LatencyNs < minNs_ ) minNs_ = LatencyNs;
+    if( LatencyNs > maxNs_ ) maxNs_ = LatencyNs;
+    sumNs_ += LatencyNs;
+    ++count_;
+    overruns_ += Overruns;
+}
+
+I32_T CycleStats::MinUs() const
+{
+    return static_cast<I32_T>( minNs_ / 1000 );
+}
+
+I32_T CycleStats::AvgUs() const
+{
+    return count_ ? static_cast<I32_T>( sumNs_ / static_cast<I64_T>( count_ ) / 1000 ) : 0;
+}
+
+I32_T CycleStats::MaxUs() const
+{
+    return static_cast<I32_T>( maxNs_ / 1000 );
+}
+
+I32_T CycleStats::PercentileUs( F64_T Percent ) const
+{
+    if( count_ == 0 )
+        return 0;
+    U64_T target = static_cast<U64_T>( count_ * Percent / 100.0 + 0.5 );
+    U64_T sum = 0;
+    for( I32_T us = 0; us < kLatencyBinsUs - 1; ++us )
+    {
+        sum += histogram_[us];
+        if( sum >= target )
+            return us + 1;
+    }
+    return MaxUs();
+}
+
+} // namespace nmc
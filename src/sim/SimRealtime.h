@@ -0,0 +1,116 @@
+/*!
+ * @file        SimRealtime.h
+ * @brief       Real-time scheduling of the motion cycle thread and cycle latency statistics
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_REALTIME_H
+#define __NEXMOTION_SIM_REALTIME_H
+
+#include "SimCommon.h"
+#include <pthread.h>
+#include <time.h>
+#include <vector>
+
+namespace nmc
+{
+
+/*! @struct RtConfig_T
+ *  @brief  Scheduling of the motion cycle thread, system parameters 0x10 ~ 0x13.
+ */
+struct RtConfig_T
+{
+    I32_T priority;         //!< SCHED_FIFO priority 1 ~ 99, 0 keeps the default scheduling policy
+    I32_T cpu;              //!< CPU the thread is pinned to, -1 for no affinity
+    bool  lockMemory;       //!< Lock the pages of the process in memory (mlockall)
+    I32_T stackPrefaultKb;  //!< Stack touched by the thread before the first cycle
+};
+
+/*!
+ * @brief Apply Config to the calling thread.
+ *
+ * A setting which cannot be applied (usually for lack of privileges) is reported as a warning
+ * message and the thread continues with the default scheduling.
+ */
+void RtApplyToCurrentThread( const RtConfig_T &Config, const char *PSource );
+
+//! CLOCK_MONOTONIC in nanoseconds.
+I64_T MonotonicNs();
+
+/*!
+ * @brief Mutex with priority inheritance, for a lock shared by the cycle thread and the API callers.
+ *
+ * A caller of a lower priority which holds the lock runs at the priority of the cycle thread while
+ * the cycle waits for it, so it cannot be preempted by the threads in between. Where the protocol
+ * is not supported, it is an ordinary mutex. Usable with std::lock_guard and std::unique_lock.
+ */
+class PiMutex
+{
+public:
+    PiMutex();
+    ~PiMutex();
+
+    void lock();
+    bool try_lock();
+    void unlock();
+
+private:
+    PiMutex( const PiMutex & );
+    PiMutex &operator=( const PiMutex & );
+
+    pthread_mutex_t mutex_;
+};
+
+/*!
+ * @brief Absolute deadline timer on CLOCK_MONOTONIC.
+ */
+class CycleTimer
+{
+public:
+    //! Start the timer, the first deadline is one period from now.
+    void  Start( I32_T PeriodUs );
+    //! Sleep until the current deadline and return the wake up latency (ns).
+    I64_T WaitDeadline();
+    /*!
+     * @brief Advance to the next deadline after a cycle has been executed.
+     * @return Number of deadlines which already passed and are skipped (overruns).
+     */
+    I32_T Advance();
+
+private:
+    struct timespec deadline_;
+    I64_T           periodNs_;
+};
+
+/*!
+ * @brief Statistics of the wake up latency of the cycle thread (system parameters 0x20, 0x21), also used for the interval between I/O exchanges (0x22).
+ *
+ * The latency is kept in a histogram of 1 us bins, so the percentile costs nothing in the cycle.
+ */
+class CycleStats
+{
+public:
+    CycleStats();
+
+    void  Reset();
+    void  Add( I64_T LatencyNs, I32_T Overruns );
+
+    I32_T MinUs() const;
+    I32_T AvgUs() const;
+    I32_T MaxUs() const;
+    //! Smallest latency which is not exceeded by Percent of the cycles.
+    I32_T PercentileUs( F64_T Percent ) const;
+    I32_T Overruns() const { return overruns_; }
+
+private:
+    std::vector<U32_T> histogram_;  //!< Count of cycles per latency us, the last bin collects the rest
+    U64_T              count_;
+    I64_T              sumNs_;
+    I64_T              minNs_;
+    I64_T              maxNs_;
+    I32_T              overruns_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_REALTIME_H
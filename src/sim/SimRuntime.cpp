@@ -0,0 +1,419 @@
+/*!
+ * @file        SimRuntime.cpp
+ * @brief       Process wide services of the simulator runtime: device table, system messages and API trace
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimRuntime.h"
+#include "SimDevice.h"
+#include "SimRealtime.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <sys/time.h>
+
+namespace nmc
+{
+
+namespace
+{
+
+const size_t kMaxMessages = 256;
+
+// Device table
+std::mutex              gDeviceLock;
+std::shared_ptr<Device> gDevices[kMaxDevices];
+
+// Open up and shutdown requests
+struct Request_T
+{
+    Request_T() : running( false ), pending( false ), ret( ERR_NEXMOTION_SUCCESS ), devId( -1 ) {}
+
+    bool    running;    //!< The request thread is running
+    bool    pending;    //!< A result is waiting to be collected by the wait function
+    RTN_ERR ret;
+    I32_T   devId;
+};
+
+std::mutex              gRequestLock;
+std::condition_variable gRequestDone;
+Request_T               gOpenUpRequest;
+Request_T               gShutdownRequests[kMaxDevices];
+
+// Progress of the last open up
+std::mutex              gProgressLock;
+NmcOpenUpProgress_T     gProgress;
+bool                    gProgressValid = false;
+I64_T                   gProgressStartNs = 0;
+I64_T                   gPhaseStartNs    = 0;
+
+// System messages
+std::mutex              gMessageLock;
+std::deque<NmcMsg_T>    gMessages;
+std::atomic<U32_T>      gMessageIndex( 0 );   // Written under gMessageLock
+bool                    gMessageOutput = false;
+
+// API trace
+std::atomic<I32_T>         gTraceMode( NMC_TRACE_MODE_DISABLE );
+std::atomic<void *>        gHookData( static_cast<void *>( 0 ) );
+std::atomic<PF_NmcHookAPI> gHookFunc( static_cast<PF_NmcHookAPI>( 0 ) );
+
+void ProgressBegin()
+{
+    std::lock_guard<std::mutex> guard( gProgressLock );
+    std::memset( &gProgress, 0, sizeof( gProgress ) );
+    gProgress.sizeOfStruct = sizeof( gProgress );
+    gProgress.devId        = -1;
+    gProgress.phase        = NMC_OPENUP_PHASE_CREATE;
+    gProgressValid   = true;
+    gProgressStartNs = MonotonicNs();
+    gPhaseStartNs    = gProgressStartNs;
+}
+
+//! End the current phase and record its time, Phase is the next phase or NMC_OPENUP_PHASE_DONE.
+void ProgressPhase( I32_T Phase, I32_T DevID, RTN_ERR Ret )
+{
+    std::lock_guard<std::mutex> guard( gProgressLock );
+    I64_T now = MonotonicNs();
+    // A concurrent open up may have restarted or finished the record.
+    if( gProgress.phase < NMC_OPENUP_PHASE_COUNT )
+        gProgress.phaseTimeUs[gProgress.phase] = static_cast<U32_T>( ( now - gPhaseStartNs ) / 1000 );
+    gProgress.totalTimeUs = static_cast<U32_T>( ( now - gProgressStartNs ) / 1000 );
+    gProgress.devId  = DevID;
+    gProgress.phase  = Phase;
+    gProgress.result = Ret;
+    gPhaseStartNs    = now;
+}
+
+void RunOpenUpRequest( I32_T DevType, I32_T DevIndex, I32_T Options )
+{
+    I32_T   devId = -1;
+    RTN_ERR ret   = DeviceOpenUp( DevType, DevIndex, Options, &devId );
+
+    std::lock_guard<std::mutex> guard( gRequestLock );
+    gOpenUpRequest.running = false;
+    gOpenUpRequest.ret     = ret;
+    gOpenUpRequest.devId   = devId;
+    gRequestDone.notify_all();
+}
+
+void RunShutdownRequest( I32_T DevID )
+{
+    RTN_ERR ret = DeviceShutdown( DevID );
+
+    std::lock_guard<std::mutex> guard( gRequestLock );
+    gShutdownRequests[DevID].running = false;
+    gShutdownRequests[DevID].ret     = ret;
+    gRequestDone.notify_all();
+}
+
+//! Wait until the request thread finished. Called with gRequestLock held.
+RTN_ERR WaitRequest( std::unique_lock<std::mutex> &Lock, Request_T &Request, U32_T WaitMs )
+{
+    if( !Request.pending )
+        return ERR_NEXMOTION_WAIT_FAILED;
+    if( WaitMs == NMC_WAIT_TIME_INFINITE )
+    {
+        while( Request.running )
+            gRequestDone.wait( Lock );
+    }
+    else
+    {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( WaitMs );
+        while( Request.running )
+        {
+            if( gRequestDone.wait_until( Lock, deadline ) == std::cv_status::timeout && Request.running )
+                return ERR_NEXMOTION_PROCESS_TIMEOUT;
+        }
+    }
+    Request.pending = false;
+    return Request.ret;
+}
+
+} // namespace
+
+RTN_ERR DeviceCreate( I32_T DevType, I32_T DevIndex, I32_T *PRetDevID )
+{
+    if( !PRetDevID )
+        return ERR_NEXMOTION_POINTER_NULL;
+    if( DevType == NMC_DEVICE_TYPE_ETHERCAT )
+    {
+        PostMessage( NMC_MSG_TYPE_ERROR, ERR_NEXMOTION_LOAD_RUNTIME_FAILED, "Device", "The EtherCAT runtime is not available in the simulator library" );
+        return ERR_NEXMOTION_LOAD_RUNTIME_FAILED;
+    }
+    if( DevType != NMC_DEVICE_TYPE_SIMULATOR || DevIndex < 0 || DevIndex >= kMaxDevices )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    std::lock_guard<std::mutex> guard( gDeviceLock );
+    I32_T freeId = -1;
+    for( I32_T id = 0; id < kMaxDevices; ++id )
+    {
+        if( !gDevices[id] )
+        {
+            if( freeId < 0 ) freeId = id;
+        }
+        else if( gDevices[id]->DevType() == DevType && gDevices[id]->DevIndex() == DevIndex )
+        {
+            return ERR_NEXMOTION_OPERATION_DENIED;
+        }
+    }
+    if( freeId < 0 )
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+
+    try
+    {
+        gDevices[freeId] = std::make_shared<Device>( DevType, DevIndex );
+    }
+    catch( ... )
+    {
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+    }
+    *PRetDevID = freeId;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR DeviceDelete( I32_T DevID )
+{
+    std::shared_ptr<Device> dev;
+    {
+        std::lock_guard<std::mutex> guard( gDeviceLock );
+        if( DevID < 0 || DevID >= kMaxDevices || !gDevices[DevID] )
+            return ERR_NEXMOTION_OBJECT_ID_INVALID;
+        dev.swap( gDevices[DevID] );
+    }
+    // Stop outside the table lock, the cycle thread may post messages while it terminates.
+    dev->Stop();
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+std::shared_ptr<Device> DeviceFind( I32_T DevID )
+{
+    if( DevID < 0 || DevID >= kMaxDevices )
+        return std::shared_ptr<Device>();
+    std::lock_guard<std::mutex> guard( gDeviceLock );
+    return gDevices[DevID];
+}
+
+RTN_ERR DeviceOpenUp( I32_T DevType, I32_T DevIndex, I32_T Options, I32_T *PRetDevID )
+{
+    if( !PRetDevID )
+        return ERR_NEXMOTION_POINTER_NULL;
+    if( ( Options & ~NMC_OPENUP_OPT_ENABLE_ALL ) != 0 )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    ProgressBegin();
+    I32_T   devId = -1;
+    RTN_ERR ret   = DeviceCreate( DevType, DevIndex, &devId );
+    if( ret != ERR_NEXMOTION_SUCCESS )
+    {
+        ProgressPhase( NMC_OPENUP_PHASE_DONE, -1, ret );
+        return ret;
+    }
+
+    std::shared_ptr<Device> dev = DeviceFind( devId );
+    DeviceConfig_T config;
+    std::string    source;
+    ProgressPhase( NMC_OPENUP_PHASE_READ_CONFIG, devId, ERR_NEXMOTION_SUCCESS );
+    ret = dev->ReadIniConfig( &config, &source );
+    if( ret == ERR_NEXMOTION_SUCCESS )
+    {
+        ProgressPhase( NMC_OPENUP_PHASE_APPLY_CONFIG, devId, ERR_NEXMOTION_SUCCESS );
+        ret = dev->LoadConfig( config, source );
+    }
+    if( ret == ERR_NEXMOTION_SUCCESS )
+    {
+        ProgressPhase( NMC_OPENUP_PHASE_START, devId, ERR_NEXMOTION_SUCCESS );
+        ret = dev->Start();
+    }
+    if( ret == ERR_NEXMOTION_SUCCESS && ( Options & NMC_OPENUP_OPT_ENABLE_ALL ) )
+    {
+        ProgressPhase( NMC_OPENUP_PHASE_ENABLE, devId, ERR_NEXMOTION_SUCCESS );
+        ret = dev->EnableAll();
+    }
+    if( ret != ERR_NEXMOTION_SUCCESS )
+    {
+        DeviceDelete( devId );
+        ProgressPhase( NMC_OPENUP_PHASE_DONE, -1, ret );
+        return ret;
+    }
+    ProgressPhase( NMC_OPENUP_PHASE_DONE, devId, ERR_NEXMOTION_SUCCESS );
+    *PRetDevID = devId;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR GetOpenUpProgress( NmcOpenUpProgress_T *PRetProgress )
+{
+    if( !PRetProgress )
+        return ERR_NEXMOTION_POINTER_NULL;
+    if( PRetProgress->sizeOfStruct != sizeof( NmcOpenUpProgress_T ) )
+        return ERR_NEXMOTION_STRUCT_SIZE_INCOMPTIBLE;
+    std::lock_guard<std::mutex> guard( gProgressLock );
+    if( !gProgressValid )
+        return ERR_NEXMOTION_WAIT_FAILED;
+    *PRetProgress = gProgress;
+    if( gProgress.phase != NMC_OPENUP_PHASE_DONE )
+    {
+        // Still running: report the time spent so far.
+        I64_T now = MonotonicNs();
+        PRetProgress->phaseTimeUs[gProgress.phase] = static_cast<U32_T>( ( now - gPhaseStartNs ) / 1000 );
+        PRetProgress->totalTimeUs = static_cast<U32_T>( ( now - gProgressStartNs ) / 1000 );
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR DeviceShutdown( I32_T DevID )
+{
+    return DeviceDelete( DevID );
+}
+
+RTN_ERR DeviceOpenUpRequest( I32_T DevType, I32_T DevIndex, I32_T Options )
+{
+    std::lock_guard<std::mutex> guard( gRequestLock );
+    if( gOpenUpRequest.running )
+        return ERR_NEXMOTION_OPERATION_BUSY;
+    try
+    {
+        std::thread( RunOpenUpRequest, DevType, DevIndex, Options ).detach();
+    }
+    catch( ... )
+    {
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+    }
+    gOpenUpRequest.running = true;
+    gOpenUpRequest.pending = true;
+    gOpenUpRequest.devId   = -1;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR DeviceWaitOpenUpRequest( U32_T WaitMs, I32_T *PRetDevID )
+{
+    if( !PRetDevID )
+        return ERR_NEXMOTION_POINTER_NULL;
+    std::unique_lock<std::mutex> lock( gRequestLock );
+    NMC_RETURN_IF_ERR( WaitRequest( lock, gOpenUpRequest, WaitMs ) );
+    *PRetDevID = gOpenUpRequest.devId;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR DeviceShutdownRequest( I32_T DevID )
+{
+    if( !DeviceFind( DevID ) )
+        return ERR_NEXMOTION_OBJECT_ID_INVALID;
+
+    std::lock_guard<std::mutex> guard( gRequestLock );
+    Request_T &request = gShutdownRequests[DevID];
+    if( request.running )
+        return ERR_NEXMOTION_OPERATION_BUSY;
+    try
+    {
+        std::thread( RunShutdownRequest, DevID ).detach();
+    }
+    catch( ... )
+    {
+        return ERR_NEXMOTION_OUT_OF_SYSTEM_RESOURCES;
+    }
+    request.running = true;
+    request.pending = true;
+    request.devId   = DevID;
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+RTN_ERR DeviceWaitShutdownRequest( I32_T DevID, U32_T WaitMs )
+{
+    if( DevID < 0 || DevID >= kMaxDevices )
+        return ERR_NEXMOTION_OBJECT_ID_INVALID;
+    std::unique_lock<std::mutex> lock( gRequestLock );
+    return WaitRequest( lock, gShutdownRequests[DevID], WaitMs );
+}
+
+void PostMessage( I32_T Type, I32_T Code, const char *PSource, const char *PFormat, ... )
+{
+    NmcMsg_T msg;
+    std::memset( &msg, 0, sizeof( msg ) );
+    msg.sizeOfStruct = sizeof( msg );
+    msg.type         = Type;
+    msg.code         = Code;
+    std::strncpy( msg.source, PSource, sizeof( msg.source ) - 1 );
+
+    va_list args;
+    va_start( args, PFormat );
+    std::vsnprintf( msg.text, sizeof( msg.text ), PFormat, args );
+    va_end( args );
+
+    struct timeval tv;
+    struct tm      lt;
+    ::gettimeofday( &tv, 0 );
+    time_t sec = tv.tv_sec;
+    ::localtime_r( &sec, &lt );
+    msg.localTime.year         = lt.tm_year + 1900;
+    msg.localTime.month        = lt.tm_mon + 1;
+    msg.localTime.day          = lt.tm_mday;
+    msg.localTime.hour         = lt.tm_hour;
+    msg.localTime.minute       = lt.tm_min;
+    msg.localTime.second       = lt.tm_sec;
+    msg.localTime.milliseconds = static_cast<U32_T>( tv.tv_usec / 1000 );
+
+    std::lock_guard<std::mutex> guard( gMessageLock );
+    msg.index = gMessageIndex++;
+    if( gMessages.size() >= kMaxMessages )
+        gMessages.pop_front();
+    gMessages.push_back( msg );
+    if( gMessageOutput )
+        std::fprintf( stderr, "[NexMotion] %s(%d) type=%d code=%d: %s\n", msg.source, msg.index, msg.type, msg.code, msg.text );
+}
+
+U32_T NextMessageIndex()
+{
+    return gMessageIndex.load( std::memory_order_relaxed );
+}
+
+RTN_ERR PopMessage( NmcMsg_T *PRetMsg )
+{
+    if( PRetMsg && PRetMsg->sizeOfStruct != sizeof( NmcMsg_T ) )
+        return ERR_NEXMOTION_STRUCT_SIZE_INCOMPTIBLE;
+    std::lock_guard<std::mutex> guard( gMessageLock );
+    if( gMessages.empty() )
+        return ERR_NEXMOTION_QUEUE_EMPTY;
+    if( PRetMsg ) *PRetMsg = gMessages.front();
+    gMessages.pop_front();
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+void SetMessageOutput( bool Enable )
+{
+    std::lock_guard<std::mutex> guard( gMessageLock );
+    gMessageOutput = Enable;
+}
+
+void SetTraceMode( I32_T TraceMode )
+{
+    gTraceMode = TraceMode;
+}
+
+void SetHookData( void *PHookUserData )
+{
+    gHookData = PHookUserData;
+}
+
+void SetHookFunction( PF_NmcHookAPI PFHookFuncPtr )
+{
+    gHookFunc = PFHookFuncPtr;
+}
+
+RTN_ERR TraceApi( const void *PFuncAddress, const char *PFuncName, RTN_ERR Ret )
+{
+    I32_T mode = gTraceMode;
+    if( mode == NMC_TRACE_MODE_ALL || ( mode == NMC_TRACE_MODE_ERROR && Ret != ERR_NEXMOTION_SUCCESS ) )
+        std::fprintf( stderr, "[NexMotion] %s() = %d\n", PFuncName, Ret );
+
+    PF_NmcHookAPI hook = gHookFunc;
+    if( hook )
+        hook( PFuncAddress, PFuncName, Ret, gHookData );
+    return Ret;
+}
+
+} // namespace nmc
@@ -0,0 +1,69 @@
+/*!
+ * @file        SimRuntime.h
+ * @brief       Process wide services of the simulator runtime: device table, system messages and API trace
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_RUNTIME_H
+#define __NEXMOTION_SIM_RUNTIME_H
+
+#include "SimCommon.h"
+#include <memory>
+
+namespace nmc
+{
+
+class Device;
+
+// Device table. A DevID is the slot of the device in the table.
+
+//! Create a device. Only NMC_DEVICE_TYPE_SIMULATOR is supported.
+RTN_ERR DeviceCreate( I32_T DevType, I32_T DevIndex, I32_T *PRetDevID );
+//! Stop and delete a device.
+RTN_ERR DeviceDelete( I32_T DevID );
+//! Return the device or an empty pointer if DevID is not valid. The device stays alive while the pointer is held.
+std::shared_ptr<Device> DeviceFind( I32_T DevID );
+
+/*!
+ * Create, load the configuration and start a device, then enable it if Options has NMC_OPENUP_OPT_ENABLE_ALL.
+ * The device is deleted again if a step fails. The phases are timed, see GetOpenUpProgress().
+ */
+RTN_ERR DeviceOpenUp( I32_T DevType, I32_T DevIndex, I32_T Options, I32_T *PRetDevID );
+//! Progress of the last DeviceOpenUp(), blocking or on the request thread.
+RTN_ERR GetOpenUpProgress( NmcOpenUpProgress_T *PRetProgress );
+//! Stop and delete a device.
+RTN_ERR DeviceShutdown( I32_T DevID );
+
+//! Run DeviceOpenUp() on a request thread. Only one open up request can be pending.
+RTN_ERR DeviceOpenUpRequest( I32_T DevType, I32_T DevIndex, I32_T Options );
+RTN_ERR DeviceWaitOpenUpRequest( U32_T WaitMs, I32_T *PRetDevID );
+//! Run DeviceShutdown() on a request thread.
+RTN_ERR DeviceShutdownRequest( I32_T DevID );
+RTN_ERR DeviceWaitShutdownRequest( I32_T DevID, U32_T WaitMs );
+
+// System messages, see NMC_MessagePopFirst()
+
+//! Append a message to the message queue. The oldest message is dropped when the queue is full.
+void    PostMessage( I32_T Type, I32_T Code, const char *PSource, const char *PFormat, ... )
+#if defined(__GNUC__)
+    __attribute__(( format( printf, 4, 5 ) ))
+#endif
+    ;
+RTN_ERR PopMessage( NmcMsg_T *PRetMsg );
+//! Index of the next message posted. Does not take the message lock.
+U32_T   NextMessageIndex();
+//! Copy every posted message to stderr.
+void    SetMessageOutput( bool Enable );
+
+// API trace, see NMC_DebugSetTraceMode()
+
+void    SetTraceMode( I32_T TraceMode );
+void    SetHookData( void *PHookUserData );
+void    SetHookFunction( PF_NmcHookAPI PFHookFuncPtr );
+
+//! Called by every API before returning: write the trace line and call the hook function. Return Ret.
+RTN_ERR TraceApi( const void *PFuncAddress, const char *PFuncName, RTN_ERR Ret );
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_RUNTIME_H
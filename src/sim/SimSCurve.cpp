@@ -0,0 +1,231 @@
+/*!
+ * @file        SimSCurve.cpp
+ * @brief       Closed form 7 phase jerk limited (S-curve) point-to-point profile, AXP_PROF_TYPE 1
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimSCurve.h"
+#include <cmath>
+
+namespace nmc
+{
+
+namespace
+{
+
+const I32_T kMaxNewtonSteps = 64;
+
+/*!
+ * @brief A jerk limited velocity change between V1 and V2 with the acceleration limited to A.
+ *
+ * The acceleration rises for tj, stays at its limit for ta and falls for tj. The change is symmetric in
+ * time, so its distance is the mean velocity times its duration.
+ */
+struct Ramp_T
+{
+    F64_T tj;
+    F64_T ta;
+    F64_T dist;
+    F64_T dDist;    //!< Derivative of dist with respect to the larger velocity
+
+    Ramp_T( F64_T V1, F64_T V2, F64_T A, F64_T J )
+    {
+        F64_T dv  = std::fabs( V2 - V1 );
+        F64_T sum = V1 + V2;
+        if( dv * J >= A * A )
+        {
+            tj    = A / J;
+            ta    = dv / A - tj;
+            dist  = 0.5 * sum * ( dv / A + tj );
+            dDist = 0.5 * ( dv / A + tj ) + 0.5 * sum / A;
+        }
+        else
+        {
+            tj    = std::sqrt( dv / J );
+            ta    = 0.0;
+            dist  = sum * tj;
+            dDist = tj + ( tj > 0.0 ? 0.5 * sum / ( J * tj ) : 0.0 );
+        }
+    }
+
+    F64_T Duration() const { return 2.0 * tj + ta; }
+};
+
+//! Distance from Vs to V with the acceleration limit and from V to Ve with the deceleration limit, V >= Vs, Ve.
+F64_T MoveDist( F64_T Vs, F64_T V, F64_T Ve, const SCurveLimit_T &L, F64_T *PRetDeriv )
+{
+    Ramp_T up( Vs, V, L.acc, L.jerk ), down( V, Ve, L.dec, L.jerk );
+    if( PRetDeriv ) *PRetDeriv = up.dDist + down.dDist;
+    return up.dist + down.dist;
+}
+
+//! Real root of x^3 + P x + Q = 0 with P >= 0 and Q <= 0, the only one.
+F64_T CubicRoot( F64_T P, F64_T Q )
+{
+    // Cardano, with the second cube root taken as -P / 3c to avoid the cancellation of cbrt( -Q / 2 - r )
+    F64_T c = std::cbrt( -0.5 * Q + std::sqrt( 0.25 * Q * Q + P * P * P / 27.0 ) );
+    return ( c > 0.0 ) ? c - P / ( 3.0 * c ) : 0.0;
+}
+
+/*!
+ * @brief Peak velocity V in [Lo, Hi] of a move of Dist without constant velocity, MoveDist( Vs, V, Ve ) = Dist.
+ *
+ * MoveDist() increases with V and each of its two velocity changes switches once from a triangular to a
+ * trapezoidal acceleration, so [Lo, Hi] is first narrowed to a piece of a single form, which is solved in
+ * closed form when possible.
+ */
+F64_T SolvePeak( F64_T Vs, F64_T Ve, F64_T Dist, F64_T Lo, F64_T Hi, const SCurveLimit_T &L )
+{
+    F64_T breaks[2] = { Vs + L.acc * L.acc / L.jerk, Ve + L.dec * L.dec / L.jerk };
+    for( I32_T i = 0; i < 2; ++i )
+    {
+        F64_T b = breaks[i];
+        if( b <= Lo || b >= Hi ) continue;
+        if( MoveDist( Vs, b, Ve, L, 0 ) >= Dist ) Hi = b;
+        else                                     Lo = b;
+    }
+
+    bool fullUp   = Lo >= breaks[0];
+    bool fullDown = Lo >= breaks[1];
+    F64_T v;
+    if( fullUp && fullDown )
+    {
+        // ( v^2 - Vs^2 ) / 2A + ( Vs + v ) A / 2J + ( v^2 - Ve^2 ) / 2D + ( v + Ve ) D / 2J = Dist
+        F64_T a = 0.5 / L.acc + 0.5 / L.dec;
+        F64_T b = 0.5 * ( L.acc + L.dec ) / L.jerk;
+        F64_T c = -0.5 * Vs * Vs / L.acc + 0.5 * Vs * L.acc / L.jerk - 0.5 * Ve * Ve / L.dec + 0.5 * Ve * L.dec / L.jerk - Dist;
+        v = ( -b + std::sqrt( b * b - 4.0 * a * c ) ) / ( 2.0 * a );
+    }
+    else if( !fullUp && !fullDown && std::fabs( Vs - Ve ) <= kVelEpsilon )
+    {
+        // 2 ( Vs + v ) sqrt( ( v - Vs ) / J ) = Dist, with x = sqrt( v - Vs ): x^3 + 2 Vs x - Dist sqrt( J ) / 2 = 0
+        F64_T x = CubicRoot( 2.0 * Vs, -0.5 * Dist * std::sqrt( L.jerk ) );
+        v = Vs + x * x;
+    }
+    else
+    {
+        // One change is triangular and the other trapezoidal, or the triangles differ: Newton kept in the bracket.
+        v = 0.5 * ( Lo + Hi );
+        for( I32_T k = 0; k < kMaxNewtonSteps && Hi - Lo > kVelEpsilon; ++k )
+        {
+            F64_T deriv;
+            F64_T f = MoveDist( Vs, v, Ve, L, &deriv ) - Dist;
+            if( std::fabs( f ) <= kPosEpsilon ) break;
+            if( f > 0.0 ) Hi = v;
+            else          Lo = v;
+            F64_T next = ( deriv > 0.0 ) ? v - f / deriv : Lo - 1.0;
+            v = ( next >= Lo && next <= Hi ) ? next : 0.5 * ( Lo + Hi );
+        }
+    }
+    return Clamp( v, Lo, Hi );
+}
+
+} // namespace
+
+SCurveProfile::SCurveProfile()
+    : start_( 0.0 )
+    , target_( 0.0 )
+    , dir_( 1.0 )
+    , end_( 0.0 )
+    , peak_( 0.0 )
+    , firstPhase_( PROFILE_PHASE_ACC )
+{
+    for( I32_T i = 0; i < kPhases; ++i )
+        phases_[i].t = phases_[i].pos = phases_[i].vel = phases_[i].acc = phases_[i].jerk = 0.0;
+}
+
+bool SCurveProfile::Plan( F64_T StartPos, F64_T StartVel, F64_T Target, const SCurveLimit_T &Limit )
+{
+    start_  = StartPos;
+    target_ = Target;
+    end_    = 0.0;
+    peak_   = 0.0;
+    for( I32_T i = 0; i < kPhases; ++i )
+        phases_[i].t = phases_[i].pos = phases_[i].vel = phases_[i].acc = phases_[i].jerk = 0.0;
+
+    if( !( Limit.vm > 0.0 && Limit.acc > 0.0 && Limit.dec > 0.0 && Limit.jerk > 0.0 && Limit.vBase >= 0.0 ) )
+        return false;
+    F64_T dist = std::fabs( Target - StartPos );
+    dir_ = Sign( Target - StartPos );
+    F64_T v0 = StartVel * dir_;
+    if( v0 < -kVelEpsilon )
+        return false;
+
+    // As the trapezoidal profile: the base velocity is a floor, also above the maximum velocity.
+    F64_T ve = Limit.vBase;
+    F64_T vs = ( v0 > ve ) ? v0 : ve;
+    F64_T vm = ( Limit.vm > ve ) ? Limit.vm : ve;
+    if( dist <= kPosEpsilon )
+        return vs <= ve + kVelEpsilon;
+
+    F64_T vp;
+    if( vs > vm )
+    {
+        vp = vm;
+        Ramp_T down1( vs, vm, Limit.dec, Limit.jerk ), down2( vm, ve, Limit.dec, Limit.jerk );
+        if( down1.dist + down2.dist > dist + kPosEpsilon )
+            return false;
+        firstPhase_ = PROFILE_PHASE_DEC;
+    }
+    else
+    {
+        if( MoveDist( vs, vm, ve, Limit, 0 ) <= dist )      vp = vm;
+        else if( MoveDist( vs, vs, ve, Limit, 0 ) > dist + kPosEpsilon ) return false;
+        else                                             vp = SolvePeak( vs, ve, dist, vs, vm, Limit );
+        firstPhase_ = PROFILE_PHASE_ACC;
+    }
+
+    F64_T a1 = ( vp >= vs ) ? Limit.acc : Limit.dec;
+    F64_T s1 = ( vp >= vs ) ? 1.0 : -1.0;
+    Ramp_T first( vs, vp, a1, Limit.jerk ), last( vp, ve, Limit.dec, Limit.jerk );
+    F64_T cruise = dist - first.dist - last.dist;
+    F64_T tc     = ( cruise > 0.0 && vp > 0.0 ) ? cruise / vp : 0.0;
+
+    const F64_T durations[kPhases] = { first.tj, first.ta, first.tj, tc, last.tj, last.ta, last.tj };
+    const F64_T jerks[kPhases]     = { s1 * Limit.jerk, 0.0, -s1 * Limit.jerk, 0.0, -Limit.jerk, 0.0, Limit.jerk };
+    F64_T t = 0.0, p = 0.0, v = vs, a = 0.0;
+    for( I32_T i = 0; i < kPhases; ++i )
+    {
+        Phase_T &ph = phases_[i];
+        ph.t = t; ph.pos = p; ph.vel = v; ph.acc = ( i == 3 ) ? 0.0 : a; ph.jerk = jerks[i];
+        F64_T d = durations[i];
+        p += v * d + ph.acc * d * d / 2.0 + ph.jerk * d * d * d / 6.0;
+        v += ph.acc * d + ph.jerk * d * d / 2.0;
+        a  = ph.acc + ph.jerk * d;
+        t += d;
+    }
+    end_  = t;
+    peak_ = vp;
+    return true;
+}
+
+void SCurveProfile::Evaluate( F64_T T, SCurveState_T *PRet ) const
+{
+    if( T >= end_ )
+    {
+        PRet->pos   = target_;
+        PRet->vel   = 0.0;
+        PRet->acc   = 0.0;
+        PRet->phase = PROFILE_PHASE_DEC;
+        return;
+    }
+    if( T < 0.0 ) T = 0.0;
+    I32_T i = kPhases - 1;
+    while( i > 0 && phases_[i].t > T ) --i;
+
+    const Phase_T &ph = phases_[i];
+    F64_T d = T - ph.t;
+    PRet->pos   = start_ + dir_ * ( ph.pos + d * ( ph.vel + d * ( ph.acc / 2.0 + d * ph.jerk / 6.0 ) ) );
+    PRet->vel   = dir_ * ( ph.vel + d * ( ph.acc + d * ph.jerk / 2.0 ) );
+    PRet->acc   = dir_ * ( ph.acc + d * ph.jerk );
+    PRet->phase = ( i < 3 ) ? firstPhase_ : ( i == 3 ) ? PROFILE_PHASE_CONST : PROFILE_PHASE_DEC;
+}
+
+F64_T SCurveProfile::PhaseDuration( I32_T Phase ) const
+{
+    if( Phase < 0 || Phase >= kPhases )
+        return 0.0;
+    return ( ( Phase + 1 < kPhases ) ? phases_[Phase + 1].t : end_ ) - phases_[Phase].t;
+}
+
+} // namespace nmc
@@ -0,0 +1,95 @@
+/*!
+ * @file        SimSCurve.h
+ * @brief       Closed form 7 phase jerk limited (S-curve) point-to-point profile, AXP_PROF_TYPE 1
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_SCURVE_H
+#define __NEXMOTION_SIM_SCURVE_H
+
+#include "SimProfile.h"
+
+namespace nmc
+{
+
+/*! @struct SCurveLimit_T
+ *  @brief  Kinematic limits of a jerk limited profile.
+ */
+struct SCurveLimit_T
+{
+    F64_T vm;       //!< Maximum velocity (> 0)
+    F64_T acc;      //!< Acceleration (> 0)
+    F64_T dec;      //!< Deceleration (> 0)
+    F64_T jerk;     //!< Jerk (> 0), the rate of change of both the acceleration and the deceleration
+    F64_T vBase;    //!< Base velocity. Motion starts from and stops at this velocity.
+};
+
+//! State of a profile at a given time.
+struct SCurveState_T
+{
+    F64_T pos;
+    F64_T vel;
+    F64_T acc;
+    I32_T phase;    //!< ProfilePhase_E
+};
+
+/*!
+ * @brief Point-to-point profile with a jerk limited velocity change to the peak velocity and back, planned once.
+ *
+ * The profile has 7 phases: jerk up, constant acceleration, jerk down, constant velocity, then the same three
+ * for the deceleration, each of them possibly empty. Plan() computes the phase durations analytically from the
+ * distance, the start velocity and the limits; acceleration and deceleration may differ. The peak velocity of a
+ * move too short to reach the maximum velocity is the root of the distance equation: a quadratic when both
+ * velocity changes reach their acceleration limit, a cubic (Cardano) when neither does from equal start and end
+ * velocities, and a bracketed Newton iteration in the mixed cases. The state at the start of each phase is
+ * stored, so Evaluate() is a lookup among 7 phases and a cubic polynomial: O(1), no allocation, no iteration.
+ *
+ * The velocity starts at the larger of the start velocity and the base velocity, and ends at the base velocity
+ * before it drops to 0 on the target, as the trapezoidal profile of OnlineProfile. The start acceleration is
+ * taken as 0.
+ */
+class SCurveProfile
+{
+public:
+    enum { kPhases = 7 };
+
+    SCurveProfile();
+
+    /*!
+     * @brief Plan a move from StartPos, at velocity StartVel, to Target.
+     * @return false if the limits are not positive, if the axis moves away from the target, or if it is too
+     *         fast to stop on the target within the limits. The profile is then left empty.
+     */
+    bool  Plan( F64_T StartPos, F64_T StartVel, F64_T Target, const SCurveLimit_T &Limit );
+
+    //! State at time T from the start of the move. At and after Duration() the axis stands on the target.
+    void  Evaluate( F64_T T, SCurveState_T *PRet ) const;
+
+    F64_T Duration() const               { return end_; }
+    F64_T PhaseDuration( I32_T Phase ) const;
+    //! Velocity of the constant velocity phase, in the direction of the move.
+    F64_T PeakVel() const                { return peak_; }
+
+private:
+    //! Start of a phase, in the direction of the move and relative to the start position.
+    struct Phase_T
+    {
+        F64_T t;
+        F64_T pos;
+        F64_T vel;
+        F64_T acc;
+        F64_T jerk;
+    };
+
+    Phase_T phases_[kPhases];
+    F64_T   start_;
+    F64_T   target_;
+    F64_T   dir_;
+    F64_T   end_;
+    F64_T   peak_;
+    I32_T   firstPhase_;    //!< PROFILE_PHASE_ACC, or PROFILE_PHASE_DEC if the move starts above the maximum velocity
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_SCURVE_H
@@ -0,0 +1,171 @@
+/*!
+ * @file        SimSnapshot.cpp
+ * @brief       Per-cycle status snapshot of a device, published by the motion cycle behind a seqlock
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimSnapshot.h"
+#include "SimRealtime.h"
+#include <cstring>
+
+namespace nmc
+{
+
+namespace
+{
+
+const size_t kWord = sizeof( U64_T );
+
+} // namespace
+
+static_assert( sizeof( AxisSnap_T ) % sizeof( U64_T ) == 0, "AxisSnap_T must be a whole number of words" );
+static_assert( sizeof( GroupSnap_T ) % sizeof( U64_T ) == 0, "GroupSnap_T must be a whole number of words" );
+
+void SeqLockBuffer::Resize( size_t Bytes )
+{
+    count_ = ( Bytes + kWord - 1 ) / kWord;
+    words_.reset( count_ ? new std::atomic<U64_T>[count_] : 0 );
+    for( size_t i = 0; i < count_; ++i )
+        words_[i].store( 0, std::memory_order_relaxed );
+    seq_.store( 0, std::memory_order_release );
+}
+
+void SeqLockBuffer::BeginWrite()
+{
+    seq_.store( seq_.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+}
+
+void SeqLockBuffer::Write( size_t Offset, const void *PData, size_t Bytes )
+{
+    const U8_T *src = static_cast<const U8_T *>( PData );
+    for( size_t i = 0; i < Bytes / kWord; ++i )
+    {
+        U64_T word;
+        std::memcpy( &word, src + i * kWord, kWord );
+        words_[Offset / kWord + i].store( word, std::memory_order_relaxed );
+    }
+}
+
+void SeqLockBuffer::EndWrite()
+{
+    seq_.store( seq_.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+}
+
+void SeqLockBuffer::Read( size_t Offset, void *PRetData, size_t Bytes ) const
+{
+    SeqLockRange_T range = { Offset, PRetData, Bytes };
+    Read( &range, 1 );
+}
+
+void SeqLockBuffer::Read( const SeqLockRange_T *PRanges, size_t Count ) const
+{
+    for( ;; )
+    {
+        U32_T before = seq_.load( std::memory_order_acquire );
+        if( before & 1 )
+            continue;
+        for( size_t r = 0; r < Count; ++r )
+        {
+            U8_T *dst = static_cast<U8_T *>( PRanges[r].pData );
+            for( size_t i = 0; i < PRanges[r].bytes / kWord; ++i )
+            {
+                U64_T word = words_[PRanges[r].offset / kWord + i].load( std::memory_order_relaxed );
+                std::memcpy( dst + i * kWord, &word, kWord );
+            }
+        }
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( seq_.load( std::memory_order_relaxed ) == before )
+            return;
+    }
+}
+
+StatusSnapshot::StatusSnapshot()
+    : axisCount_( 0 )
+    , groupCount_( 0 )
+{
+    buffer_.Resize( GroupOffset( kMaxGroups ) );
+}
+
+void StatusSnapshot::WriteHeader( U64_T CycleCount )
+{
+    Header_T header;
+    header.cycleCount = CycleCount;
+    header.timeNs     = MonotonicNs();
+    header.axisCount  = axisCount_.load( std::memory_order_relaxed );
+    header.groupCount = groupCount_.load( std::memory_order_relaxed );
+    buffer_.Write( 0, &header, sizeof( header ) );
+}
+
+void StatusSnapshot::Resize( I32_T AxisCount, I32_T GroupCount )
+{
+    static const AxisSnap_T  kAxisZero  = AxisSnap_T();
+    static const GroupSnap_T kGroupZero = GroupSnap_T();
+    buffer_.BeginWrite();
+    axisCount_.store( AxisCount, std::memory_order_release );
+    groupCount_.store( GroupCount, std::memory_order_release );
+    WriteHeader( 0 );
+    for( I32_T i = 0; i < kMaxAxes; ++i )
+        buffer_.Write( AxisOffset( i ), &kAxisZero, sizeof( kAxisZero ) );
+    for( I32_T g = 0; g < kMaxGroups; ++g )
+        buffer_.Write( GroupOffset( g ), &kGroupZero, sizeof( kGroupZero ) );
+    buffer_.EndWrite();
+}
+
+void StatusSnapshot::BeginPublish( U64_T CycleCount )
+{
+    buffer_.BeginWrite();
+    WriteHeader( CycleCount );
+}
+
+void StatusSnapshot::SetAxis( I32_T Index, const AxisSnap_T &Snap )
+{
+    buffer_.Write( AxisOffset( Index ), &Snap, sizeof( Snap ) );
+}
+
+void StatusSnapshot::SetGroup( I32_T Index, const GroupSnap_T &Snap )
+{
+    buffer_.Write( GroupOffset( Index ), &Snap, sizeof( Snap ) );
+}
+
+void StatusSnapshot::EndPublish()
+{
+    buffer_.EndWrite();
+}
+
+void StatusSnapshot::GetAxis( I32_T Index, AxisSnap_T *PRet ) const
+{
+    buffer_.Read( AxisOffset( Index ), PRet, sizeof( *PRet ) );
+}
+
+void StatusSnapshot::GetGroup( I32_T Index, GroupSnap_T *PRet ) const
+{
+    buffer_.Read( GroupOffset( Index ), PRet, sizeof( *PRet ) );
+}
+
+void StatusSnapshot::GetAll( U64_T *PRetCycleCount, I64_T *PRetTimeNs, I32_T *PRetAxisCount, I32_T *PRetGroupCount,
+                             AxisSnap_T *PAxes, GroupSnap_T *PGroups ) const
+{
+    // Copy the entries of the current numbers, again if a resize changed them in between.
+    Header_T header;
+    for( ;; )
+    {
+        I32_T axisCount  = AxisCount();
+        I32_T groupCount = GroupCount();
+        SeqLockRange_T ranges[] =
+        {
+            { 0,                &header, sizeof( header ) },
+            { AxisOffset( 0 ),  PAxes,   axisCount * sizeof( AxisSnap_T ) },
+            { GroupOffset( 0 ), PGroups, groupCount * sizeof( GroupSnap_T ) },
+        };
+        buffer_.Read( ranges, sizeof( ranges ) / sizeof( ranges[0] ) );
+        if( header.axisCount == axisCount && header.groupCount == groupCount )
+            break;
+    }
+    *PRetCycleCount = header.cycleCount;
+    *PRetTimeNs     = header.timeNs;
+    *PRetAxisCount  = header.axisCount;
+    *PRetGroupCount = header.groupCount;
+}
+
+} // namespace nmc
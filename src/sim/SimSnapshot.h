@@ -0,0 +1,141 @@
+/*!
+ * @file        SimSnapshot.h
+ * @brief       Per-cycle status snapshot of a device, published by the motion cycle behind a seqlock
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_SNAPSHOT_H
+#define __NEXMOTION_SIM_SNAPSHOT_H
+
+#include "SimCommon.h"
+#include <atomic>
+#include <memory>
+
+namespace nmc
+{
+
+//! Status of an axis at the end of a motion cycle.
+struct AxisSnap_T
+{
+    I32_T state;
+    I32_T status;
+    F64_T cmdPos;
+    F64_T actPos;
+    F64_T cmdVel;
+    F64_T actVel;
+};
+
+//! Status of a group at the end of a motion cycle, with the positions in every coordinate system.
+struct GroupSnap_T
+{
+    I32_T state;
+    I32_T status;
+    F64_T cmdAcs[NMC_MAX_POS_SIZE];
+    F64_T actAcs[NMC_MAX_POS_SIZE];
+    F64_T cmdVel[NMC_MAX_POS_SIZE];     //!< ACS command velocity
+    F64_T actVel[NMC_MAX_POS_SIZE];     //!< ACS actual velocity
+    F64_T cmdMcs[NMC_MAX_POS_SIZE];
+    F64_T actMcs[NMC_MAX_POS_SIZE];
+    F64_T cmdPcs[NMC_MAX_POS_SIZE];     //!< In the base selected by group parameter 0x48:1
+    F64_T actPcs[NMC_MAX_POS_SIZE];
+    I32_T pcsError;                     //!< Error of the MCS to PCS conversion, the PCS positions are zero if set
+    I32_T reserved;
+};
+
+//! Part of a SeqLockBuffer copied by SeqLockBuffer::Read().
+struct SeqLockRange_T
+{
+    size_t offset;
+    void  *pData;
+    size_t bytes;
+};
+
+/*!
+ * @brief Buffer of 64 bit words written by one writer at a time and read by any thread without a lock.
+ *
+ * The writer makes the sequence number odd while it stores, a reader retries if the number was odd
+ * or changed while it loaded. The words are relaxed atomics so the concurrent loads are well defined.
+ * The writer never waits for readers.
+ */
+class SeqLockBuffer
+{
+public:
+    SeqLockBuffer() : count_( 0 ), seq_( 0 ) {}
+
+    //! Set the size in bytes and zero the content. Not thread safe, called once before any reader.
+    void   Resize( size_t Bytes );
+    size_t Bytes() const { return count_ * sizeof( U64_T ); }
+
+    void   BeginWrite();
+    void   Write( size_t Offset, const void *PData, size_t Bytes );
+    void   EndWrite();
+
+    //! Copy Bytes at Offset, all written by the same BeginWrite() / EndWrite().
+    void   Read( size_t Offset, void *PRetData, size_t Bytes ) const;
+    //! Copy several ranges, all written by the same BeginWrite() / EndWrite().
+    void   Read( const SeqLockRange_T *PRanges, size_t Count ) const;
+
+private:
+    SeqLockBuffer( const SeqLockBuffer & );
+    SeqLockBuffer &operator=( const SeqLockBuffer & );
+
+    std::unique_ptr<std::atomic<U64_T>[]> words_;
+    size_t                                count_;
+    std::atomic<U32_T>                    seq_;
+};
+
+/*!
+ * @brief Status of every axis and group of a device, published at the end of each motion cycle.
+ *
+ * Publishing requires the device lock, reading requires no lock at all: the status getters of the API
+ * read a consistent record of a single cycle and never wait for the motion cycle. The buffer holds
+ * kMaxAxes axes and kMaxGroups groups whatever the configuration, so a reader which races with a
+ * lifecycle function reads zeros or the last record, never freed memory.
+ */
+class StatusSnapshot
+{
+public:
+    StatusSnapshot();
+
+    //! Set the number of axes and groups and zero their status, as a publication. The caller holds the device lock.
+    void  Resize( I32_T AxisCount, I32_T GroupCount );
+    I32_T AxisCount() const  { return axisCount_.load( std::memory_order_acquire ); }
+    I32_T GroupCount() const { return groupCount_.load( std::memory_order_acquire ); }
+
+    // Writer, the caller holds the device lock.
+    void  BeginPublish( U64_T CycleCount );
+    void  SetAxis( I32_T Index, const AxisSnap_T &Snap );
+    void  SetGroup( I32_T Index, const GroupSnap_T &Snap );
+    void  EndPublish();
+
+    // Readers, Index is checked against kMaxAxes or kMaxGroups only.
+    void  GetAxis( I32_T Index, AxisSnap_T *PRet ) const;
+    void  GetGroup( I32_T Index, GroupSnap_T *PRet ) const;
+    /*!
+     * Every axis and group of the same cycle, with their numbers. PAxes and PGroups hold kMaxAxes and
+     * kMaxGroups entries.
+     */
+    void  GetAll( U64_T *PRetCycleCount, I64_T *PRetTimeNs, I32_T *PRetAxisCount, I32_T *PRetGroupCount,
+                  AxisSnap_T *PAxes, GroupSnap_T *PGroups ) const;
+
+private:
+    struct Header_T
+    {
+        U64_T cycleCount;
+        I64_T timeNs;       //!< CLOCK_MONOTONIC at publication
+        I32_T axisCount;
+        I32_T groupCount;
+    };
+
+    static size_t AxisOffset( I32_T Index )  { return sizeof( Header_T ) + Index * sizeof( AxisSnap_T ); }
+    static size_t GroupOffset( I32_T Index ) { return AxisOffset( kMaxAxes ) + Index * sizeof( GroupSnap_T ); }
+    void   WriteHeader( U64_T CycleCount );
+
+    SeqLockBuffer      buffer_;
+    std::atomic<I32_T> axisCount_;
+    std::atomic<I32_T> groupCount_;
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_SNAPSHOT_H
@@ -0,0 +1,262 @@
+/*!
+ * @file        SimSpline.cpp
+ * @brief       B-spline / NURBS path of NMC_GroupSpline(), parameterized by its path length
+ * @author      NexCOBOT, Inc.
+ */
+
+#include "SimSpline.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace nmc
+{
+
+namespace
+{
+
+const I32_T kStride = kSplineCoords + 1;   // Weighted control point and its weight
+
+// 4 point Gauss-Legendre rule on [-1, 1]
+const F64_T kGaussNodes[4]   = { -0.8611363115940526, -0.3399810435848563, 0.3399810435848563, 0.8611363115940526 };
+const F64_T kGaussWeights[4] = { 0.3478548451374538, 0.6521451548625461, 0.6521451548625461, 0.3478548451374538 };
+
+} // namespace
+
+SplinePath::SplinePath()
+    : degree_( 0 )
+    , count_( 0 )
+    , rotOnly_( false )
+{
+    std::memset( maxRate_, 0, sizeof( maxRate_ ) );
+    std::memset( maxBend_, 0, sizeof( maxBend_ ) );
+}
+
+RTN_ERR SplinePath::Build( I32_T Degree, I32_T Count, const F64_T *PCtrl, const F64_T *PKnots, const F64_T *PWeights )
+{
+    if( Degree < 1 || Degree > kMaxSplineDegree || Count <= Degree || Count > kMaxSplinePoints )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+
+    // Clamped: the first and the last knot are repeated Degree + 1 times, an inner knot at most Degree times.
+    I32_T nKnots = Count + Degree + 1;
+    knots_.resize( nKnots );
+    for( I32_T i = 0; i < nKnots; ++i )
+    {
+        knots_[i] = PKnots ? PKnots[i] : Clamp( i - Degree, 0.0, Count - Degree );
+        if( !std::isfinite( knots_[i] ) || ( i > 0 && !( knots_[i] >= knots_[i - 1] ) ) )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    }
+    if( knots_[0] != knots_[Degree] || knots_[Count] != knots_[nKnots - 1] )
+        return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    for( I32_T i = 1; i < Count; ++i )
+    {
+        if( !( knots_[i] < knots_[i + Degree] ) )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+    }
+
+    ctrl_.resize( Count * kStride );
+    for( I32_T k = 0; k < Count; ++k )
+    {
+        F64_T w = PWeights ? PWeights[k] : 1.0;
+        if( !( w > 0.0 ) || !std::isfinite( w ) )
+            return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+        for( I32_T i = 0; i < kSplineCoords; ++i )
+        {
+            if( !std::isfinite( PCtrl[k * kSplineCoords + i] ) )
+                return ERR_NEXMOTION_PARAMETER_VALUE_INVALID;
+            ctrl_[k * kStride + i] = w * PCtrl[k * kSplineCoords + i];
+        }
+        ctrl_[k * kStride + kSplineCoords] = w;
+    }
+
+    degree_  = Degree;
+    count_   = Count;
+    rotOnly_ = false;
+    BuildTable();
+    if( Length() <= kPosEpsilon )
+    {
+        rotOnly_ = true;
+        BuildTable();
+    }
+    return ERR_NEXMOTION_SUCCESS;
+}
+
+I32_T SplinePath::FindSpan( F64_T U ) const
+{
+    // Knot span [u_i, u_i+1) of U among the spans Degree ~ Count - 1, the last one includes its end.
+    I32_T span = static_cast<I32_T>( std::upper_bound( knots_.begin() + degree_, knots_.begin() + count_ + 1, U ) - knots_.begin() ) - 1;
+    return std::min( std::max( span, degree_ ), count_ - 1 );
+}
+
+void SplinePath::Basis( I32_T Span, F64_T U, F64_T *PN, F64_T *PDN ) const
+{
+    // Non-zero basis functions N_Span-p+j,p and their derivatives, j = 0 ~ p (The NURBS Book, A2.2 and eq. 2.7).
+    const I32_T p = degree_;
+    F64_T left[kMaxSplineDegree + 1], right[kMaxSplineDegree + 1], lower[kMaxSplineDegree + 1];
+    PN[0] = 1.0;
+    for( I32_T j = 1; j <= p; ++j )
+    {
+        if( j == p ) std::memcpy( lower, PN, sizeof( F64_T ) * p );
+        left[j]  = U - knots_[Span + 1 - j];
+        right[j] = knots_[Span + j] - U;
+        F64_T saved = 0.0;
+        for( I32_T r = 0; r < j; ++r )
+        {
+            F64_T temp = PN[r] / ( right[r + 1] + left[j - r] );
+            PN[r] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        PN[j] = saved;
+    }
+
+    // N'_i,p = p * ( N_i,p-1 / ( u_i+p - u_i ) - N_i+1,p-1 / ( u_i+p+1 - u_i+1 ) ), lower[k] = N_Span-p+1+k,p-1
+    for( I32_T j = 0; j <= p; ++j )
+    {
+        I32_T i = Span - p + j;
+        F64_T a = ( j > 0 ) ? lower[j - 1] / ( knots_[i + p] - knots_[i] ) : 0.0;
+        F64_T b = ( j < p ) ? lower[j] / ( knots_[i + p + 1] - knots_[i + 1] ) : 0.0;
+        PDN[j] = p * ( a - b );
+    }
+}
+
+void SplinePath::Point( F64_T U, F64_T PRetPose[kSplineCoords], F64_T PRetDeriv[kSplineCoords] ) const
+{
+    F64_T n[kMaxSplineDegree + 1], dn[kMaxSplineDegree + 1];
+    I32_T span = FindSpan( U );
+    Basis( span, U, n, dn );
+
+    // Homogeneous point A( u ) = sum( N * w * P ), w( u ) = sum( N * w ), then C = A / w and C' = ( A' - w' C ) / w.
+    F64_T a[kStride], da[kStride];
+    std::memset( a, 0, sizeof( a ) );
+    std::memset( da, 0, sizeof( da ) );
+    for( I32_T j = 0; j <= degree_; ++j )
+    {
+        const F64_T *p = &ctrl_[( span - degree_ + j ) * kStride];
+        for( I32_T i = 0; i < kStride; ++i )
+        {
+            a[i]  += n[j] * p[i];
+            da[i] += dn[j] * p[i];
+        }
+    }
+    F64_T w = a[kSplineCoords], dw = da[kSplineCoords];
+    for( I32_T i = 0; i < kSplineCoords; ++i )
+    {
+        PRetPose[i]  = a[i] / w;
+        PRetDeriv[i] = ( da[i] - dw * PRetPose[i] ) / w;
+    }
+}
+
+F64_T SplinePath::Speed( const F64_T *PDeriv ) const
+{
+    if( !rotOnly_ )
+        return std::sqrt( PDeriv[0] * PDeriv[0] + PDeriv[1] * PDeriv[1] + PDeriv[2] * PDeriv[2] );
+    F64_T speed = 0.0;
+    for( I32_T i = 3; i < kSplineCoords; ++i )
+        speed = std::max( speed, std::fabs( PDeriv[i] ) );
+    return speed;
+}
+
+void SplinePath::BuildTable()
+{
+    F64_T pose[kSplineCoords], d[kSplineCoords];
+    table_.clear();
+    Sample_T first = { 0.0, knots_[degree_], 0.0 };
+    table_.push_back( first );
+    for( I32_T span = degree_; span < count_; ++span )
+    {
+        F64_T a = knots_[span], b = knots_[span + 1];
+        if( !( b > a ) )
+            continue;
+        F64_T h = ( b - a ) / kSamplesPerSpan;
+        for( I32_T k = 0; k < kSamplesPerSpan; ++k )
+        {
+            F64_T u0 = a + k * h;
+            F64_T ds = 0.0;
+            for( I32_T g = 0; g < 4; ++g )
+            {
+                Point( u0 + 0.5 * h * ( 1.0 + kGaussNodes[g] ), pose, d );
+                ds += 0.5 * h * kGaussWeights[g] * Speed( d );
+            }
+            Sample_T next = { table_.back().s + ds, ( k + 1 == kSamplesPerSpan ) ? b : u0 + h, 0.0 };
+            table_.push_back( next );
+        }
+    }
+
+    // du/ds at the samples, and the rates of the coordinates for the axis limits of the group.
+    F64_T prevRate[kSplineCoords] = { 0.0 };
+    std::memset( maxRate_, 0, sizeof( maxRate_ ) );
+    std::memset( maxBend_, 0, sizeof( maxBend_ ) );
+    for( size_t k = 0; k < table_.size(); ++k )
+    {
+        Sample_T &smp = table_[k];
+        Point( smp.u, pose, d );
+        F64_T speed = Speed( d );
+        smp.duds = ( speed > 0.0 && std::isfinite( 1.0 / speed ) ) ? 1.0 / speed : 0.0;
+        for( I32_T i = 0; i < kSplineCoords; ++i )
+        {
+            F64_T rate = d[i] * smp.duds;
+            maxRate_[i] = std::max( maxRate_[i], std::fabs( rate ) );
+            if( k > 0 && smp.s - table_[k - 1].s > kPosEpsilon )
+                maxBend_[i] = std::max( maxBend_[i], std::fabs( rate - prevRate[i] ) / ( smp.s - table_[k - 1].s ) );
+            prevRate[i] = rate;
+        }
+    }
+}
+
+F64_T SplinePath::Param( F64_T S ) const
+{
+    // Samples a and b with a.s <= S < b.s
+    size_t lo = 0, hi = table_.size();
+    while( hi - lo > 1 )
+    {
+        size_t mid = ( lo + hi ) / 2;
+        if( table_[mid].s <= S ) lo = mid;
+        else                     hi = mid;
+    }
+    if( hi >= table_.size() )
+        return table_.back().u;
+
+    // Cubic Hermite interpolation of u( s ), linear where the path stands still or the slopes would
+    // make u( s ) overshoot (Fritsch-Carlson).
+    const Sample_T &a = table_[lo], &b = table_[hi];
+    F64_T h  = b.s - a.s;
+    F64_T du = b.u - a.u;
+    F64_T t  = ( S - a.s ) / h;
+    F64_T m0 = a.duds * h, m1 = b.duds * h;
+    if( !( m0 > 0.0 && m1 > 0.0 && m0 <= 3.0 * du && m1 <= 3.0 * du ) )
+        return a.u + du * t;
+    F64_T t2 = t * t, t3 = t2 * t;
+    F64_T u  = ( 2.0 * t3 - 3.0 * t2 + 1.0 ) * a.u + ( t3 - 2.0 * t2 + t ) * m0 + ( 3.0 * t2 - 2.0 * t3 ) * b.u + ( t3 - t2 ) * m1;
+    u = Clamp( u, a.u, b.u );
+
+    // One Newton step on the length from sample a to u, integrated as in the table.
+    F64_T pose[kSplineCoords], d[kSplineCoords];
+    F64_T h2 = u - a.u, len = 0.0;
+    for( I32_T g = 0; g < 4; ++g )
+    {
+        Point( a.u + 0.5 * h2 * ( 1.0 + kGaussNodes[g] ), pose, d );
+        len += 0.5 * h2 * kGaussWeights[g] * Speed( d );
+    }
+    Point( u, pose, d );
+    F64_T speed = Speed( d );
+    if( speed > 0.0 )
+        u = Clamp( u + ( S - a.s - len ) / speed, a.u, b.u );
+    return u;
+}
+
+void SplinePath::Pose( F64_T S, F64_T PRetPose[kSplineCoords] ) const
+{
+    F64_T d[kSplineCoords];
+    Point( Param( Clamp( S, 0.0, Length() ) ), PRetPose, d );
+}
+
+void SplinePath::Rate( F64_T S, F64_T PRetRate[kSplineCoords] ) const
+{
+    F64_T pose[kSplineCoords];
+    Point( Param( Clamp( S, 0.0, Length() ) ), pose, PRetRate );
+    F64_T speed = Speed( PRetRate );
+    for( I32_T i = 0; i < kSplineCoords; ++i )
+        PRetRate[i] = ( speed > 0.0 ) ? PRetRate[i] / speed : 0.0;
+}
+
+} // namespace nmc
@@ -0,0 +1,83 @@
+/*!
+ * @file        SimSpline.h
+ * @brief       B-spline / NURBS path of NMC_GroupSpline(), parameterized by its path length
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_SPLINE_H
+#define __NEXMOTION_SIM_SPLINE_H
+
+#include "SimCommon.h"
+#include <vector>
+
+namespace nmc
+{
+
+const I32_T kSplineCoords    = NMC_MAX_POS_SIZE;   //!< Coordinates of a control point: X, Y, Z, A, B, C, U, V
+const I32_T kMaxSplineDegree = 5;
+const I32_T kMaxSplinePoints = 16384;
+
+/*!
+ * @brief Clamped non-uniform rational B-spline of group poses, evaluated by path length.
+ *
+ * Build() runs on the API side. It checks the knots and the weights, then divides each non-empty knot
+ * span into kSamplesPerSpan pieces and integrates the speed |dC/du| of the XYZ part over each piece by
+ * Gauss-Legendre quadrature. The table holds the path length s, the parameter u and du/ds at every
+ * piece boundary, so Pose() maps s to u by a binary search, a cubic Hermite interpolation and one
+ * Newton step on the length from the sample: a fixed cost and no allocation in the motion cycle. A
+ * path without translation is measured by its largest coordinate change, as a line.
+ */
+class SplinePath
+{
+public:
+    SplinePath();
+
+    /*!
+     * @brief Set the path from Count control points of kSplineCoords coordinates each.
+     * @param PKnots   Count + Degree + 1 non-decreasing knots, the first and the last Degree + 1 equal.
+     *                 NULL (0) for a uniform knot vector.
+     * @param PWeights Count positive weights, NULL (0) for a non-rational B-spline.
+     */
+    RTN_ERR Build( I32_T Degree, I32_T Count, const F64_T *PCtrl, const F64_T *PKnots, const F64_T *PWeights );
+
+    F64_T Length() const { return table_.empty() ? 0.0 : table_.back().s; }
+    //! Pose at the path length S, clamped to [0, Length()].
+    void  Pose( F64_T S, F64_T PRetPose[kSplineCoords] ) const;
+    //! Derivative of the pose with respect to the path length at S.
+    void  Rate( F64_T S, F64_T PRetRate[kSplineCoords] ) const;
+    //! Largest |dC/ds| of each coordinate along the path.
+    const F64_T *MaxRate() const { return maxRate_; }
+    //! Largest |d2C/ds2| of each coordinate along the path, from the rates at the table samples.
+    const F64_T *MaxBend() const { return maxBend_; }
+
+private:
+    enum { kSamplesPerSpan = 8 };
+
+    //! Sample of the arc length table.
+    struct Sample_T
+    {
+        F64_T s;
+        F64_T u;
+        F64_T duds;     //!< 0 where the path stands still
+    };
+
+    I32_T FindSpan( F64_T U ) const;
+    void  Basis( I32_T Span, F64_T U, F64_T *PN, F64_T *PDN ) const;
+    void  Point( F64_T U, F64_T PRetPose[kSplineCoords], F64_T PRetDeriv[kSplineCoords] ) const;
+    F64_T Speed( const F64_T *PDeriv ) const;
+    F64_T Param( F64_T S ) const;
+    void  BuildTable();
+
+    I32_T                 degree_;
+    I32_T                 count_;
+    bool                  rotOnly_;     //!< No translation: the length is the largest coordinate change
+    std::vector<F64_T>    ctrl_;        //!< Weighted control points w * P followed by w
+    std::vector<F64_T>    knots_;
+    std::vector<Sample_T> table_;
+    F64_T                 maxRate_[kSplineCoords];
+    F64_T                 maxBend_[kSplineCoords];
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_SPLINE_H
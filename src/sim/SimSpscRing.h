@@ -0,0 +1,126 @@
+/*!
+ * @file        SimSpscRing.h
+ * @brief       Bounded single-producer/single-consumer ring used as motion buffer
+ * @author      NexCOBOT, Inc.
+ */
+
+#ifndef __NEXMOTION_SIM_SPSC_RING_H
+#define __NEXMOTION_SIM_SPSC_RING_H
+
+#include "SimCommon.h"
+#include <atomic>
+#include <vector>
+
+namespace nmc
+{
+
+const size_t kCacheLineSize = 64;
+
+/*!
+ * @brief Bounded lock-free ring between one producer and one consumer.
+ *
+ * The producer (the API callers, serialized by the append lock of the axis or group) calls Push(), the
+ * consumer (the motion cycle, or an API caller holding the device lock) calls Front(), Pop() and
+ * Clear(). Size() and Free() may be called from any thread. The head and tail indexes are free
+ * running counters kept on separate cache lines, so producer and consumer never write the same line.
+ * The number of slots is a power of two, so a counter wrapping at 2^32 keeps addressing the same slot.
+ * Resize() is not thread safe and is only called while the device is not in operation.
+ */
+template <typename T>
+class SpscRing
+{
+public:
+    SpscRing()
+        : slots_( 1 )
+        , mask_( 0 )
+        , capacity_( 1 )
+        , head_( 0 )
+        , tail_( 0 )
+    {
+    }
+
+    //! Set the capacity and discard the content.
+    void Resize( I32_T Capacity )
+    {
+        U32_T capacity = ( Capacity > 0 ) ? static_cast<U32_T>( Capacity ) : 1;
+        U32_T slots    = 1;
+        while( slots < capacity ) slots <<= 1;
+        slots_.assign( slots, T() );
+        mask_ = slots - 1;
+        capacity_.store( capacity, std::memory_order_relaxed );
+        head_.store( 0, std::memory_order_relaxed );
+        tail_.store( 0, std::memory_order_release );
+    }
+
+    I32_T Capacity() const { return static_cast<I32_T>( capacity_.load( std::memory_order_relaxed ) ); }
+
+    I32_T Size() const
+    {
+        // Load the tail first: the size seen by a third thread then never exceeds the capacity,
+        // the head may pass the loaded tail in between, which is read as empty.
+        U32_T tail = tail_.load( std::memory_order_acquire );
+        U32_T head = head_.load( std::memory_order_acquire );
+        I32_T size = static_cast<I32_T>( tail - head );
+        return ( size > 0 ) ? size : 0;
+    }
+
+    I32_T Free() const  { return Capacity() - Size(); }
+    bool  Empty() const { return Size() == 0; }
+
+    //! Producer: append Item, return false if the ring is full.
+    bool Push( const T &Item )
+    {
+        U32_T tail = tail_.load( std::memory_order_relaxed );
+        if( tail - head_.load( std::memory_order_acquire ) >= capacity_.load( std::memory_order_relaxed ) )
+            return false;
+        slots_[tail & mask_] = Item;
+        tail_.store( tail + 1, std::memory_order_release );
+        return true;
+    }
+
+    //! Consumer: oldest item, the ring must not be empty.
+    T &Front()
+    {
+        return slots_[head_.load( std::memory_order_relaxed ) & mask_];
+    }
+
+    //! Consumer: free running index of the oldest item, incremented by each Pop() and moved to the end by Clear().
+    U32_T Head() const { return head_.load( std::memory_order_relaxed ); }
+
+    //! Consumer: item at the free running index Index, Head() <= Index < Head() + Size().
+    T &At( U32_T Index )
+    {
+        return slots_[Index & mask_];
+    }
+
+    //! Consumer: remove the oldest item, the ring must not be empty.
+    void Pop()
+    {
+        head_.store( head_.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+    }
+
+    //! Consumer: remove every item pushed so far.
+    void Clear()
+    {
+        head_.store( tail_.load( std::memory_order_acquire ), std::memory_order_release );
+    }
+
+private:
+    SpscRing( const SpscRing & );
+    SpscRing &operator=( const SpscRing & );
+
+    // The padding keeps head_ and tail_ a full cache line apart. alignas() is not used: C++11 has no
+    // over-aligned operator new and the rings live in heap allocated axes and groups.
+    std::vector<T>     slots_;      //!< Capacity rounded up to a power of two
+    U32_T              mask_;       //!< slots_.size() - 1
+    std::atomic<U32_T> capacity_;
+    char               padHead_[kCacheLineSize];
+    std::atomic<U32_T> head_;       //!< Written by the consumer
+    char               padTail_[kCacheLineSize - sizeof( std::atomic<U32_T> )];
+    std::atomic<U32_T> tail_;       //!< Written by the producer
+    char               padEnd_[kCacheLineSize - sizeof( std::atomic<U32_T> )];
+};
+
+} // namespace nmc
+
+#endif // #ifndef __NEXMOTION_SIM_SPSC_RING_H
@@ -0,0 +1,171 @@
+/*!
+ * @file        NmcConfigCache.cpp
+ * @brief       Build and inspect the compiled cache of a device configuration file (NexMotionLibConfig.ini)
+ * @author      NexCOBOT, Inc.
+ *
+ * @code{.sh}
+ * nmc_config_cache build   <ini file> [<cache file>]
+ * nmc_config_cache inspect <cache file> [<ini file>]
+ * @endcode
+ */
+
+#include "sim/SimConfigCache.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace nmc;
+
+namespace
+{
+
+void Usage()
+{
+    std::fprintf( stderr,
+        "Usage: nmc_config_cache build   <ini file> [<cache file>]\n"
+        "       nmc_config_cache inspect <cache file> [<ini file>]\n"
+        "\n"
+        "The cache of <ini file> defaults to <ini file>%s, NMC_DeviceLoadIniConfig() uses it while it\n"
+        "matches the content of the ini file.\n", kConfigCacheSuffix );
+}
+
+size_t CountParams( const DeviceConfig_T &Config )
+{
+    size_t n = 0;
+    for( size_t i = 0; i < Config.axes.size(); ++i ) n += Config.axes[i].params.size();
+    for( size_t i = 0; i < Config.groups.size(); ++i )
+    {
+        n += Config.groups[i].params.size();
+        for( size_t a = 0; a < Config.groups[i].axes.size(); ++a ) n += Config.groups[i].axes[a].params.size();
+    }
+    return n;
+}
+
+void PrintDescription( const std::string &Description )
+{
+    if( !Description.empty() ) std::printf( "Description = %s\n", Description.c_str() );
+}
+
+void PrintParams( const std::vector<ConfigParam_T> &Params )
+{
+    for( size_t k = 0; k < Params.size(); ++k )
+    {
+        const ConfigParam_T &p = Params[k];
+        std::printf( "Param.0x%X.%d = %.17g  (slot %d, %s)\n", p.paramNum, p.subIndex, p.value, p.slot,
+                     p.type == PARAM_TYPE_I32 ? "I32" : "F64" );
+    }
+}
+
+int Build( const std::string &IniPath, const std::string &CachePath )
+{
+    std::string text, errorText;
+    RTN_ERR ret = ConfigReadFile( IniPath, &text );
+    if( ret != ERR_NEXMOTION_SUCCESS )
+    {
+        std::fprintf( stderr, "%s: cannot read (%d)\n", IniPath.c_str(), ret );
+        return 1;
+    }
+
+    DeviceConfig_T cfg;
+    ret = ConfigParse( text, IniPath, &cfg, &errorText );
+    if( ret == ERR_NEXMOTION_SUCCESS )
+        ret = ConfigCompile( &cfg, &errorText );
+    if( ret != ERR_NEXMOTION_SUCCESS )
+    {
+        std::fprintf( stderr, "%s (%d)\n", errorText.empty() ? IniPath.c_str() : errorText.c_str(), ret );
+        return 1;
+    }
+
+    ret = ConfigCacheWrite( CachePath, cfg, ConfigHash( text.data(), text.size() ), text.size() );
+    if( ret != ERR_NEXMOTION_SUCCESS )
+    {
+        std::fprintf( stderr, "%s: cannot write (%d)\n", CachePath.c_str(), ret );
+        return 1;
+    }
+    std::printf( "%s: %d axes, %d groups, %zu parameters\n", CachePath.c_str(), cfg.axisCount, cfg.groupCount, CountParams( cfg ) );
+    return 0;
+}
+
+int Inspect( const std::string &CachePath, const std::string &IniPath )
+{
+    ConfigCacheHeader_T header;
+    DeviceConfig_T cfg;
+    RTN_ERR ret = ConfigCacheRead( CachePath, 0, &cfg, &header );
+    if( ret == ERR_NEXMOTION_FILE_NOT_FOUND || ret == ERR_NEXMOTION_FILE_OPEN_FAILED || ret == ERR_NEXMOTION_FILE_LOAD_FAILED )
+    {
+        std::fprintf( stderr, "%s: cannot read (%d)\n", CachePath.c_str(), ret );
+        return 1;
+    }
+    if( ret == ERR_NEXMOTION_FILE_BAD_FORMAT )
+    {
+        std::fprintf( stderr, "%s: corrupted, bad magic, size or checksum\n", CachePath.c_str() );
+        return 1;
+    }
+
+    std::printf( "Cache         %s\n", CachePath.c_str() );
+    std::printf( "Version       %u%s\n", header.version, header.version == kConfigCacheVersion ? "" : "  (not supported)" );
+    std::printf( "Source        %llu bytes, hash %016llx\n", static_cast<unsigned long long>( header.sourceBytes ),
+                 static_cast<unsigned long long>( header.sourceHash ) );
+    std::printf( "Param tables  %016llx%s\n", static_cast<unsigned long long>( header.tableHash ), header.tableHash == ConfigTableHash() ? "" : "  (stale, built by another library)" );
+    std::printf( "Body          %llu bytes, hash %016llx\n", static_cast<unsigned long long>( header.bodyBytes ),
+                 static_cast<unsigned long long>( header.bodyHash ) );
+
+    int status = ( ret == ERR_NEXMOTION_SUCCESS ) ? 0 : 2;
+    if( !IniPath.empty() )
+    {
+        std::string text;
+        if( ConfigReadFile( IniPath, &text ) != ERR_NEXMOTION_SUCCESS )
+        {
+            std::fprintf( stderr, "%s: cannot read\n", IniPath.c_str() );
+            return 1;
+        }
+        bool fresh = ( ConfigHash( text.data(), text.size() ) == header.sourceHash );
+        std::printf( "Ini file      %s, %s\n", IniPath.c_str(), fresh ? "up to date" : "stale, the ini file changed" );
+        if( !fresh ) status = 2;
+    }
+    if( ret != ERR_NEXMOTION_SUCCESS )
+        return status;
+
+    std::printf( "\n[System]\nCycleTimeUs = %d\nAxisCount = %d\nGroupCount = %d\nAxisMotionBuffSize = %d\nGroupMotionBuffSize = %d\n"
+                 "InputMemorySize = %u\nOutputMemorySize = %u\nIoLoopback = %d\nRtPriority = %d\nRtCpu = %d\nRtLockMemory = %d\nRtStackPrefaultKb = %d\n",
+                 cfg.cycleTimeUs, cfg.axisCount, cfg.groupCount, cfg.axisBuffSize, cfg.groupBuffSize, cfg.inputSize, cfg.outputSize,
+                 cfg.ioLoopback ? 1 : 0, cfg.rtPriority, cfg.rtCpu, cfg.rtLockMemory, cfg.rtStackPrefaultKb );
+    for( size_t i = 0; i < cfg.axes.size(); ++i )
+    {
+        std::printf( "\n[Axis%zu]\n", i );
+        PrintDescription( cfg.axes[i].description );
+        PrintParams( cfg.axes[i].params );
+    }
+    for( size_t i = 0; i < cfg.groups.size(); ++i )
+    {
+        const GroupConfig_T &g = cfg.groups[i];
+        std::printf( "\n[Group%zu]\n", i );
+        PrintDescription( g.description );
+        std::printf( "AxisCount = %d\n", g.axisCount );
+        PrintParams( g.params );
+        for( size_t a = 0; a < g.axes.size(); ++a )
+        {
+            if( g.axes[a].params.empty() ) continue;
+            std::printf( "[Group%zu.Axis%zu]\n", i, a );
+            PrintParams( g.axes[a].params );
+        }
+    }
+    return status;
+}
+
+} // namespace
+
+int main( int argc, char *argv[] )
+{
+    if( argc < 3 || argc > 4 )
+    {
+        Usage();
+        return 1;
+    }
+    std::string second = ( argc == 4 ) ? argv[3] : "";
+    if( std::strcmp( argv[1], "build" ) == 0 )
+        return Build( argv[2], second.empty() ? ConfigCachePath( argv[2] ) : second );
+    if( std::strcmp( argv[1], "inspect" ) == 0 )
+        return Inspect( argv[2], second );
+    Usage();
+    return 1;
+}
@@ -0,0 +1,152 @@
+/*!
+ * @file        NmcIoCapture.cpp
+ * @brief       Decode the I/O capture files of NMC_DeviceStartIoCapture()
+ * @author      NexCOBOT, Inc.
+ *
+ * @code{.sh}
+ * nmc_io_capture info    <capture file>
+ * nmc_io_capture dump    <capture file>
+ * nmc_io_capture changes <capture file>
+ * @endcode
+ */
+
+#include "sim/SimIoCapture.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace nmc;
+
+namespace
+{
+
+enum Mode_E
+{
+    MODE_INFO,
+    MODE_DUMP,
+    MODE_CHANGES,
+};
+
+void Usage()
+{
+    std::fprintf( stderr,
+        "Usage: nmc_io_capture info    <capture file>\n"
+        "       nmc_io_capture dump    <capture file>\n"
+        "       nmc_io_capture changes <capture file>\n"
+        "\n"
+        "info prints the header and counts the frames, dump prints every frame in hex, one range per column,\n"
+        "changes prints every byte which changed with its rising and falling bits.\n" );
+}
+
+const char *AreaName( I32_T Area )
+{
+    return ( Area == NMC_MEM_ENTRY_AREA_INPUT ) ? "IN" : "OUT";
+}
+
+void PrintLost( U32_T Lost )
+{
+    if( Lost > 0 ) std::printf( "# %u frames lost\n", Lost );
+}
+
+void PrintFrame( const IoCaptureReader &Reader, U64_T Cycle, const std::vector<U8_T> &Frame )
+{
+    std::printf( "%llu", static_cast<unsigned long long>( Cycle ) );
+    const U8_T *p = &Frame[0];
+    for( size_t r = 0; r < Reader.Ranges().size(); ++r )
+    {
+        std::printf( " " );
+        for( U32_T k = 0; k < Reader.Ranges()[r].sizeByte; ++k )
+            std::printf( "%02x", *p++ );
+    }
+    std::printf( "\n" );
+}
+
+void PrintChanges( const IoCaptureReader &Reader, U64_T Cycle, const std::vector<U8_T> &Prev, const std::vector<U8_T> &Frame )
+{
+    U32_T at = 0;
+    for( size_t r = 0; r < Reader.Ranges().size(); ++r )
+    {
+        const NmcIoCaptureRange_T &range = Reader.Ranges()[r];
+        for( U32_T k = 0; k < range.sizeByte; ++k, ++at )
+        {
+            if( Prev[at] == Frame[at] ) continue;
+            std::printf( "%llu %s[%u] %02x -> %02x rising %02x falling %02x\n", static_cast<unsigned long long>( Cycle ),
+                         AreaName( range.area ), range.offsetByte + k, Prev[at], Frame[at],
+                         Frame[at] & ~Prev[at] & 0xFF, Prev[at] & ~Frame[at] & 0xFF );
+        }
+    }
+}
+
+int Decode( const std::string &Path, Mode_E Mode )
+{
+    IoCaptureReader reader;
+    RTN_ERR ret = reader.Open( Path );
+    if( ret != ERR_NEXMOTION_SUCCESS )
+    {
+        std::fprintf( stderr, "%s: %s (%d)\n", Path.c_str(), ret == ERR_NEXMOTION_FILE_BAD_FORMAT ? "not a capture file"
+                      : ret == ERR_NEXMOTION_FILE_VERSION_INCOMPTIBLE ? "version not supported" : "cannot read", ret );
+        return 1;
+    }
+
+    const IoCaptureHeader_T &header = reader.Header();
+    if( Mode == MODE_INFO )
+    {
+        std::printf( "Capture       %s\n", Path.c_str() );
+        std::printf( "Version       %u\n", header.version );
+        std::printf( "Cycle time    %u us\n", header.cycleTimeUs );
+        std::printf( "Started       %llu ns since 1970\n", static_cast<unsigned long long>( header.startUnixNs ) );
+        std::printf( "Frame         %u bytes\n", header.frameBytes );
+        for( size_t r = 0; r < reader.Ranges().size(); ++r )
+        {
+            const NmcIoCaptureRange_T &range = reader.Ranges()[r];
+            std::printf( "Range %-7zu %s[%u..%u]\n", r, AreaName( range.area ), range.offsetByte, range.offsetByte + range.sizeByte - 1 );
+        }
+    }
+
+    std::vector<U8_T>        prev( header.frameBytes, 0 );
+    const std::vector<U8_T> *frame = 0;
+    U64_T cycle = 0, first = 0, frames = 0, lost = 0;
+    U32_T lostBefore = 0;
+    while( ( ret = reader.Next( &cycle, &lostBefore, &frame ) ) == ERR_NEXMOTION_SUCCESS )
+    {
+        if( frames++ == 0 ) first = cycle;
+        lost += lostBefore;
+        if( Mode != MODE_INFO ) PrintLost( lostBefore );
+        if( Mode == MODE_DUMP )
+            PrintFrame( reader, cycle, *frame );
+        else if( Mode == MODE_CHANGES )
+            PrintChanges( reader, cycle, prev, *frame );
+        prev = *frame;
+    }
+    lost += lostBefore;
+    if( Mode != MODE_INFO ) PrintLost( lostBefore );
+    if( ret == ERR_NEXMOTION_FILE_BAD_FORMAT )
+        std::fprintf( stderr, "%s: corrupted record after frame %llu\n", Path.c_str(), static_cast<unsigned long long>( frames ) );
+
+    if( Mode == MODE_INFO )
+    {
+        std::printf( "Frames        %llu", static_cast<unsigned long long>( frames ) );
+        if( frames > 0 )
+            std::printf( ", cycles %llu ~ %llu", static_cast<unsigned long long>( first ), static_cast<unsigned long long>( cycle ) );
+        std::printf( "\nLost          %llu\n", static_cast<unsigned long long>( lost ) );
+    }
+    return ( ret == ERR_NEXMOTION_FILE_BAD_FORMAT ) ? 2 : 0;
+}
+
+} // namespace
+
+int main( int argc, char *argv[] )
+{
+    if( argc != 3 )
+    {
+        Usage();
+        return 1;
+    }
+    if( std::strcmp( argv[1], "info" ) == 0 )
+        return Decode( argv[2], MODE_INFO );
+    if( std::strcmp( argv[1], "dump" ) == 0 )
+        return Decode( argv[2], MODE_DUMP );
+    if( std::strcmp( argv[1], "changes" ) == 0 )
+        return Decode( argv[2], MODE_CHANGES );
+    Usage();
+    return 1;
+}
@@ -0,0 +1,139 @@
+/*!
+ * @file        NmcSCurve.cpp
+ * @brief       Plan, sample and time the S-curve profile of AXP_PROF_TYPE 1 outside a device
+ * @author      NexCOBOT, Inc.
+ *
+ * @code{.sh}
+ * nmc_scurve plan   <distance> <vm> <acc> <dec> <jerk> [<start vel> [<base vel>]]
+ * nmc_scurve sample <distance> <vm> <acc> <dec> <jerk> [<start vel> [<base vel>]] [-dt <sec>]
+ * nmc_scurve bench  <distance> <vm> <acc> <dec> <jerk> [<start vel> [<base vel>]]
+ * @endcode
+ */
+
+#include "sim/SimSCurve.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace nmc;
+
+namespace
+{
+
+const I32_T kBenchPlans       = 200000;
+const I32_T kBenchEvaluations = 10000000;
+
+void Usage()
+{
+    std::fprintf( stderr,
+        "Usage: nmc_scurve plan   <distance> <vm> <acc> <dec> <jerk> [<start vel> [<base vel>]]\n"
+        "       nmc_scurve sample <distance> <vm> <acc> <dec> <jerk> [<start vel> [<base vel>]] [-dt <sec>]\n"
+        "       nmc_scurve bench  <distance> <vm> <acc> <dec> <jerk> [<start vel> [<base vel>]]\n"
+        "\n"
+        "plan prints the durations of the 7 phases, sample prints time, position, velocity and acceleration\n"
+        "every -dt seconds (default 0.001) as CSV, bench times Plan() and Evaluate().\n" );
+}
+
+const char *PhaseName( I32_T Phase )
+{
+    switch( Phase )
+    {
+    case PROFILE_PHASE_ACC:   return "ACC";
+    case PROFILE_PHASE_CONST: return "CONST";
+    case PROFILE_PHASE_DEC:   return "DEC";
+    default:                  return "IDLE";
+    }
+}
+
+void Plan( const SCurveProfile &Profile )
+{
+    static const char *const kNames[SCurveProfile::kPhases] =
+        { "jerk up", "acceleration", "jerk down", "cruise", "jerk up", "deceleration", "jerk down" };
+    for( I32_T i = 0; i < SCurveProfile::kPhases; ++i )
+        std::printf( "Phase %d  %-13s %.9f s\n", i + 1, kNames[i], Profile.PhaseDuration( i ) );
+    std::printf( "Duration       %.9f s\n", Profile.Duration() );
+    std::printf( "Peak velocity  %.9g\n", Profile.PeakVel() );
+}
+
+void Sample( const SCurveProfile &Profile, F64_T Dt )
+{
+    std::printf( "t,pos,vel,acc,phase\n" );
+    SCurveState_T s;
+    for( I64_T k = 0;; ++k )
+    {
+        F64_T t = k * Dt;
+        Profile.Evaluate( t, &s );
+        std::printf( "%.6f,%.9f,%.9f,%.9f,%s\n", t, s.pos, s.vel, s.acc, PhaseName( s.phase ) );
+        if( t >= Profile.Duration() ) break;
+    }
+}
+
+void Bench( F64_T Distance, F64_T StartVel, const SCurveLimit_T &Limit, const SCurveProfile &Profile )
+{
+    typedef std::chrono::steady_clock Clock;
+    SCurveProfile  p;
+    volatile F64_T sink = 0.0;     // Keeps the timed calls
+
+    Clock::time_point t0 = Clock::now();
+    for( I32_T i = 0; i < kBenchPlans; ++i )
+        sink += p.Plan( 0.0, StartVel, Distance * ( 1.0 + i * 1e-9 ), Limit ) ? p.Duration() : 0.0;
+    Clock::time_point t1 = Clock::now();
+
+    SCurveState_T s;
+    F64_T step = Profile.Duration() / kBenchEvaluations;
+    for( I32_T i = 0; i < kBenchEvaluations; ++i )
+    {
+        Profile.Evaluate( i * step, &s );
+        sink += s.pos;
+    }
+    Clock::time_point t2 = Clock::now();
+
+    std::printf( "Plan()      %.1f ns\n", std::chrono::duration<F64_T, std::nano>( t1 - t0 ).count() / kBenchPlans );
+    std::printf( "Evaluate()  %.1f ns\n", std::chrono::duration<F64_T, std::nano>( t2 - t1 ).count() / kBenchEvaluations );
+}
+
+} // namespace
+
+int main( int argc, char *argv[] )
+{
+    F64_T dt = 0.001;
+    if( argc >= 3 && std::strcmp( argv[argc - 2], "-dt" ) == 0 )
+    {
+        dt = std::atof( argv[argc - 1] );
+        argc -= 2;
+    }
+    if( argc < 7 || argc > 9 || !( dt > 0.0 ) )
+    {
+        Usage();
+        return 1;
+    }
+
+    F64_T distance = std::atof( argv[2] );
+    SCurveLimit_T limit;
+    limit.vm    = std::atof( argv[3] );
+    limit.acc   = std::atof( argv[4] );
+    limit.dec   = std::atof( argv[5] );
+    limit.jerk  = std::atof( argv[6] );
+    F64_T startVel = ( argc > 7 ) ? std::atof( argv[7] ) : 0.0;
+    limit.vBase = ( argc > 8 ) ? std::atof( argv[8] ) : 0.0;
+
+    SCurveProfile profile;
+    if( !profile.Plan( 0.0, startVel, distance, limit ) )
+    {
+        std::fprintf( stderr, "No S-curve: the limits are not positive, or the axis cannot stop within the distance\n" );
+        return 2;
+    }
+    if( std::strcmp( argv[1], "plan" ) == 0 )
+        Plan( profile );
+    else if( std::strcmp( argv[1], "sample" ) == 0 )
+        Sample( profile, dt );
+    else if( std::strcmp( argv[1], "bench" ) == 0 )
+        Bench( distance, startVel, limit, profile );
+    else
+    {
+        Usage();
+        return 1;
+    }
+    return 0;
+}